@@ -0,0 +1,362 @@
+#
+# Synthetic Richards problem used by the benchmark suite.
+#
+# Writes <name>.pfidb (and any auxiliary inputs) into the current
+# directory; pfbench.py runs ParFlow on it.  All arguments are key=value
+# pairs, see the defaults below.  Every random input uses a fixed seed so
+# a configuration always solves the same problem.
+#
+# usage: tclsh benchmark_problem.tcl name=<run name> [key=value ...]
+#
+
+lappend auto_path $env(PARFLOW_DIR)/bin
+package require parflow
+namespace import Parflow::*
+
+set benchmark_dir [file dirname [file normalize [info script]]]
+
+#-----------------------------------------------------------------------------
+# Arguments
+#-----------------------------------------------------------------------------
+array set opt {
+    name      ""
+    P         1
+    Q         1
+    R         1
+    scaling   weak
+    nx        40
+    ny        40
+    nz        20
+    steps     10
+    overland  0
+    clm       0
+    io        0
+    geometry  box
+    precond   MGSemi
+    seed      33335
+}
+
+foreach arg $argv {
+    set pair [split $arg =]
+    if {[llength $pair] != 2 || ![info exists opt([lindex $pair 0])]} {
+	puts stderr "benchmark_problem.tcl: unknown argument '$arg'"
+	exit 1
+    }
+    set opt([lindex $pair 0]) [lindex $pair 1]
+}
+
+if {$opt(name) == ""} {
+    puts stderr "benchmark_problem.tcl: name=<run name> is required"
+    exit 1
+}
+
+if {$opt(clm)} {
+    # CLM is driven through the overland flow boundary condition
+    set opt(overland) 1
+}
+
+#-----------------------------------------------------------------------------
+# File input version number
+#-----------------------------------------------------------------------------
+pfset FileVersion 4
+
+#-----------------------------------------------------------------------------
+# Process Topology
+#-----------------------------------------------------------------------------
+pfset Process.Topology.P        $opt(P)
+pfset Process.Topology.Q        $opt(Q)
+pfset Process.Topology.R        $opt(R)
+
+#-----------------------------------------------------------------------------
+# Computational Grid
+#
+# Weak scaling: nx, ny, nz are the cells per process.
+# Strong scaling: nx, ny, nz are the cells of the whole domain.
+#-----------------------------------------------------------------------------
+switch -- $opt(scaling) {
+    weak {
+	set NX [expr $opt(nx) * $opt(P)]
+	set NY [expr $opt(ny) * $opt(Q)]
+	set NZ [expr $opt(nz) * $opt(R)]
+    }
+    strong {
+	set NX $opt(nx)
+	set NY $opt(ny)
+	set NZ $opt(nz)
+    }
+    default {
+	puts stderr "benchmark_problem.tcl: scaling must be weak or strong"
+	exit 1
+    }
+}
+
+pfset ComputationalGrid.Lower.X                0.0
+pfset ComputationalGrid.Lower.Y                0.0
+pfset ComputationalGrid.Lower.Z                0.0
+
+pfset ComputationalGrid.NX                     $NX
+pfset ComputationalGrid.NY                     $NY
+pfset ComputationalGrid.NZ                     $NZ
+
+#-----------------------------------------------------------------------------
+# Geometry
+#
+# box    : the full computational grid is active.
+# crater : the 2D crater solid of the old inactive/active timing problem,
+#          so most of the grid is inactive.
+#-----------------------------------------------------------------------------
+switch -- $opt(geometry) {
+    box {
+	pfset ComputationalGrid.DX             1000.0
+	pfset ComputationalGrid.DY             1000.0
+	pfset ComputationalGrid.DZ             2.0
+
+	pfset GeomInput.Names                  "domain_input"
+	pfset GeomInput.domain_input.InputType Box
+	pfset GeomInput.domain_input.GeomName  domain
+
+	pfset Geom.domain.Lower.X              0.0
+	pfset Geom.domain.Lower.Y              0.0
+	pfset Geom.domain.Lower.Z              0.0
+	pfset Geom.domain.Upper.X              [expr 1000.0 * $NX]
+	pfset Geom.domain.Upper.Y              [expr 1000.0 * $NY]
+	pfset Geom.domain.Upper.Z              [expr 2.0 * $NZ]
+
+	pfset Geom.domain.Patches "x-lower x-upper y-lower y-upper z-lower z-upper"
+	set top_patch z-upper
+
+	# Water table two meters below the surface, or at the surface with
+	# overland flow so the rain ponds and runs off
+	set ic_patch  z-upper
+	set ic_value  [expr {$opt(overland) ? 0.0 : -2.0}]
+    }
+    crater {
+	if {$opt(overland) || $NY != 1} {
+	    puts stderr "benchmark_problem.tcl: the crater geometry is 2D (ny=1) and has no overland flow"
+	    exit 1
+	}
+	file copy -force [file join $benchmark_dir crater2D.pfsol] crater2D.pfsol
+
+	pfset ComputationalGrid.DX             [expr 400.0 / $NX]
+	pfset ComputationalGrid.DY             1.0
+	pfset ComputationalGrid.DZ             [expr 200.0 / $NZ]
+
+	pfset GeomInput.Names                  "solidinput"
+	pfset GeomInput.solidinput.InputType   SolidFile
+	pfset GeomInput.solidinput.GeomNames   domain
+	pfset GeomInput.solidinput.FileName    crater2D.pfsol
+
+	pfset Geom.domain.Patches "infiltration z-upper x-lower y-lower x-upper y-upper z-lower"
+	set top_patch infiltration
+
+	# Water table 10 to 60 meters below the sloped surface
+	set ic_patch  z-lower
+	set ic_value  140.0
+    }
+    default {
+	puts stderr "benchmark_problem.tcl: geometry must be box or crater"
+	exit 1
+    }
+}
+
+pfset Domain.GeomName                          domain
+
+#-----------------------------------------------------------------------------
+# Permeability: a turning bands field with a fixed seed and a correlation
+# length of five cells
+#-----------------------------------------------------------------------------
+pfset Geom.Perm.Names                          domain
+pfset Geom.domain.Perm.Type                    TurnBands
+pfset Geom.domain.Perm.LambdaX                 [expr 5.0 * [pfget ComputationalGrid.DX]]
+pfset Geom.domain.Perm.LambdaY                 [expr 5.0 * [pfget ComputationalGrid.DY]]
+pfset Geom.domain.Perm.LambdaZ                 [expr 5.0 * [pfget ComputationalGrid.DZ]]
+pfset Geom.domain.Perm.GeomMean                0.1
+pfset Geom.domain.Perm.Sigma                   0.5
+pfset Geom.domain.Perm.NumLines                100
+pfset Geom.domain.Perm.RZeta                   5.0
+pfset Geom.domain.Perm.KMax                    100.0
+pfset Geom.domain.Perm.DelK                    0.2
+pfset Geom.domain.Perm.Seed                    $opt(seed)
+pfset Geom.domain.Perm.LogNormal               Log
+pfset Geom.domain.Perm.StratType               Bottom
+
+pfset Perm.TensorType                          TensorByGeom
+pfset Geom.Perm.TensorByGeom.Names             "domain"
+pfset Geom.domain.Perm.TensorValX              1.0
+pfset Geom.domain.Perm.TensorValY              1.0
+pfset Geom.domain.Perm.TensorValZ              1.0
+
+#-----------------------------------------------------------------------------
+# Material properties
+#-----------------------------------------------------------------------------
+pfset SpecificStorage.Type                     Constant
+pfset SpecificStorage.GeomNames                "domain"
+pfset Geom.domain.SpecificStorage.Value        1.0e-4
+
+pfset Phase.Names                              "water"
+pfset Phase.water.Density.Type                 Constant
+pfset Phase.water.Density.Value                1.0
+pfset Phase.water.Viscosity.Type               Constant
+pfset Phase.water.Viscosity.Value              1.0
+
+pfset Contaminants.Names                       ""
+pfset Geom.Retardation.GeomNames               ""
+pfset Gravity                                  1.0
+
+pfset Geom.Porosity.GeomNames                  domain
+pfset Geom.domain.Porosity.Type                Constant
+pfset Geom.domain.Porosity.Value               0.39
+
+pfset Phase.RelPerm.Type                       VanGenuchten
+pfset Phase.RelPerm.GeomNames                  domain
+pfset Geom.domain.RelPerm.Alpha                3.5
+pfset Geom.domain.RelPerm.N                    2.0
+
+pfset Phase.Saturation.Type                    VanGenuchten
+pfset Phase.Saturation.GeomNames               domain
+pfset Geom.domain.Saturation.Alpha             3.5
+pfset Geom.domain.Saturation.N                 2.0
+pfset Geom.domain.Saturation.SRes              0.2
+pfset Geom.domain.Saturation.SSat              1.0
+
+pfset Wells.Names                              ""
+
+pfset PhaseSources.water.Type                  Constant
+pfset PhaseSources.water.GeomNames             domain
+pfset PhaseSources.water.Geom.domain.Value     0.0
+
+pfset KnownSolution                            NoKnownSolution
+
+#-----------------------------------------------------------------------------
+# Timing: CLM steps are one hour, the met forcing is hourly
+#-----------------------------------------------------------------------------
+pfset TimingInfo.BaseUnit                      1.0
+pfset TimingInfo.StartCount                    0
+pfset TimingInfo.StartTime                     0.0
+pfset TimingInfo.StopTime                      $opt(steps)
+pfset TimeStep.Type                            Constant
+pfset TimeStep.Value                           1.0
+
+if {$opt(io)} {
+    pfset TimingInfo.DumpInterval              1.0
+} {
+    pfset TimingInfo.DumpInterval              -1
+}
+
+#-----------------------------------------------------------------------------
+# Boundary conditions: no flow on the sides, rain on and off at the top
+#-----------------------------------------------------------------------------
+pfset Cycle.Names                              "constant rainrec"
+pfset Cycle.constant.Names                     "alltime"
+pfset Cycle.constant.alltime.Length            1
+pfset Cycle.constant.Repeat                    -1
+
+pfset Cycle.rainrec.Names                      "rain rec"
+pfset Cycle.rainrec.rain.Length                2
+pfset Cycle.rainrec.rec.Length                 3
+pfset Cycle.rainrec.Repeat                     -1
+
+pfset BCPressure.PatchNames                    [pfget Geom.domain.Patches]
+
+foreach patch [pfget Geom.domain.Patches] {
+    pfset Patch.$patch.BCPressure.Type         FluxConst
+    pfset Patch.$patch.BCPressure.Cycle        "constant"
+    pfset Patch.$patch.BCPressure.alltime.Value 0.0
+}
+
+if {$opt(overland)} {
+    pfset Patch.$top_patch.BCPressure.Type     OverlandFlow
+} {
+    pfset Patch.$top_patch.BCPressure.Type     FluxConst
+}
+pfset Patch.$top_patch.BCPressure.Cycle        "rainrec"
+pfset Patch.$top_patch.BCPressure.rain.Value   -0.01
+pfset Patch.$top_patch.BCPressure.rec.Value    0.0
+
+#-----------------------------------------------------------------------------
+# Overland flow: a tilted plane draining towards x-lower
+#-----------------------------------------------------------------------------
+pfset TopoSlopesX.Type                         "Constant"
+pfset TopoSlopesX.GeomNames                    "domain"
+pfset TopoSlopesX.Geom.domain.Value            0.005
+
+pfset TopoSlopesY.Type                         "Constant"
+pfset TopoSlopesY.GeomNames                    "domain"
+pfset TopoSlopesY.Geom.domain.Value            0.001
+
+pfset Mannings.Type                            "Constant"
+pfset Mannings.GeomNames                       "domain"
+pfset Mannings.Geom.domain.Value               5.52e-6
+
+#-----------------------------------------------------------------------------
+# Initial conditions: hydrostatic, see the geometry
+#-----------------------------------------------------------------------------
+pfset ICPressure.Type                          HydroStaticPatch
+pfset ICPressure.GeomNames                     domain
+pfset Geom.domain.ICPressure.Value             $ic_value
+pfset Geom.domain.ICPressure.RefGeom           domain
+pfset Geom.domain.ICPressure.RefPatch          $ic_patch
+
+#-----------------------------------------------------------------------------
+# Solver
+#-----------------------------------------------------------------------------
+pfset Solver                                   Richards
+pfset Solver.MaxIter                           100000
+
+pfset Solver.Nonlinear.MaxIter                 20
+pfset Solver.Nonlinear.ResidualTol             1e-6
+pfset Solver.Nonlinear.EtaChoice               EtaConstant
+pfset Solver.Nonlinear.EtaValue                0.01
+pfset Solver.Nonlinear.UseJacobian             True
+pfset Solver.Nonlinear.DerivativeEpsilon       1e-8
+pfset Solver.Nonlinear.StepTol                 1e-20
+pfset Solver.Nonlinear.Globalization           LineSearch
+pfset Solver.Linear.KrylovDimension            25
+pfset Solver.Linear.MaxRestarts                2
+pfset Solver.Linear.Preconditioner             $opt(precond)
+pfset Solver.Drop                              1E-20
+pfset Solver.AbsTol                            1E-9
+
+# Per step phase times and iteration counts for pfbench.py
+pfset Solver.Telemetry                         True
+
+# The I/O heavy configuration writes every field at every step
+set print [expr {$opt(io) ? "True" : "False"}]
+foreach key {PrintSubsurfData PrintPressure PrintSaturation PrintMask
+             PrintVelocities PrintEvapTrans} {
+    pfset Solver.$key                          $print
+}
+pfset Solver.PrintOverlandSum [expr {($opt(io) && $opt(overland)) ? "True" : "False"}]
+
+#-----------------------------------------------------------------------------
+# CLM: the single column forcing of the CLM regression test over a
+# uniform grassland
+#-----------------------------------------------------------------------------
+if {$opt(clm)} {
+    set clm_dir [file join $benchmark_dir .. .. test tcl clm]
+    foreach file {drv_clmin.dat drv_vegp.dat narr_1hr.sc3.txt.0} {
+	file copy -force [file join $clm_dir $file] $file
+    }
+
+    set vegm [open drv_vegm.dat w]
+    puts $vegm " x  y  lat    lon    sand clay color  fractional coverage of grid by vegetation class (Must/Should Add to 1.0)"
+    puts $vegm "       (Deg)\t (Deg)  (%/100)   index  1    2    3    4    5    6    7    8    9    10   11   12   13   14   15   16   17   18"
+    for {set i 1} {$i <= $NX} {incr i} {
+	for {set j 1} {$j <= $NY} {incr j} {
+	    puts $vegm [format "%4d%4d   34.750 -98.138  0.16 0.265   2   0.0 0.0  0.0  0.0  0.0  0.0  0.0  0.0  0.0  1.0  0.0  0.0  0.0  0.0  0.0  0.0  0.0  0.0" $i $j]
+	}
+    }
+    close $vegm
+
+    pfset Solver.LSM                           CLM
+    pfset Solver.CLM.MetForcing                1D
+    pfset Solver.CLM.MetFileName               narr_1hr.sc3.txt.0
+    pfset Solver.CLM.MetFilePath               ./
+    pfset Solver.PrintCLM                      $print
+    pfset Solver.WriteCLMBinary                False
+}
+
+#-----------------------------------------------------------------------------
+# Write the database; pfbench.py starts the runs
+#-----------------------------------------------------------------------------
+pfwritedb $opt(name)
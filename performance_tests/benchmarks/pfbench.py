@@ -0,0 +1,455 @@
+#!/usr/bin/env python3
+"""ParFlow benchmark runner.
+
+  pfbench.py run     runs one benchmark configuration and writes
+                     <results-dir>/<name>.json
+  pfbench.py compare compares two result directories (or files) and exits
+                     with status 1 if anything regressed
+
+A benchmark is a benchmark_problem.tcl configuration.  The problem is
+written once, ParFlow is run --warmup times with the results discarded and
+then --repetitions times.  Each repetition collects:
+
+  * the wall clock time of the run,
+  * the per phase times and iteration counts of the solver telemetry
+    stream (<name>.out.telemetry.jsonl),
+  * the timers of <name>.out.timing.csv (only present in PARFLOW_ENABLE_TIMING
+    builds, otherwise just the total run time),
+  * the number of bytes of field output written.
+
+Times are summarized as median/min/max over the repetitions.  Iteration
+counts and bytes written must not change between repetitions; they are
+the same for every run of a configuration unless the numerics change.
+
+With --kernels the problem is run by pfkernelbench instead of ParFlow,
+which times the core solver kernels (function evaluation, Jacobian,
+matvec, constitutive relations, halo update, vector operations) on the
+initial state.  Its seconds per call are collected in place of the solver
+phases.
+
+Only the Python standard library is used.
+"""
+
+import argparse
+import csv
+import datetime
+import glob
+import json
+import os
+import platform
+import shutil
+import statistics
+import subprocess
+import sys
+import time
+
+RESULT_FORMAT = 1
+
+# Seconds per kernel call below which kernel times are not compared
+KERNEL_MIN_TIME = 1e-5
+
+BENCHMARK_DIR = os.path.dirname(os.path.abspath(__file__))
+
+# Field output counted as bytes written; logs are excluded since their
+# size depends on the printed timings.
+OUTPUT_PATTERNS = ['*.pfb', '*.pfsb', '*.pfb.dist', '*.pfsb.dist',
+                   '*.silo', '*.nc', '*.C.pfb']
+
+
+def topology(ranks):
+    """Most square P x Q x 1 process grid with P >= Q."""
+    q = int(ranks ** 0.5)
+    while ranks % q:
+        q -= 1
+    return ranks // q, q, 1
+
+
+def summarize(values):
+    return {'median': statistics.median(values),
+            'min': min(values),
+            'max': max(values)}
+
+
+def read_telemetry(filename):
+    """Sum the per step records of a telemetry stream.
+
+    Phase times are the sum over steps of the slowest rank, which is the
+    time the phase adds to the run.
+    """
+    totals = {'steps': 0, 'attempts': 0, 'nonlin_iters': 0, 'lin_iters': 0}
+    phases = {}
+
+    with open(filename) as f:
+        for line in f:
+            if not line.strip():
+                continue
+            record = json.loads(line)
+            totals['steps'] += 1
+            for key in ('attempts', 'nonlin_iters', 'lin_iters'):
+                totals[key] += record[key]
+            for key, value in record.items():
+                if isinstance(value, dict) and 'max' in value:
+                    # 'wall' is the time of the whole step
+                    key = 'time_steps' if key == 'wall' else key
+                    phases[key] = phases.get(key, 0.0) + value['max']
+
+    return totals, phases
+
+
+def read_timing(filename):
+    timers = {}
+    with open(filename, newline='') as f:
+        for row in csv.reader(f):
+            if len(row) < 2 or row[0] == 'Timer':
+                continue
+            try:
+                timers[row[0]] = float(row[1])
+            except ValueError:
+                pass
+    return timers
+
+
+def output_bytes(work_dir):
+    files = set()
+    for pattern in OUTPUT_PATTERNS:
+        files.update(glob.glob(os.path.join(work_dir, '**', pattern),
+                               recursive=True))
+    return sum(os.path.getsize(f) for f in files)
+
+
+def clean_outputs(work_dir, name):
+    for path in glob.glob(os.path.join(work_dir, name + '.out.*')):
+        if os.path.isdir(path):
+            shutil.rmtree(path)
+        else:
+            os.remove(path)
+
+
+def parflow_version(work_dir, name):
+    log = os.path.join(work_dir, name + '.out.log')
+    if os.path.exists(log):
+        with open(log) as f:
+            for line in f:
+                if 'Version' in line and ':' in line:
+                    return line.split(':', 1)[1].strip()
+    return None
+
+
+def run_once(parflow_dir, work_dir, name, ranks, kernels=False):
+    clean_outputs(work_dir, name)
+
+    program = ['-p', 'pfkernelbench'] if kernels else []
+    start = time.perf_counter()
+    result = subprocess.run(
+        ['sh', os.path.join(parflow_dir, 'bin', 'run')] + program
+        + [name, str(ranks)],
+        cwd=work_dir, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+        universal_newlines=True)
+    wall = time.perf_counter() - start
+
+    # ParFlow exits normally when a time step fails, so check its output
+    out_txt = os.path.join(work_dir, name + '.out.txt')
+    output = ''
+    if os.path.exists(out_txt):
+        with open(out_txt) as f:
+            output = f.read()
+    if result.returncode or any(line.startswith('Error')
+                                for line in output.splitlines()):
+        sys.stdout.write(result.stdout + output)
+        sys.exit(f'pfbench.py: {name}: ParFlow failed')
+
+    if kernels:
+        filename = os.path.join(work_dir, name + '.out.kernels.json')
+        if not os.path.exists(filename):
+            sys.exit(f'pfbench.py: {name}: {filename} was not written')
+        with open(filename) as f:
+            kernel_report = json.load(f)
+        return {'wall': wall,
+                'iterations': {},
+                'phases': {},
+                'timers': {},
+                'kernels': {kernel: value['seconds'] for kernel, value
+                            in kernel_report['kernels'].items()},
+                'kernel_report': kernel_report,
+                'bytes_written': 0}
+
+    telemetry = os.path.join(work_dir, name + '.out.telemetry.jsonl')
+    if not os.path.exists(telemetry):
+        sys.exit(f'pfbench.py: {name}: {telemetry} was not written')
+    iterations, phases = read_telemetry(telemetry)
+
+    timing = os.path.join(work_dir, name + '.out.timing.csv')
+    timers = read_timing(timing) if os.path.exists(timing) else {}
+
+    return {'wall': wall,
+            'iterations': iterations,
+            'phases': phases,
+            'timers': timers,
+            'bytes_written': output_bytes(work_dir)}
+
+
+def command_run(args):
+    parflow_dir = os.environ.get('PARFLOW_DIR', args.parflow_dir)
+    if not parflow_dir:
+        sys.exit('pfbench.py: PARFLOW_DIR is not set')
+
+    name = args.name
+    work_dir = os.path.abspath(args.work_dir or name)
+    if os.path.isdir(work_dir):
+        shutil.rmtree(work_dir)
+    os.makedirs(work_dir)
+
+    if args.topology:
+        P, Q, R = args.topology
+        if P * Q * R != args.ranks:
+            sys.exit(f'pfbench.py: {name}: topology {P}x{Q}x{R} does not '
+                     f'match {args.ranks} ranks')
+    else:
+        P, Q, R = topology(args.ranks)
+    problem = ['name=' + name, f'P={P}', f'Q={Q}', f'R={R}'] + args.problem
+
+    env = dict(os.environ, PARFLOW_DIR=parflow_dir)
+    subprocess.run(['tclsh', os.path.join(BENCHMARK_DIR,
+                                          'benchmark_problem.tcl')] + problem,
+                   cwd=work_dir, env=env, check=True)
+
+    os.environ['PARFLOW_DIR'] = parflow_dir
+
+    for i in range(args.warmup):
+        print(f'{name}: warm-up {i + 1}/{args.warmup}', flush=True)
+        run_once(parflow_dir, work_dir, name, args.ranks, args.kernels)
+
+    runs = []
+    for i in range(args.repetitions):
+        run = run_once(parflow_dir, work_dir, name, args.ranks, args.kernels)
+        print(f'{name}: repetition {i + 1}/{args.repetitions} '
+              f'{run["wall"]:.3f} s', flush=True)
+        runs.append(run)
+
+    for key in ('iterations', 'bytes_written'):
+        if any(run[key] != runs[0][key] for run in runs):
+            sys.exit(f'pfbench.py: {name}: {key} differ between repetitions, '
+                     'the benchmark is not reproducible')
+
+    phases = sorted(set().union(*(run['phases'] for run in runs)))
+    timers = sorted(set().union(*(run['timers'] for run in runs)))
+
+    result = {
+        'format': RESULT_FORMAT,
+        'name': name,
+        'labels': args.labels.split(',') if args.labels else [],
+        'problem': problem,
+        'ranks': args.ranks,
+        'topology': [P, Q, R],
+        'warmup': args.warmup,
+        'repetitions': args.repetitions,
+        'wall': summarize([run['wall'] for run in runs]),
+        'phases': {phase: summarize([run['phases'].get(phase, 0.0)
+                                     for run in runs])
+                   for phase in phases},
+        'timers': {timer: summarize([run['timers'].get(timer, 0.0)
+                                     for run in runs])
+                   for timer in timers},
+        'kernels': {kernel: summarize([run['kernels'][kernel]
+                                       for run in runs])
+                    for kernel in runs[0].get('kernels', {})},
+        'iterations': runs[0]['iterations'],
+        'bytes_written': runs[0]['bytes_written'],
+        'samples': [run['wall'] for run in runs],
+        'machine': {
+            'host': platform.node(),
+            'platform': platform.platform(),
+            'processor': platform.processor(),
+            'cpus': os.cpu_count(),
+            'omp_num_threads': os.environ.get('OMP_NUM_THREADS'),
+        },
+        'parflow_version': parflow_version(work_dir, name),
+        'date': datetime.datetime.now(datetime.timezone.utc).isoformat(),
+    }
+
+    if args.kernels:
+        kernel_report = runs[0]['kernel_report']
+        for key in ('backend', 'threads', 'cells'):
+            result[key] = kernel_report[key]
+        result['stream_triad_bandwidth'] = summarize(
+            [run['kernel_report']['stream_triad_bandwidth'] for run in runs])
+
+    results_dir = os.path.abspath(args.results_dir)
+    os.makedirs(results_dir, exist_ok=True)
+    filename = os.path.join(results_dir, name + '.json')
+    with open(filename, 'w') as f:
+        json.dump(result, f, indent=2, sort_keys=True)
+        f.write('\n')
+    if args.kernels:
+        print(f'{name}: {result["cells"]:.0f} cells, backend '
+              f'{result["backend"]}, {result["threads"]} threads, STREAM '
+              f'triad {1e-9 * result["stream_triad_bandwidth"]["median"]:.2f}'
+              ' GB/s')
+        for kernel, seconds in sorted(result['kernels'].items()):
+            print(f'  {kernel:<18} {1e3 * seconds["median"]:10.4f} ms/call')
+        print(f'{name}: -> {filename}')
+    else:
+        print(f'{name}: median {result["wall"]["median"]:.3f} s, '
+              f'{result["iterations"]["nonlin_iters"]} nonlinear and '
+              f'{result["iterations"]["lin_iters"]} linear iterations, '
+              f'{result["bytes_written"]} bytes written -> {filename}')
+
+    if args.baseline:
+        baseline = os.path.join(args.baseline, name + '.json')
+        if not os.path.exists(baseline):
+            print(f'{name}: no baseline in {args.baseline}')
+            return 0
+        return report([compare(load(baseline), result, args.threshold,
+                               args.min_time)])
+
+    return 0
+
+
+def load(filename):
+    with open(filename) as f:
+        result = json.load(f)
+    if result.get('format') != RESULT_FORMAT:
+        sys.exit(f'pfbench.py: {filename}: unsupported result format')
+    return result
+
+
+def load_dir(path):
+    if os.path.isfile(path):
+        result = load(path)
+        return {result['name']: result}
+    return {r['name']: r for r in
+            (load(f) for f in sorted(glob.glob(os.path.join(path,
+                                                            '*.json'))))}
+
+
+def compare(baseline, current, threshold, min_time):
+    """Compare two results of the same benchmark.
+
+    A time regresses when the current median is more than threshold
+    (relative) and min_time (absolute, seconds) slower than the baseline
+    median; times below min_time in both are not reported.  Iteration
+    counts and bytes written must match exactly.
+    """
+    lines = []
+    regressed = False
+
+    def check_time(label, base, cur, min_time=min_time):
+        nonlocal regressed
+        b, c = base['median'], cur['median']
+        if b < min_time and c < min_time:
+            return
+        change = (c - b) / b if b > 0 else 0.0
+        status = ''
+        if c - b > min_time and change > threshold:
+            status = 'REGRESSION'
+            regressed = True
+        elif b - c > min_time and -change > threshold:
+            status = 'improved'
+        lines.append(f'  {label:<32} {b:10.4g} {c:10.4g} '
+                     f'{100.0 * change:+8.1f}%  {status}')
+
+    check_time('wall', baseline['wall'], current['wall'])
+    for group in ('phases', 'timers'):
+        for key in sorted(set(baseline[group]) & set(current[group])):
+            check_time(key, baseline[group][key], current[group][key])
+
+    # Kernel times are per call, far below min_time; they are the best of
+    # several samples and compared by the relative threshold down to
+    # calls too short for the 100 us ParFlow clock
+    kernels = (baseline.get('kernels', {}), current.get('kernels', {}))
+    for key in sorted(set(kernels[0]) & set(kernels[1])):
+        check_time(key, kernels[0][key], kernels[1][key], KERNEL_MIN_TIME)
+
+    for key in sorted(set(baseline['iterations'])
+                      | set(current['iterations'])):
+        b = baseline['iterations'].get(key)
+        c = current['iterations'].get(key)
+        if b != c:
+            lines.append(f'  {key:<32} {b!s:>10} {c!s:>10}'
+                         '            CHANGED')
+            regressed = True
+
+    if baseline['bytes_written'] != current['bytes_written']:
+        lines.append(f'  {"bytes_written":<32} {baseline["bytes_written"]:>10}'
+                     f' {current["bytes_written"]:>10}            CHANGED')
+        regressed = True
+
+    header = f'{current["name"]}: {"REGRESSED" if regressed else "ok"}'
+    return regressed, [header,
+                       f'  {"":<32} {"baseline":>10} {"current":>10}'] + lines
+
+
+def report(comparisons):
+    regressed = False
+    for failed, lines in comparisons:
+        regressed = regressed or failed
+        print('\n'.join(lines))
+    return 1 if regressed else 0
+
+
+def command_compare(args):
+    baseline = load_dir(args.baseline)
+    current = load_dir(args.current)
+
+    comparisons = []
+    for name in sorted(current):
+        if name in baseline:
+            comparisons.append(compare(baseline[name], current[name],
+                                       args.threshold, args.min_time))
+        else:
+            print(f'{name}: no baseline')
+    for name in sorted(set(baseline) - set(current)):
+        print(f'{name}: missing from the current results')
+
+    return report(comparisons)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    commands = parser.add_subparsers(dest='command')
+    commands.required = True
+
+    def add_compare_options(p):
+        p.add_argument('--threshold', type=float, default=0.10,
+                       help='relative slowdown flagged as a regression '
+                       '(default 0.10)')
+        p.add_argument('--min-time', type=float, default=0.05,
+                       help='ignore differences below this many seconds '
+                       '(default 0.05)')
+
+    run = commands.add_parser('run', help='run one benchmark')
+    run.add_argument('--name', required=True,
+                     help='benchmark name, also the ParFlow run name')
+    run.add_argument('--ranks', type=int, default=1)
+    run.add_argument('--topology', type=int, nargs=3, metavar=('P', 'Q', 'R'),
+                     help='process grid (default: most square P x Q x 1)')
+    run.add_argument('--repetitions', type=int, default=3)
+    run.add_argument('--warmup', type=int, default=1)
+    run.add_argument('--work-dir',
+                     help='directory the problem runs in (default ./<name>)')
+    run.add_argument('--results-dir', default='results')
+    run.add_argument('--labels', help='comma separated labels')
+    run.add_argument('--parflow-dir',
+                     help='ParFlow installation used if PARFLOW_DIR is unset')
+    run.add_argument('--kernels', action='store_true',
+                     help='time the solver kernels with pfkernelbench')
+    run.add_argument('--baseline',
+                     help='directory of baseline results to compare with')
+    add_compare_options(run)
+    run.add_argument('problem', nargs='*',
+                     help='key=value arguments for benchmark_problem.tcl')
+    run.set_defaults(func=command_run)
+
+    cmp = commands.add_parser('compare',
+                              help='compare results against a baseline')
+    cmp.add_argument('baseline', help='baseline result directory or file')
+    cmp.add_argument('current', help='current result directory or file')
+    add_compare_options(cmp)
+    cmp.set_defaults(func=command_compare)
+
+    args = parser.parse_args()
+    return args.func(args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -1,5 +0,0 @@
-set size 8
-set name "big_domain"
-
-source base_problem.tcl
-
@@ -1,5 +0,0 @@
-set size [lindex $argv 0] 
-set name [lindex $argv 1]
-
-source base_problem.tcl
-
@@ -1,5 +0,0 @@
-set size 1
-set name "small_domain"
-
-source base_problem.tcl
-
@@ -229,6 +229,9 @@ extern int amps_write_size;
 #define amps_Min MPI_MIN
 #define amps_Add MPI_SUM
 
+/* Request handle of a non-blocking reduction */
+typedef MPI_Request amps_ReduceRequest;
+
 
 #define AMPS_PID 0
 
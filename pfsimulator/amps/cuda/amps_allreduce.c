@@ -187,3 +187,87 @@ int amps_AllReduce(amps_Comm comm, amps_Invoice invoice, MPI_Op operation)
   
   return 0;
 }
+
+
+/*===========================================================================*/
+/**
+ * \Ref{amps_AllReduceDoubles} reduces an array of doubles in place on all
+ * the nodes of a context.  It is the same as \Ref{amps_AllReduce} with a
+ * "%*d" invoice, but avoids creating the invoice and copying the data to
+ * and from temporary buffers, so it is cheaper for the small reductions
+ * done in every iteration of the solvers.
+ *
+ * {\large Example:}
+ * \begin{verbatim}
+ * double sums[2];
+ *
+ * // find sum of the local values on all nodes
+ * amps_AllReduceDoubles(amps_CommWorld, sums, 2, amps_Add);
+ * \end{verbatim}
+ *
+ * @memo Reduction of doubles
+ * @param comm communication context for the reduction [IN]
+ * @param data array to reduce [IN/OUT]
+ * @param len number of elements in data [IN]
+ * @param operation reduction operation to perform [IN]
+ * @return Error code
+ */
+int amps_AllReduceDoubles(amps_Comm comm, double *data, int len,
+                          MPI_Op operation)
+{
+  return MPI_Allreduce(MPI_IN_PLACE, data, len, MPI_DOUBLE, operation, comm);
+}
+
+/*===========================================================================*/
+/**
+ * \Ref{amps_IAllReduceDoubles} starts a non-blocking \Ref{amps_AllReduceDoubles}
+ * so work that does not need the result can overlap the reduction.  The
+ * data may not be touched until \Ref{amps_WaitReduce} has been called on
+ * the request.  Without MPI-3 the reduction is done before returning.
+ *
+ * {\large Example:}
+ * \begin{verbatim}
+ * amps_ReduceRequest request;
+ * double sum;
+ *
+ * amps_IAllReduceDoubles(amps_CommWorld, &sum, 1, amps_Add, &request);
+ *
+ * // work not depending on sum
+ *
+ * amps_WaitReduce(&request);
+ * \end{verbatim}
+ *
+ * @memo Start a non-blocking reduction of doubles
+ * @param comm communication context for the reduction [IN]
+ * @param data array to reduce [IN/OUT]
+ * @param len number of elements in data [IN]
+ * @param operation reduction operation to perform [IN]
+ * @param request handle to wait on for the result [OUT]
+ * @return Error code
+ */
+int amps_IAllReduceDoubles(amps_Comm comm, double *data, int len,
+                           MPI_Op operation, amps_ReduceRequest *request)
+{
+#if MPI_VERSION >= 3
+  return MPI_Iallreduce(MPI_IN_PLACE, data, len, MPI_DOUBLE, operation,
+                        comm, request);
+#else
+  *request = MPI_REQUEST_NULL;
+  return MPI_Allreduce(MPI_IN_PLACE, data, len, MPI_DOUBLE, operation, comm);
+#endif
+}
+
+/*===========================================================================*/
+/**
+ * \Ref{amps_WaitReduce} blocks until the reduction started by
+ * \Ref{amps_IAllReduceDoubles} is complete and its result is in the data
+ * array.
+ *
+ * @memo Wait for a non-blocking reduction
+ * @param request handle of the reduction [IN/OUT]
+ * @return Error code
+ */
+int amps_WaitReduce(amps_ReduceRequest *request)
+{
+  return MPI_Wait(request, MPI_STATUS_IGNORE);
+}
@@ -81,6 +81,13 @@ typedef FILE *amps_File;
 
 #define amps_AllReduce(comm, invoice, operation)
 
+typedef int amps_ReduceRequest;
+
+#define amps_AllReduceDoubles(comm, data, len, operation) ((void)(data), 0)
+#define amps_IAllReduceDoubles(comm, data, len, operation, request) \
+  ((void)(data), *(request) = 0)
+#define amps_WaitReduce(request) ((void)(request), 0)
+
 #define amps_BCast(comm, source, invoice) 0
 
 #define amps_NewHandle(comm, id, invoice)
@@ -228,6 +228,9 @@ extern int amps_write_size;
 #define amps_Min 2
 #define amps_Add 3
 
+/* Request handle of a non-blocking reduction */
+typedef int amps_ReduceRequest;
+
 
 
 #define AMPS_PID 0
@@ -442,3 +442,38 @@ int operation;
   return 0;
 }
 
+/* Typed reductions; without a native non-blocking reduction these go
+ * through an invoice and complete before returning */
+int amps_AllReduceDoubles(comm, data, len, operation)
+amps_Comm comm;
+double *data;
+int len;
+int operation;
+{
+  amps_Invoice invoice;
+  int result;
+
+  invoice = amps_NewInvoice("%*d", len, data);
+  result = amps_AllReduce(comm, invoice, operation);
+  amps_FreeInvoice(invoice);
+
+  return result;
+}
+
+int amps_IAllReduceDoubles(comm, data, len, operation, request)
+amps_Comm comm;
+double *data;
+int len;
+int operation;
+amps_ReduceRequest *request;
+{
+  *request = 0;
+  return amps_AllReduceDoubles(comm, data, len, operation);
+}
+
+int amps_WaitReduce(request)
+amps_ReduceRequest *request;
+{
+  (void)request;
+  return 0;
+}
@@ -0,0 +1,150 @@
+/*BHEADER*********************************************************************
+ *
+ *  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+ *  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+ *  by the Parflow Team (see the CONTRIBUTORS file)
+ *  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+ *
+ *  This file is part of Parflow. For details, see
+ *  http://www.llnl.gov/casc/parflow
+ *
+ *  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+ *  for the GNU Lesser General Public License.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License (as published
+ *  by the Free Software Foundation) version 2.1 dated February 1999.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+ *  and conditions of the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ *  USA
+ **********************************************************************EHEADER*/
+/*
+ * Test the typed reductions of doubles, blocking and non-blocking.
+ */
+
+#include "amps.h"
+#include "amps_test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define LEN 3
+
+int sum(int x)
+{
+  int i, result = 0;
+
+  for (i = 1; i <= x; i++)
+    result += i;
+
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  amps_ReduceRequest max_request;
+  amps_ReduceRequest add_request;
+
+  double d_result[LEN];
+  double d_max[LEN];
+  double d_add[LEN];
+
+  int num;
+  int me;
+
+  int loop, i, n;
+
+  int result = 0;
+
+  if (amps_Init(&argc, &argv))
+  {
+    amps_Printf("Error amps_Init\n");
+    amps_Exit(1);
+  }
+
+  loop = atoi(argv[1]);
+
+  num = amps_Size(amps_CommWorld);
+
+  me = amps_Rank(amps_CommWorld);
+
+  for (i = loop; i; i--)
+  {
+    /* Blocking reductions */
+    for (n = 0; n < LEN; n++)
+      d_result[n] = (me + 1) * (n + 1);
+
+    amps_AllReduceDoubles(amps_CommWorld, d_result, LEN, amps_Max);
+
+    for (n = 0; n < LEN; n++)
+    {
+      if (d_result[n] != (double)(num * (n + 1)))
+      {
+        amps_Printf("ERROR!!!!! MAX result is incorrect: %f  %d\n",
+                    d_result[n], num * (n + 1));
+        result = 1;
+      }
+    }
+
+    for (n = 0; n < LEN; n++)
+      d_result[n] = (me + 1) * (n + 1);
+
+    amps_AllReduceDoubles(amps_CommWorld, d_result, LEN, amps_Min);
+
+    for (n = 0; n < LEN; n++)
+    {
+      if (d_result[n] != (double)(n + 1))
+      {
+        amps_Printf("ERROR!!!!! MIN result is incorrect: %f  %d\n",
+                    d_result[n], n + 1);
+        result = 1;
+      }
+    }
+
+    for (n = 0; n < LEN; n++)
+      d_result[n] = (me + 1) * (n + 1);
+
+    amps_AllReduceDoubles(amps_CommWorld, d_result, LEN, amps_Add);
+
+    for (n = 0; n < LEN; n++)
+    {
+      if (d_result[n] != (double)(sum(num) * (n + 1)))
+      {
+        amps_Printf("ERROR!!!!! Add result is incorrect: %f  %d\n",
+                    d_result[n], sum(num) * (n + 1));
+        result = 1;
+      }
+    }
+
+    /* Two non-blocking reductions in flight at once */
+    for (n = 0; n < LEN; n++)
+      d_max[n] = d_add[n] = (me + 1) * (n + 1);
+
+    amps_IAllReduceDoubles(amps_CommWorld, d_max, LEN, amps_Max, &max_request);
+    amps_IAllReduceDoubles(amps_CommWorld, d_add, LEN, amps_Add, &add_request);
+    amps_WaitReduce(&add_request);
+    amps_WaitReduce(&max_request);
+
+    for (n = 0; n < LEN; n++)
+    {
+      if (d_max[n] != (double)(num * (n + 1))
+          || d_add[n] != (double)(sum(num) * (n + 1)))
+      {
+        amps_Printf("ERROR!!!!! non-blocking result is incorrect: %f %f\n",
+                    d_max[n], d_add[n]);
+        result = 1;
+      }
+    }
+  }
+
+  amps_Finalize();
+
+  return amps_check_result(result);
+}
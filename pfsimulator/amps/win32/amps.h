@@ -62,6 +62,9 @@ int AMPS_USERS_MAIN(int argc, char *argv []);
 #define amps_Min 2
 #define amps_Add 3
 
+/* Request handle of a non-blocking reduction */
+typedef int amps_ReduceRequest;
+
 #define AMPS_PID 0
 
 /* These are the built-in types that are supported */
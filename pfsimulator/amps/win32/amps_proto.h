@@ -4,6 +4,9 @@ void _dorand48 (unsigned short xseed [3 ]);
 /* amps_allreduce.c */
 int amps_ReduceOperation (amps_Comm comm, amps_Invoice invoice, char *buf_dest, char *buf_src, int operation);
 int amps_AllReduce (amps_Comm comm, amps_Invoice invoice, int operation);
+int amps_AllReduceDoubles (amps_Comm comm, double *data, int len, int operation);
+int amps_IAllReduceDoubles (amps_Comm comm, double *data, int len, int operation, amps_ReduceRequest *request);
+int amps_WaitReduce (amps_ReduceRequest *request);
 
 /* amps_bcast.c */
 int amps_BCast (amps_Comm comm, int source, amps_Invoice invoice);
@@ -0,0 +1,566 @@
+/*BHEADER*********************************************************************
+ *
+ *  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+ *  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+ *  by the Parflow Team (see the CONTRIBUTORS file)
+ *  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+ *
+ *  This file is part of Parflow. For details, see
+ *  http://www.llnl.gov/casc/parflow
+ *
+ *  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+ *  for the GNU Lesser General Public License.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License (as published
+ *  by the Free Software Foundation) version 2.1 dated February 1999.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+ *  and conditions of the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ *  USA
+ **********************************************************************EHEADER*/
+/*****************************************************************************
+*
+* pfkernelbench: microbenchmarks of the core Richards solver kernels.
+*
+* The problem of a Richards run (<name>.pfidb) is set up as for a
+* simulation, then each kernel is called on the initial state
+*
+*   KernelBenchmark.Samples x KernelBenchmark.Repetitions
+*
+* times.  The time per call is the best sample (slowest rank).  Cells/s and
+* GB/s are reported against the memory bandwidth of a STREAM triad run by
+* every rank, the roofline of these bandwidth bound kernels.  The bytes
+* per cell are the compulsory traffic of each kernel, every array streamed
+* once, so the GB/s are a lower bound.
+*
+* The loop backend is fixed at compile time; run the pfkernelbench of each
+* build (PARFLOW_ACCELERATOR_BACKEND) to compare backends.  Results are
+* printed and written to <name>.out.kernels.json.
+*
+*****************************************************************************/
+#include "parflow.h"
+#include "pfversion.h"
+#include "amps.h"
+
+#if defined(PARFLOW_HAVE_CUDA) || defined(PARFLOW_HAVE_KOKKOS)
+#include "pf_devices.h"
+#endif
+
+#ifdef PARFLOW_HAVE_OMP
+#include <omp.h>
+#endif
+
+#include <string.h>
+
+#if defined(PARFLOW_HAVE_KOKKOS)
+#define KERNEL_BENCH_BACKEND "kokkos"
+#elif defined(PARFLOW_HAVE_CUDA)
+#define KERNEL_BENCH_BACKEND "cuda"
+#elif defined(PARFLOW_HAVE_OMP)
+#define KERNEL_BENCH_BACKEND "omp"
+#elif defined(PARFLOW_HAVE_SIMD)
+#define KERNEL_BENCH_BACKEND "simd"
+#else
+#define KERNEL_BENCH_BACKEND "none"
+#endif
+
+typedef struct {
+  ProblemData *problem_data;
+  double gravity;
+  double dt;
+  double time;
+
+  PFModule    *nl_function_eval;
+  PFModule    *jacobian_eval;
+  PFModule    *saturation;
+  PFModule    *rel_perm;
+
+  Vector      *pressure;
+  Vector      *old_pressure;
+  Vector      *saturation_v;
+  Vector      *old_saturation;
+  Vector      *density;
+  Vector      *old_density;
+  Vector      *evap_trans;
+  Vector      *ovrl_bc_flx;
+  Vector      *x_velocity;
+  Vector      *y_velocity;
+  Vector      *z_velocity;
+
+  Vector      *fval;
+  Vector      *work;
+  Matrix      *J;
+  Matrix      *JC;
+
+  double sink;            /* keeps reductions from being optimized away */
+} KernelState;
+
+typedef void (*KernelFunction)(KernelState *state);
+
+typedef struct {
+  const char     *name;
+  KernelFunction function;
+  double bytes_per_cell;  /* compulsory traffic, 0 if not bandwidth bound */
+} Kernel;
+
+
+static void KernelNlFunctionEval(KernelState *s)
+{
+  PFModuleInvokeType(NlFunctionEvalInvoke, s->nl_function_eval,
+                     (s->pressure, s->fval, s->problem_data,
+                      s->saturation_v, s->old_saturation,
+                      s->density, s->old_density, s->dt, s->time,
+                      s->old_pressure, s->evap_trans, s->ovrl_bc_flx,
+                      s->x_velocity, s->y_velocity, s->z_velocity));
+}
+
+static void KernelJacobianEval(KernelState *s)
+{
+  PFModuleInvokeType(RichardsJacobianEvalInvoke, s->jacobian_eval,
+                     (s->pressure, s->old_pressure, &(s->J), &(s->JC),
+                      s->saturation_v, s->density, s->problem_data,
+                      s->dt, s->time, 0));
+}
+
+static void KernelMatvec(KernelState *s)
+{
+  Matvec(1.0, s->J, s->pressure, 0.0, s->fval);
+}
+
+static void KernelSaturation(KernelState *s)
+{
+  PFModuleInvokeType(SaturationInvoke, s->saturation,
+                     (s->work, s->pressure, s->density, s->gravity,
+                      s->problem_data, CALCFCN));
+}
+
+static void KernelRelPerm(KernelState *s)
+{
+  PFModuleInvokeType(PhaseRelPermInvoke, s->rel_perm,
+                     (s->work, s->pressure, s->density, s->gravity,
+                      s->problem_data, CALCFCN));
+}
+
+static void KernelHalo(KernelState *s)
+{
+  VectorUpdateCommHandle *handle;
+
+  handle = InitVectorUpdate(s->pressure, VectorUpdateAll);
+  FinalizeVectorUpdate(handle);
+}
+
+static void KernelLinearSum(KernelState *s)
+{
+  PFVLinearSum(1.0, s->pressure, 0.5, s->old_pressure, s->work);
+}
+
+static void KernelInnerProd(KernelState *s)
+{
+  s->sink += InnerProd(s->pressure, s->old_pressure);
+}
+
+/*
+ * Bytes per cell: the Jacobian and function evaluation read pressure,
+ * saturation and density (new and old), porosity, specific storage, three
+ * permeabilities, the evaporation/transpiration sink and the dz multiplier
+ * and write the 7 matrix coefficients or the residual and three face
+ * velocities.  The halo update is latency bound; its GB/s are the ghost
+ * layer bytes per second.
+ */
+static Kernel kernels[] = {
+  { "nl_function_eval", KernelNlFunctionEval, 8.0 * (14 + 4) },
+  { "jacobian_eval", KernelJacobianEval, 8.0 * (14 + 7) },
+  { "matvec", KernelMatvec, 8.0 * (7 + 1 + 1) },
+  { "saturation", KernelSaturation, 8.0 * 3 },
+  { "rel_perm", KernelRelPerm, 8.0 * 3 },
+  { "halo", KernelHalo, 0.0 },
+  { "linear_sum", KernelLinearSum, 8.0 * 3 },
+  { "inner_prod", KernelInnerProd, 8.0 * 2 },
+};
+
+#define NumKernels ((int)(sizeof(kernels) / sizeof(kernels[0])))
+
+
+/*--------------------------------------------------------------------------
+ * TimeCalls:
+ *   Seconds per call of the best sample on the slowest rank.
+ *--------------------------------------------------------------------------*/
+
+static double TimeCalls(KernelFunction function, KernelState *state,
+                        int samples, int repetitions)
+{
+  amps_Clock_t clock;
+  double best = -1.0;
+  double seconds;
+  int sample, i;
+
+  /* Untimed call to fault in the data and set up communication */
+  function(state);
+
+  for (sample = 0; sample < samples; sample++)
+  {
+    amps_Sync(amps_CommWorld);
+
+    clock = amps_Clock();
+    for (i = 0; i < repetitions; i++)
+      function(state);
+    clock = amps_Clock() - clock;
+
+    seconds = (double)clock / AMPS_TICKS_PER_SEC;
+    amps_AllReduceDoubles(amps_CommWorld, &seconds, 1, amps_Max);
+
+    if (best < 0.0 || seconds < best)
+      best = seconds;
+  }
+
+  /* A sample shorter than the clock resolution counts as one tick */
+  if (best <= 0.0)
+    best = 1.0 / AMPS_TICKS_PER_SEC;
+
+  return best / repetitions;
+}
+
+
+/*--------------------------------------------------------------------------
+ * StreamTriad:
+ *   Memory bandwidth in bytes/s of a = b + s * c over all ranks, with
+ *   arrays of length n on each rank.
+ *--------------------------------------------------------------------------*/
+
+static double      *triad_a, *triad_b, *triad_c;
+static int triad_n;
+
+static void KernelTriad(KernelState *s)
+{
+  double *a = triad_a;
+  double *b = triad_b;
+  double *c = triad_c;
+  int n = triad_n;
+  int i;
+
+  (void)s;
+
+#ifdef PARFLOW_HAVE_OMP
+  #pragma omp parallel for
+#endif
+  for (i = 0; i < n; i++)
+    a[i] = b[i] + 3.0 * c[i];
+}
+
+static double StreamTriad(int n, int samples, int repetitions)
+{
+  double bytes;
+  double seconds;
+  int i;
+
+  triad_n = n;
+  triad_a = talloc(double, n);
+  triad_b = talloc(double, n);
+  triad_c = talloc(double, n);
+
+  /* First touch by the threads that use the data */
+#ifdef PARFLOW_HAVE_OMP
+  #pragma omp parallel for
+#endif
+  for (i = 0; i < n; i++)
+  {
+    triad_a[i] = 0.0;
+    triad_b[i] = 1.0;
+    triad_c[i] = 2.0;
+  }
+
+  seconds = TimeCalls(KernelTriad, NULL, samples, repetitions);
+
+  tfree(triad_a);
+  tfree(triad_b);
+  tfree(triad_c);
+
+  bytes = 3.0 * sizeof(double) * n * amps_Size(amps_CommWorld);
+  return bytes / seconds;
+}
+
+
+/*--------------------------------------------------------------------------
+ * GhostBytes:
+ *   Bytes of the ghost layers of a vector over all ranks, the data a halo
+ *   update exchanges at most.
+ *--------------------------------------------------------------------------*/
+
+static double GhostBytes(Vector *vector)
+{
+  Grid *grid = VectorGrid(vector);
+  Subgrid *subgrid;
+  double bytes = 0.0;
+  int i;
+
+  ForSubgridI(i, GridSubgrids(grid))
+  {
+    subgrid = GridSubgrid(grid, i);
+    bytes += SubvectorDataSize(VectorSubvector(vector, i))
+             - (double)SubgridNX(subgrid) * SubgridNY(subgrid)
+             * SubgridNZ(subgrid);
+  }
+  bytes *= sizeof(double);
+
+  amps_AllReduceDoubles(amps_CommWorld, &bytes, 1, amps_Add);
+  return bytes;
+}
+
+
+int main(int argc, char *argv [])
+{
+  PFModule    *solver_module;
+  PFModule    *solver;
+  PFModule    *nl_function_eval_module;
+  PFModule    *jacobian_eval_module;
+  Problem     *problem;
+  Grid        *grid;
+  KernelState state;
+
+  NameArray switch_na;
+  char        *switch_name;
+
+  double seconds[NumKernels];
+  double cells, ghost_bytes, bandwidth;
+  int samples, repetitions, stream_length, threads;
+  int k;
+
+  if (amps_Init(&argc, &argv))
+  {
+    amps_Printf("Error: amps_Init initalization failed\n");
+    exit(1);
+  }
+
+  amps_SetConsole(stdout);
+
+#if defined(PARFLOW_HAVE_KOKKOS)
+  kokkosInit();
+#endif
+
+  if (argc != 2)
+  {
+    if (!amps_Rank(amps_CommWorld))
+      fprintf(stderr, "USAGE: %s <input pfidb filename>\n", argv[0]);
+    amps_Finalize();
+    return(-1);
+  }
+
+  NewGlobals(argv[1]);
+  amps_ThreadLocal(input_database) = IDB_NewDB(GlobalsInFileName);
+  NewLogging();
+  NewTiming();
+
+  samples = GetIntDefault("KernelBenchmark.Samples", 5);
+  repetitions = GetIntDefault("KernelBenchmark.Repetitions", 20);
+  stream_length = GetIntDefault("KernelBenchmark.StreamLength", 1 << 22);
+  if (samples < 1 || repetitions < 1 || stream_length < 1)
+  {
+    InputError("Error: KernelBenchmark.Samples, Repetitions and StreamLength must be positive%s%s\n", "", "");
+  }
+
+  /*-----------------------------------------------------------------------
+   * Set up the Richards problem and its initial state as NewSolver does
+   *-----------------------------------------------------------------------*/
+
+  switch_na = NA_NewNameArray("Richards");
+  switch_name = GetStringDefault("Solver", "Impes");
+  NA_NameToIndexExitOnError(switch_na, switch_name, "Solver");
+  NA_FreeNameArray(switch_na);
+
+  GlobalsNumProcsX = GetIntDefault("Process.Topology.P", 1);
+  GlobalsNumProcsY = GetIntDefault("Process.Topology.Q", 1);
+  GlobalsNumProcsZ = GetIntDefault("Process.Topology.R", 1);
+
+  GlobalsNumProcs = amps_Size(amps_CommWorld);
+
+  GlobalsBackground = ReadBackground();
+
+  GlobalsUserGrid = ReadUserGrid();
+
+  SetBackgroundBounds(GlobalsBackground, GlobalsUserGrid);
+
+  GlobalsMaxRefLevel = 0;
+
+  switch_na = NA_NewNameArray("False True");
+  switch_name = GetStringDefault("UseClustering", "True");
+  GlobalsUseClustering = NA_NameToIndexExitOnError(switch_na, switch_name, "UseClustering");
+  switch_name = GetStringDefault("UseVectorRowPadding", "False");
+  GlobalsUseVectorRowPadding = NA_NameToIndexExitOnError(switch_na, switch_name, "UseVectorRowPadding");
+  switch_name = GetStringDefault("UseMappedPFBReader", "False");
+  GlobalsUseMappedPFBReader = NA_NameToIndexExitOnError(switch_na, switch_name, "UseMappedPFBReader");
+  NA_FreeNameArray(switch_na);
+
+  solver_module = PFModuleNewModuleType(SolverNewPublicXtraInvoke,
+                                        SolverRichards, ("Solver"));
+  solver = PFModuleNewInstance(solver_module, ());
+  SetupRichards(solver);
+
+  problem = GetProblemRichards(solver);
+
+  state.problem_data = GetProblemDataRichards(solver);
+  state.gravity = ProblemGravity(problem);
+  state.dt = 1.0;
+  state.time = ProblemStartTime(problem);
+  state.sink = 0.0;
+
+  GetStateRichards(solver, &state.pressure, &state.old_pressure,
+                   &state.saturation_v, &state.old_saturation,
+                   &state.density, &state.old_density,
+                   &state.evap_trans, &state.ovrl_bc_flx,
+                   &state.x_velocity, &state.y_velocity, &state.z_velocity);
+
+  /* The state of the first nonlinear iteration of the first step */
+  PFVCopy(state.pressure, state.old_pressure);
+  PFVCopy(state.saturation_v, state.old_saturation);
+  PFVCopy(state.density, state.old_density);
+
+  grid = VectorGrid(state.pressure);
+  state.fval = NewVectorType(grid, 1, 1, vector_cell_centered);
+  state.work = NewVectorType(grid, 1, 1, vector_cell_centered);
+  InitVectorAll(state.fval, 0.0);
+  InitVectorAll(state.work, 0.0);
+
+  nl_function_eval_module = PFModuleNewModule(NlFunctionEval, ());
+  jacobian_eval_module =
+    PFModuleNewModuleType(RichardsJacobianEvalNewPublicXtraInvoke,
+                          RichardsJacobianEval, ("Solver.Nonlinear.Jacobian"));
+
+  state.nl_function_eval =
+    PFModuleNewInstanceType(NlFunctionEvalInitInstanceXtraInvoke,
+                            nl_function_eval_module, (problem, grid, NULL));
+  state.jacobian_eval =
+    PFModuleNewInstanceType(RichardsJacobianEvalInitInstanceXtraInvoke,
+                            jacobian_eval_module,
+                            (problem, grid, state.problem_data, NULL, 0));
+  state.saturation =
+    PFModuleNewInstanceType(SaturationInitInstanceXtraInvoke,
+                            ProblemSaturation(problem), (NULL, NULL));
+  state.rel_perm =
+    PFModuleNewInstanceType(PhaseRelPermInitInstanceXtraInvoke,
+                            ProblemPhaseRelPerm(problem), (NULL, NULL));
+
+  state.J = NULL;
+  state.JC = NULL;
+  KernelJacobianEval(&state);
+
+  /*-----------------------------------------------------------------------
+   * Run the kernels
+   *-----------------------------------------------------------------------*/
+
+  for (k = 0; k < NumKernels; k++)
+    seconds[k] = TimeCalls(kernels[k].function, &state, samples, repetitions);
+
+  bandwidth = StreamTriad(stream_length, samples, repetitions);
+
+  cells = (double)GridSize(grid);
+  ghost_bytes = GhostBytes(state.pressure);
+
+#ifdef PARFLOW_HAVE_OMP
+  threads = omp_get_max_threads();
+#else
+  threads = 1;
+#endif
+
+  /*-----------------------------------------------------------------------
+   * Report
+   *-----------------------------------------------------------------------*/
+
+  if (!amps_Rank(amps_CommWorld))
+  {
+    char filename[2048];
+    FILE *file;
+
+    amps_Printf("Kernel benchmark: %s, %.0f cells, %d ranks, backend %s, %d threads\n",
+                GlobalsInFileName, cells, amps_Size(amps_CommWorld),
+                KERNEL_BENCH_BACKEND, threads);
+    amps_Printf("STREAM triad: %.2f GB/s\n\n", bandwidth * 1e-9);
+    amps_Printf("%-18s %12s %12s %10s %10s %12s\n", "kernel", "ms/call",
+                "Mcells/s", "GB/s", "roofline", "bound Mc/s");
+
+    sprintf(filename, "%s.kernels.json", GlobalsOutFileName);
+    if ((file = fopen(filename, "w")) == NULL)
+    {
+      InputError("Error: can't open output file %s%s\n", filename, "");
+    }
+
+    fprintf(file, "{\"format\":1,\"version\":\"%s\",\"backend\":\"%s\",\"ranks\":%d,"
+            "\"threads\":%d,\"cells\":%.0f,\"samples\":%d,\"repetitions\":%d,"
+            "\"stream_triad_bandwidth\":%.6e,\"kernels\":{",
+            PARFLOW_VERSION_STRING, KERNEL_BENCH_BACKEND,
+            amps_Size(amps_CommWorld), threads, cells, samples, repetitions,
+            bandwidth);
+
+    for (k = 0; k < NumKernels; k++)
+    {
+      double bytes = (kernels[k].bytes_per_cell > 0.0) ?
+                     kernels[k].bytes_per_cell * cells : ghost_bytes;
+      double cells_per_second = cells / seconds[k];
+      double bytes_per_second = bytes / seconds[k];
+
+      if (kernels[k].bytes_per_cell > 0.0)
+      {
+        double bound = bandwidth / kernels[k].bytes_per_cell;
+
+        amps_Printf("%-18s %12.4f %12.2f %10.2f %9.1f%% %12.2f\n",
+                    kernels[k].name, 1e3 * seconds[k],
+                    1e-6 * cells_per_second, 1e-9 * bytes_per_second,
+                    100.0 * bytes_per_second / bandwidth, 1e-6 * bound);
+      }
+      else
+      {
+        amps_Printf("%-18s %12.4f %12s %10.2f %10s %12s\n",
+                    kernels[k].name, 1e3 * seconds[k], "-",
+                    1e-9 * bytes_per_second, "-", "-");
+      }
+
+      fprintf(file, "%s\"%s\":{\"seconds\":%.6e,\"cells_per_second\":%.6e,"
+              "\"bytes_per_second\":%.6e,\"bytes_per_cell\":%g}",
+              k ? "," : "", kernels[k].name, seconds[k], cells_per_second,
+              bytes_per_second, kernels[k].bytes_per_cell);
+    }
+
+    fprintf(file, "}}\n");
+    fclose(file);
+  }
+
+  /*-----------------------------------------------------------------------
+   * Clean up
+   *-----------------------------------------------------------------------*/
+
+  PFModuleFreeInstance(state.rel_perm);
+  PFModuleFreeInstance(state.saturation);
+  PFModuleFreeInstance(state.jacobian_eval);
+  PFModuleFreeModule(jacobian_eval_module);
+  PFModuleFreeInstance(state.nl_function_eval);
+  PFModuleFreeModule(nl_function_eval_module);
+  FreeVector(state.work);
+  FreeVector(state.fval);
+
+  TeardownRichards(solver);
+  PFModuleFreeInstance(solver);
+  PFModuleFreeModule(solver_module);
+
+  FreeUserGrid(GlobalsUserGrid);
+  FreeBackground(GlobalsBackground);
+
+  FreeLogging();
+  FreeTiming();
+
+  IDB_FreeDB(amps_ThreadLocal(input_database));
+  FreeGlobals();
+
+  amps_Finalize();
+
+#ifdef PARFLOW_HAVE_KOKKOS
+  kokkosFinalize();
+#endif
+
+  return 0;
+}
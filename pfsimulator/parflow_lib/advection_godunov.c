@@ -36,6 +36,8 @@
 
 #include "parflow.h"
 
+#include <string.h>
+
 /*--------------------------------------------------------------------------
  * Structures
  *--------------------------------------------------------------------------*/
@@ -55,6 +57,14 @@ typedef struct {
   int max_ny;
   int max_nz;
 
+  /* number of contaminants with their own slz and sbot scratch planes */
+  int num_fields;
+
+  /* halo update of the old concentrations of the last call */
+  int num_comm_vectors;
+  Vector **comm_vectors;
+  CommPkg *comm_pkg;
+
   double *slx;
   double *sly;
   double *slz;
@@ -75,18 +85,23 @@ typedef struct {
 
 /*--------------------------------------------------------------------------
  * Godunov
+ *
+ * Advects contaminants 0 to num_concentrations - 1 of `phase' together:
+ * the ghost layers of all old concentrations are updated with one
+ * message per neighbor, and the advection sweeps the k planes of the
+ * velocity field once, advancing every contaminant in each plane.
  *--------------------------------------------------------------------------*/
 
 void     Godunov(
                  ProblemData *problem_data,
                  int          phase,
-                 int          concentration,
-                 Vector *     old_concentration,
-                 Vector *     new_concentration,
+                 int          num_concentrations,
+                 Vector **    old_concentrations,
+                 Vector **    new_concentrations,
                  Vector *     x_velocity,
                  Vector *     y_velocity,
                  Vector *     z_velocity,
-                 Vector *     solid_mass_factor,
+                 Vector **    solid_mass_factors,
                  double       time,
                  double       deltat,
                  int          order)
@@ -101,6 +116,9 @@ void     Godunov(
   Vector     *scale = NULL;
   Vector     *right_hand_side = NULL;
 
+  Vector     *new_concentration;
+  Vector     *solid_mass_factor;
+
   double     *slx = (instance_xtra->slx);
   double     *sly = (instance_xtra->sly);
   double     *slz = (instance_xtra->slz);
@@ -162,6 +180,8 @@ void     Godunov(
     nx_yv, ny_yv, nz_yv,
     nx_zv, ny_zv, nz_zv;
   int i, j, k, ci, pi, wi, xi, yi, zi;
+  int concentration, km, kc, kp, kt;
+  int slz_size, sbot_size;
   int nx_cells, ny_cells, nz_cells, index, flopest;
   double lambda, decay_factor;
 
@@ -237,14 +257,43 @@ void     Godunov(
      +
      (nz_cells * ny_cells * nx_cells + 3));
 
-  compute_pkg = GridComputePkg(VectorGrid(old_concentration), VectorUpdateGodunov);
+  flopest *= num_concentrations;
+
+  slz_size = (instance_xtra->max_nx + 2 + 2) * (instance_xtra->max_ny + 2 + 2) * 3;
+  sbot_size = (instance_xtra->max_nx + 3 + 3) * (instance_xtra->max_ny + 3 + 3);
+
+  if (num_concentrations > (instance_xtra->num_fields))
+  {
+    PARFLOW_ERROR("Godunov: more concentrations than contaminants");
+  }
+
+  compute_pkg = GridComputePkg(VectorGrid(old_concentrations[0]), VectorUpdateGodunov);
+
+  /* the halo update of the last call is reused for the same vectors */
+  if ((instance_xtra->comm_pkg) == NULL
+      || (instance_xtra->num_comm_vectors) != num_concentrations
+      || memcmp((instance_xtra->comm_vectors), old_concentrations,
+                num_concentrations * sizeof(Vector *)))
+  {
+    FreeCommPkg(instance_xtra->comm_pkg);
+    tfree(instance_xtra->comm_vectors);
+
+    (instance_xtra->comm_pkg) =
+      NewVectorGroupCommPkg(old_concentrations, num_concentrations, compute_pkg);
+    (instance_xtra->num_comm_vectors) = num_concentrations;
+    (instance_xtra->comm_vectors) = talloc(Vector *, num_concentrations);
+    memcpy((instance_xtra->comm_vectors), old_concentrations,
+           num_concentrations * sizeof(Vector *));
+  }
 
   for (compute_i = 0; compute_i < 2; compute_i++)
   {
     switch (compute_i)
     {
       case 0:
-        handle = InitVectorUpdate(old_concentration, VectorUpdateGodunov);
+        handle = InitVectorGroupUpdate(old_concentrations, num_concentrations,
+                                       VectorUpdateGodunov,
+                                       (instance_xtra->comm_pkg));
         compute_reg = ComputePkgIndRegion(compute_pkg);
         break;
 
@@ -260,15 +309,10 @@ void     Godunov(
       subgrid = SubgridArraySubgrid(subgrids, sr);
 
       /**** Get locations for subvector data of vectors passed in ****/
-      c = SubvectorData(VectorSubvector(old_concentration, sr));
-      cn = SubvectorData(VectorSubvector(new_concentration, sr));
-
       uedge = SubvectorData(VectorSubvector(x_velocity, sr));
       vedge = SubvectorData(VectorSubvector(y_velocity, sr));
       wedge = SubvectorData(VectorSubvector(z_velocity, sr));
 
-      phi = SubvectorData(VectorSubvector(solid_mass_factor, sr));
-
       /***** Compute extents of data *****/
       dlo[0] = SubgridIX(subgrid);
       dlo[1] = SubgridIY(subgrid);
@@ -296,13 +340,34 @@ void     Godunov(
         hi[1] = SubregionIY(subregion) + (SubregionNY(subregion) - 1);
         hi[2] = SubregionIZ(subregion) + (SubregionNZ(subregion) - 1);
 
-        /***** Make the call to the Godunov advection routine *****/
-        CALL_ADVECT(c, cn,
-                    uedge, vedge, wedge, phi,
-                    slx, sly, slz,
-                    lo, hi, dlo, dhi, hx, dt, fstord,
-                    sbot, stop, sbotp, sfrt, sbck, sleft, sright, sfluxz,
-                    dxscr, dyscr, dzscr, dzfrm);
+        /***** Advance every contaminant in a k plane before the next *****/
+        km = 3;
+        kc = 1;
+        kp = 2;
+
+        for (k = lo[2] - 1; k <= hi[2] + 1; k++)
+        {
+          for (concentration = 0; concentration < num_concentrations;
+               concentration++)
+          {
+            c = SubvectorData(VectorSubvector(old_concentrations[concentration], sr));
+            cn = SubvectorData(VectorSubvector(new_concentrations[concentration], sr));
+            phi = SubvectorData(VectorSubvector(solid_mass_factors[concentration], sr));
+
+            CALL_ADVECTPLANE(c, cn,
+                             uedge, vedge, wedge, phi,
+                             slx, sly, slz + concentration * slz_size,
+                             lo, hi, dlo, dhi, hx, dt, fstord, k, km, kc, kp,
+                             sbot + concentration * sbot_size, stop, sbotp,
+                             sfrt, sbck, sleft, sright, sfluxz,
+                             dxscr, dyscr, dzscr, dzfrm);
+          }
+
+          kt = km;
+          km = kc;
+          kc = kp;
+          kp = kt;
+        }
       }
     }
   }
@@ -311,158 +376,191 @@ void     Godunov(
 
 
   /*-----------------------------------------------------------------------
-   * Adjust for degradation
+   * Degradation and well terms of each contaminant
    *-----------------------------------------------------------------------*/
 
-  lambda = ProblemContaminantDegradation(problem, concentration);
-  decay_factor = exp(-1.0 * lambda * dt);
-
-  if (lambda != 0.0)
+  for (concentration = 0; concentration < num_concentrations; concentration++)
   {
-    flopest = 3 * nx_cells * ny_cells * nz_cells;
+    new_concentration = new_concentrations[concentration];
+    solid_mass_factor = solid_mass_factors[concentration];
 
-    ForSubgridI(sg, subgrids)
+    /*-----------------------------------------------------------------------
+     * Adjust for degradation
+     *-----------------------------------------------------------------------*/
+
+    lambda = ProblemContaminantDegradation(problem, concentration);
+    decay_factor = exp(-1.0 * lambda * dt);
+
+    if (lambda != 0.0)
     {
-      subgrid = SubgridArraySubgrid(subgrids, sg);
+      flopest = 3 * nx_cells * ny_cells * nz_cells;
 
-      subvector = VectorSubvector(new_concentration, sg);
+      ForSubgridI(sg, subgrids)
+      {
+        subgrid = SubgridArraySubgrid(subgrids, sg);
 
-      ix = SubgridIX(subgrid);
-      iy = SubgridIY(subgrid);
-      iz = SubgridIZ(subgrid);
+        subvector = VectorSubvector(new_concentration, sg);
 
-      nx = SubgridNX(subgrid);
-      ny = SubgridNY(subgrid);
-      nz = SubgridNZ(subgrid);
+        ix = SubgridIX(subgrid);
+        iy = SubgridIY(subgrid);
+        iz = SubgridIZ(subgrid);
 
-      dx = SubgridDX(subgrid);
-      dy = SubgridDY(subgrid);
-      dz = SubgridDZ(subgrid);
+        nx = SubgridNX(subgrid);
+        ny = SubgridNY(subgrid);
+        nz = SubgridNZ(subgrid);
 
-      nx_c = SubvectorNX(subvector);
-      ny_c = SubvectorNY(subvector);
-      nz_c = SubvectorNZ(subvector);
+        dx = SubgridDX(subgrid);
+        dy = SubgridDY(subgrid);
+        dz = SubgridDZ(subgrid);
 
-      cell_volume = dx * dy * dz;
+        nx_c = SubvectorNX(subvector);
+        ny_c = SubvectorNY(subvector);
+        nz_c = SubvectorNZ(subvector);
 
-      cn = SubvectorElt(subvector, ix, iy, iz);
+        cell_volume = dx * dy * dz;
 
-      ci = 0;
-      BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
-                ci, nx_c, ny_c, nz_c, 1, 1, 1,
-      {
-        cn[ci] = cn[ci] * decay_factor;
+        cn = SubvectorElt(subvector, ix, iy, iz);
 
-        cell_change = cn[ci] * ((decay_factor - 1.0) / decay_factor);
-      });
-    }
+        ci = 0;
+        BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
+                  ci, nx_c, ny_c, nz_c, 1, 1, 1,
+        {
+          cn[ci] = cn[ci] * decay_factor;
 
-    IncFLOPCount(flopest);
-  }
+          cell_change = cn[ci] * ((decay_factor - 1.0) / decay_factor);
+        });
+      }
 
+      IncFLOPCount(flopest);
+    }
 
-  /*-----------------------------------------------------------------------
-   * Set up well terms, right hand side and scaling term
-   *-----------------------------------------------------------------------*/
 
-  index = phase * WellDataNumContaminants(well_data) + concentration;
+    /*-----------------------------------------------------------------------
+     * Set up well terms, right hand side and scaling term
+     *-----------------------------------------------------------------------*/
 
-  InitVectorAll(scale, 0.0);
-  InitVectorAll(right_hand_side, 0.0);
+    index = phase * WellDataNumContaminants(well_data) + concentration;
 
-  if (WellDataNumWells(well_data) > 0)
-  {
-    time_cycle_data = WellDataTimeCycleData(well_data);
-    for (well = 0; well < WellDataNumPressWells(well_data); well++)
+    InitVectorAll(scale, 0.0);
+    InitVectorAll(right_hand_side, 0.0);
+
+    if (WellDataNumWells(well_data) > 0)
     {
-      well_data_physical = WellDataPressWellPhysical(well_data, well);
-      cycle_number = WellDataPhysicalCycleNumber(well_data_physical);
-      interval_number = TimeCycleDataComputeIntervalNumber(problem, time, time_cycle_data, cycle_number);
-      well_data_value = WellDataPressWellIntervalValue(well_data, well, interval_number);
-      well_data_stat = WellDataPressWellStat(well_data, well);
+      time_cycle_data = WellDataTimeCycleData(well_data);
+      for (well = 0; well < WellDataNumPressWells(well_data); well++)
+      {
+        well_data_physical = WellDataPressWellPhysical(well_data, well);
+        cycle_number = WellDataPhysicalCycleNumber(well_data_physical);
+        interval_number = TimeCycleDataComputeIntervalNumber(problem, time, time_cycle_data, cycle_number);
+        well_data_value = WellDataPressWellIntervalValue(well_data, well, interval_number);
+        well_data_stat = WellDataPressWellStat(well_data, well);
 
-      well_subgrid = WellDataPhysicalSubgrid(well_data_physical);
+        well_subgrid = WellDataPhysicalSubgrid(well_data_physical);
 
-      volume = WellDataPhysicalSize(well_data_physical);
+        volume = WellDataPhysicalSize(well_data_physical);
 
-      total_volume = 0.0;
+        total_volume = 0.0;
 
-      ForSubgridI(sg, subgrids)
-      {
-        subgrid = SubgridArraySubgrid(subgrids, sg);
+        ForSubgridI(sg, subgrids)
+        {
+          subgrid = SubgridArraySubgrid(subgrids, sg);
 
-        subvector_scal = VectorSubvector(scale, sg);
-        subvector_rhs = VectorSubvector(right_hand_side, sg);
-        subvector_smf = VectorSubvector(solid_mass_factor, sg);
-        subvector_xvel = VectorSubvector(x_velocity, sg);
-        subvector_yvel = VectorSubvector(y_velocity, sg);
-        subvector_zvel = VectorSubvector(z_velocity, sg);
+          subvector_scal = VectorSubvector(scale, sg);
+          subvector_rhs = VectorSubvector(right_hand_side, sg);
+          subvector_smf = VectorSubvector(solid_mass_factor, sg);
+          subvector_xvel = VectorSubvector(x_velocity, sg);
+          subvector_yvel = VectorSubvector(y_velocity, sg);
+          subvector_zvel = VectorSubvector(z_velocity, sg);
 
-        nx_w = SubvectorNX(subvector_scal);      /*scal,rhs & smf share nx_w */
-        ny_w = SubvectorNY(subvector_scal);      /*scal,rhs & smf share ny_w */
-        nz_w = SubvectorNZ(subvector_scal);      /*scal,rhs & smf share nz_w */
+          nx_w = SubvectorNX(subvector_scal);      /*scal,rhs & smf share nx_w */
+          ny_w = SubvectorNY(subvector_scal);      /*scal,rhs & smf share ny_w */
+          nz_w = SubvectorNZ(subvector_scal);      /*scal,rhs & smf share nz_w */
 
-        nx_xv = SubvectorNX(subvector_xvel);
-        ny_xv = SubvectorNY(subvector_xvel);
-        nz_xv = SubvectorNZ(subvector_xvel);
+          nx_xv = SubvectorNX(subvector_xvel);
+          ny_xv = SubvectorNY(subvector_xvel);
+          nz_xv = SubvectorNZ(subvector_xvel);
 
-        nx_yv = SubvectorNX(subvector_yvel);
-        ny_yv = SubvectorNY(subvector_yvel);
-        nz_yv = SubvectorNZ(subvector_yvel);
+          nx_yv = SubvectorNX(subvector_yvel);
+          ny_yv = SubvectorNY(subvector_yvel);
+          nz_yv = SubvectorNZ(subvector_yvel);
 
-        nx_zv = SubvectorNX(subvector_zvel);
-        ny_zv = SubvectorNY(subvector_zvel);
-        nz_zv = SubvectorNZ(subvector_zvel);
+          nx_zv = SubvectorNX(subvector_zvel);
+          ny_zv = SubvectorNY(subvector_zvel);
+          nz_zv = SubvectorNZ(subvector_zvel);
 
-        /*  Get the intersection of the well with the subgrid  */
-        if ((tmp_subgrid = IntersectSubgrids(subgrid, well_subgrid)))
-        {
-          ix = SubgridIX(tmp_subgrid);
-          iy = SubgridIY(tmp_subgrid);
-          iz = SubgridIZ(tmp_subgrid);
+          /*  Get the intersection of the well with the subgrid  */
+          if ((tmp_subgrid = IntersectSubgrids(subgrid, well_subgrid)))
+          {
+            ix = SubgridIX(tmp_subgrid);
+            iy = SubgridIY(tmp_subgrid);
+            iz = SubgridIZ(tmp_subgrid);
 
-          dx = SubgridDX(tmp_subgrid);
-          dy = SubgridDY(tmp_subgrid);
-          dz = SubgridDZ(tmp_subgrid);
+            dx = SubgridDX(tmp_subgrid);
+            dy = SubgridDY(tmp_subgrid);
+            dz = SubgridDZ(tmp_subgrid);
 
-          nx = SubgridNX(tmp_subgrid);
-          ny = SubgridNY(tmp_subgrid);
-          nz = SubgridNZ(tmp_subgrid);
+            nx = SubgridNX(tmp_subgrid);
+            ny = SubgridNY(tmp_subgrid);
+            nz = SubgridNZ(tmp_subgrid);
 
-          cell_volume = dx * dy * dz;
+            cell_volume = dx * dy * dz;
 
-          rhs = SubvectorElt(subvector_rhs, ix, iy, iz);
-          scal = SubvectorElt(subvector_scal, ix, iy, iz);
-          smf = SubvectorElt(subvector_smf, ix, iy, iz);
+            rhs = SubvectorElt(subvector_rhs, ix, iy, iz);
+            scal = SubvectorElt(subvector_scal, ix, iy, iz);
+            smf = SubvectorElt(subvector_smf, ix, iy, iz);
 
-          xvel_l = SubvectorElt(subvector_xvel, ix, iy, iz);
-          xvel_u = SubvectorElt(subvector_xvel, ix + 1, iy, iz);
+            xvel_l = SubvectorElt(subvector_xvel, ix, iy, iz);
+            xvel_u = SubvectorElt(subvector_xvel, ix + 1, iy, iz);
 
-          yvel_l = SubvectorElt(subvector_yvel, ix, iy, iz);
-          yvel_u = SubvectorElt(subvector_yvel, ix, iy + 1, iz);
+            yvel_l = SubvectorElt(subvector_yvel, ix, iy, iz);
+            yvel_u = SubvectorElt(subvector_yvel, ix, iy + 1, iz);
 
-          zvel_l = SubvectorElt(subvector_zvel, ix, iy, iz);
-          zvel_u = SubvectorElt(subvector_zvel, ix, iy, iz + 1);
+            zvel_l = SubvectorElt(subvector_zvel, ix, iy, iz);
+            zvel_u = SubvectorElt(subvector_zvel, ix, iy, iz + 1);
 
-          if (WellDataPhysicalAction(well_data_physical)
-              == INJECTION_WELL)
-          {
-            if (WellDataValueDeltaContaminantPtrs(well_data_value))
-            {
-              input_c =
-                WellDataValueContaminantFraction(well_data_value,
-                                                 index)
-                * fabs(WellDataValueDeltaContaminantPtr(well_data_value,
-                                                        index))
-                / volume;
-            }
-            else
+            if (WellDataPhysicalAction(well_data_physical)
+                == INJECTION_WELL)
             {
-              input_c = WellDataValueContaminantValue(well_data_value,
-                                                      index);
-            }
+              if (WellDataValueDeltaContaminantPtrs(well_data_value))
+              {
+                input_c =
+                  WellDataValueContaminantFraction(well_data_value,
+                                                   index)
+                  * fabs(WellDataValueDeltaContaminantPtr(well_data_value,
+                                                          index))
+                  / volume;
+              }
+              else
+              {
+                input_c = WellDataValueContaminantValue(well_data_value,
+                                                        index);
+              }
+
+              if (input_c > 0.0)
+              {
+                xi = 0; yi = 0; zi = 0; wi = 0;
+                BoxLoopI4(i, j, k,
+                          ix, iy, iz, nx, ny, nz,
+                          xi, nx_xv, ny_xv, nz_xv,
+                          yi, nx_yv, ny_yv, nz_yv,
+                          zi, nx_zv, ny_zv, nz_zv,
+                          wi, nx_w, ny_w, nz_w,
+                {
+                  flux = (xvel_u[xi] - xvel_l[xi]) / dx
+                         + (yvel_u[yi] - yvel_l[yi]) / dy
+                         + (zvel_u[zi] - zvel_l[zi]) / dz;
 
-            if (input_c > 0.0)
+                  scaled_flux = flux / smf[wi];
+
+                  scal[wi] = dt * scaled_flux;
+                  rhs[wi] = -dt * scaled_flux * input_c;
+
+                  total_volume += dt * flux * cell_volume;
+                });
+              }
+            }
+            else if (WellDataPhysicalAction(well_data_physical)
+                     == EXTRACTION_WELL)
             {
               xi = 0; yi = 0; zi = 0; wi = 0;
               BoxLoopI4(i, j, k,
@@ -472,6 +570,7 @@ void     Godunov(
                         zi, nx_zv, ny_zv, nz_zv,
                         wi, nx_w, ny_w, nz_w,
               {
+                /*   compute flux for each cell and store it   */
                 flux = (xvel_u[xi] - xvel_l[xi]) / dx
                        + (yvel_u[yi] - yvel_l[yi]) / dy
                        + (zvel_u[zi] - zvel_l[zi]) / dz;
@@ -479,146 +578,161 @@ void     Godunov(
                 scaled_flux = flux / smf[wi];
 
                 scal[wi] = dt * scaled_flux;
-                rhs[wi] = -dt * scaled_flux * input_c;
 
                 total_volume += dt * flux * cell_volume;
               });
             }
+            FreeSubgrid(tmp_subgrid);        /* done with temporary subgrid */
           }
-          else if (WellDataPhysicalAction(well_data_physical)
-                   == EXTRACTION_WELL)
-          {
-            xi = 0; yi = 0; zi = 0; wi = 0;
-            BoxLoopI4(i, j, k,
-                      ix, iy, iz, nx, ny, nz,
-                      xi, nx_xv, ny_xv, nz_xv,
-                      yi, nx_yv, ny_yv, nz_yv,
-                      zi, nx_zv, ny_zv, nz_zv,
-                      wi, nx_w, ny_w, nz_w,
-            {
-              /*   compute flux for each cell and store it   */
-              flux = (xvel_u[xi] - xvel_l[xi]) / dx
-                     + (yvel_u[yi] - yvel_l[yi]) / dy
-                     + (zvel_u[zi] - zvel_l[zi]) / dz;
-
-              scaled_flux = flux / smf[wi];
+        }
 
-              scal[wi] = dt * scaled_flux;
+        if (concentration == 0)
+        {
+          result_invoice = amps_NewInvoice("%d", &total_volume);
+          amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
+          amps_FreeInvoice(result_invoice);
 
-              total_volume += dt * flux * cell_volume;
-            });
-          }
-          FreeSubgrid(tmp_subgrid);        /* done with temporary subgrid */
+          WellDataStatDeltaPhase(well_data_stat, phase) = total_volume;
+          WellDataStatPhaseStat(well_data_stat, phase) += total_volume;
         }
       }
 
-      if (concentration == 0)
+      for (well = 0; well < WellDataNumFluxWells(well_data); well++)
       {
-        result_invoice = amps_NewInvoice("%d", &total_volume);
-        amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
-        amps_FreeInvoice(result_invoice);
+        well_data_physical = WellDataFluxWellPhysical(well_data, well);
+        cycle_number = WellDataPhysicalCycleNumber(well_data_physical);
+        interval_number = TimeCycleDataComputeIntervalNumber(problem, time, time_cycle_data, cycle_number);
+        well_data_value = WellDataFluxWellIntervalValue(well_data, well, interval_number);
+        well_data_stat = WellDataFluxWellStat(well_data, well);
 
-        WellDataStatDeltaPhase(well_data_stat, phase) = total_volume;
-        WellDataStatPhaseStat(well_data_stat, phase) += total_volume;
-      }
-    }
+        well_subgrid = WellDataPhysicalSubgrid(well_data_physical);
 
-    for (well = 0; well < WellDataNumFluxWells(well_data); well++)
-    {
-      well_data_physical = WellDataFluxWellPhysical(well_data, well);
-      cycle_number = WellDataPhysicalCycleNumber(well_data_physical);
-      interval_number = TimeCycleDataComputeIntervalNumber(problem, time, time_cycle_data, cycle_number);
-      well_data_value = WellDataFluxWellIntervalValue(well_data, well, interval_number);
-      well_data_stat = WellDataFluxWellStat(well_data, well);
-
-      well_subgrid = WellDataPhysicalSubgrid(well_data_physical);
-
-      well_value = 0.0;
-      if (WellDataPhysicalAction(well_data_physical) == INJECTION_WELL)
-      {
-        well_value = WellDataValuePhaseValue(well_data_value, phase);
-      }
-      else if (WellDataPhysicalAction(well_data_physical) == EXTRACTION_WELL)
-      {
-        well_value = -WellDataValuePhaseValue(well_data_value, phase);
-      }
+        well_value = 0.0;
+        if (WellDataPhysicalAction(well_data_physical) == INJECTION_WELL)
+        {
+          well_value = WellDataValuePhaseValue(well_data_value, phase);
+        }
+        else if (WellDataPhysicalAction(well_data_physical) == EXTRACTION_WELL)
+        {
+          well_value = -WellDataValuePhaseValue(well_data_value, phase);
+        }
 
-      volume = WellDataPhysicalSize(well_data_physical);
-      flux = well_value / volume;
+        volume = WellDataPhysicalSize(well_data_physical);
+        flux = well_value / volume;
 
-      total_volume = 0.0;
+        total_volume = 0.0;
 
-      avg_x = WellDataPhysicalAveragePermeabilityX(well_data_physical);
-      avg_y = WellDataPhysicalAveragePermeabilityY(well_data_physical);
-      avg_z = WellDataPhysicalAveragePermeabilityZ(well_data_physical);
+        avg_x = WellDataPhysicalAveragePermeabilityX(well_data_physical);
+        avg_y = WellDataPhysicalAveragePermeabilityY(well_data_physical);
+        avg_z = WellDataPhysicalAveragePermeabilityZ(well_data_physical);
 
-      ForSubgridI(sg, subgrids)
-      {
-        subgrid = SubgridArraySubgrid(subgrids, sg);
+        ForSubgridI(sg, subgrids)
+        {
+          subgrid = SubgridArraySubgrid(subgrids, sg);
 
-        subvector_scal = VectorSubvector(scale, sg);
-        subvector_rhs = VectorSubvector(right_hand_side, sg);
-        subvector_smf = VectorSubvector(solid_mass_factor, sg);
+          subvector_scal = VectorSubvector(scale, sg);
+          subvector_rhs = VectorSubvector(right_hand_side, sg);
+          subvector_smf = VectorSubvector(solid_mass_factor, sg);
 
-        px_sub = VectorSubvector(perm_x, sg);
-        py_sub = VectorSubvector(perm_y, sg);
-        pz_sub = VectorSubvector(perm_z, sg);
+          px_sub = VectorSubvector(perm_x, sg);
+          py_sub = VectorSubvector(perm_y, sg);
+          pz_sub = VectorSubvector(perm_z, sg);
 
-        nx_w = SubvectorNX(subvector_scal);      /*scal,rhs & smf share nx_w */
-        ny_w = SubvectorNY(subvector_scal);      /*scal,rhs & smf share ny_w */
-        nz_w = SubvectorNZ(subvector_scal);      /*scal,rhs & smf share nz_w */
+          nx_w = SubvectorNX(subvector_scal);      /*scal,rhs & smf share nx_w */
+          ny_w = SubvectorNY(subvector_scal);      /*scal,rhs & smf share ny_w */
+          nz_w = SubvectorNZ(subvector_scal);      /*scal,rhs & smf share nz_w */
 
-        nx_p = SubvectorNX(px_sub);
-        ny_p = SubvectorNY(px_sub);
-        nz_p = SubvectorNZ(px_sub);
+          nx_p = SubvectorNX(px_sub);
+          ny_p = SubvectorNY(px_sub);
+          nz_p = SubvectorNZ(px_sub);
 
-        /*  Get the intersection of the well with the subgrid  */
-        if ((tmp_subgrid = IntersectSubgrids(subgrid, well_subgrid)))
-        {
-          ix = SubgridIX(tmp_subgrid);
-          iy = SubgridIY(tmp_subgrid);
-          iz = SubgridIZ(tmp_subgrid);
-
-          dx = SubgridDX(tmp_subgrid);
-          dy = SubgridDY(tmp_subgrid);
-          dz = SubgridDZ(tmp_subgrid);
-
-          nx = SubgridNX(tmp_subgrid);
-          ny = SubgridNY(tmp_subgrid);
-          nz = SubgridNZ(tmp_subgrid);
-
-          cell_volume = dx * dy * dz;
-          area_x = dy * dz;
-          area_y = dx * dz;
-          area_z = dx * dy;
-          area_sum = area_x + area_y + area_z;
-
-          rhs = SubvectorElt(subvector_rhs, ix, iy, iz);
-          scal = SubvectorElt(subvector_scal, ix, iy, iz);
-          smf = SubvectorElt(subvector_smf, ix, iy, iz);
-          px = SubvectorElt(px_sub, ix, iy, iz);
-          py = SubvectorElt(py_sub, ix, iy, iz);
-          pz = SubvectorElt(pz_sub, ix, iy, iz);
-
-          if (WellDataPhysicalAction(well_data_physical)
-              == INJECTION_WELL)
+          /*  Get the intersection of the well with the subgrid  */
+          if ((tmp_subgrid = IntersectSubgrids(subgrid, well_subgrid)))
           {
-            if (WellDataValueDeltaContaminantPtrs(well_data_value))
+            ix = SubgridIX(tmp_subgrid);
+            iy = SubgridIY(tmp_subgrid);
+            iz = SubgridIZ(tmp_subgrid);
+
+            dx = SubgridDX(tmp_subgrid);
+            dy = SubgridDY(tmp_subgrid);
+            dz = SubgridDZ(tmp_subgrid);
+
+            nx = SubgridNX(tmp_subgrid);
+            ny = SubgridNY(tmp_subgrid);
+            nz = SubgridNZ(tmp_subgrid);
+
+            cell_volume = dx * dy * dz;
+            area_x = dy * dz;
+            area_y = dx * dz;
+            area_z = dx * dy;
+            area_sum = area_x + area_y + area_z;
+
+            rhs = SubvectorElt(subvector_rhs, ix, iy, iz);
+            scal = SubvectorElt(subvector_scal, ix, iy, iz);
+            smf = SubvectorElt(subvector_smf, ix, iy, iz);
+            px = SubvectorElt(px_sub, ix, iy, iz);
+            py = SubvectorElt(py_sub, ix, iy, iz);
+            pz = SubvectorElt(pz_sub, ix, iy, iz);
+
+            if (WellDataPhysicalAction(well_data_physical)
+                == INJECTION_WELL)
             {
-              input_c =
-                WellDataValueContaminantFraction(well_data_value,
-                                                 index)
-                * fabs(WellDataValueDeltaContaminantPtr(well_data_value,
-                                                        index))
-                / volume;
-            }
-            else
-            {
-              input_c = WellDataValueContaminantValue(well_data_value,
-                                                      index);
-            }
+              if (WellDataValueDeltaContaminantPtrs(well_data_value))
+              {
+                input_c =
+                  WellDataValueContaminantFraction(well_data_value,
+                                                   index)
+                  * fabs(WellDataValueDeltaContaminantPtr(well_data_value,
+                                                          index))
+                  / volume;
+              }
+              else
+              {
+                input_c = WellDataValueContaminantValue(well_data_value,
+                                                        index);
+              }
 
-            if (input_c > 0.0)
+              if (input_c > 0.0)
+              {
+                wi = 0; pi = 0;
+                BoxLoopI2(i, j, k,
+                          ix, iy, iz, nx, ny, nz,
+                          pi, nx_p, ny_p, nz_p, 1, 1, 1,
+                          wi, nx_w, ny_w, nz_w, 1, 1, 1,
+                {
+                  scaled_flux = flux / smf[wi];
+
+                  if (WellDataPhysicalMethod(well_data_physical)
+                      == FLUX_STANDARD)
+                  {
+                    weight = 1.0;
+                  }
+                  else if (WellDataPhysicalMethod(well_data_physical)
+                           == FLUX_WEIGHTED)
+                  {
+                    weight = (px[pi] / avg_x) * (area_x / area_sum)
+                             + (py[pi] / avg_y) * (area_y / area_sum)
+                             + (pz[pi] / avg_z) * (area_z / area_sum);
+                  }
+                  else if (WellDataPhysicalMethod(well_data_physical)
+                           == FLUX_PATTERNED)
+                  {
+                    weight = 0.0;
+                  }
+                  else
+                  {
+                    weight = 0.0;
+                  }
+
+                  scal[wi] += dt * weight * scaled_flux;
+                  rhs[wi] -= dt * weight * scaled_flux * input_c;
+
+                  total_volume += dt * weight * flux * cell_volume;
+                });
+              }
+            }
+            else if (WellDataPhysicalAction(well_data_physical)
+                     == EXTRACTION_WELL)
             {
               wi = 0; pi = 0;
               BoxLoopI2(i, j, k,
@@ -645,313 +759,274 @@ void     Godunov(
                 {
                   weight = 0.0;
                 }
-                else
-                {
-                  weight = 0.0;
-                }
 
-                scal[wi] += dt * weight * scaled_flux;
-                rhs[wi] -= dt * weight * scaled_flux * input_c;
+                scal[wi] -= dt * weight * scaled_flux;
 
                 total_volume += dt * weight * flux * cell_volume;
               });
             }
+            FreeSubgrid(tmp_subgrid);        /* done with temporary subgrid */
           }
-          else if (WellDataPhysicalAction(well_data_physical)
-                   == EXTRACTION_WELL)
-          {
-            wi = 0; pi = 0;
-            BoxLoopI2(i, j, k,
-                      ix, iy, iz, nx, ny, nz,
-                      pi, nx_p, ny_p, nz_p, 1, 1, 1,
-                      wi, nx_w, ny_w, nz_w, 1, 1, 1,
-            {
-              scaled_flux = flux / smf[wi];
-
-              if (WellDataPhysicalMethod(well_data_physical)
-                  == FLUX_STANDARD)
-              {
-                weight = 1.0;
-              }
-              else if (WellDataPhysicalMethod(well_data_physical)
-                       == FLUX_WEIGHTED)
-              {
-                weight = (px[pi] / avg_x) * (area_x / area_sum)
-                         + (py[pi] / avg_y) * (area_y / area_sum)
-                         + (pz[pi] / avg_z) * (area_z / area_sum);
-              }
-              else if (WellDataPhysicalMethod(well_data_physical)
-                       == FLUX_PATTERNED)
-              {
-                weight = 0.0;
-              }
-
-              scal[wi] -= dt * weight * scaled_flux;
-
-              total_volume += dt * weight * flux * cell_volume;
-            });
-          }
-          FreeSubgrid(tmp_subgrid);        /* done with temporary subgrid */
         }
-      }
 
-      if (concentration == 0)
-      {
-        result_invoice = amps_NewInvoice("%d", &total_volume);
-        amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
-        amps_FreeInvoice(result_invoice);
+        if (concentration == 0)
+        {
+          result_invoice = amps_NewInvoice("%d", &total_volume);
+          amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
+          amps_FreeInvoice(result_invoice);
 
-        WellDataStatDeltaPhase(well_data_stat, phase) = total_volume;
-        WellDataStatPhaseStat(well_data_stat, phase) += total_volume;
+          WellDataStatDeltaPhase(well_data_stat, phase) = total_volume;
+          WellDataStatPhaseStat(well_data_stat, phase) += total_volume;
+        }
       }
     }
-  }
 
 
 
-  /*-----------------------------------------------------------------------
-   * Compute contributions due to well terms.
-   *-----------------------------------------------------------------------*/
+    /*-----------------------------------------------------------------------
+     * Compute contributions due to well terms.
+     *-----------------------------------------------------------------------*/
 
-  flopest = 5 * nx_cells * ny_cells * nz_cells;
+    flopest = 5 * nx_cells * ny_cells * nz_cells;
 
-  ForSubgridI(sg, subgrids)
-  {
-    subgrid = SubgridArraySubgrid(subgrids, sg);
+    ForSubgridI(sg, subgrids)
+    {
+      subgrid = SubgridArraySubgrid(subgrids, sg);
 
-    subvector = VectorSubvector(new_concentration, sg);
-    subvector_scal = VectorSubvector(scale, sg);
-    subvector_rhs = VectorSubvector(right_hand_side, sg);
+      subvector = VectorSubvector(new_concentration, sg);
+      subvector_scal = VectorSubvector(scale, sg);
+      subvector_rhs = VectorSubvector(right_hand_side, sg);
 
-    ix = SubgridIX(subgrid);
-    iy = SubgridIY(subgrid);
-    iz = SubgridIZ(subgrid);
+      ix = SubgridIX(subgrid);
+      iy = SubgridIY(subgrid);
+      iz = SubgridIZ(subgrid);
 
-    nx = SubgridNX(subgrid);
-    ny = SubgridNY(subgrid);
-    nz = SubgridNZ(subgrid);
+      nx = SubgridNX(subgrid);
+      ny = SubgridNY(subgrid);
+      nz = SubgridNZ(subgrid);
 
-    dx = SubgridDX(subgrid);
-    dy = SubgridDY(subgrid);
-    dz = SubgridDZ(subgrid);
+      dx = SubgridDX(subgrid);
+      dy = SubgridDY(subgrid);
+      dz = SubgridDZ(subgrid);
 
-    nx_c = SubvectorNX(subvector);
-    ny_c = SubvectorNY(subvector);
-    nz_c = SubvectorNZ(subvector);
+      nx_c = SubvectorNX(subvector);
+      ny_c = SubvectorNY(subvector);
+      nz_c = SubvectorNZ(subvector);
 
-    nx_w = SubvectorNX(subvector_scal);     /* scal & rhs share nx_w */
-    ny_w = SubvectorNY(subvector_scal);     /* scal & rhs share ny_w */
-    nz_w = SubvectorNZ(subvector_scal);     /* scal & rhs share nz_w */
+      nx_w = SubvectorNX(subvector_scal);     /* scal & rhs share nx_w */
+      ny_w = SubvectorNY(subvector_scal);     /* scal & rhs share ny_w */
+      nz_w = SubvectorNZ(subvector_scal);     /* scal & rhs share nz_w */
 
-    cn = SubvectorElt(subvector, ix, iy, iz);
-    rhs = SubvectorElt(subvector_rhs, ix, iy, iz);
-    scal = SubvectorElt(subvector_scal, ix, iy, iz);
+      cn = SubvectorElt(subvector, ix, iy, iz);
+      rhs = SubvectorElt(subvector_rhs, ix, iy, iz);
+      scal = SubvectorElt(subvector_scal, ix, iy, iz);
 
-    ci = 0; wi = 0;
-    BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
-              wi, nx_w, ny_w, nz_w, 1, 1, 1,
-              ci, nx_c, ny_c, nz_c, 1, 1, 1,
-    {
-      cn[ci] = (cn[ci] - rhs[wi]) / (1.0 + scal[wi]);
-    });
-  }
+      ci = 0; wi = 0;
+      BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+                wi, nx_w, ny_w, nz_w, 1, 1, 1,
+                ci, nx_c, ny_c, nz_c, 1, 1, 1,
+      {
+        cn[ci] = (cn[ci] - rhs[wi]) / (1.0 + scal[wi]);
+      });
+    }
 
-  IncFLOPCount(flopest);
+    IncFLOPCount(flopest);
 
 
-  /*-----------------------------------------------------------------------
-   * Compute changes in well stats where needed.
-   *-----------------------------------------------------------------------*/
+    /*-----------------------------------------------------------------------
+     * Compute changes in well stats where needed.
+     *-----------------------------------------------------------------------*/
 
-  if (WellDataNumWells(well_data) > 0)
-  {
-    time_cycle_data = WellDataTimeCycleData(well_data);
-    for (well = 0; well < WellDataNumPressWells(well_data); well++)
+    if (WellDataNumWells(well_data) > 0)
     {
-      well_data_physical = WellDataPressWellPhysical(well_data, well);
-      cycle_number = WellDataPhysicalCycleNumber(well_data_physical);
-      interval_number = TimeCycleDataComputeIntervalNumber(problem, time, time_cycle_data, cycle_number);
-      well_data_value = WellDataPressWellIntervalValue(well_data, well, interval_number);
-      well_data_stat = WellDataPressWellStat(well_data, well);
+      time_cycle_data = WellDataTimeCycleData(well_data);
+      for (well = 0; well < WellDataNumPressWells(well_data); well++)
+      {
+        well_data_physical = WellDataPressWellPhysical(well_data, well);
+        cycle_number = WellDataPhysicalCycleNumber(well_data_physical);
+        interval_number = TimeCycleDataComputeIntervalNumber(problem, time, time_cycle_data, cycle_number);
+        well_data_value = WellDataPressWellIntervalValue(well_data, well, interval_number);
+        well_data_stat = WellDataPressWellStat(well_data, well);
 
-      well_subgrid = WellDataPhysicalSubgrid(well_data_physical);
+        well_subgrid = WellDataPhysicalSubgrid(well_data_physical);
 
-      well_stat = 0.0;
-      ForSubgridI(sg, subgrids)
-      {
-        subgrid = SubgridArraySubgrid(subgrids, sg);
+        well_stat = 0.0;
+        ForSubgridI(sg, subgrids)
+        {
+          subgrid = SubgridArraySubgrid(subgrids, sg);
 
-        subvector = VectorSubvector(new_concentration, sg);
-        subvector_scal = VectorSubvector(scale, sg);
-        subvector_rhs = VectorSubvector(right_hand_side, sg);
+          subvector = VectorSubvector(new_concentration, sg);
+          subvector_scal = VectorSubvector(scale, sg);
+          subvector_rhs = VectorSubvector(right_hand_side, sg);
 
-        nx_c = SubvectorNX(subvector);
-        ny_c = SubvectorNY(subvector);
-        nz_c = SubvectorNZ(subvector);
+          nx_c = SubvectorNX(subvector);
+          ny_c = SubvectorNY(subvector);
+          nz_c = SubvectorNZ(subvector);
 
-        nx_w = SubvectorNX(subvector_scal);         /* scal & rhs share nx_w */
-        ny_w = SubvectorNY(subvector_scal);         /* scal & rhs share ny_w */
-        nz_w = SubvectorNZ(subvector_scal);         /* scal & rhs share nz_w */
+          nx_w = SubvectorNX(subvector_scal);         /* scal & rhs share nx_w */
+          ny_w = SubvectorNY(subvector_scal);         /* scal & rhs share ny_w */
+          nz_w = SubvectorNZ(subvector_scal);         /* scal & rhs share nz_w */
 
-        /*  Get the intersection of the well with the subgrid  */
-        if ((tmp_subgrid = IntersectSubgrids(subgrid, well_subgrid)))
-        {
-          ix = SubgridIX(tmp_subgrid);
-          iy = SubgridIY(tmp_subgrid);
-          iz = SubgridIZ(tmp_subgrid);
+          /*  Get the intersection of the well with the subgrid  */
+          if ((tmp_subgrid = IntersectSubgrids(subgrid, well_subgrid)))
+          {
+            ix = SubgridIX(tmp_subgrid);
+            iy = SubgridIY(tmp_subgrid);
+            iz = SubgridIZ(tmp_subgrid);
 
-          dx = SubgridDX(tmp_subgrid);
-          dy = SubgridDY(tmp_subgrid);
-          dz = SubgridDZ(tmp_subgrid);
+            dx = SubgridDX(tmp_subgrid);
+            dy = SubgridDY(tmp_subgrid);
+            dz = SubgridDZ(tmp_subgrid);
 
-          nx = SubgridNX(tmp_subgrid);
-          ny = SubgridNY(tmp_subgrid);
-          nz = SubgridNZ(tmp_subgrid);
+            nx = SubgridNX(tmp_subgrid);
+            ny = SubgridNY(tmp_subgrid);
+            nz = SubgridNZ(tmp_subgrid);
 
-          cell_volume = dx * dy * dz;
+            cell_volume = dx * dy * dz;
 
-          cn = SubvectorElt(subvector, ix, iy, iz);
-          rhs = SubvectorElt(subvector_rhs, ix, iy, iz);
-          scal = SubvectorElt(subvector_scal, ix, iy, iz);
+            cn = SubvectorElt(subvector, ix, iy, iz);
+            rhs = SubvectorElt(subvector_rhs, ix, iy, iz);
+            scal = SubvectorElt(subvector_scal, ix, iy, iz);
 
-          if (WellDataPhysicalAction(well_data_physical) == INJECTION_WELL)
-          {
-            wi = 0; ci = 0;
-            BoxLoopI2(i, j, k,
-                      ix, iy, iz, nx, ny, nz,
-                      wi, nx_w, ny_w, nz_w, 1, 1, 1,
-                      ci, nx_c, ny_c, nz_c, 1, 1, 1,
+            if (WellDataPhysicalAction(well_data_physical) == INJECTION_WELL)
             {
-              cell_change = -(scal[wi] * cn[ci] + rhs[wi]);
-              well_stat += cell_change * cell_volume;
-            });
-          }
-          else if (WellDataPhysicalAction(well_data_physical) == EXTRACTION_WELL)
-          {
-            wi = 0; ci = 0;
-            BoxLoopI2(i, j, k,
-                      ix, iy, iz, nx, ny, nz,
-                      wi, nx_w, ny_w, nz_w, 1, 1, 1,
-                      ci, nx_c, ny_c, nz_c, 1, 1, 1,
+              wi = 0; ci = 0;
+              BoxLoopI2(i, j, k,
+                        ix, iy, iz, nx, ny, nz,
+                        wi, nx_w, ny_w, nz_w, 1, 1, 1,
+                        ci, nx_c, ny_c, nz_c, 1, 1, 1,
+              {
+                cell_change = -(scal[wi] * cn[ci] + rhs[wi]);
+                well_stat += cell_change * cell_volume;
+              });
+            }
+            else if (WellDataPhysicalAction(well_data_physical) == EXTRACTION_WELL)
             {
-              cell_change = -(scal[wi] * cn[ci]);
-              well_stat += cell_change * cell_volume;
-            });
+              wi = 0; ci = 0;
+              BoxLoopI2(i, j, k,
+                        ix, iy, iz, nx, ny, nz,
+                        wi, nx_w, ny_w, nz_w, 1, 1, 1,
+                        ci, nx_c, ny_c, nz_c, 1, 1, 1,
+              {
+                cell_change = -(scal[wi] * cn[ci]);
+                well_stat += cell_change * cell_volume;
+              });
+            }
+            FreeSubgrid(tmp_subgrid);        /* done with temporary subgrid */
           }
-          FreeSubgrid(tmp_subgrid);        /* done with temporary subgrid */
         }
-      }
 
-      result_invoice = amps_NewInvoice("%d", &well_stat);
-      amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
-      amps_FreeInvoice(result_invoice);
+        result_invoice = amps_NewInvoice("%d", &well_stat);
+        amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
+        amps_FreeInvoice(result_invoice);
 
-      WellDataStatDeltaContaminant(well_data_stat, index) = well_stat;
-      WellDataStatContaminantStat(well_data_stat, index) += WellDataValueContaminantFraction(well_data_value, index) * well_stat;
-    }
+        WellDataStatDeltaContaminant(well_data_stat, index) = well_stat;
+        WellDataStatContaminantStat(well_data_stat, index) += WellDataValueContaminantFraction(well_data_value, index) * well_stat;
+      }
 
-    for (well = 0; well < WellDataNumFluxWells(well_data); well++)
-    {
-      well_data_physical = WellDataFluxWellPhysical(well_data, well);
-      cycle_number = WellDataPhysicalCycleNumber(well_data_physical);
-      interval_number = TimeCycleDataComputeIntervalNumber(problem, time, time_cycle_data, cycle_number);
-      well_data_value = WellDataFluxWellIntervalValue(well_data, well, interval_number);
-      well_data_stat = WellDataFluxWellStat(well_data, well);
+      for (well = 0; well < WellDataNumFluxWells(well_data); well++)
+      {
+        well_data_physical = WellDataFluxWellPhysical(well_data, well);
+        cycle_number = WellDataPhysicalCycleNumber(well_data_physical);
+        interval_number = TimeCycleDataComputeIntervalNumber(problem, time, time_cycle_data, cycle_number);
+        well_data_value = WellDataFluxWellIntervalValue(well_data, well, interval_number);
+        well_data_stat = WellDataFluxWellStat(well_data, well);
 
-      well_subgrid = WellDataPhysicalSubgrid(well_data_physical);
+        well_subgrid = WellDataPhysicalSubgrid(well_data_physical);
 
-      well_stat = 0.0;
-      ForSubgridI(sg, subgrids)
-      {
-        subgrid = SubgridArraySubgrid(subgrids, sg);
+        well_stat = 0.0;
+        ForSubgridI(sg, subgrids)
+        {
+          subgrid = SubgridArraySubgrid(subgrids, sg);
 
-        subvector = VectorSubvector(new_concentration, sg);
-        subvector_scal = VectorSubvector(scale, sg);
-        subvector_rhs = VectorSubvector(right_hand_side, sg);
+          subvector = VectorSubvector(new_concentration, sg);
+          subvector_scal = VectorSubvector(scale, sg);
+          subvector_rhs = VectorSubvector(right_hand_side, sg);
 
-        nx_c = SubvectorNX(subvector);
-        ny_c = SubvectorNY(subvector);
-        nz_c = SubvectorNZ(subvector);
+          nx_c = SubvectorNX(subvector);
+          ny_c = SubvectorNY(subvector);
+          nz_c = SubvectorNZ(subvector);
 
-        nx_w = SubvectorNX(subvector_scal);         /* scal & rhs share nx_w */
-        ny_w = SubvectorNY(subvector_scal);         /* scal & rhs share ny_w */
-        nz_w = SubvectorNZ(subvector_scal);         /* scal & rhs share nz_w */
+          nx_w = SubvectorNX(subvector_scal);         /* scal & rhs share nx_w */
+          ny_w = SubvectorNY(subvector_scal);         /* scal & rhs share ny_w */
+          nz_w = SubvectorNZ(subvector_scal);         /* scal & rhs share nz_w */
 
-        /*  Get the intersection of the well with the subgrid  */
-        if ((tmp_subgrid = IntersectSubgrids(subgrid, well_subgrid)))
-        {
-          ix = SubgridIX(tmp_subgrid);
-          iy = SubgridIY(tmp_subgrid);
-          iz = SubgridIZ(tmp_subgrid);
+          /*  Get the intersection of the well with the subgrid  */
+          if ((tmp_subgrid = IntersectSubgrids(subgrid, well_subgrid)))
+          {
+            ix = SubgridIX(tmp_subgrid);
+            iy = SubgridIY(tmp_subgrid);
+            iz = SubgridIZ(tmp_subgrid);
 
-          dx = SubgridDX(tmp_subgrid);
-          dy = SubgridDY(tmp_subgrid);
-          dz = SubgridDZ(tmp_subgrid);
+            dx = SubgridDX(tmp_subgrid);
+            dy = SubgridDY(tmp_subgrid);
+            dz = SubgridDZ(tmp_subgrid);
 
-          nx = SubgridNX(tmp_subgrid);
-          ny = SubgridNY(tmp_subgrid);
-          nz = SubgridNZ(tmp_subgrid);
+            nx = SubgridNX(tmp_subgrid);
+            ny = SubgridNY(tmp_subgrid);
+            nz = SubgridNZ(tmp_subgrid);
 
-          cell_volume = dx * dy * dz;
+            cell_volume = dx * dy * dz;
 
-          cn = SubvectorElt(subvector, ix, iy, iz);
-          rhs = SubvectorElt(subvector_rhs, ix, iy, iz);
-          scal = SubvectorElt(subvector_scal, ix, iy, iz);
+            cn = SubvectorElt(subvector, ix, iy, iz);
+            rhs = SubvectorElt(subvector_rhs, ix, iy, iz);
+            scal = SubvectorElt(subvector_scal, ix, iy, iz);
 
-          if (WellDataPhysicalAction(well_data_physical) == INJECTION_WELL)
-          {
-            wi = 0; ci = 0;
-            BoxLoopI2(i, j, k,
-                      ix, iy, iz, nx, ny, nz,
-                      wi, nx_w, ny_w, nz_w, 1, 1, 1,
-                      ci, nx_c, ny_c, nz_c, 1, 1, 1,
+            if (WellDataPhysicalAction(well_data_physical) == INJECTION_WELL)
             {
-              cell_change = -(scal[wi] * cn[ci] + rhs[wi]);
-              well_stat += cell_change * cell_volume;
-            });
-          }
-          else if (WellDataPhysicalAction(well_data_physical) == EXTRACTION_WELL)
-          {
-            wi = 0; ci = 0;
-            BoxLoopI2(i, j, k,
-                      ix, iy, iz, nx, ny, nz,
-                      wi, nx_w, ny_w, nz_w, 1, 1, 1,
-                      ci, nx_c, ny_c, nz_c, 1, 1, 1,
+              wi = 0; ci = 0;
+              BoxLoopI2(i, j, k,
+                        ix, iy, iz, nx, ny, nz,
+                        wi, nx_w, ny_w, nz_w, 1, 1, 1,
+                        ci, nx_c, ny_c, nz_c, 1, 1, 1,
+              {
+                cell_change = -(scal[wi] * cn[ci] + rhs[wi]);
+                well_stat += cell_change * cell_volume;
+              });
+            }
+            else if (WellDataPhysicalAction(well_data_physical) == EXTRACTION_WELL)
             {
-              cell_change = -(scal[wi] * cn[ci]);
-              well_stat += cell_change * cell_volume;
-            });
+              wi = 0; ci = 0;
+              BoxLoopI2(i, j, k,
+                        ix, iy, iz, nx, ny, nz,
+                        wi, nx_w, ny_w, nz_w, 1, 1, 1,
+                        ci, nx_c, ny_c, nz_c, 1, 1, 1,
+              {
+                cell_change = -(scal[wi] * cn[ci]);
+                well_stat += cell_change * cell_volume;
+              });
+            }
+            FreeSubgrid(tmp_subgrid);        /* done with temporary subgrid */
           }
-          FreeSubgrid(tmp_subgrid);        /* done with temporary subgrid */
         }
-      }
 
-      result_invoice = amps_NewInvoice("%d", &well_stat);
-      amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
-      amps_FreeInvoice(result_invoice);
+        result_invoice = amps_NewInvoice("%d", &well_stat);
+        amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
+        amps_FreeInvoice(result_invoice);
 
-      WellDataStatDeltaContaminant(well_data_stat, index) = well_stat;
-      WellDataStatContaminantStat(well_data_stat, index) += WellDataValueContaminantFraction(well_data_value, index) * well_stat;
+        WellDataStatDeltaContaminant(well_data_stat, index) = well_stat;
+        WellDataStatContaminantStat(well_data_stat, index) += WellDataValueContaminantFraction(well_data_value, index) * well_stat;
+      }
     }
-  }
 
 
 #if 1
-  /*-----------------------------------------------------------------------
-   * Informational computation and printing.
-   *-----------------------------------------------------------------------*/
+    /*-----------------------------------------------------------------------
+     * Informational computation and printing.
+     *-----------------------------------------------------------------------*/
 
-  field_sum = ComputeTotalConcen(ProblemDataGrDomain(problem_data),
-                                 grid, new_concentration);
+    field_sum = ComputeTotalConcen(ProblemDataGrDomain(problem_data),
+                                   grid, new_concentration);
 
 
-  if (!amps_Rank(amps_CommWorld))
-  {
-    amps_Printf("Concentration volume for phase %1d, component %2d at time %f = %f\n", phase, concentration, time, field_sum);
-  }
+    if (!amps_Rank(amps_CommWorld))
+    {
+      amps_Printf("Concentration volume for phase %1d, component %2d at time %f = %f\n", phase, concentration, time, field_sum);
+    }
 
-  IncFLOPCount(VectorSize(new_concentration));
+    IncFLOPCount(VectorSize(new_concentration));
 #endif
+  }
 
 
   /*-----------------------------------------------------------------------
@@ -985,6 +1060,7 @@ PFModule  *GodunovInitInstanceXtra(
   Subgrid      *subgrid;
 
   int max_nx, max_ny, max_nz;
+  int num_fields;
   int sg;
 
 
@@ -998,7 +1074,10 @@ PFModule  *GodunovInitInstanceXtra(
    *-----------------------------------------------------------------------*/
 
   if (problem != NULL)
+  {
     (instance_xtra->problem) = problem;
+    (instance_xtra->num_fields) = pfmax(ProblemNumContaminants(problem), 1);
+  }
 
   /*-----------------------------------------------------------------------
    * Initialize data associated with argument `grid'
@@ -1009,6 +1088,11 @@ PFModule  *GodunovInitInstanceXtra(
     /* free old data */
     if ((instance_xtra->grid) != NULL)
     {
+      FreeCommPkg(instance_xtra->comm_pkg);
+      tfree(instance_xtra->comm_vectors);
+      (instance_xtra->comm_pkg) = NULL;
+      (instance_xtra->comm_vectors) = NULL;
+      (instance_xtra->num_comm_vectors) = 0;
     }
 
     /* set new data */
@@ -1055,6 +1139,7 @@ PFModule  *GodunovInitInstanceXtra(
     max_nx = (instance_xtra->max_nx);
     max_ny = (instance_xtra->max_ny);
     max_nz = (instance_xtra->max_nz);
+    num_fields = (instance_xtra->num_fields);
 
     /*** set temp data pointers ***/
     (instance_xtra->slx) = temp_data;
@@ -1062,10 +1147,10 @@ PFModule  *GodunovInitInstanceXtra(
     (instance_xtra->sly) = temp_data;
     temp_data += (max_nx + 2 + 2) * (max_ny + 2 + 2);
     (instance_xtra->slz) = temp_data;
-    temp_data += (max_nx + 2 + 2) * (max_ny + 2 + 2) * 3;
+    temp_data += (max_nx + 2 + 2) * (max_ny + 2 + 2) * 3 * num_fields;
 
     (instance_xtra->sbot) = temp_data;
-    temp_data += (max_nx + 3 + 3) * (max_ny + 3 + 3);
+    temp_data += (max_nx + 3 + 3) * (max_ny + 3 + 3) * num_fields;
     (instance_xtra->stop) = temp_data;
     temp_data += (max_nx + 3 + 3) * (max_ny + 3 + 3);
     (instance_xtra->sbotp) = temp_data;
@@ -1105,6 +1190,8 @@ void  GodunovFreeInstanceXtra()
 
   if (instance_xtra)
   {
+    FreeCommPkg(instance_xtra->comm_pkg);
+    tfree(instance_xtra->comm_vectors);
     tfree(instance_xtra);
   }
 }
@@ -1153,15 +1240,16 @@ int  GodunovSizeOfTempData()
 
   int max_nx = (instance_xtra->max_nx);
   int max_ny = (instance_xtra->max_ny);
+  int num_fields = (instance_xtra->num_fields);
 
   int sz = 0;
 
   /* add local TempData size to `sz' */
   sz += (max_nx + 2 + 2) * (max_ny + 2 + 2);
   sz += (max_nx + 2 + 2) * (max_ny + 2 + 2);
-  sz += (max_nx + 2 + 2) * (max_ny + 2 + 2) * 3;
+  sz += (max_nx + 2 + 2) * (max_ny + 2 + 2) * 3 * num_fields;
 
-  sz += (max_nx + 3 + 3) * (max_ny + 3 + 3);
+  sz += (max_nx + 3 + 3) * (max_ny + 3 + 3) * num_fields;
   sz += (max_nx + 3 + 3) * (max_ny + 3 + 3);
   sz += (max_nx + 3 + 3) * (max_ny + 3 + 3);
   sz += (max_nx + 3 + 3) * (max_ny + 3 + 3);
@@ -36,6 +36,13 @@
    1:     CXX compiler, Standard heap allocation, Parallel loops on CPU
    2:     CXX compiler, Standard heap allocation, Sequential loops on CPU
    Other: CXX compiler, Standard heap allocation, Sequential loops on CPU
+
+
+------------------------------------------------------------
+   SIMD
+------------------------------------------------------------
+   1:     CXX compiler, Standard heap allocation, Vectorized loops on CPU
+   Other: CXX compiler, Standard heap allocation, Sequential loops on CPU
 */
 
 /* Include headers depending on the accelerator backend */
@@ -71,6 +78,14 @@
     #include "pf_omploops.h" // For OMP loops
   #endif
 
+#elif defined(PARFLOW_HAVE_SIMD)
+
+  #define ACC_ID _simd
+
+  #if PF_COMP_UNIT_TYPE == 1
+    #include "pf_simdloops.h"
+  #endif
+
 #endif
 
 
@@ -160,19 +175,19 @@
   #define PlusEquals PlusEquals_default
 #endif
 
-#if defined(ReduceMax_cuda) || defined(ReduceMax_kokkos) || defined(ReduceMax_omp)
+#if defined(ReduceMax_cuda) || defined(ReduceMax_kokkos) || defined(ReduceMax_omp) || defined(ReduceMax_simd)
   #define ReduceMax CHOOSE_BACKEND(DEFER(ReduceMax), ACC_ID)
 #else
   #define ReduceMax ReduceMax_default
 #endif
 
-#if defined(ReduceMin_cuda) || defined(ReduceMin_kokkos) || defined(ReduceMin_omp)
+#if defined(ReduceMin_cuda) || defined(ReduceMin_kokkos) || defined(ReduceMin_omp) || defined(ReduceMin_simd)
   #define ReduceMin CHOOSE_BACKEND(DEFER(ReduceMin), ACC_ID)
 #else
   #define ReduceMin ReduceMin_default
 #endif
 
-#if defined(ReduceSum_cuda) || defined(ReduceSum_kokkos) || defined(ReduceSum_omp)
+#if defined(ReduceSum_cuda) || defined(ReduceSum_kokkos) || defined(ReduceSum_omp) || defined(ReduceSum_simd)
   #define ReduceSum CHOOSE_BACKEND(DEFER(ReduceSum), ACC_ID)
 #else
   #define ReduceSum ReduceSum_default
@@ -192,37 +207,37 @@
 
 // Loops
 
-#if defined(BoxLoopI0_cuda) || defined(BoxLoopI0_kokkos) || defined(BoxLoopI0_omp)
+#if defined(BoxLoopI0_cuda) || defined(BoxLoopI0_kokkos) || defined(BoxLoopI0_omp) || defined(BoxLoopI0_simd)
   #define BoxLoopI0 CHOOSE_BACKEND(DEFER(BoxLoopI0), ACC_ID)
 #else
   #define BoxLoopI0 BoxLoopI0_default
 #endif
 
-#if defined(BoxLoopI1_cuda) || defined(BoxLoopI1_kokkos) || defined(BoxLoopI1_omp)
+#if defined(BoxLoopI1_cuda) || defined(BoxLoopI1_kokkos) || defined(BoxLoopI1_omp) || defined(BoxLoopI1_simd)
   #define BoxLoopI1 CHOOSE_BACKEND(DEFER(BoxLoopI1), ACC_ID)
 #else
   #define BoxLoopI1 BoxLoopI1_default
 #endif
 
-#if defined(BoxLoopI2_cuda) || defined(BoxLoopI2_kokkos) || defined(BoxLoopI2_omp)
+#if defined(BoxLoopI2_cuda) || defined(BoxLoopI2_kokkos) || defined(BoxLoopI2_omp) || defined(BoxLoopI2_simd)
   #define BoxLoopI2 CHOOSE_BACKEND(DEFER(BoxLoopI2), ACC_ID)
 #else
   #define BoxLoopI2 BoxLoopI2_default
 #endif
 
-#if defined(BoxLoopI3_cuda) || defined(BoxLoopI3_kokkos) || defined(BoxLoopI3_omp)
+#if defined(BoxLoopI3_cuda) || defined(BoxLoopI3_kokkos) || defined(BoxLoopI3_omp) || defined(BoxLoopI3_simd)
   #define BoxLoopI3 CHOOSE_BACKEND(DEFER(BoxLoopI3), ACC_ID)
 #else
   #define BoxLoopI3 BoxLoopI3_default
 #endif
 
-#if defined(BoxLoopReduceI1_cuda) || defined(BoxLoopReduceI1_kokkos) || defined(BoxLoopReduceI1_omp)
+#if defined(BoxLoopReduceI1_cuda) || defined(BoxLoopReduceI1_kokkos) || defined(BoxLoopReduceI1_omp) || defined(BoxLoopReduceI1_simd)
   #define BoxLoopReduceI1 CHOOSE_BACKEND(DEFER(BoxLoopReduceI1), ACC_ID)
 #else
   #define BoxLoopReduceI1 BoxLoopReduceI1_default
 #endif
 
-#if defined(BoxLoopReduceI2_cuda) || defined(BoxLoopReduceI2_kokkos) || defined(BoxLoopReduceI2_omp)
+#if defined(BoxLoopReduceI2_cuda) || defined(BoxLoopReduceI2_kokkos) || defined(BoxLoopReduceI2_omp) || defined(BoxLoopReduceI2_simd)
   #define BoxLoopReduceI2 CHOOSE_BACKEND(DEFER(BoxLoopReduceI2), ACC_ID)
 #else
   #define BoxLoopReduceI2 BoxLoopReduceI2_default
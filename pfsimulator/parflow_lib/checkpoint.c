@@ -0,0 +1,340 @@
+/*BHEADER*********************************************************************
+ *
+ *  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+ *  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+ *  by the Parflow Team (see the CONTRIBUTORS file)
+ *  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+ *
+ *  This file is part of Parflow. For details, see
+ *  http://www.llnl.gov/casc/parflow
+ *
+ *  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+ *  for the GNU Lesser General Public License.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License (as published
+ *  by the Free Software Foundation) version 2.1 dated February 1999.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+ *  and conditions of the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ *  USA
+ **********************************************************************EHEADER*/
+
+/*****************************************************************************
+ *
+ * Routines for writing and restoring checkpoints of a time integration.
+ *
+ * The owner of the state registers pointers to the integers, doubles and
+ * vectors it needs to continue the integration; WriteCheckpoint saves
+ * them and ReadCheckpoint stores them back.  Doubles are written with 17
+ * significant digits and vectors as PFB files, so a restored run
+ * continues from exactly the same values.
+ *
+ * Files written for a run named <prefix>:
+ *
+ *   <prefix>.chkpt.<slot>.<name>.pfb    one per registered vector
+ *   <prefix>.chkpt.info                 scalars, points to the last slot
+ *
+ *****************************************************************************/
+
+#include "parflow.h"
+
+#include <stdio.h>
+#include <unistd.h>
+
+
+/*--------------------------------------------------------------------------
+ * NewCheckpoint
+ *--------------------------------------------------------------------------*/
+
+Checkpoint  *NewCheckpoint(
+                           double wall_clock_interval,
+                           int    step_interval)
+{
+  Checkpoint  *checkpoint;
+
+  checkpoint = ctalloc(Checkpoint, 1);
+
+  CheckpointWallClockInterval(checkpoint) = wall_clock_interval;
+  CheckpointStepInterval(checkpoint) = step_interval;
+  CheckpointSlot(checkpoint) = 0;
+  (checkpoint->last_clock) = amps_Clock();
+
+  return checkpoint;
+}
+
+
+/*--------------------------------------------------------------------------
+ * FreeCheckpoint
+ *--------------------------------------------------------------------------*/
+
+void  FreeCheckpoint(
+                     Checkpoint *checkpoint)
+{
+  tfree(checkpoint);
+}
+
+
+/*--------------------------------------------------------------------------
+ * ClearCheckpoint:
+ *   Forget the registered state, keeping the slot and the wall clock so
+ *   that the next write still alternates with the previous one.
+ *--------------------------------------------------------------------------*/
+
+void  ClearCheckpoint(
+                      Checkpoint *checkpoint)
+{
+  (checkpoint->num_ints) = 0;
+  (checkpoint->num_doubles) = 0;
+  (checkpoint->num_vectors) = 0;
+}
+
+
+/*--------------------------------------------------------------------------
+ * CheckpointAddInt, CheckpointAddDouble, CheckpointAddVector:
+ *   Register state.  The order of registration defines the layout of the
+ *   info file, so a run must register the same entries in the same order
+ *   as the run that wrote the checkpoint.  NULL vectors are skipped.
+ *--------------------------------------------------------------------------*/
+
+void  CheckpointAddInt(
+                       Checkpoint *checkpoint,
+                       int *       value)
+{
+  if ((checkpoint->num_ints) == CHECKPOINT_MAX_ENTRIES)
+  {
+    PARFLOW_ERROR("Too many integers registered with checkpoint");
+  }
+  (checkpoint->ints)[(checkpoint->num_ints)++] = value;
+}
+
+void  CheckpointAddDouble(
+                          Checkpoint *checkpoint,
+                          double *    value)
+{
+  if ((checkpoint->num_doubles) == CHECKPOINT_MAX_ENTRIES)
+  {
+    PARFLOW_ERROR("Too many doubles registered with checkpoint");
+  }
+  (checkpoint->doubles)[(checkpoint->num_doubles)++] = value;
+}
+
+void  CheckpointAddVector(
+                          Checkpoint *checkpoint,
+                          char *      name,
+                          Vector *    vector)
+{
+  if (vector == NULL)
+  {
+    return;
+  }
+
+  if ((checkpoint->num_vectors) == CHECKPOINT_MAX_ENTRIES)
+  {
+    PARFLOW_ERROR("Too many vectors registered with checkpoint");
+  }
+  (checkpoint->vector_names)[(checkpoint->num_vectors)] = name;
+  (checkpoint->vectors)[(checkpoint->num_vectors)++] = vector;
+}
+
+
+/*--------------------------------------------------------------------------
+ * CheckpointDue:
+ *   Returns 1 if the time step numbered step should end with a
+ *   checkpoint.  When a wall clock interval is set the elapsed time is
+ *   reduced over all processes so that they all come to the same answer;
+ *   this makes the call collective.
+ *--------------------------------------------------------------------------*/
+
+int  CheckpointDue(
+                   Checkpoint *checkpoint,
+                   int         step)
+{
+  int due = 0;
+
+  if (CheckpointStepInterval(checkpoint) > 0)
+  {
+    due = ((step % CheckpointStepInterval(checkpoint)) == 0);
+  }
+
+  if (CheckpointWallClockInterval(checkpoint) > 0.0)
+  {
+    double elapsed;
+    amps_Invoice invoice;
+
+    elapsed = (double)(amps_Clock() - (checkpoint->last_clock))
+              / AMPS_TICKS_PER_SEC;
+
+    invoice = amps_NewInvoice("%d", &elapsed);
+    amps_AllReduce(amps_CommWorld, invoice, amps_Max);
+    amps_FreeInvoice(invoice);
+
+    if (elapsed >= CheckpointWallClockInterval(checkpoint))
+    {
+      due = 1;
+    }
+  }
+
+  return due;
+}
+
+
+/*--------------------------------------------------------------------------
+ * WriteCheckpoint
+ *--------------------------------------------------------------------------*/
+
+void  WriteCheckpoint(
+                      Checkpoint *checkpoint,
+                      char *      file_prefix)
+{
+  char file_suffix[2048];
+  char info_filename[2048];
+  char tmp_filename[2048];
+  FILE *file;
+  int slot = CheckpointSlot(checkpoint);
+  int i;
+
+  for (i = 0; i < (checkpoint->num_vectors); i++)
+  {
+    sprintf(file_suffix, "chkpt.%d.%s", slot, (checkpoint->vector_names)[i]);
+    WritePFBinary(file_prefix, file_suffix, (checkpoint->vectors)[i]);
+  }
+
+  /* All vector files must be complete before the info file refers to them */
+  amps_Sync(amps_CommWorld);
+
+  if (!amps_Rank(amps_CommWorld))
+  {
+    sprintf(info_filename, "%s.chkpt.info", file_prefix);
+    sprintf(tmp_filename, "%s.chkpt.info.tmp", file_prefix);
+
+    if ((file = fopen(tmp_filename, "w")) == NULL)
+    {
+      PARFLOW_ERROR("Can't open checkpoint info file");
+    }
+
+    fprintf(file, "%d %d\n", CHECKPOINT_VERSION, slot);
+    fprintf(file, "%d %d %d\n", (checkpoint->num_ints),
+            (checkpoint->num_doubles), (checkpoint->num_vectors));
+    for (i = 0; i < (checkpoint->num_ints); i++)
+    {
+      fprintf(file, "%d\n", *((checkpoint->ints)[i]));
+    }
+    for (i = 0; i < (checkpoint->num_doubles); i++)
+    {
+      fprintf(file, "%.17e\n", *((checkpoint->doubles)[i]));
+    }
+    fclose(file);
+
+    /* rename is atomic, so the info file always describes a whole slot */
+    if (rename(tmp_filename, info_filename))
+    {
+      PARFLOW_ERROR("Can't replace checkpoint info file");
+    }
+  }
+
+  amps_Sync(amps_CommWorld);
+
+  CheckpointSlot(checkpoint) = 1 - slot;
+  (checkpoint->last_clock) = amps_Clock();
+}
+
+
+/*--------------------------------------------------------------------------
+ * ReadCheckpoint:
+ *   Restores the registered state from the last checkpoint written for
+ *   file_prefix.  Returns 0 if there is no checkpoint and 1 otherwise.
+ *--------------------------------------------------------------------------*/
+
+int  ReadCheckpoint(
+                    Checkpoint *checkpoint,
+                    char *      file_prefix)
+{
+  char info_filename[2048];
+  char filename[2048];
+  amps_File file;
+  amps_Invoice invoice;
+  VectorUpdateCommHandle *handle;
+  int version, slot;
+  int num_ints, num_doubles, num_vectors;
+  int    *int_buffer;
+  double *double_buffer;
+  int i;
+
+  sprintf(info_filename, "%s.chkpt.info", file_prefix);
+  if (access(info_filename, 0) == -1)
+  {
+    return 0;
+  }
+
+  if ((file = amps_SFopen(info_filename, "r")) == NULL)
+  {
+    PARFLOW_ERROR("Can't open checkpoint info file");
+  }
+
+  invoice = amps_NewInvoice("%i%i%i%i%i", &version, &slot,
+                            &num_ints, &num_doubles, &num_vectors);
+  amps_SFBCast(amps_CommWorld, file, invoice);
+  amps_FreeInvoice(invoice);
+
+  if (version != CHECKPOINT_VERSION
+      || num_ints != (checkpoint->num_ints)
+      || num_doubles != (checkpoint->num_doubles)
+      || num_vectors != (checkpoint->num_vectors))
+  {
+    InputError("Error: checkpoint <%s> does not match the state of this run%s\n",
+               info_filename, "");
+  }
+
+  int_buffer = ctalloc(int, pfmax(num_ints, 1));
+  double_buffer = ctalloc(double, pfmax(num_doubles, 1));
+
+  if (num_ints)
+  {
+    invoice = amps_NewInvoice("%*i", num_ints, int_buffer);
+    amps_SFBCast(amps_CommWorld, file, invoice);
+    amps_FreeInvoice(invoice);
+  }
+  if (num_doubles)
+  {
+    invoice = amps_NewInvoice("%*d", num_doubles, double_buffer);
+    amps_SFBCast(amps_CommWorld, file, invoice);
+    amps_FreeInvoice(invoice);
+  }
+
+  amps_SFclose(file);
+
+  for (i = 0; i < num_ints; i++)
+  {
+    *((checkpoint->ints)[i]) = int_buffer[i];
+  }
+  for (i = 0; i < num_doubles; i++)
+  {
+    *((checkpoint->doubles)[i]) = double_buffer[i];
+  }
+
+  tfree(int_buffer);
+  tfree(double_buffer);
+
+  for (i = 0; i < num_vectors; i++)
+  {
+    sprintf(filename, "%s.chkpt.%d.%s.pfb", file_prefix, slot,
+            (checkpoint->vector_names)[i]);
+    ReadPFBinary(filename, (checkpoint->vectors)[i]);
+
+    handle = InitVectorUpdate((checkpoint->vectors)[i], VectorUpdateAll);
+    FinalizeVectorUpdate(handle);
+  }
+
+  /* Never overwrite the slot that was just restored */
+  CheckpointSlot(checkpoint) = 1 - slot;
+  (checkpoint->last_clock) = amps_Clock();
+
+  return 1;
+}
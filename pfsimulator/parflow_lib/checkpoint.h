@@ -0,0 +1,72 @@
+/*BHEADER*********************************************************************
+ *
+ *  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+ *  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+ *  by the Parflow Team (see the CONTRIBUTORS file)
+ *  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+ *
+ *  This file is part of Parflow. For details, see
+ *  http://www.llnl.gov/casc/parflow
+ *
+ *  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+ *  for the GNU Lesser General Public License.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License (as published
+ *  by the Free Software Foundation) version 2.1 dated February 1999.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+ *  and conditions of the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ *  USA
+ **********************************************************************EHEADER*/
+
+#ifndef _CHECKPOINT_HEADER
+#define _CHECKPOINT_HEADER
+
+/*----------------------------------------------------------------
+ * Checkpoint structure
+ *
+ * A checkpoint is a set of registered integers, doubles and vectors
+ * that together describe the state of a time integration.  The
+ * scalars are stored in a small text info file, the vectors as PFB
+ * files.  Checkpoints alternate between two slots and the info file
+ * is replaced only after a slot has been completely written, so an
+ * interrupted write never destroys the previous checkpoint.
+ *----------------------------------------------------------------*/
+
+#define CHECKPOINT_VERSION 1
+#define CHECKPOINT_MAX_ENTRIES 32
+
+typedef struct {
+  double wall_clock_interval;   /* seconds between checkpoints, 0 = off */
+  int step_interval;            /* time steps between checkpoints, 0 = off */
+
+  int slot;                     /* slot the next checkpoint is written to */
+  amps_Clock_t last_clock;      /* wall clock at the last checkpoint */
+
+  int num_ints;
+  int     *ints[CHECKPOINT_MAX_ENTRIES];
+
+  int num_doubles;
+  double  *doubles[CHECKPOINT_MAX_ENTRIES];
+
+  int num_vectors;
+  char    *vector_names[CHECKPOINT_MAX_ENTRIES];
+  Vector  *vectors[CHECKPOINT_MAX_ENTRIES];
+} Checkpoint;
+
+/*--------------------------------------------------------------------------
+ * Accessor macros: Checkpoint
+ *--------------------------------------------------------------------------*/
+
+#define CheckpointWallClockInterval(checkpoint) ((checkpoint)->wall_clock_interval)
+#define CheckpointStepInterval(checkpoint)      ((checkpoint)->step_interval)
+#define CheckpointSlot(checkpoint)              ((checkpoint)->slot)
+
+#endif
@@ -111,12 +111,12 @@ HistogramBox* NewHistogramBox(Box *box)
 
   BoxCopy(&(histogram_box->box), box);
 
-  int size = BoxSize(&(histogram_box->box));
+  Point num_cells;
+  BoxNumberCells(&(histogram_box->box), &num_cells);
 
   for (int dim = 0; dim < DIM; dim++)
   {
-    histogram_box->histogram[dim] = talloc(int, size);
-    memset(histogram_box->histogram[dim], 0, size * sizeof(int));
+    histogram_box->histogram[dim] = ctalloc(int, num_cells[dim]);
   }
 
   return histogram_box;
@@ -142,13 +142,13 @@ void FreeHistogramBox(HistogramBox* histogram_box)
  */
 void ResetHistogram(HistogramBox *histogram_box)
 {
+  Point num_cells;
+
+  BoxNumberCells(&(histogram_box->box), &num_cells);
+
   for (int dim = 0; dim < DIM; dim++)
   {
-    int size = BoxSize(&(histogram_box->box));
-    for (int index = 0; index < size; index++)
-    {
-      histogram_box->histogram[dim][index] = 0;
-    }
+    memset(histogram_box->histogram[dim], 0, num_cells[dim] * sizeof(int));
   }
 }
 
@@ -228,100 +228,71 @@ void FindBoundBoxForTags(HistogramBox* histogram_box, Box* bound_box, Point min_
 }
 
 /**
- * Reduces tag counts along an axis.
+ * Reduces tag counts along all axes.
  *
- * Reduce (count) the number of cells that have the specified tag
- * along the provided dimension and store into the provided histogram
- * box.
+ * Count the number of cells that have the specified tag in each slice
+ * of the histogram box along every dimension and add them to the
+ * provided histogram box.  The cells are visited once for all
+ * dimensions.
  */
-void ReduceTags(HistogramBox *histogram_box, Vector *vector, int dim, DoubleTags tag)
+void ReduceTags(HistogramBox *histogram_box, Vector *vector, DoubleTags tag)
 {
-  Box intersection;
+  Grid* grid = VectorGrid(vector);
+  Box* box = &(histogram_box->box);
 
-  BoxClear(&intersection);
+  Subvector* v_sub;
+  double     *vp;
 
-  BoxCopy(&intersection, &(histogram_box->box));
+  Subgrid* subgrid;
 
-  int ilo = intersection.lo[dim];
-  int ihi = intersection.up[dim];
+  int ix, iy, iz;
+  int nx, ny, nz;
 
+  int i_s;
+  int i, j, k, iv;
 
-  for (int ic_sb = ilo; ic_sb <= ihi; ic_sb++)
+  ForSubgridI(i_s, GridSubgrids(grid))
   {
-    tag_count = 0;
+    subgrid = GridSubgrid(grid, i_s);
 
-    Box src_box;
-    BoxClear(&src_box);
+    v_sub = VectorSubvector(vector, i_s);
 
-    BoxCopy(&src_box, &intersection);
+    /* intersect the box with the subgrid including ghost layers */
+    ix = pfmax(SubgridIX(subgrid) - num_ghost, box->lo[0]);
+    iy = pfmax(SubgridIY(subgrid) - num_ghost, box->lo[1]);
+    iz = pfmax(SubgridIZ(subgrid) - num_ghost, box->lo[2]);
 
-    src_box.lo[dim] = ic_sb;
-    src_box.up[dim] = ic_sb;
+    nx = pfmin(SubgridIX(subgrid) + SubgridNX(subgrid) + num_ghost - 1, box->up[0]) - ix + 1;
+    ny = pfmin(SubgridIY(subgrid) + SubgridNY(subgrid) + num_ghost - 1, box->up[1]) - iy + 1;
+    nz = pfmin(SubgridIZ(subgrid) + SubgridNZ(subgrid) + num_ghost - 1, box->up[2]) - iz + 1;
 
+    if ((nx < 1) || (ny < 1) || (nz < 1))
     {
-      Grid* grid = VectorGrid(vector);
-      Subvector* v_sub;
-      double     *vp;
-
-      Subgrid* subgrid;
-
-      int ix, iy, iz;
-      int nx, ny, nz;
-      int nx_v, ny_v, nz_v;
-
-      int i_s;
-      int i, j, k, iv;
+      continue;
+    }
 
-      Box bounding_box;
-      BoxClear(&bounding_box);
-      //      Point lo, up;
+    vp = SubvectorData(v_sub);
 
-      ForSubgridI(i_s, GridSubgrids(grid))
+    /* Plain host loops: the histogram is a shared host array and the
+     * sweep may already run inside the OpenMP loop over boxes */
+    for (k = iz; k < iz + nz; k++)
+    {
+      for (j = iy; j < iy + ny; j++)
       {
-        subgrid = GridSubgrid(grid, i_s);
-
-        v_sub = VectorSubvector(vector, i_s);
-
-        ix = SubgridIX(subgrid) - num_ghost;
-        iy = SubgridIY(subgrid) - num_ghost;
-        iz = SubgridIZ(subgrid) - num_ghost;
-
-        nx = SubgridNX(subgrid) + 2 * num_ghost;
-        ny = SubgridNY(subgrid) + 2 * num_ghost;
-        nz = SubgridNZ(subgrid) + 2 * num_ghost;
-
-        nx_v = SubvectorNX(v_sub);
-        ny_v = SubvectorNY(v_sub);
-        nz_v = SubvectorNZ(v_sub);
-
-        ix = pfmax(ix, src_box.lo[0]);
-        iy = pfmax(iy, src_box.lo[1]);
-        iz = pfmax(iz, src_box.lo[2]);
-
-        nx = pfmin(nx, src_box.up[0] - src_box.lo[0] + 1);
-        ny = pfmin(ny, src_box.up[1] - src_box.lo[1] + 1);
-        nz = pfmin(nz, src_box.up[2] - src_box.lo[2] + 1);
-        vp = SubvectorElt(v_sub, ix, iy, iz);
-
-        iv = 0;
-        BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
-                  iv, nx_v, ny_v, nz_v, 1, 1, 1,
+        iv = SubvectorEltIndex(v_sub, ix, j, k);
+        for (i = ix; i < ix + nx; i++, iv++)
         {
           DoubleTags v;
           v.as_double = vp[iv];
 
           if (v.as_tags & tag.as_tags)
           {
-            if (((src_box.lo[0] <= i) && (i <= src_box.up[0])) &&
-                ((src_box.lo[1] <= j) && (j <= src_box.up[1])) &&
-                ((src_box.lo[2] <= k) && (k <= src_box.up[2])))
-            {
-              PlusEquals(tag_count, 1);
-            }
+            HistogramBoxAddTags(histogram_box, 0, i, 1);
+            HistogramBoxAddTags(histogram_box, 1, j, 1);
+            HistogramBoxAddTags(histogram_box, 2, k, 1);
           }
-        });
+        }
       }
-      HistogramBoxAddTags(histogram_box, dim, ic_sb, tag_count);
     }
   }
 }
@@ -336,10 +307,7 @@ int ComputeTagHistogram(HistogramBox *histogram_box, Vector* vector, DoubleTags
 
   ResetHistogram(histogram_box);
 
-  for (int dim = 0; dim < DIM; dim++)
-  {
-    ReduceTags(histogram_box, vector, dim, tag);
-  }
+  ReduceTags(histogram_box, vector, tag);
 
   BoxNumberCells(&(histogram_box->box), &num_cells);
 
@@ -572,11 +540,75 @@ int SplitTagBoundBox(Box*          box_lft,
 }
 
 /**
- * Recursive function to compute boxes that cover cells with the provided tag.
+ * Node of the Berger-Rigoutsos split tree.
+ */
+typedef struct {
+  /** Box searched for tags */
+  Box box;
+
+  /** Smallest box bounding the tags in box */
+  Box tag_bound_box;
+
+  int num_tags;
+
+  /** Split of tag_bound_box, valid if is_split */
+  Box box_lft;
+  Box box_rgt;
+  int is_split;
+
+  /** Indices of the child nodes searching box_lft and box_rgt */
+  int lft;
+  int rgt;
+
+  /** Boxes exactly covering the tags in box */
+  BoxList* boxes;
+} SplitNode;
+
+/**
+ * Histogram the tags in the node box and attempt to split the box
+ * bounding them.
+ */
+void SplitNodeCompute(SplitNode* node,
+                      Vector*    vector,
+                      Point      min_box,
+                      DoubleTags tag)
+{
+  HistogramBox* hist_box = NewHistogramBox(&(node->box));
+
+  node->num_tags = ComputeTagHistogram(hist_box, vector, tag);
+  node->is_split = FALSE;
+
+  if (node->num_tags > 0)
+  {
+    BoxClear(&(node->tag_bound_box));
+
+    FindBoundBoxForTags(hist_box, &(node->tag_bound_box), min_box);
+
+    if (node->num_tags < BoxSize(&(node->tag_bound_box)))
+    {
+      BoxClear(&(node->box_lft));
+      BoxClear(&(node->box_rgt));
+
+      node->is_split = SplitTagBoundBox(&(node->box_lft), &(node->box_rgt),
+                                        &(node->tag_bound_box),
+                                        hist_box, min_box);
+    }
+  }
+
+  FreeHistogramBox(hist_box);
+}
+
+/**
+ * Compute boxes that cover cells with the provided tag.
  *
- * Create a list of boxes that exactly cover all tags that match the
- * specified tag value.
+ * Create a list of boxes that exactly cover all tags in bound_box
+ * that match the specified tag value.
  *
+ * The split tree is built one level at a time: the histograms of all
+ * boxes at a level are independent, so they are computed together
+ * (concurrently with OpenMP).  The tree is then resolved from the
+ * leaves up, keeping the split of a box only if it reduces the
+ * covered volume.
  */
 void FindBoxesContainingTags(BoxList*   boxes,
                              Vector*    vector,
@@ -584,77 +616,100 @@ void FindBoxesContainingTags(BoxList*   boxes,
                              Point      min_box,
                              DoubleTags tag)
 {
-  HistogramBox* hist_box = NewHistogramBox(bound_box);
+  int num_nodes = 1;
+  int max_nodes = 64;
+  SplitNode* nodes = ctalloc(SplitNode, max_nodes);
 
-  int num_tags = ComputeTagHistogram(hist_box, vector, tag);
-
-  if (num_tags == 0)
-  {
-    BoxListClearItems(boxes);
-  }
-  else
-  {
-    Box tag_bound_box;
-    BoxClear(&tag_bound_box);
+  BoxCopy(&(nodes[0].box), bound_box);
 
-    FindBoundBoxForTags(hist_box, &tag_bound_box, min_box);
+  int level_lo = 0;
+  int level_hi = num_nodes;
 
-    int num_cells = BoxSize(&tag_bound_box);
-
-    if (num_tags < num_cells)
+  while (level_lo < level_hi)
+  {
+#ifdef PARFLOW_HAVE_OMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (int n = level_lo; n < level_hi; n++)
     {
-      Box box_lft;
-      Box box_rgt;
-      BoxClear(&box_lft);
-      BoxClear(&box_rgt);
+      SplitNodeCompute(&(nodes[n]), vector, min_box, tag);
+    }
 
-      int is_split = SplitTagBoundBox(&box_lft, &box_rgt, &tag_bound_box,
-                                      hist_box, min_box);
+    /*
+     * Boxes that have been split are searched at the next level.
+     */
+    for (int n = level_lo; n < level_hi; n++)
+    {
+      nodes[n].lft = -1;
+      nodes[n].rgt = -1;
 
-      if (is_split)
+      if (nodes[n].is_split)
       {
-        /*
-         * The bounding box "tag_bound_box" has been split into two
-         * boxes, "box_lft" and "box_rgt".  Now, attempt to recursively
-         * split these boxes further.
-         */
-        BoxList* box_list_lft = NewBoxList();
-        BoxList* box_list_rgt = NewBoxList();
-
-        FindBoxesContainingTags(box_list_lft,
-                                vector,
-                                &box_lft, min_box,
-                                tag);
-        FindBoxesContainingTags(box_list_rgt,
-                                vector,
-                                &box_rgt, min_box,
-                                tag);
-
-        if (((BoxListSize(box_list_lft) > 1) ||
-             (BoxListSize(box_list_rgt) > 1)) ||
-            ((double)(BoxSize(BoxListFront(box_list_lft))
-                      + BoxSize(BoxListFront(box_list_rgt)))
-             < ((double)BoxSize(&tag_bound_box))))
+        if (num_nodes + 2 > max_nodes)
         {
-          BoxListConcatenate(boxes, box_list_lft);
-          BoxListConcatenate(boxes, box_list_rgt);
+          SplitNode* tmp_nodes = nodes;
+          nodes = ctalloc(SplitNode, 2 * max_nodes);
+          memcpy(nodes, tmp_nodes, max_nodes * sizeof(SplitNode));
+          max_nodes *= 2;
+          tfree(tmp_nodes);
         }
 
-        FreeBoxList(box_list_lft);
-        FreeBoxList(box_list_rgt);
+        nodes[n].lft = num_nodes;
+        BoxCopy(&(nodes[num_nodes++].box), &(nodes[n].box_lft));
+        nodes[n].rgt = num_nodes;
+        BoxCopy(&(nodes[num_nodes++].box), &(nodes[n].box_rgt));
       }
     }
 
+    level_lo = level_hi;
+    level_hi = num_nodes;
+  }
+
+  /*
+   * Children always follow their parent so walking the nodes backwards
+   * resolves the children before the parent.
+   */
+  for (int n = num_nodes - 1; n >= 0; n--)
+  {
+    SplitNode* node = &(nodes[n]);
+
+    node->boxes = (n == 0) ? boxes : NewBoxList();
+
+    if (node->num_tags == 0)
+    {
+      BoxListClearItems(node->boxes);
+      continue;
+    }
+
+    if (node->is_split)
+    {
+      BoxList* box_list_lft = nodes[node->lft].boxes;
+      BoxList* box_list_rgt = nodes[node->rgt].boxes;
+
+      if (((BoxListSize(box_list_lft) > 1) ||
+           (BoxListSize(box_list_rgt) > 1)) ||
+          ((double)(BoxSize(BoxListFront(box_list_lft))
+                    + BoxSize(BoxListFront(box_list_rgt)))
+           < ((double)BoxSize(&(node->tag_bound_box)))))
+      {
+        BoxListConcatenate(node->boxes, box_list_lft);
+        BoxListConcatenate(node->boxes, box_list_rgt);
+      }
+
+      FreeBoxList(box_list_lft);
+      FreeBoxList(box_list_rgt);
+    }
+
     /*
      * If no good splitting is found, add bounding box to list.
      */
-    if (BoxListIsEmpty(boxes))
+    if (BoxListIsEmpty(node->boxes))
     {
-      BoxListAppend(boxes, &tag_bound_box);
+      BoxListAppend(node->boxes, &(node->tag_bound_box));
     }
   }
 
-  FreeHistogramBox(hist_box);
+  tfree(nodes);
 }
 
 /**
@@ -706,78 +761,7 @@ void BergerRigoutsos(Vector*    vector,
 
   BoxSet(&bounding_box, lo, up);
 
-  HistogramBox* histogram_box = NewHistogramBox(&bounding_box);
-
-  int num_tags = ComputeTagHistogram(histogram_box, vector, tag);
-
-  if (num_tags == 0)
-  {
-    BoxListClearItems(boxes);
-  }
-  else
-  {
-    Box tag_bound_box;
-    BoxClear(&tag_bound_box);
-
-    FindBoundBoxForTags(histogram_box, &tag_bound_box, min_box);
-
-    int num_cells = BoxSize(&tag_bound_box);
-
-    if (num_tags < num_cells)
-    {
-      Box box_lft;
-      Box box_rgt;
-
-      BoxClear(&box_lft);
-      BoxClear(&box_rgt);
-
-      int is_split = SplitTagBoundBox(&box_lft, &box_rgt, &tag_bound_box,
-                                      histogram_box, min_box);
-
-      if (is_split)
-      {
-        /*
-         * The bounding box "tag_bound_box" has been split into two
-         * boxes, "box_lft" and "box_rgt".  Now, attempt to recursively
-         * split these boxes further.
-         */
-        BoxList* box_list_lft = NewBoxList();
-        BoxList* box_list_rgt = NewBoxList();
-
-        FindBoxesContainingTags(box_list_lft,
-                                vector,
-                                &box_lft, min_box,
-                                tag);
-        FindBoxesContainingTags(box_list_rgt,
-                                vector,
-                                &box_rgt, min_box,
-                                tag);
-
-        if (((BoxListSize(box_list_lft) > 1) ||
-             (BoxListSize(box_list_rgt) > 1)) ||
-            ((double)(BoxSize(BoxListFront(box_list_lft))
-                      + BoxSize(BoxListFront(box_list_rgt)))
-             < ((double)BoxSize(&tag_bound_box))))
-        {
-          BoxListConcatenate(boxes, box_list_lft);
-          BoxListConcatenate(boxes, box_list_rgt);
-        }
-
-        FreeBoxList(box_list_lft);
-        FreeBoxList(box_list_rgt);
-      }
-    }
-
-    /*
-     * If no good splitting is found, add bounding box to list.
-     */
-    if (BoxListIsEmpty(boxes))
-    {
-      BoxListAppend(boxes, &tag_bound_box);
-    }
-  }
-
-  FreeHistogramBox(histogram_box);
+  FindBoxesContainingTags(boxes, vector, &bounding_box, min_box, tag);
 }
 
 
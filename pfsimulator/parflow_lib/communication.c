@@ -151,6 +151,26 @@ CommPkg         *NewCommPkg(
                             SubregionArray *data_space,
                             int             num_vars, /* number of variables in the vector */
                             double *        data)
+{
+  return NewMultiCommPkg(send_region, recv_region, data_space, num_vars,
+                         1, &data);
+}
+
+
+/*--------------------------------------------------------------------------
+ * NewMultiCommPkg:
+ *   Like NewCommPkg, but updates the `num_data' arrays `data' that all
+ *   have the layout `data_space'.  The arrays are packed into one message
+ *   per neighbor process.
+ *--------------------------------------------------------------------------*/
+
+CommPkg         *NewMultiCommPkg(
+                                 Region *        send_region,
+                                 Region *        recv_region,
+                                 SubregionArray *data_space,
+                                 int             num_vars, /* number of variables in the vector */
+                                 int             num_data,
+                                 double **       data)
 {
   CommPkg         *new_comm_pkg;
 
@@ -173,7 +193,7 @@ CommPkg         *NewCommPkg(
   int num_recv_procs;
 
   int proc;
-  int i, j, p;
+  int i, j, p, d;
 
   int dim;
 
@@ -281,15 +301,18 @@ CommPkg         *NewCommPkg(
             dim = NewCommPkgInfo(data_sr, comm_sr, i, num_vars,
                                  loop_array);
 
-            invoice =
-              amps_NewInvoice("%&.&D(*)",
-                              loop_array + 1,
-                              loop_array + 5,
-                              dim,
-                              data + loop_array[0]);
+            for (d = 0; d < num_data; d++)
+            {
+              invoice =
+                amps_NewInvoice("%&.&D(*)",
+                                loop_array + 1,
+                                loop_array + 5,
+                                dim,
+                                data[d] + loop_array[0]);
 
-            amps_AppendInvoice(&(new_comm_pkg->send_invoices[p]),
-                               invoice);
+              amps_AppendInvoice(&(new_comm_pkg->send_invoices[p]),
+                                 invoice);
+            }
 
             num_send_subregions++;
             loop_array += 9;
@@ -323,15 +346,18 @@ CommPkg         *NewCommPkg(
             dim = NewCommPkgInfo(data_sr, comm_sr, i, num_vars,
                                  loop_array);
 
-            invoice =
-              amps_NewInvoice("%&.&D(*)",
-                              loop_array + 1,
-                              loop_array + 5,
-                              dim,
-                              data + loop_array[0]);
+            for (d = 0; d < num_data; d++)
+            {
+              invoice =
+                amps_NewInvoice("%&.&D(*)",
+                                loop_array + 1,
+                                loop_array + 5,
+                                dim,
+                                data[d] + loop_array[0]);
 
-            amps_AppendInvoice(&(new_comm_pkg->recv_invoices[p]),
-                               invoice);
+              amps_AppendInvoice(&(new_comm_pkg->recv_invoices[p]),
+                                 invoice);
+            }
 
             num_recv_subregions++;
             loop_array += 9;
@@ -414,7 +440,9 @@ void         FinalizeCommunication(
                                    CommHandle *handle)
 {
   PUSH_NVTX("amps_Wait",1)
+  TelemetryBeginPhase(TelemetryHaloWaitPhase);
   (void)amps_Wait((amps_Handle)handle);
+  TelemetryEndPhase(TelemetryHaloWaitPhase);
   POP_NVTX
 }
 
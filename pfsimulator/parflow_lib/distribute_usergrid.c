@@ -83,6 +83,16 @@ SubgridArray   *DistributeUserGrid(
   R = GlobalsNumProcsZ;
 
   Grid *process_grid = ReadProcessGrid();
+  int balanced = 0;
+
+  /*
+   * Otherwise balance the active cells over the processes if requested.
+   */
+  if (!process_grid)
+  {
+    process_grid = BalancedProcessGrid(user_grid);
+    balanced = (process_grid != NULL);
+  }
 
   /*
    * If user specified a process grid in input use that.
@@ -112,6 +122,21 @@ SubgridArray   *DistributeUserGrid(
 
       AppendSubgrid(new_subgrid, all_subgrids);
     }
+
+    /*
+     * The balanced decomposition gives every process whole columns,
+     * so in z it looks like a single process.
+     */
+    if (balanced)
+    {
+      GlobalsNumProcsX = num_procs;
+      GlobalsNumProcsY = 1;
+      GlobalsNumProcsZ = 1;
+
+      GlobalsP = amps_Rank(amps_CommWorld);
+      GlobalsQ = 0;
+      GlobalsR = 0;
+    }
   }
   else
   {
@@ -29,9 +29,9 @@ static int c__1 = 1;
                       int *   incx,
                       double *dy,
                       int *   incy);
-  static int j, k;
-  static double s, t;
-  static int jm1;
+  int j, k;
+  double s, t;
+  int jm1;
 
 
 /*     dpofa factors a double precision symmetric positive definite */
@@ -133,9 +133,9 @@ double ddot_(
   double ret_val;
 
   /* Local variables */
-  static int i, m;
-  static double dtemp;
-  static int ix, iy, mp1;
+  int i, m;
+  double dtemp;
+  int ix, iy, mp1;
 
 
 /*     forms the dot product of two vectors. */
@@ -35,10 +35,10 @@ static int c__1 = 1;
                               double *dy,
                               int *   incy);
 
-  static int k;
-  static double t;
+  int k;
+  double t;
 
-  static int kb;
+  int kb;
 
 
 /*     dposl solves the double precision symmetric positive definite */
@@ -134,7 +134,7 @@ static int c__1 = 1;
   int i__1;
 
   /* Local variables */
-  static int i, m, ix, iy, mp1;
+  int i, m, ix, iy, mp1;
 
 
 /*     constant times a vector plus a vector. */
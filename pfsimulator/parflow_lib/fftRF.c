@@ -0,0 +1,826 @@
+/*BHEADER*********************************************************************
+ *
+ *  Copyright (c) 1995-2024, Lawrence Livermore National Security,
+ *  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+ *  by the Parflow Team (see the CONTRIBUTORS file)
+ *  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+ *
+ *  This file is part of Parflow. For details, see
+ *  http://www.llnl.gov/casc/parflow
+ *
+ *  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+ *  for the GNU Lesser General Public License.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License (as published
+ *  by the Free Software Foundation) version 2.1 dated February 1999.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+ *  and conditions of the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ *  USA
+ **********************************************************************EHEADER*/
+/*****************************************************************************
+*
+* Routines to generate a Gaussian random field with the FFT moving
+* average (FFT-MA) method.
+*
+* The field is the convolution of a white noise field with a kernel g
+* whose autocorrelation is the covariance model, g * g = C.  The kernel
+* is computed once by circulant embedding, g = IFFT(sqrt(FFT(C))), and
+* truncated at KernelRadius correlation lengths.  The white noise value
+* of a cell is a hash of the seed and the global cell index, so every
+* process can generate the noise under the halo of its subgrids itself.
+* Each subgrid is then convolved in tiles with local FFTs; no data is
+* exchanged between processes and the field does not depend on the
+* process topology (up to rounding).
+*
+*****************************************************************************/
+
+#include "parflow.h"
+
+#include <math.h>
+#include <stdint.h>
+
+/*--------------------------------------------------------------------------
+ * Structures
+ *--------------------------------------------------------------------------*/
+
+typedef struct {
+  double lambdaX;
+  double lambdaY;
+  double lambdaZ;
+  double mean;
+  double sigma;
+  double kernel_radius;
+  int log_normal;
+  double low_cutoff;
+  double high_cutoff;
+  int seed;
+  int time_index;
+} PublicXtra;
+
+typedef struct {
+  /* InitInstanceXtra arguments */
+  Grid   *grid;
+  double *temp_data;
+} InstanceXtra;
+
+
+/*--------------------------------------------------------------------------
+ * FFTRFNextPow2
+ *--------------------------------------------------------------------------*/
+
+static int FFTRFNextPow2(int n)
+{
+  int p = 1;
+
+  while (p < n)
+    p *= 2;
+
+  return p;
+}
+
+
+/*--------------------------------------------------------------------------
+ * FFTRFNormal:
+ *   N(0,1) white noise value of global cell (i, j, k).  The cell index
+ *   and seed are hashed (splitmix64) into two uniforms which are turned
+ *   into a normal deviate with the Box-Muller transform.
+ *--------------------------------------------------------------------------*/
+
+static uint64_t FFTRFHash(uint64_t x)
+{
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+static double FFTRFNormal(int seed, int i, int j, int k)
+{
+  uint64_t h;
+  double u1, u2;
+
+  h = FFTRFHash((uint64_t)(uint32_t)seed);
+  h = FFTRFHash(h ^ (uint64_t)(uint32_t)i);
+  h = FFTRFHash(h ^ ((uint64_t)(uint32_t)j << 21));
+  h = FFTRFHash(h ^ ((uint64_t)(uint32_t)k << 42));
+
+  /* u1 in (0,1], u2 in [0,1) */
+  u1 = ((double)(h >> 11) + 1.0) * (1.0 / 9007199254740992.0);
+  h = FFTRFHash(h);
+  u2 = (double)(h >> 11) * (1.0 / 9007199254740992.0);
+
+  return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+
+/*--------------------------------------------------------------------------
+ * FFTRFTransform:
+ *   In place radix-2 FFT of n (a power of 2) interleaved complex values.
+ *   sign = -1 is the forward transform; the inverse is not scaled.
+ *--------------------------------------------------------------------------*/
+
+static void FFTRFTransform(double *data, int n, int sign)
+{
+  int i, j, m, mmax, istep;
+  double wr, wi, wpr, wpi, wtemp, theta, tr, ti;
+
+  /* Bit reversal permutation */
+  j = 0;
+  for (i = 0; i < n - 1; i++)
+  {
+    if (i < j)
+    {
+      tr = data[2 * i]; data[2 * i] = data[2 * j]; data[2 * j] = tr;
+      ti = data[2 * i + 1]; data[2 * i + 1] = data[2 * j + 1]; data[2 * j + 1] = ti;
+    }
+    m = n >> 1;
+    while (m >= 1 && j >= m)
+    {
+      j -= m;
+      m >>= 1;
+    }
+    j += m;
+  }
+
+  /* Danielson-Lanczos butterflies */
+  for (mmax = 1; mmax < n; mmax = istep)
+  {
+    istep = mmax << 1;
+    theta = sign * M_PI / mmax;
+    wtemp = sin(0.5 * theta);
+    wpr = -2.0 * wtemp * wtemp;
+    wpi = sin(theta);
+    wr = 1.0;
+    wi = 0.0;
+    for (m = 0; m < mmax; m++)
+    {
+      for (i = m; i < n; i += istep)
+      {
+        j = i + mmax;
+        tr = wr * data[2 * j] - wi * data[2 * j + 1];
+        ti = wr * data[2 * j + 1] + wi * data[2 * j];
+        data[2 * j] = data[2 * i] - tr;
+        data[2 * j + 1] = data[2 * i + 1] - ti;
+        data[2 * i] += tr;
+        data[2 * i + 1] += ti;
+      }
+      wtemp = wr;
+      wr += wr * wpr - wi * wpi;
+      wi += wi * wpr + wtemp * wpi;
+    }
+  }
+}
+
+
+/*--------------------------------------------------------------------------
+ * FFTRFTransform3D:
+ *   FFT of an n[0] x n[1] x n[2] complex array (x fastest).  The y and z
+ *   lines are gathered into line, which holds max(n) complex values.
+ *--------------------------------------------------------------------------*/
+
+static void FFTRFTransform3D(double *data, int *n, int sign, double *line)
+{
+  int i, j, k, l;
+  int nx = n[0], ny = n[1], nz = n[2];
+  int sy = nx, sz = nx * ny;
+
+  if (nx > 1)
+  {
+    for (l = 0; l < ny * nz; l++)
+      FFTRFTransform(data + 2 * l * nx, nx, sign);
+  }
+
+  if (ny > 1)
+  {
+    for (k = 0; k < nz; k++)
+      for (i = 0; i < nx; i++)
+      {
+        double *base = data + 2 * (k * sz + i);
+        for (j = 0; j < ny; j++)
+        {
+          line[2 * j] = base[2 * j * sy];
+          line[2 * j + 1] = base[2 * j * sy + 1];
+        }
+        FFTRFTransform(line, ny, sign);
+        for (j = 0; j < ny; j++)
+        {
+          base[2 * j * sy] = line[2 * j];
+          base[2 * j * sy + 1] = line[2 * j + 1];
+        }
+      }
+  }
+
+  if (nz > 1)
+  {
+    for (j = 0; j < ny; j++)
+      for (i = 0; i < nx; i++)
+      {
+        double *base = data + 2 * (j * sy + i);
+        for (k = 0; k < nz; k++)
+        {
+          line[2 * k] = base[2 * k * sz];
+          line[2 * k + 1] = base[2 * k * sz + 1];
+        }
+        FFTRFTransform(line, nz, sign);
+        for (k = 0; k < nz; k++)
+        {
+          base[2 * k * sz] = line[2 * k];
+          base[2 * k * sz + 1] = line[2 * k + 1];
+        }
+      }
+  }
+}
+
+
+/*--------------------------------------------------------------------------
+ * FFTRFKernel:
+ *   Moving average kernel for the exponential covariance
+ *   C(h) = exp(-|h / lambda|) used by the other simulators.  Returns the
+ *   (2 H[0] + 1) x (2 H[1] + 1) x (2 H[2] + 1) kernel centered on offset 0,
+ *   scaled so that sum g^2 = C(0) = 1 after the truncation.
+ *--------------------------------------------------------------------------*/
+
+static double *FFTRFKernel(int *H, double *scale)
+{
+  double *c, *g, *line;
+  int M[3];
+  int i, j, k, d, nk, m_total;
+  int oi, oj, ok;
+  double a1, a2, a3, sum;
+
+  for (d = 0; d < 3; d++)
+    M[d] = FFTRFNextPow2(2 * H[d] + 1);
+  m_total = M[0] * M[1] * M[2];
+
+  /* Covariance on the periodic embedding */
+  c = ctalloc(double, 2 * m_total);
+  for (k = 0; k < M[2]; k++)
+    for (j = 0; j < M[1]; j++)
+      for (i = 0; i < M[0]; i++)
+      {
+        oi = pfmin(i, M[0] - i);
+        oj = pfmin(j, M[1] - j);
+        ok = pfmin(k, M[2] - k);
+        a1 = oi * scale[0];
+        a2 = oj * scale[1];
+        a3 = ok * scale[2];
+        c[2 * ((k * M[1] + j) * M[0] + i)] =
+          exp(-sqrt(a1 * a1 + a2 * a2 + a3 * a3));
+      }
+
+  line = talloc(double, 2 * pfmax(pfmax(M[0], M[1]), M[2]));
+
+  /* The spectrum of a real symmetric covariance is real; negative
+   * eigenvalues of the embedding are dropped */
+  FFTRFTransform3D(c, M, -1, line);
+  for (i = 0; i < m_total; i++)
+  {
+    c[2 * i] = sqrt(pfmax(c[2 * i], 0.0));
+    c[2 * i + 1] = 0.0;
+  }
+  FFTRFTransform3D(c, M, 1, line);
+
+  /* Truncate to the kernel radius and renormalize */
+  nk = (2 * H[0] + 1) * (2 * H[1] + 1) * (2 * H[2] + 1);
+  g = talloc(double, nk);
+  sum = 0.0;
+  d = 0;
+  for (ok = -H[2]; ok <= H[2]; ok++)
+    for (oj = -H[1]; oj <= H[1]; oj++)
+      for (oi = -H[0]; oi <= H[0]; oi++)
+      {
+        i = (oi + M[0]) % M[0];
+        j = (oj + M[1]) % M[1];
+        k = (ok + M[2]) % M[2];
+        g[d] = c[2 * ((k * M[1] + j) * M[0] + i)] / m_total;
+        sum += g[d] * g[d];
+        d++;
+      }
+
+  sum = 1.0 / sqrt(sum);
+  for (d = 0; d < nk; d++)
+    g[d] *= sum;
+
+  tfree(line);
+  tfree(c);
+
+  return g;
+}
+
+
+/*--------------------------------------------------------------------------
+ * FFTRFFillNoise:
+ *   White noise under the tile at global index origin o of size t and its
+ *   halo of H cells, stored in every other double of data (the real or
+ *   the imaginary part of the F[0] x F[1] x F[2] complex array).
+ *--------------------------------------------------------------------------*/
+
+static void FFTRFFillNoise(double *data, int *F, int *H, int *o, int *t,
+                           int seed)
+{
+  int a, b, c;
+
+  for (c = 0; c < t[2] + 2 * H[2]; c++)
+    for (b = 0; b < t[1] + 2 * H[1]; b++)
+      for (a = 0; a < t[0] + 2 * H[0]; a++)
+      {
+        data[2 * ((c * F[1] + b) * F[0] + a)] =
+          FFTRFNormal(seed, o[0] - H[0] + a, o[1] - H[1] + b, o[2] - H[2] + c);
+      }
+}
+
+
+/*--------------------------------------------------------------------------
+ * FFTRFConvolve:
+ *   Circular convolution of work with the kernel whose spectrum is G.
+ *   The result is not scaled by the FFT size.
+ *--------------------------------------------------------------------------*/
+
+static void FFTRFConvolve(double *work, double *G, int *F, double *line)
+{
+  int a, f_total = F[0] * F[1] * F[2];
+  double re, im;
+
+  FFTRFTransform3D(work, F, -1, line);
+  for (a = 0; a < f_total; a++)
+  {
+    re = work[2 * a] * G[2 * a] - work[2 * a + 1] * G[2 * a + 1];
+    im = work[2 * a] * G[2 * a + 1] + work[2 * a + 1] * G[2 * a];
+    work[2 * a] = re;
+    work[2 * a + 1] = im;
+  }
+  FFTRFTransform3D(work, F, 1, line);
+}
+
+
+/*--------------------------------------------------------------------------
+ * FFTRFWriteTile:
+ *   Copy the geounit cells of the tile at o out of the convolved data.
+ *--------------------------------------------------------------------------*/
+
+static void FFTRFWriteTile(double *data, int *F, int *H, int *o, int *t,
+                           int f_total, GrGeomSolid *gr_geounit, int r,
+                           Subvector *field_sub)
+{
+  double *fieldp = SubvectorData(field_sub);
+  int i, j, k, a, b, c, index;
+
+  GrGeomInLoop(i, j, k, gr_geounit, r, o[0], o[1], o[2], t[0], t[1], t[2],
+  {
+    a = i - o[0] + H[0];
+    b = j - o[1] + H[1];
+    c = k - o[2] + H[2];
+    index = SubvectorEltIndex(field_sub, i, j, k);
+    fieldp[index] = data[2 * ((c * F[1] + b) * F[0] + a)] / f_total;
+  });
+}
+
+
+/*--------------------------------------------------------------------------
+ * FFTRF
+ *--------------------------------------------------------------------------*/
+
+void         FFTRF(
+                   GeomSolid *  geounit,
+                   GrGeomSolid *gr_geounit,
+                   Vector *     field,
+                   RFCondData * cdata)
+{
+  PFModule      *this_module = ThisPFModule;
+  PublicXtra    *public_xtra = (PublicXtra*)PFModulePublicXtra(this_module);
+  InstanceXtra  *instance_xtra = (InstanceXtra*)PFModuleInstanceXtra(this_module);
+
+  double lambda[3];
+  double mean = (public_xtra->mean);
+  double sigma = (public_xtra->sigma);
+  double kernel_radius = (public_xtra->kernel_radius);
+  int log_normal = (public_xtra->log_normal);
+  double low_cutoff = (public_xtra->low_cutoff);
+  double high_cutoff = (public_xtra->high_cutoff);
+  int seed = (public_xtra->seed);
+
+  Grid       *grid = (instance_xtra->grid);
+
+  Subgrid    *subgrid;
+  Subvector  *field_sub;
+  double     *fieldp;
+
+  int global_n[3];
+  double spacing[3], scale[3];
+  int H[3], F[3], T[3], F_old[3];
+  int s[3], n[3], t0[3];
+  int o[2][3], t[2][3];
+
+  double     *g, *G, *work, *line;
+  int f_total;
+
+  int is, d, i, j, k, a, b, c, p;
+  int oi, oj, ok;
+  int index, r, in_tile, pending;
+
+  Statistics *stats;
+
+  BeginTiming(public_xtra->time_index);
+
+  lambda[0] = (public_xtra->lambdaX);
+  lambda[1] = (public_xtra->lambdaY);
+  lambda[2] = (public_xtra->lambdaZ);
+
+  global_n[0] = BackgroundNX(GlobalsBackground);
+  global_n[1] = BackgroundNY(GlobalsBackground);
+  global_n[2] = BackgroundNZ(GlobalsBackground);
+
+  /* For now, we will assume that all subgrids have the same uniform spacing */
+  subgrid = GridSubgrid(grid, 0);
+  spacing[0] = SubgridDX(subgrid);
+  spacing[1] = SubgridDY(subgrid);
+  spacing[2] = SubgridDZ(subgrid);
+
+  /*-----------------------------------------------------------------------
+   * Kernel radius in cells.  A zero correlation length leaves the field
+   * uncorrelated in that direction.
+   *-----------------------------------------------------------------------*/
+
+  for (d = 0; d < 3; d++)
+  {
+    if (lambda[d] > 0.0)
+    {
+      scale[d] = spacing[d] / lambda[d];
+      H[d] = (int)ceil(kernel_radius * lambda[d] / spacing[d]);
+      H[d] = pfmin(H[d], global_n[d]);
+    }
+    else
+    {
+      scale[d] = 0.0;
+      H[d] = 0;
+    }
+  }
+
+  g = FFTRFKernel(H, scale);
+
+  G = NULL;
+  work = NULL;
+  line = NULL;
+  F_old[0] = F_old[1] = F_old[2] = 0;
+
+  /*-----------------------------------------------------------------------
+   * Convolve the white noise with the kernel on each subgrid.  The
+   * subgrid is split in tiles of T cells so that a tile and its halo of
+   * H cells fit an FFT of size F; the circular convolution is exact
+   * inside the halo.
+   *-----------------------------------------------------------------------*/
+
+  ForSubgridI(is, GridSubgrids(grid))
+  {
+    subgrid = GridSubgrid(grid, is);
+    field_sub = VectorSubvector(field, is);
+    fieldp = SubvectorData(field_sub);
+
+    s[0] = SubgridIX(subgrid);
+    s[1] = SubgridIY(subgrid);
+    s[2] = SubgridIZ(subgrid);
+
+    n[0] = SubgridNX(subgrid);
+    n[1] = SubgridNY(subgrid);
+    n[2] = SubgridNZ(subgrid);
+
+    /* RDF: assume resolutions are the same in all 3 directions */
+    r = SubgridRX(subgrid);
+
+    /* Tiles of about 8 H cells keep the halo overhead low; the FFT size
+     * is limited to 256 unless the kernel itself needs more */
+    for (d = 0; d < 3; d++)
+    {
+      if (H[d] == 0)
+        F[d] = 1;
+      else
+      {
+        F[d] = pfmax(pfmin(FFTRFNextPow2(8 * H[d]), 256),
+                     FFTRFNextPow2(4 * H[d]));
+        F[d] = pfmin(F[d], FFTRFNextPow2(n[d] + 2 * H[d]));
+      }
+      T[d] = F[d] - 2 * H[d];
+    }
+
+    /* Spectrum of the kernel for this FFT size */
+    if (F[0] != F_old[0] || F[1] != F_old[1] || F[2] != F_old[2])
+    {
+      tfree(G);
+      tfree(work);
+      tfree(line);
+
+      f_total = F[0] * F[1] * F[2];
+      G = ctalloc(double, 2 * f_total);
+      work = talloc(double, 2 * f_total);
+      line = talloc(double, 2 * pfmax(pfmax(F[0], F[1]), F[2]));
+
+      d = 0;
+      for (ok = -H[2]; ok <= H[2]; ok++)
+        for (oj = -H[1]; oj <= H[1]; oj++)
+          for (oi = -H[0]; oi <= H[0]; oi++)
+          {
+            a = (oi + F[0]) % F[0];
+            b = (oj + F[1]) % F[1];
+            c = (ok + F[2]) % F[2];
+            G[2 * ((c * F[1] + b) * F[0] + a)] = g[d++];
+          }
+      FFTRFTransform3D(G, F, -1, line);
+
+      F_old[0] = F[0];
+      F_old[1] = F[1];
+      F_old[2] = F[2];
+    }
+
+    /* The kernel is real, so two tiles are convolved with one complex
+     * FFT: the first in the real part and the second in the imaginary
+     * part of work */
+    f_total = F[0] * F[1] * F[2];
+    pending = 0;
+
+    for (t0[2] = 0; t0[2] < n[2]; t0[2] += T[2])
+      for (t0[1] = 0; t0[1] < n[1]; t0[1] += T[1])
+        for (t0[0] = 0; t0[0] < n[0]; t0[0] += T[0])
+        {
+          for (d = 0; d < 3; d++)
+          {
+            o[pending][d] = s[d] + t0[d];
+            t[pending][d] = pfmin(T[d], n[d] - t0[d]);
+          }
+
+          /* Skip tiles with no cells in the geounit */
+          in_tile = 0;
+          GrGeomInLoop(i, j, k, gr_geounit, r,
+                       o[pending][0], o[pending][1], o[pending][2],
+                       t[pending][0], t[pending][1], t[pending][2],
+          {
+            in_tile = 1;
+          });
+
+          if (!in_tile)
+            continue;
+
+          if (pending == 0)
+          {
+            for (a = 0; a < 2 * f_total; a++)
+              work[a] = 0.0;
+          }
+          FFTRFFillNoise(work + pending, F, H, o[pending], t[pending], seed);
+          pending++;
+
+          if (pending == 2)
+          {
+            FFTRFConvolve(work, G, F, line);
+            for (p = 0; p < 2; p++)
+              FFTRFWriteTile(work + p, F, H, o[p], t[p], f_total,
+                             gr_geounit, r, field_sub);
+            pending = 0;
+          }
+        }
+
+    if (pending)
+    {
+      FFTRFConvolve(work, G, F, line);
+      FFTRFWriteTile(work, F, H, o[0], t[0], f_total,
+                     gr_geounit, r, field_sub);
+    }
+  }
+
+  tfree(G);
+  tfree(work);
+  tfree(line);
+  tfree(g);
+
+  /*
+   * Condition the field to data using the p-field method.
+   * See "SCRF 1993 Annual Report", Stanford Center for
+   * Reservoir Forecasting.
+   */
+  if (cdata->nc)
+  {
+    stats = ctalloc(Statistics, 1);
+    (stats->mean) = mean;
+    (stats->sigma) = sigma;
+    (stats->lambdaX) = lambda[0];
+    (stats->lambdaY) = lambda[1];
+    (stats->lambdaZ) = lambda[2];
+    (stats->lognormal) = (log_normal == 1) || (log_normal == 3);
+    PField(grid, geounit, gr_geounit, field, cdata, stats);
+    tfree(stats);
+  }
+
+  /* make field normal or lognormal */
+  ForSubgridI(is, GridSubgrids(grid))
+  {
+    subgrid = GridSubgrid(grid, is);
+    field_sub = VectorSubvector(field, is);
+    fieldp = SubvectorData(field_sub);
+
+    s[0] = SubgridIX(subgrid);
+    s[1] = SubgridIY(subgrid);
+    s[2] = SubgridIZ(subgrid);
+
+    n[0] = SubgridNX(subgrid);
+    n[1] = SubgridNY(subgrid);
+    n[2] = SubgridNZ(subgrid);
+
+    r = SubgridRX(subgrid);
+
+    switch (log_normal)
+    {
+      case 0:    /* normal distribution */
+        GrGeomInLoop(i, j, k, gr_geounit, r, s[0], s[1], s[2], n[0], n[1], n[2],
+      {
+        index = SubvectorEltIndex(field_sub, i, j, k);
+        fieldp[index] = mean + sigma * fieldp[index];
+      });
+        break;
+
+      case 1:    /* log normal distribution */
+        GrGeomInLoop(i, j, k, gr_geounit, r, s[0], s[1], s[2], n[0], n[1], n[2],
+      {
+        index = SubvectorEltIndex(field_sub, i, j, k);
+        fieldp[index] = mean * exp((sigma) * fieldp[index]);
+      });
+        break;
+
+      case 2:    /* normal distribution with low and high cutoffs */
+        GrGeomInLoop(i, j, k, gr_geounit, r, s[0], s[1], s[2], n[0], n[1], n[2],
+      {
+        index = SubvectorEltIndex(field_sub, i, j, k);
+        fieldp[index] = mean + sigma * fieldp[index];
+        if (fieldp[index] < low_cutoff)
+          fieldp[index] = low_cutoff;
+        if (fieldp[index] > high_cutoff)
+          fieldp[index] = high_cutoff;
+      });
+        break;
+
+      case 3:    /* log normal distribution with low and high cutoffs */
+        GrGeomInLoop(i, j, k, gr_geounit, r, s[0], s[1], s[2], n[0], n[1], n[2],
+      {
+        index = SubvectorEltIndex(field_sub, i, j, k);
+        fieldp[index] = mean * exp((sigma) * fieldp[index]);
+        if (fieldp[index] < low_cutoff)
+          fieldp[index] = low_cutoff;
+        if (fieldp[index] > high_cutoff)
+          fieldp[index] = high_cutoff;
+      });
+        break;
+    }   /* end switch(lognormal)  */
+  }
+
+  EndTiming(public_xtra->time_index);
+}
+
+
+/*--------------------------------------------------------------------------
+ * FFTRFInitInstanceXtra
+ *--------------------------------------------------------------------------*/
+
+PFModule  *FFTRFInitInstanceXtra(
+                                 Grid *  grid,
+                                 double *temp_data)
+{
+  PFModule      *this_module = ThisPFModule;
+  InstanceXtra  *instance_xtra;
+
+
+  if (PFModuleInstanceXtra(this_module) == NULL)
+    instance_xtra = ctalloc(InstanceXtra, 1);
+  else
+    instance_xtra = (InstanceXtra*)PFModuleInstanceXtra(this_module);
+
+  /*-----------------------------------------------------------------------
+   * Initialize data associated with argument `grid'
+   *-----------------------------------------------------------------------*/
+
+  if (grid != NULL)
+  {
+    /* set new data */
+    (instance_xtra->grid) = grid;
+  }
+
+  /*-----------------------------------------------------------------------
+   * Initialize data associated with argument `temp_data'
+   *-----------------------------------------------------------------------*/
+
+  if (temp_data != NULL)
+  {
+    (instance_xtra->temp_data) = temp_data;
+  }
+
+  PFModuleInstanceXtra(this_module) = instance_xtra;
+  return this_module;
+}
+
+
+/*--------------------------------------------------------------------------
+ * FFTRFFreeInstanceXtra
+ *--------------------------------------------------------------------------*/
+
+void  FFTRFFreeInstanceXtra()
+{
+  PFModule      *this_module = ThisPFModule;
+  InstanceXtra  *instance_xtra = (InstanceXtra*)PFModuleInstanceXtra(this_module);
+
+
+  if (instance_xtra)
+  {
+    tfree(instance_xtra);
+  }
+}
+
+
+/*--------------------------------------------------------------------------
+ * FFTRFNewPublicXtra
+ *--------------------------------------------------------------------------*/
+
+PFModule   *FFTRFNewPublicXtra(char *geom_name)
+{
+  PFModule      *this_module = ThisPFModule;
+  PublicXtra    *public_xtra;
+
+  char key[IDB_MAX_KEY_LEN];
+
+  NameArray log_normal_na;
+
+  char *tmp;
+
+  public_xtra = ctalloc(PublicXtra, 1);
+
+  sprintf(key, "Geom.%s.Perm.LambdaX", geom_name);
+  public_xtra->lambdaX = GetDouble(key);
+  sprintf(key, "Geom.%s.Perm.LambdaY", geom_name);
+  public_xtra->lambdaY = GetDouble(key);
+  sprintf(key, "Geom.%s.Perm.LambdaZ", geom_name);
+  public_xtra->lambdaZ = GetDouble(key);
+
+  sprintf(key, "Geom.%s.Perm.GeomMean", geom_name);
+  public_xtra->mean = GetDouble(key);
+  sprintf(key, "Geom.%s.Perm.Sigma", geom_name);
+  public_xtra->sigma = GetDouble(key);
+
+  sprintf(key, "Geom.%s.Perm.KernelRadius", geom_name);
+  public_xtra->kernel_radius = GetDoubleDefault(key, 4.0);
+  if (public_xtra->kernel_radius <= 0.0)
+  {
+    InputError("Error: invalid value <%s> for key <%s>\n", "<= 0.0", key);
+  }
+
+  log_normal_na = NA_NewNameArray("Normal Log NormalTruncated LogTruncated");
+  sprintf(key, "Geom.%s.Perm.LogNormal", geom_name);
+  tmp = GetStringDefault(key, "LogTruncated");
+  public_xtra->log_normal = NA_NameToIndexExitOnError(log_normal_na, tmp, key);
+  NA_FreeNameArray(log_normal_na);
+
+  sprintf(key, "Geom.%s.Perm.Seed", geom_name);
+  public_xtra->seed = GetIntDefault(key, 1);
+
+  if (public_xtra->log_normal > 1)
+  {
+    sprintf(key, "Geom.%s.Perm.LowCutoff", geom_name);
+    public_xtra->low_cutoff = GetDouble(key);
+
+    sprintf(key, "Geom.%s.Perm.HighCutoff", geom_name);
+    public_xtra->high_cutoff = GetDouble(key);
+  }
+
+  (public_xtra->time_index) = RegisterTiming("FFT RF");
+
+  PFModulePublicXtra(this_module) = public_xtra;
+  return this_module;
+}
+
+
+/*--------------------------------------------------------------------------
+ * FFTRFFreePublicXtra
+ *--------------------------------------------------------------------------*/
+
+void  FFTRFFreePublicXtra()
+{
+  PFModule    *this_module = ThisPFModule;
+  PublicXtra  *public_xtra = (PublicXtra*)PFModulePublicXtra(this_module);
+
+
+  if (public_xtra)
+  {
+    tfree(public_xtra);
+  }
+}
+
+/*--------------------------------------------------------------------------
+ * FFTRFSizeOfTempData
+ *--------------------------------------------------------------------------*/
+
+int  FFTRFSizeOfTempData()
+{
+  return 0;
+}
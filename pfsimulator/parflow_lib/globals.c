@@ -79,6 +79,10 @@ void   NewGlobals(char *run_name)
   globals_ptr->repeat_counts = 0;
 
   globals_ptr->use_clustering = 0;
+
+  globals_ptr->use_vector_row_padding = 0;
+
+  globals_ptr->use_mapped_pfb_reader = 0;
 }
 
 
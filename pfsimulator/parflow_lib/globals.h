@@ -88,6 +88,10 @@ typedef struct _Globals {
 
   int use_clustering;
 
+  int use_vector_row_padding;
+
+  int use_mapped_pfb_reader;
+
 #ifdef HAVE_SAMRAI
   SAMRAI::tbox::Pointer < Parflow > parflow_simulation;
 #endif
@@ -143,6 +147,10 @@ amps_ThreadLocalDcl(extern IDB *, input_database);
 
 #define GlobalsUseClustering      (globals->use_clustering)
 
+#define GlobalsUseVectorRowPadding  (globals->use_vector_row_padding)
+
+#define GlobalsUseMappedPFBReader   (globals->use_mapped_pfb_reader)
+
 #define pqr_to_process(p, q, r, P, Q, R)  ((((r) * (Q)) + (q)) * (P) + (p))
 
 #endif
@@ -0,0 +1,697 @@
+/*BHEADER*********************************************************************
+ *
+ *  Copyright (c) 1995-2024, Lawrence Livermore National Security,
+ *  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+ *  by the Parflow Team (see the CONTRIBUTORS file)
+ *  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+ *
+ *  This file is part of Parflow. For details, see
+ *  http://www.llnl.gov/casc/parflow
+ *
+ *  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+ *  for the GNU Lesser General Public License.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License (as published
+ *  by the Free Software Foundation) version 2.1 dated February 1999.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+ *  and conditions of the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ *  USA
+ **********************************************************************EHEADER*/
+/*****************************************************************************
+ *
+ * Routines for caching the GrGeom solids of a problem between runs.
+ *
+ * The octrees and the iteration boxes of the solids only depend on the
+ * geometry inputs, the background grid and the process topology.  The
+ * cache file is written as an amps fixed file, each process writing and
+ * reading only its own section:
+ *
+ *   int     magic, version
+ *   int     global key (2 ints), local key (2 ints)
+ *   int     num_solids
+ *   per solid:
+ *     int   octree_bg_level, octree_ix, octree_iy, octree_iz, num_patches
+ *     the solid octree and the num_patches patch octrees, each as
+ *       int   num_nodes
+ *       char  flags and faces of the nodes in depth first order
+ *     the interior boxes, the 6 surface boxes and the 6*num_patches
+ *     patch boxes, each as
+ *       int   size (-1 if the boxes were not computed)
+ *       int   lo and up of the boxes
+ *
+ * The global key is the same on all processes and names the file, the
+ * local key describes the inputs seen by a single process.
+ *
+ *****************************************************************************/
+
+#include "parflow.h"
+
+#include <stdio.h>
+#include <unistd.h>
+
+#define GrGeomCacheMagic    0x50464743
+#define GrGeomCacheVersion  1
+
+
+/*--------------------------------------------------------------------------
+ * GrGeomCacheHash:
+ *   Adds size bytes of data to a 64 bit FNV-1a hash.
+ *--------------------------------------------------------------------------*/
+
+unsigned long long  GrGeomCacheHash(
+                                    unsigned long long hash,
+                                    const void *       data,
+                                    long               size)
+{
+  const unsigned char *bytes = (const unsigned char*)data;
+  long i;
+
+  for (i = 0; i < size; i++)
+  {
+    hash ^= (unsigned long long)bytes[i];
+    hash *= 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+
+/*--------------------------------------------------------------------------
+ * GrGeomCacheHashGlobals:
+ *   Adds the background grid, refinement, clustering and process topology.
+ *--------------------------------------------------------------------------*/
+
+unsigned long long  GrGeomCacheHashGlobals(
+                                           unsigned long long hash)
+{
+  Background *bg = GlobalsBackground;
+  int ints[9];
+  double doubles[6];
+
+  ints[0] = BackgroundNX(bg);
+  ints[1] = BackgroundNY(bg);
+  ints[2] = BackgroundNZ(bg);
+  ints[3] = GlobalsMaxRefLevel;
+  ints[4] = GlobalsUseClustering;
+  ints[5] = amps_Size(amps_CommWorld);
+  ints[6] = GlobalsNumProcsX;
+  ints[7] = GlobalsNumProcsY;
+  ints[8] = GlobalsNumProcsZ;
+
+  doubles[0] = BackgroundX(bg);
+  doubles[1] = BackgroundY(bg);
+  doubles[2] = BackgroundZ(bg);
+  doubles[3] = BackgroundDX(bg);
+  doubles[4] = BackgroundDY(bg);
+  doubles[5] = BackgroundDZ(bg);
+
+  hash = GrGeomCacheHash(hash, ints, sizeof(ints));
+  hash = GrGeomCacheHash(hash, doubles, sizeof(doubles));
+
+  return hash;
+}
+
+
+/*--------------------------------------------------------------------------
+ * GrGeomCacheHashGeomSolid:
+ *   Adds the surface and the patches of a triangulated solid.
+ *--------------------------------------------------------------------------*/
+
+unsigned long long  GrGeomCacheHashGeomSolid(
+                                             unsigned long long hash,
+                                             GeomSolid *        solid)
+{
+  GeomTSolid   *solid_data;
+  GeomTIN      *surface;
+  GeomVertex   *vertex;
+  GeomTriangle *triangle;
+  int n, p, type;
+
+  type = GeomSolidType(solid);
+  hash = GrGeomCacheHash(hash, &type, sizeof(int));
+
+  switch (type)
+  {
+    case GeomTSolidType:
+    {
+      solid_data = (GeomTSolid*)GeomSolidData(solid);
+      surface = (solid_data->surface);
+
+      for (n = 0; n < GeomTINNumVertices(surface); n++)
+      {
+        vertex = GeomTINVertex(surface, n);
+        hash = GrGeomCacheHash(hash, vertex, sizeof(GeomVertex));
+      }
+
+      for (n = 0; n < GeomTINNumTriangles(surface); n++)
+      {
+        triangle = GeomTINTriangle(surface, n);
+        hash = GrGeomCacheHash(hash, triangle, sizeof(GeomTriangle));
+      }
+
+      hash = GrGeomCacheHash(hash, &(solid_data->num_patches), sizeof(int));
+      for (p = 0; p < (solid_data->num_patches); p++)
+      {
+        hash = GrGeomCacheHash(hash, &(solid_data->num_patch_triangles[p]),
+                               sizeof(int));
+        hash = GrGeomCacheHash(hash, solid_data->patches[p],
+                               (solid_data->num_patch_triangles[p]) * sizeof(int));
+      }
+
+      break;
+    }
+  }
+
+  return hash;
+}
+
+
+/*--------------------------------------------------------------------------
+ * GrGeomCacheHashVector:
+ *   Adds the local data, including ghost layers, of a vector.
+ *--------------------------------------------------------------------------*/
+
+unsigned long long  GrGeomCacheHashVector(
+                                          unsigned long long hash,
+                                          Vector *           vector)
+{
+  Grid       *grid = VectorGrid(vector);
+  Subvector  *subvector;
+  int sg;
+
+  ForSubgridI(sg, GridSubgrids(grid))
+  {
+    subvector = VectorSubvector(vector, sg);
+    hash = GrGeomCacheHash(hash, SubvectorData(subvector),
+                           SubvectorDataSize(subvector) * sizeof(double));
+  }
+
+  return hash;
+}
+
+
+/*--------------------------------------------------------------------------
+ * GrGeomCacheHashSubgrids:
+ *   Adds the placement of the local subgrids.
+ *--------------------------------------------------------------------------*/
+
+unsigned long long  GrGeomCacheHashSubgrids(
+                                            unsigned long long hash,
+                                            SubgridArray *     subgrids)
+{
+  Subgrid  *subgrid;
+  int ints[9];
+  int sg;
+
+  ForSubgridI(sg, subgrids)
+  {
+    subgrid = SubgridArraySubgrid(subgrids, sg);
+
+    ints[0] = SubgridIX(subgrid);
+    ints[1] = SubgridIY(subgrid);
+    ints[2] = SubgridIZ(subgrid);
+    ints[3] = SubgridNX(subgrid);
+    ints[4] = SubgridNY(subgrid);
+    ints[5] = SubgridNZ(subgrid);
+    ints[6] = SubgridRX(subgrid);
+    ints[7] = SubgridRY(subgrid);
+    ints[8] = SubgridRZ(subgrid);
+
+    hash = GrGeomCacheHash(hash, ints, sizeof(ints));
+  }
+
+  return hash;
+}
+
+
+/*--------------------------------------------------------------------------
+ * Octree (de)serialization helpers
+ *--------------------------------------------------------------------------*/
+
+static int  CountOctreeNodes(
+                             GrGeomOctree *octree)
+{
+  int num_nodes = 1;
+  int ic;
+
+  if (!GrGeomOctreeNodeIsLeaf(octree))
+  {
+    for (ic = 0; ic < GrGeomOctreeNumChildren; ic++)
+      num_nodes += CountOctreeNodes(GrGeomOctreeChild(octree, ic));
+  }
+
+  return num_nodes;
+}
+
+static void  PackOctree(
+                        GrGeomOctree * octree,
+                        char *         buffer,
+                        int *          position)
+{
+  int ic;
+
+  buffer[(*position)++] = (char)GrGeomOctreeFlag(octree);
+  buffer[(*position)++] = (char)GrGeomOctreeFaces(octree);
+
+  if (!GrGeomOctreeNodeIsLeaf(octree))
+  {
+    for (ic = 0; ic < GrGeomOctreeNumChildren; ic++)
+      PackOctree(GrGeomOctreeChild(octree, ic), buffer, position);
+  }
+}
+
+/* Returns 0 if the buffer does not describe a complete octree */
+static int  UnpackOctree(
+                         GrGeomOctree *octree,
+                         char *        buffer,
+                         int           size,
+                         int *         position)
+{
+  int ic;
+
+  if ((*position) + 2 > size)
+    return 0;
+
+  GrGeomOctreeFlag(octree) = (unsigned char)buffer[(*position)++];
+  GrGeomOctreeFaces(octree) = (unsigned char)buffer[(*position)++];
+
+  if (!GrGeomOctreeNodeIsLeaf(octree))
+  {
+    /* GrGeomNewOctreeChildren only allocates children for leaf nodes */
+    GrGeomOctreeSetNodeLeaf(octree);
+    GrGeomNewOctreeChildren(octree);
+
+    for (ic = 0; ic < GrGeomOctreeNumChildren; ic++)
+      if (!UnpackOctree(GrGeomOctreeChild(octree, ic), buffer, size, position))
+        return 0;
+  }
+
+  return 1;
+}
+
+static long  SizeofOctree(
+                          GrGeomOctree *octree)
+{
+  return amps_SizeofInt + 2 * CountOctreeNodes(octree) * amps_SizeofChar;
+}
+
+static void  WriteOctree(
+                         amps_File     file,
+                         GrGeomOctree *octree)
+{
+  char *buffer;
+  int num_nodes, position = 0;
+
+  num_nodes = CountOctreeNodes(octree);
+  buffer = talloc(char, 2 * num_nodes);
+  PackOctree(octree, buffer, &position);
+
+  amps_WriteInt(file, &num_nodes, 1);
+  amps_WriteChar(file, buffer, 2 * num_nodes);
+
+  tfree(buffer);
+}
+
+static GrGeomOctree  *ReadOctree(
+                                 amps_File file)
+{
+  GrGeomOctree *octree;
+  char *buffer;
+  int num_nodes = 0, position = 0;
+
+  amps_ReadInt(file, &num_nodes, 1);
+  if (num_nodes < 1)
+    return NULL;
+
+  buffer = ctalloc(char, 2 * num_nodes);
+  amps_ReadChar(file, buffer, 2 * num_nodes);
+
+  octree = GrGeomNewOctree();
+  if (!UnpackOctree(octree, buffer, 2 * num_nodes, &position))
+  {
+    GrGeomFreeOctree(octree);
+    octree = NULL;
+  }
+
+  tfree(buffer);
+
+  return octree;
+}
+
+
+/*--------------------------------------------------------------------------
+ * BoxArray (de)serialization helpers
+ *--------------------------------------------------------------------------*/
+
+static long  SizeofBoxes(
+                         BoxArray *boxes)
+{
+  return amps_SizeofInt * (1 + (boxes ? 2 * DIM * BoxArraySize(boxes) : 0));
+}
+
+static void  WriteBoxes(
+                        amps_File file,
+                        BoxArray *boxes)
+{
+  int size = boxes ? (int)BoxArraySize(boxes) : -1;
+  int i;
+
+  amps_WriteInt(file, &size, 1);
+
+  for (i = 0; i < size; i++)
+  {
+    amps_WriteInt(file, boxes->boxes[i].lo, DIM);
+    amps_WriteInt(file, boxes->boxes[i].up, DIM);
+  }
+}
+
+static BoxArray  *ReadBoxes(
+                            amps_File file)
+{
+  BoxList   *box_list;
+  BoxArray  *boxes;
+  Box box;
+  int size = -1;
+  int i;
+
+  amps_ReadInt(file, &size, 1);
+  if (size < 0)
+    return NULL;
+
+  box_list = NewBoxList();
+  for (i = 0; i < size; i++)
+  {
+    amps_ReadInt(file, box.lo, DIM);
+    amps_ReadInt(file, box.up, DIM);
+    BoxListAppend(box_list, &box);
+  }
+
+  boxes = NewBoxArray(box_list);
+  FreeBoxList(box_list);
+
+  return boxes;
+}
+
+
+/*--------------------------------------------------------------------------
+ * GrGeomCacheFilename:
+ *   Builds the cache file name in filename, which holds 2048 characters.
+ *   The temporary and .dist names derived from it have room for their
+ *   suffixes.
+ *--------------------------------------------------------------------------*/
+
+void  GrGeomCacheFilename(
+                          char *             filename,
+                          char *             directory,
+                          unsigned long long global_key)
+{
+  if (snprintf(filename, 2048, "%s/geometry.%016llx.cache",
+               directory, global_key) >= 2048)
+  {
+    InputError("Error: GeometryCache.Directory <%s> is too long%s\n",
+               directory, "");
+  }
+}
+
+
+/*--------------------------------------------------------------------------
+ * GrGeomWriteCache:
+ *   Writes the solids to the cache file.  The file is written under a
+ *   temporary name and renamed when complete, so concurrent runs on the
+ *   same inputs never see a partial cache.
+ *--------------------------------------------------------------------------*/
+
+void  GrGeomWriteCache(
+                       char *             filename,
+                       unsigned long long global_key,
+                       unsigned long long local_key,
+                       GrGeomSolid **     solids,
+                       int                num_solids)
+{
+  amps_File file;
+  amps_Invoice invoice;
+
+  GrGeomSolid *solid;
+
+  char tmp_filename[2048 + 16];
+  char dist_filename[2048 + 8];
+  char tmp_dist_filename[2048 + 16 + 8];
+
+  FILE *test_file;
+
+  int header[7];
+  int pid, writable;
+  long size;
+  int i, p, f;
+
+  /* All processes use the process id of process 0 to name the file */
+  pid = amps_Rank(amps_CommWorld) ? 0 : (int)getpid();
+  invoice = amps_NewInvoice("%i", &pid);
+  amps_AllReduce(amps_CommWorld, invoice, amps_Max);
+  amps_FreeInvoice(invoice);
+
+  snprintf(tmp_filename, sizeof(tmp_filename), "%s.%d", filename, pid);
+
+  /* Process 0 creates the file, make sure it can */
+  writable = 1;
+  if (!amps_Rank(amps_CommWorld))
+  {
+    if ((test_file = fopen(tmp_filename, "wb")) == NULL)
+    {
+      amps_Printf("Warning: can't open geometry cache file %s\n", tmp_filename);
+      writable = 0;
+    }
+    else
+    {
+      fclose(test_file);
+    }
+  }
+  invoice = amps_NewInvoice("%i", &writable);
+  amps_AllReduce(amps_CommWorld, invoice, amps_Min);
+  amps_FreeInvoice(invoice);
+
+  if (!writable)
+  {
+    return;
+  }
+
+  header[0] = GrGeomCacheMagic;
+  header[1] = GrGeomCacheVersion;
+  header[2] = (int)(global_key >> 32);
+  header[3] = (int)(global_key & 0xffffffffULL);
+  header[4] = (int)(local_key >> 32);
+  header[5] = (int)(local_key & 0xffffffffULL);
+  header[6] = num_solids;
+
+  size = 7 * amps_SizeofInt;
+  for (i = 0; i < num_solids; i++)
+  {
+    solid = solids[i];
+
+    size += 5 * amps_SizeofInt;
+    size += SizeofOctree(GrGeomSolidData(solid));
+    for (p = 0; p < GrGeomSolidNumPatches(solid); p++)
+      size += SizeofOctree(GrGeomSolidPatch(solid, p));
+
+    size += SizeofBoxes(GrGeomSolidInteriorBoxes(solid));
+    for (f = 0; f < GrGeomOctreeNumFaces; f++)
+    {
+      size += SizeofBoxes(GrGeomSolidSurfaceBoxes(solid, f));
+      for (p = 0; p < GrGeomSolidNumPatches(solid); p++)
+        size += SizeofBoxes(GrGeomSolidPatchBoxes(solid, p, f));
+    }
+  }
+
+  file = amps_FFopen(amps_CommWorld, tmp_filename, "wb", size);
+
+  amps_WriteInt(file, header, 7);
+
+  for (i = 0; i < num_solids; i++)
+  {
+    solid = solids[i];
+
+    amps_WriteInt(file, &GrGeomSolidOctreeBGLevel(solid), 1);
+    amps_WriteInt(file, &GrGeomSolidOctreeIX(solid), 1);
+    amps_WriteInt(file, &GrGeomSolidOctreeIY(solid), 1);
+    amps_WriteInt(file, &GrGeomSolidOctreeIZ(solid), 1);
+    amps_WriteInt(file, &GrGeomSolidNumPatches(solid), 1);
+
+    WriteOctree(file, GrGeomSolidData(solid));
+    for (p = 0; p < GrGeomSolidNumPatches(solid); p++)
+      WriteOctree(file, GrGeomSolidPatch(solid, p));
+
+    WriteBoxes(file, GrGeomSolidInteriorBoxes(solid));
+    for (f = 0; f < GrGeomOctreeNumFaces; f++)
+    {
+      WriteBoxes(file, GrGeomSolidSurfaceBoxes(solid, f));
+      for (p = 0; p < GrGeomSolidNumPatches(solid); p++)
+        WriteBoxes(file, GrGeomSolidPatchBoxes(solid, p, f));
+    }
+  }
+
+  amps_FFclose(file);
+
+  amps_Sync(amps_CommWorld);
+
+  if (!amps_Rank(amps_CommWorld))
+  {
+    snprintf(dist_filename, sizeof(dist_filename), "%s.dist", filename);
+    snprintf(tmp_dist_filename, sizeof(tmp_dist_filename), "%s.dist",
+             tmp_filename);
+
+    /* The .dist file only depends on the global key, so a reader never
+     * sees sizes that do not match the data */
+    if (rename(tmp_dist_filename, dist_filename) ||
+        rename(tmp_filename, filename))
+    {
+      amps_Printf("Warning: can't create geometry cache file %s\n", filename);
+      unlink(tmp_dist_filename);
+      unlink(tmp_filename);
+    }
+  }
+}
+
+
+/*--------------------------------------------------------------------------
+ * GrGeomReadCache:
+ *   Reads the solids from the cache file.  Returns 1 if every process
+ *   found a cache written for the same keys, 0 otherwise; in that case no
+ *   solids are returned.
+ *--------------------------------------------------------------------------*/
+
+int  GrGeomReadCache(
+                     char *             filename,
+                     unsigned long long global_key,
+                     unsigned long long local_key,
+                     GrGeomSolid **     solids,
+                     int                num_solids)
+{
+  amps_File file;
+  amps_Invoice invoice;
+
+  GrGeomOctree  *data;
+  GrGeomOctree **patches;
+  GrGeomSolid   *solid;
+
+  char dist_filename[2048 + 8];
+
+  int header[7];
+  int info[5];
+  int valid;
+  int i, p, f;
+
+  /* Process 0 checks for the file, which is opened collectively */
+  valid = 0;
+  if (!amps_Rank(amps_CommWorld))
+  {
+    snprintf(dist_filename, sizeof(dist_filename), "%s.dist", filename);
+    valid = (access(filename, R_OK) == 0) && (access(dist_filename, R_OK) == 0);
+  }
+  invoice = amps_NewInvoice("%i", &valid);
+  amps_AllReduce(amps_CommWorld, invoice, amps_Max);
+
+  if (!valid)
+  {
+    amps_FreeInvoice(invoice);
+    return 0;
+  }
+
+  if ((file = amps_FFopen(amps_CommWorld, filename, "rb", 0)) == NULL)
+  {
+    valid = 0;
+  }
+  else
+  {
+    for (i = 0; i < 7; i++)
+      header[i] = 0;
+    amps_ReadInt(file, header, 7);
+
+    valid = (header[0] == GrGeomCacheMagic) &&
+            (header[1] == GrGeomCacheVersion) &&
+            (header[2] == (int)(global_key >> 32)) &&
+            (header[3] == (int)(global_key & 0xffffffffULL)) &&
+            (header[4] == (int)(local_key >> 32)) &&
+            (header[5] == (int)(local_key & 0xffffffffULL)) &&
+            (header[6] == num_solids);
+  }
+
+  amps_AllReduce(amps_CommWorld, invoice, amps_Min);
+
+  if (valid)
+  {
+    for (i = 0; i < num_solids; i++)
+    {
+      for (p = 0; p < 5; p++)
+        info[p] = -1;
+      amps_ReadInt(file, info, 5);
+
+      valid = (info[4] >= 0);
+      if (!valid)
+        break;
+
+      data = ReadOctree(file);
+      patches = ctalloc(GrGeomOctree *, info[4]);
+      valid = (data != NULL);
+      for (p = 0; p < info[4] && valid; p++)
+      {
+        patches[p] = ReadOctree(file);
+        valid = (patches[p] != NULL);
+      }
+
+      if (!valid)
+      {
+        if (data)
+          GrGeomFreeOctree(data);
+        for (p = 0; p < info[4]; p++)
+          if (patches[p])
+            GrGeomFreeOctree(patches[p]);
+        tfree(patches);
+        break;
+      }
+
+      solid = GrGeomAllocSolid(data, patches, info[4],
+                               info[0], info[1], info[2], info[3]);
+      solids[i] = solid;
+
+      GrGeomSolidInteriorBoxes(solid) = ReadBoxes(file);
+      for (f = 0; f < GrGeomOctreeNumFaces; f++)
+      {
+        GrGeomSolidSurfaceBoxes(solid, f) = ReadBoxes(file);
+        for (p = 0; p < GrGeomSolidNumPatches(solid); p++)
+          GrGeomSolidPatchBoxes(solid, p, f) = ReadBoxes(file);
+      }
+    }
+
+    /* A truncated or corrupt section on any process invalidates the cache */
+    amps_AllReduce(amps_CommWorld, invoice, amps_Min);
+
+    if (!valid)
+    {
+      for (i = 0; i < num_solids; i++)
+      {
+        if (solids[i])
+        {
+          GrGeomFreeSolid(solids[i]);
+          solids[i] = NULL;
+        }
+      }
+    }
+  }
+
+  if (file)
+  {
+    amps_FFclose(file);
+  }
+
+  amps_FreeInvoice(invoice);
+
+  return valid;
+}
@@ -536,6 +536,188 @@ GrGeomOctree   *GrGeomOctreeAddFace(
 }
 
 
+/*--------------------------------------------------------------------------
+ * TINTriangleLineBounds:
+ *   Bounding box of triangle n in line index space, stored as
+ *   (x_lower, y_lower, z_lower, x_upper, y_upper, z_upper).  The box is
+ *   clamped to [-1, 2*num_indices] to avoid integer overflow.
+ *--------------------------------------------------------------------------*/
+
+static void TINTriangleLineBounds(
+                                  GeomTIN *solid,
+                                  int      n,
+                                  double   xlower,
+                                  double   ylower,
+                                  double   zlower,
+                                  double   dx_lines,
+                                  double   dy_lines,
+                                  double   dz_lines,
+                                  int      num_indices,
+                                  int *    bounds)
+{
+  GeomTriangle *triangle = GeomTINTriangle(solid, n);
+  GeomVertex   *v0 = GeomTINVertex(solid, GeomTriangleV0(triangle));
+  GeomVertex   *v1 = GeomTINVertex(solid, GeomTriangleV1(triangle));
+  GeomVertex   *v2 = GeomTINVertex(solid, GeomTriangleV2(triangle));
+
+  double v[3][3], lower[3], d_lines[3], tbox_lower, tbox_upper;
+  int d;
+
+  lower[0] = xlower;
+  lower[1] = ylower;
+  lower[2] = zlower;
+  d_lines[0] = dx_lines;
+  d_lines[1] = dy_lines;
+  d_lines[2] = dz_lines;
+
+  v[0][0] = GeomVertexX(v0);
+  v[0][1] = GeomVertexY(v0);
+  v[0][2] = GeomVertexZ(v0);
+  v[1][0] = GeomVertexX(v1);
+  v[1][1] = GeomVertexY(v1);
+  v[1][2] = GeomVertexZ(v1);
+  v[2][0] = GeomVertexX(v2);
+  v[2][1] = GeomVertexY(v2);
+  v[2][2] = GeomVertexZ(v2);
+
+  for (d = 0; d < 3; d++)
+  {
+    tbox_lower = pfmin(pfmin((v[0][d] - lower[d]) / d_lines[d],
+                             (v[1][d] - lower[d]) / d_lines[d]),
+                       (v[2][d] - lower[d]) / d_lines[d]);
+    tbox_upper = pfmax(pfmax((v[0][d] - lower[d]) / d_lines[d],
+                             (v[1][d] - lower[d]) / d_lines[d]),
+                       (v[2][d] - lower[d]) / d_lines[d]);
+
+    tbox_lower = pfmax(pfmin(tbox_lower, 2 * num_indices), -1);
+    tbox_upper = pfmin(pfmax(tbox_upper, -1), 2 * num_indices);
+
+    bounds[d] = (int)floor(tbox_lower);
+    bounds[d + 3] = (int)ceil(tbox_upper);
+  }
+}
+
+/*--------------------------------------------------------------------------
+ * TINBinTriangles:
+ *   Bin the triangles by the rows [row_l, row_u] of lines along axis
+ *   row_axis their bounds cover.  A triangle is only binned if its bounds
+ *   also cover one of the line ranges [a_l, a_u] along axis a_axis or
+ *   [b_l, b_u] along axis b_axis.  The triangles of row r are
+ *   bin[bin_start[r - row_l] .. bin_start[r - row_l + 1]-1], in
+ *   increasing order.
+ *--------------------------------------------------------------------------*/
+
+static void TINBinTriangles(
+                            int   num_triangles,
+                            int * triangle_lines,
+                            int   row_axis,
+                            int   row_l,
+                            int   row_u,
+                            int   a_axis,
+                            int   a_l,
+                            int   a_u,
+                            int   b_axis,
+                            int   b_l,
+                            int   b_u,
+                            int **bin_start_ptr,
+                            int **bin_ptr)
+{
+  int  *bin_start, *bin, *bin_len;
+  int  *bounds;
+  int num_rows = row_u - row_l + 1;
+  int n, r, lower, upper;
+
+  bin_start = ctalloc(int, num_rows + 1);
+  bin_len = ctalloc(int, num_rows);
+
+  for (n = 0; n < num_triangles; n++)
+  {
+    bounds = &triangle_lines[6 * n];
+    if ((pfmax(bounds[a_axis], a_l) <= pfmin(bounds[a_axis + 3], a_u)) ||
+        (pfmax(bounds[b_axis], b_l) <= pfmin(bounds[b_axis + 3], b_u)))
+    {
+      lower = pfmax(bounds[row_axis], row_l);
+      upper = pfmin(bounds[row_axis + 3], row_u);
+      for (r = lower; r <= upper; r++)
+        bin_start[r - row_l + 1]++;
+    }
+  }
+
+  for (r = 0; r < num_rows; r++)
+    bin_start[r + 1] += bin_start[r];
+
+  bin = talloc(int, bin_start[num_rows]);
+
+  for (n = 0; n < num_triangles; n++)
+  {
+    bounds = &triangle_lines[6 * n];
+    if ((pfmax(bounds[a_axis], a_l) <= pfmin(bounds[a_axis + 3], a_u)) ||
+        (pfmax(bounds[b_axis], b_l) <= pfmin(bounds[b_axis + 3], b_u)))
+    {
+      lower = pfmax(bounds[row_axis], row_l);
+      upper = pfmin(bounds[row_axis + 3], row_u);
+      for (r = lower; r <= upper; r++)
+      {
+        bin[bin_start[r - row_l] + bin_len[r - row_l]] = n;
+        bin_len[r - row_l]++;
+      }
+    }
+  }
+
+  tfree(bin_len);
+
+  *bin_start_ptr = bin_start;
+  *bin_ptr = bin;
+}
+
+/*--------------------------------------------------------------------------
+ * TINCastLineRow:
+ *   Intersect triangle n with the lines a_lower..a_upper of one row of
+ *   lines in the given direction and add the new intersections to
+ *   row_lines (indexed from a_first).
+ *--------------------------------------------------------------------------*/
+
+static void TINCastLineRow(
+                           GeomTIN *    solid,
+                           int          n,
+                           int          direction,
+                           double       a_origin,
+                           double       da_lines,
+                           int          a_lower,
+                           int          a_upper,
+                           int          a_first,
+                           double       b_center,
+                           ListMember **row_lines)
+{
+  GeomTriangle *triangle = GeomTINTriangle(solid, n);
+  GeomVertex   *v0 = GeomTINVertex(solid, GeomTriangleV0(triangle));
+  GeomVertex   *v1 = GeomTINVertex(solid, GeomTriangleV1(triangle));
+  GeomVertex   *v2 = GeomTINVertex(solid, GeomTriangleV2(triangle));
+
+  ListMember   *current_member;
+  double point;
+  int intersects, component;
+  int a;
+
+  for (a = a_lower; a <= a_upper; a++)
+  {
+    IntersectLineWithTriangle(direction, a_origin + a * da_lines, b_center,
+                              GeomVertexX(v0), GeomVertexY(v0), GeomVertexZ(v0),
+                              GeomVertexX(v1), GeomVertexY(v1), GeomVertexZ(v1),
+                              GeomVertexX(v2), GeomVertexY(v2), GeomVertexZ(v2),
+                              &intersects, &point, &component);
+    if (intersects)
+    {
+      if (ListValueNormalComponentSearch(row_lines[a - a_first],
+                                         point, component) == NULL)
+      {
+        current_member = NewListMember(point, component, n);
+        ListInsert(&row_lines[a - a_first], current_member);
+      }
+    }
+  }
+}
+
 /*--------------------------------------------------------------------------
  * GrGeomOctreeFromTIN
  *--------------------------------------------------------------------------*/
@@ -560,10 +742,8 @@ void GrGeomOctreeFromTIN(
   GrGeomOctree  *solid_octree;
   GrGeomOctree **patch_octrees;
 
-  GeomTriangle  *triangle;
-  GeomVertex    *vertex;
   ListMember  ***xy_lines, ***xz_lines, ***yz_lines;
-  ListMember    *current_member, *tmp_member;
+  ListMember    *current_member;
   GrGeomOctree  *grgeom_octree, *grgeom_child, *patch_octree;
   GrGeomExtents *ea_extents;
 
@@ -574,15 +754,7 @@ void GrGeomOctreeFromTIN(
   int ea_size;
   double dx_lines, dy_lines, dz_lines;
 
-  double v0_x, v0_y, v0_z;
-  double v1_x, v1_y, v1_z;
-  double v2_x, v2_y, v2_z;
-  double octree_v0_x, octree_v0_y, octree_v0_z;
-  double octree_v1_x, octree_v1_y, octree_v1_z;
-  double octree_v2_x, octree_v2_y, octree_v2_z;
-  double tbox_x_lower, tbox_x_upper;
-  double tbox_y_lower, tbox_y_upper;
-  double tbox_z_lower, tbox_z_upper;
+  int           *triangle_lines, *bin_start, *bin;
 
   int nx, ny, nz;
   // SGS there is an error here dz, nz are not being initialized correctly in second loop
@@ -591,12 +763,11 @@ void GrGeomOctreeFromTIN(
   int ix_lower, iy_lower, iz_lower;
   int ix_upper, iy_upper, iz_upper;
   int index;
-  int intersects, component, state, start_state;
+  int component, state, start_state;
 
   double x_lower, y_lower, z_lower;
   double x_center, y_center, z_center;
   double x_upper, y_upper, z_upper;
-  double point;
 
   int p, i, j, k, ie, m, n, level, new_level;
   int iprime, jprime, kprime, ic, t, face_index = 0;
@@ -741,146 +912,91 @@ void GrGeomOctreeFromTIN(
 
   /*-------------------------------------------------------------
    * Find all unique line intersections
+   *
+   * The triangles are binned by the rows of lines their bounding
+   * boxes cover (xy lines by y row, xz and yz lines by z row).
+   * Every line belongs to exactly one row, so the rows can be cast
+   * independently.  Bins hold the triangles in increasing order,
+   * which gives the same line lists as casting triangle by triangle.
    *-------------------------------------------------------------*/
 
+  triangle_lines = talloc(int, 6 * num_triangles);
+
   for (n = 0; n < num_triangles; n++)
+    TINTriangleLineBounds(solid, n, xlower, ylower, zlower,
+                          dx_lines, dy_lines, dz_lines, num_indices,
+                          &triangle_lines[6 * n]);
+
+  for (ie = 0; ie < ea_size; ie++)
   {
-    /* Get the triangle */
-    triangle = GeomTINTriangle(solid, n);
-
-    /* Get bounds on the cover for the coordinates of vertex 0 */
-    vertex = GeomTINVertex(solid, GeomTriangleV0(triangle));
-    v0_x = GeomVertexX(vertex);
-    v0_y = GeomVertexY(vertex);
-    v0_z = GeomVertexZ(vertex);
-    octree_v0_x = (v0_x - xlower) / dx_lines;
-    octree_v0_y = (v0_y - ylower) / dy_lines;
-    octree_v0_z = (v0_z - zlower) / dz_lines;
-
-    /* Get bounds on the cover for the coordinates of vertex 1 */
-    vertex = GeomTINVertex(solid, GeomTriangleV1(triangle));
-    v1_x = GeomVertexX(vertex);
-    v1_y = GeomVertexY(vertex);
-    v1_z = GeomVertexZ(vertex);
-    octree_v1_x = (v1_x - xlower) / dx_lines;
-    octree_v1_y = (v1_y - ylower) / dy_lines;
-    octree_v1_z = (v1_z - zlower) / dz_lines;
-
-    /* Get bounds on the cover for the coordinates of vertex 2 */
-    vertex = GeomTINVertex(solid, GeomTriangleV2(triangle));
-    v2_x = GeomVertexX(vertex);
-    v2_y = GeomVertexY(vertex);
-    v2_z = GeomVertexZ(vertex);
-    octree_v2_x = (v2_x - xlower) / dx_lines;
-    octree_v2_y = (v2_y - ylower) / dy_lines;
-    octree_v2_z = (v2_z - zlower) / dz_lines;
-
-    /* Get overall bounds for the vertices */
-    tbox_x_lower = pfmin(pfmin(octree_v0_x, octree_v1_x), octree_v2_x);
-    tbox_y_lower = pfmin(pfmin(octree_v0_y, octree_v1_y), octree_v2_y);
-    tbox_z_lower = pfmin(pfmin(octree_v0_z, octree_v1_z), octree_v2_z);
-    tbox_x_upper = pfmax(pfmax(octree_v0_x, octree_v1_x), octree_v2_x);
-    tbox_y_upper = pfmax(pfmax(octree_v0_y, octree_v1_y), octree_v2_y);
-    tbox_z_upper = pfmax(pfmax(octree_v0_z, octree_v1_z), octree_v2_z);
-
-    /* This is to avoid integer overflow below */
-    tbox_x_lower = pfmin(tbox_x_lower, 2 * num_indices);
-    tbox_y_lower = pfmin(tbox_y_lower, 2 * num_indices);
-    tbox_z_lower = pfmin(tbox_z_lower, 2 * num_indices);
-    tbox_x_upper = pfmax(tbox_x_upper, -1);
-    tbox_y_upper = pfmax(tbox_y_upper, -1);
-    tbox_z_upper = pfmax(tbox_z_upper, -1);
-
-    for (ie = 0; ie < ea_size; ie++)
+    /* xy lines, one row per y line */
+    TINBinTriangles(num_triangles, triangle_lines,
+                    1, iyl_lines[ie], iyu_lines[ie],
+                    0, ixl_lines[ie], ixu_lines[ie],
+                    0, 0, -1,
+                    &bin_start, &bin);
+
+#ifdef PARFLOW_HAVE_OMP
+    #pragma omp parallel for private(i, j, k, n) schedule(dynamic)
+#endif
+    for (j = iyl_lines[ie]; j <= iyu_lines[ie]; j++)
     {
-      /* Intersect bounds with xyz_lines extents */
-      ix_lower = (int)floor((double)pfmax(tbox_x_lower, ixl_lines[ie]));
-      iy_lower = (int)floor((double)pfmax(tbox_y_lower, iyl_lines[ie]));
-      iz_lower = (int)floor((double)pfmax(tbox_z_lower, izl_lines[ie]));
-      ix_upper = (int)ceil((double)pfmin(tbox_x_upper, ixu_lines[ie]));
-      iy_upper = (int)ceil((double)pfmin(tbox_y_upper, iyu_lines[ie]));
-      iz_upper = (int)ceil((double)pfmin(tbox_z_upper, izu_lines[ie]));
-
-      for (j = iy_lower; j <= iy_upper; j++)
+      for (k = bin_start[j - iyl_lines[ie]];
+           k < bin_start[j - iyl_lines[ie] + 1]; k++)
       {
-        for (i = ix_lower; i <= ix_upper; i++)
-        {
-          x_center = xlower + i * dx_lines;
-          y_center = ylower + j * dy_lines;
-          IntersectLineWithTriangle(ZDIRECTION, x_center, y_center,
-                                    v0_x, v0_y, v0_z,
-                                    v1_x, v1_y, v1_z,
-                                    v2_x, v2_y, v2_z,
-                                    &intersects, &point, &component);
-          if (intersects)
-          {
-            iprime = i - ixl_lines[ie];
-            jprime = j - iyl_lines[ie];
-            index = iprime + jprime * nx_lines[ie];
-            tmp_member = ListValueNormalComponentSearch(xy_lines[ie][index], point, component);
-            if (tmp_member == NULL)
-            {
-              current_member = NewListMember(point, component, n);
-              ListInsert(&xy_lines[ie][index], current_member);
-            }
-          }
-        }
+        n = bin[k];
+        TINCastLineRow(solid, n, ZDIRECTION,
+                       xlower, dx_lines,
+                       pfmax(triangle_lines[6 * n], ixl_lines[ie]),
+                       pfmin(triangle_lines[6 * n + 3], ixu_lines[ie]),
+                       ixl_lines[ie],
+                       ylower + j * dy_lines,
+                       &xy_lines[ie][(j - iyl_lines[ie]) * nx_lines[ie]]);
       }
+    }
 
-      for (k = iz_lower; k <= iz_upper; k++)
-      {
-        for (i = ix_lower; i <= ix_upper; i++)
-        {
-          x_center = xlower + i * dx_lines;
-          z_center = zlower + k * dz_lines;
-          IntersectLineWithTriangle(YDIRECTION, x_center, z_center,
-                                    v0_x, v0_y, v0_z,
-                                    v1_x, v1_y, v1_z,
-                                    v2_x, v2_y, v2_z,
-                                    &intersects, &point, &component);
-          if (intersects)
-          {
-            iprime = i - ixl_lines[ie];
-            kprime = k - izl_lines[ie];
-            index = iprime + kprime * nx_lines[ie];
-            tmp_member = ListValueNormalComponentSearch(xz_lines[ie][index], point, component);
-            if (tmp_member == NULL)
-            {
-              current_member = NewListMember(point, component, n);
-              ListInsert(&xz_lines[ie][index], current_member);
-            }
-          }
-        }
-      }
+    tfree(bin_start);
+    tfree(bin);
 
-      for (k = iz_lower; k <= iz_upper; k++)
+    /* xz and yz lines, one row per z line */
+    TINBinTriangles(num_triangles, triangle_lines,
+                    2, izl_lines[ie], izu_lines[ie],
+                    0, ixl_lines[ie], ixu_lines[ie],
+                    1, iyl_lines[ie], iyu_lines[ie],
+                    &bin_start, &bin);
+
+#ifdef PARFLOW_HAVE_OMP
+    #pragma omp parallel for private(i, j, k, n) schedule(dynamic)
+#endif
+    for (k = izl_lines[ie]; k <= izu_lines[ie]; k++)
+    {
+      for (i = bin_start[k - izl_lines[ie]];
+           i < bin_start[k - izl_lines[ie] + 1]; i++)
       {
-        for (j = iy_lower; j <= iy_upper; j++)
-        {
-          y_center = ylower + j * dy_lines;
-          z_center = zlower + k * dz_lines;
-          IntersectLineWithTriangle(XDIRECTION, y_center, z_center,
-                                    v0_x, v0_y, v0_z,
-                                    v1_x, v1_y, v1_z,
-                                    v2_x, v2_y, v2_z,
-                                    &intersects, &point, &component);
-          if (intersects)
-          {
-            jprime = j - iyl_lines[ie];
-            kprime = k - izl_lines[ie];
-            index = jprime + kprime * ny_lines[ie];
-            tmp_member = ListValueNormalComponentSearch(yz_lines[ie][index], point, component);
-            if (tmp_member == NULL)
-            {
-              current_member = NewListMember(point, component, n);
-              ListInsert(&yz_lines[ie][index], current_member);
-            }
-          }
-        }
+        n = bin[i];
+        TINCastLineRow(solid, n, YDIRECTION,
+                       xlower, dx_lines,
+                       pfmax(triangle_lines[6 * n], ixl_lines[ie]),
+                       pfmin(triangle_lines[6 * n + 3], ixu_lines[ie]),
+                       ixl_lines[ie],
+                       zlower + k * dz_lines,
+                       &xz_lines[ie][(k - izl_lines[ie]) * nx_lines[ie]]);
+        TINCastLineRow(solid, n, XDIRECTION,
+                       ylower, dy_lines,
+                       pfmax(triangle_lines[6 * n + 1], iyl_lines[ie]),
+                       pfmin(triangle_lines[6 * n + 4], iyu_lines[ie]),
+                       iyl_lines[ie],
+                       zlower + k * dz_lines,
+                       &yz_lines[ie][(k - izl_lines[ie]) * ny_lines[ie]]);
       }
     }
+
+    tfree(bin_start);
+    tfree(bin);
   }
 
+  tfree(triangle_lines);
+
   /*-------------------------------------------------------------
    * Create the octree, by first adding the boundary faces
    *-------------------------------------------------------------*/
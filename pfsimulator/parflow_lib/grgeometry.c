@@ -269,17 +269,18 @@ GrGeomExtentArray  *GrGeomCreateExtentArray(
 
 
 /*--------------------------------------------------------------------------
- * GrGeomNewSolid
+ * GrGeomAllocSolid:
+ *   Creates a solid without computing its iteration boxes.
  *--------------------------------------------------------------------------*/
 
-GrGeomSolid   *GrGeomNewSolid(
-                              GrGeomOctree * data,
-                              GrGeomOctree **patches,
-                              int            num_patches,
-                              int            octree_bg_level,
-                              int            octree_ix,
-                              int            octree_iy,
-                              int            octree_iz)
+GrGeomSolid   *GrGeomAllocSolid(
+                                GrGeomOctree * data,
+                                GrGeomOctree **patches,
+                                int            num_patches,
+                                int            octree_bg_level,
+                                int            octree_ix,
+                                int            octree_iy,
+                                int            octree_iz)
 {
   GrGeomSolid   *new_grgeomsolid;
 
@@ -321,6 +322,29 @@ GrGeomSolid   *GrGeomNewSolid(
     }
   }
 
+  return new_grgeomsolid;
+}
+
+
+/*--------------------------------------------------------------------------
+ * GrGeomNewSolid
+ *--------------------------------------------------------------------------*/
+
+GrGeomSolid   *GrGeomNewSolid(
+                              GrGeomOctree * data,
+                              GrGeomOctree **patches,
+                              int            num_patches,
+                              int            octree_bg_level,
+                              int            octree_ix,
+                              int            octree_iy,
+                              int            octree_iz)
+{
+  GrGeomSolid   *new_grgeomsolid;
+
+  new_grgeomsolid = GrGeomAllocSolid(data, patches, num_patches,
+                                     octree_bg_level,
+                                     octree_ix, octree_iy, octree_iz);
+
   if (GlobalsUseClustering)
   {
     ComputeBoxes(new_grgeomsolid);
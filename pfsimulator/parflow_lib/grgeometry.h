@@ -44,6 +44,9 @@
 
 typedef int GrGeomExtents[6];
 
+/* Initial value of the keys used to validate the geometry cache */
+#define GrGeomCacheHashInit  14695981039346656037ULL
+
 typedef struct {
   GrGeomExtents  *extents;
   int size;
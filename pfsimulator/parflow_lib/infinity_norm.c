@@ -55,11 +55,6 @@ double  InfinityNorm(
 
   int i_s, i, j, k, iv;
 
-  amps_Invoice result_invoice;
-
-
-  result_invoice = amps_NewInvoice("%d", &infinity_norm);
-
   infinity_norm = 0.0;
 
   ForSubgridI(i_s, GridSubgrids(grid))
@@ -92,9 +87,7 @@ double  InfinityNorm(
     });
   }
 
-  amps_AllReduce(amps_CommWorld, result_invoice, amps_Max);
-
-  amps_FreeInvoice(result_invoice);
+  amps_AllReduceDoubles(amps_CommWorld, &infinity_norm, 1, amps_Max);
 
   return infinity_norm;
 }
@@ -52,9 +52,6 @@ double   InnerProd(
 
   int i_s, i, j, k, iv;
 
-  amps_Invoice result_invoice;
-  result_invoice = amps_NewInvoice("%d", &result);
-
   ForSubgridI(i_s, GridSubgrids(grid))
   {
     subgrid = GridSubgrid(grid, i_s);
@@ -87,9 +84,7 @@ double   InnerProd(
     });
   }
 
-  amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
-
-  amps_FreeInvoice(result_invoice);
+  amps_AllReduceDoubles(amps_CommWorld, &result, 1, amps_Add);
 
   IncFLOPCount(2 * VectorSize(x) - 1);
 
@@ -124,8 +124,10 @@ int  KINSolInitPC(
   /* The preconditioner module initialized here is the KinsolPC module
    * itself */
 
+  TelemetryBeginPhase(TelemetryPCSetupPhase);
   PFModuleReNewInstanceType(KinsolPCInitInstanceXtraInvoke, precond, (NULL, NULL, problem_data, NULL,
                                                                       pressure, old_pressure, saturation, density, dt, time));
+  TelemetryEndPhase(TelemetryPCSetupPhase);
   return(0);
 }
 
@@ -161,7 +163,9 @@ int   KINSolCallPC(
   /* The preconditioner module invoked here is the KinsolPC module
    * itself */
 
+  TelemetryBeginPhase(TelemetryPCApplyPhase);
   PFModuleInvokeType(KinsolPCInvoke, precond, (vtem));
+  TelemetryEndPhase(TelemetryPCApplyPhase);
 
   return(0);
 }
@@ -197,7 +201,7 @@ void PrintFinalStats(
  * KinsolNonlinSolver
  *--------------------------------------------------------------------------*/
 
-int KinsolNonlinSolver(Vector *pressure, Vector *density, Vector *old_density, Vector *saturation, Vector *old_saturation, double t, double dt, ProblemData *problem_data, Vector *old_pressure, Vector *evap_trans, Vector *ovrl_bc_flx, Vector *x_velocity, Vector *y_velocity, Vector *z_velocity)
+int KinsolNonlinSolver(Vector *pressure, Vector *density, Vector *old_density, Vector *saturation, Vector *old_saturation, double t, double dt, ProblemData *problem_data, Vector *old_pressure, Vector *evap_trans, Vector *ovrl_bc_flx, Vector *x_velocity, Vector *y_velocity, Vector *z_velocity, int *nonlin_iters, int *lin_iters)
 {
   PFModule     *this_module = ThisPFModule;
   PublicXtra   *public_xtra = (PublicXtra*)PFModulePublicXtra(this_module);
@@ -273,6 +277,8 @@ int KinsolNonlinSolver(Vector *pressure, Vector *density, Vector *old_density, V
 
   EndTiming(public_xtra->time_index);
 
+  TelemetrySetResidualNorm(ropt[FNORM]);
+
   integer_outputs[NNI] += iopt[NNI];
   integer_outputs[NFE] += iopt[NFE];
   integer_outputs[NBCF] += iopt[NBCF];
@@ -282,6 +288,12 @@ int KinsolNonlinSolver(Vector *pressure, Vector *density, Vector *old_density, V
   integer_outputs[SPGMR_NPS] += iopt[SPGMR_NPS];
   integer_outputs[SPGMR_NCFL] += iopt[SPGMR_NCFL];
 
+  /* Iteration counts of this solve, used for time step control */
+  if (nonlin_iters)
+    (*nonlin_iters) = (int)iopt[NNI];
+  if (lin_iters)
+    (*lin_iters) = (int)iopt[SPGMR_NLI];
+
   if (!amps_Rank(amps_CommWorld))
     PrintFinalStats(kinsol_file, iopt, integer_outputs);
 
@@ -151,6 +151,8 @@ void PrintVersionInfo(FILE *log_file)
   fprintf(log_file, "\tWith acc backend: CUDA+RMM\n");
 #elif defined(PARFLOW_HAVE_OMP)
   fprintf(log_file, "\tWith acc backend: OMP\n");
+#elif defined(PARFLOW_HAVE_SIMD)
+  fprintf(log_file, "\tWith acc backend: SIMD\n");
 #endif
 
 }
@@ -695,6 +695,16 @@ void FreeMatrix(
       tfree_amps(submatrix->data);
     }
 
+    if (SubmatrixInterleaved(submatrix))
+    {
+      tfree_amps(SubmatrixInterleaved(submatrix));
+    }
+
+    if (SubmatrixSingle(submatrix))
+    {
+      tfree_amps(SubmatrixSingle(submatrix));
+    }
+
     tfree(submatrix->data_index);
     tfree(submatrix);
   }
@@ -740,6 +750,9 @@ void    InitMatrix(
   int i, j, k;
 
 
+  /* The interleaved copy no longer matches */
+  MatrixInterleaved(A) = 0;
+
   subgrids = GridSubgrids(grid);
   ForSubgridI(is, subgrids)
   {
@@ -773,3 +786,151 @@ void    InitMatrix(
     }
   }
 }
+
+
+/*--------------------------------------------------------------------------
+ * MatrixInterleave:
+ *   Copy the coefficients of A into a cell-major layout so that Matvec
+ *   streams one array per cell instead of one plane per stencil entry.
+ *   The copy is a snapshot as large as the coefficients themselves.
+ *   Only InitMatrix marks it stale; a caller that writes coefficients
+ *   through SubmatrixStencilData after interleaving must call this
+ *   routine again.  Matrices that share coefficients between symmetric
+ *   stencil entries are left alone.
+ *--------------------------------------------------------------------------*/
+
+void    MatrixInterleave(
+                         Matrix *A)
+{
+  Grid       *grid = MatrixGrid(A);
+
+  Submatrix  *A_sub;
+  double     *Ap;
+  double     *Ip;
+
+  int stencil_size = StencilSize(MatrixStencil(A));
+
+  int is, s, m, n, data_size;
+
+
+  if (MatrixDataStencilSize(A) != stencil_size)
+    return;
+
+  ForSubgridI(is, GridSubgrids(grid))
+  {
+    A_sub = MatrixSubmatrix(A, is);
+
+    n = SubmatrixSize(A_sub);
+    data_size = n * stencil_size;
+
+    if (!SubmatrixInterleaved(A_sub))
+      SubmatrixInterleaved(A_sub) = talloc_amps(double, data_size);
+
+    Ip = SubmatrixInterleaved(A_sub);
+    for (s = 0; s < stencil_size; s++)
+    {
+      Ap = SubmatrixStencilData(A_sub, s);
+      for (m = 0; m < n; m++)
+        Ip[m * stencil_size + s] = Ap[m];
+    }
+  }
+
+  MatrixInterleaved(A) = 1;
+}
+
+
+/*--------------------------------------------------------------------------
+ * MatrixSinglePrecision:
+ *   Round the coefficients of A into single precision storage with the
+ *   same layout and release the double precision data, along with the
+ *   communication package bound to it, so the matrix takes half the
+ *   memory.  The smoothers, Matvec and the MGSemi transfer operators then
+ *   read the single precision coefficients; arithmetic is still done in
+ *   double precision.  MatrixDoublePrecision undoes this before the
+ *   coefficients are computed again.
+ *--------------------------------------------------------------------------*/
+
+void    MatrixSinglePrecision(
+                              Matrix *A)
+{
+  Grid       *grid = MatrixGrid(A);
+
+  Submatrix  *A_sub;
+  double     *Ap;
+  float      *Sp;
+
+  int is, m, data_size;
+
+
+  ForSubgridI(is, GridSubgrids(grid))
+  {
+    A_sub = MatrixSubmatrix(A, is);
+
+    data_size = A_sub->data_size;
+
+    if (!SubmatrixSingle(A_sub))
+      SubmatrixSingle(A_sub) = talloc_amps(float, data_size);
+
+    Ap = SubmatrixData(A_sub);
+    Sp = SubmatrixSingle(A_sub);
+    for (m = 0; m < data_size; m++)
+      Sp[m] = (float)Ap[m];
+
+    if (A_sub->allocated)
+    {
+      tfree_amps(SubmatrixData(A_sub));
+      SubmatrixData(A_sub) = NULL;
+      A_sub->allocated = FALSE;
+    }
+  }
+
+  if (MatrixCommPkg(A))
+  {
+    FreeCommPkg(MatrixCommPkg(A));
+    MatrixCommPkg(A) = NULL;
+  }
+
+  MatrixSingle(A) = 1;
+}
+
+
+/*--------------------------------------------------------------------------
+ * MatrixDoublePrecision:
+ *   Give a matrix stored in single precision zeroed double precision data
+ *   again, with a communication package for the `ghost' stencil (as in
+ *   NewMatrix), and release the single precision coefficients.
+ *--------------------------------------------------------------------------*/
+
+void    MatrixDoublePrecision(
+                              Matrix * A,
+                              Stencil *ghost)
+{
+  Grid       *grid = MatrixGrid(A);
+
+  Submatrix  *A_sub;
+
+  int is;
+
+
+  if (!MatrixSingle(A))
+    return;
+
+  ForSubgridI(is, GridSubgrids(grid))
+  {
+    A_sub = MatrixSubmatrix(A, is);
+
+    if (!SubmatrixData(A_sub))
+    {
+      SubmatrixData(A_sub) = ctalloc_amps(double, A_sub->data_size);
+      A_sub->allocated = TRUE;
+    }
+
+    tfree_amps(SubmatrixSingle(A_sub));
+    SubmatrixSingle(A_sub) = NULL;
+  }
+
+  if (ghost)
+    MatrixCommPkg(A) = NewMatrixUpdatePkg(A, ghost);
+
+  MatrixSingle(A) = 0;
+}
@@ -72,6 +72,15 @@ typedef struct {
 
   int data_size;               /* Size of data */
 
+  double*    interleaved;      /* Cell-major copy of the coefficients,
+                                * stencil_size values per cell (see
+                                * MatrixInterleave) */
+
+  float*     single;           /* Single precision coefficients, same
+                                * layout as data, which is released
+                                * while they are in use (see
+                                * MatrixSinglePrecision) */
+
   Subregion* data_space;
 } Submatrix;
 
@@ -96,6 +105,11 @@ typedef struct {
 
   int size;                        /* Total number of nonzero coefficients */
 
+  int interleaved;                 /* Are the interleaved copies current? */
+
+  int single;                      /* Are the coefficients stored in
+                                    * single precision? */
+
   CommPkg          *comm_pkg;      /* Information on how to update boundary */
 
   enum matrix_type type;
@@ -128,6 +142,12 @@ typedef struct {
 
 #define SubmatrixDataSpace(submatrix)  ((submatrix)->data_space)
 
+#define SubmatrixInterleaved(submatrix) ((submatrix)->interleaved)
+
+#define SubmatrixSingle(submatrix) ((submatrix)->single)
+#define SubmatrixStencilSingle(submatrix, s) \
+  (((submatrix)->single) + ((submatrix)->data_index[s]))
+
 #define SubmatrixIX(submatrix)   (SubregionIX(SubmatrixDataSpace(submatrix)))
 #define SubmatrixIY(submatrix)   (SubregionIY(SubmatrixDataSpace(submatrix)))
 #define SubmatrixIZ(submatrix)   (SubregionIZ(SubmatrixDataSpace(submatrix)))
@@ -153,6 +173,15 @@ typedef struct {
 #define SubmatrixSize(submatrix) SubmatrixNX((submatrix)) * SubmatrixNY((submatrix)) * \
   SubmatrixNZ((submatrix))
 
+/* Coefficients of the cell (x,y,z) in the interleaved copy */
+#define SubmatrixInterleavedElt(submatrix, stencil_size, x, y, z) \
+  (SubmatrixInterleaved(submatrix) +                              \
+   (stencil_size) * SubmatrixEltIndex(submatrix, x, y, z))
+
+/* Single precision counterpart of SubmatrixElt */
+#define SubmatrixSingleElt(submatrix, s, x, y, z) \
+  (SubmatrixStencilSingle(submatrix, s) + SubmatrixEltIndex(submatrix, x, y, z))
+
 
 /*--------------------------------------------------------------------------
  * Accessor functions for the Matrix structure
@@ -174,7 +203,27 @@ typedef struct {
 
 #define MatrixSize(matrix)        ((matrix)->size)
 
+#define MatrixInterleaved(matrix) ((matrix)->interleaved)
+
+#define MatrixSingle(matrix)      ((matrix)->single)
+
 #define MatrixCommPkg(matrix)     ((matrix)->comm_pkg)
 
+/*--------------------------------------------------------------------------
+ * Runs the macro kernel(type, elt) with the type the coefficients of
+ * matrix A are stored in and the matching element accessor, so a kernel
+ * has one body for double and single precision coefficients.
+ *--------------------------------------------------------------------------*/
+
+#define MatrixPrecisionSwitch(A, kernel) \
+  if (MatrixSingle(A))                   \
+  {                                      \
+    kernel(float, SubmatrixSingleElt);   \
+  }                                      \
+  else                                   \
+  {                                      \
+    kernel(double, SubmatrixElt);        \
+  }
+
 
 #endif
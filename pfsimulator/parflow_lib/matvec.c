@@ -33,6 +33,168 @@
 
 #include "parflow.h"
 
+/*--------------------------------------------------------------------------
+ * MatvecBox: y += A*x on one box.
+ *
+ * The 7-point stencil is applied in a single sweep, so y is read and
+ * written once per cell instead of once per stencil entry.  The
+ * coefficients are taken from the interleaved (cell-major) copy of A when
+ * it is current, otherwise from the coefficient planes in the precision A
+ * is stored in.  The per-cell sum is accumulated in stencil order, as in
+ * the plane-by-plane loop, so the result does not depend on the path
+ * taken.
+ *--------------------------------------------------------------------------*/
+
+/* y += A x for the 7-point stencil, coefficients of type T */
+#define MatvecBox7Point(T, Elt)                      \
+  {                                                  \
+    T *a0 = Elt(A_sub, 0, ix, iy, iz);               \
+    T *a1 = Elt(A_sub, 1, ix, iy, iz);               \
+    T *a2 = Elt(A_sub, 2, ix, iy, iz);               \
+    T *a3 = Elt(A_sub, 3, ix, iy, iz);               \
+    T *a4 = Elt(A_sub, 4, ix, iy, iz);               \
+    T *a5 = Elt(A_sub, 5, ix, iy, iz);               \
+    T *a6 = Elt(A_sub, 6, ix, iy, iz);               \
+                                                     \
+    vi = 0; mi = 0;                                  \
+    BoxLoopI2(i, j, k,                               \
+              ix, iy, iz, nx, ny, nz,                \
+              vi, nx_v, ny_v, nz_v, sx, sy, sz,      \
+              mi, nx_m, ny_m, nz_m, 1, 1, 1,         \
+    {                                                \
+      double sum = yp[vi];                           \
+                                                     \
+      sum += a0[mi] * x0[vi];                        \
+      sum += a1[mi] * x1[vi];                        \
+      sum += a2[mi] * x2[vi];                        \
+      sum += a3[mi] * x3[vi];                        \
+      sum += a4[mi] * x4[vi];                        \
+      sum += a5[mi] * x5[vi];                        \
+      sum += a6[mi] * x6[vi];                        \
+      yp[vi] = sum;                                  \
+    });                                              \
+  }
+
+/* y += A_si x_si for one stencil entry si, coefficients of type T */
+#define MatvecBoxPlane(T, Elt)                       \
+  {                                                  \
+    T *ap = Elt(A_sub, si, ix, iy, iz);              \
+                                                     \
+    vi = 0; mi = 0;                                  \
+    BoxLoopI2(i, j, k,                               \
+              ix, iy, iz, nx, ny, nz,                \
+              vi, nx_v, ny_v, nz_v, sx, sy, sz,      \
+              mi, nx_m, ny_m, nz_m, 1, 1, 1,         \
+    {                                                \
+      yp[vi] += ap[mi] * xp[vi];                     \
+    });                                              \
+  }
+
+static void     MatvecBox(
+                          Matrix *   A,
+                          Submatrix *A_sub,
+                          Subvector *x_sub,
+                          Subvector *y_sub,
+                          int        ix,
+                          int        iy,
+                          int        iz,
+                          int        nx,
+                          int        ny,
+                          int        nz,
+                          int        sx,
+                          int        sy,
+                          int        sz)
+{
+  Stencil        *stencil = MatrixStencil(A);
+  int stencil_size = StencilSize(stencil);
+  StencilElt     *s = StencilShape(stencil);
+
+  double         *ap;
+  double         *xp;
+  double         *yp;
+
+  int nx_v = SubvectorNX(y_sub);
+  int ny_v = SubvectorNY(y_sub);
+  int nz_v = SubvectorNZ(y_sub);
+
+  int nx_m = SubmatrixNX(A_sub);
+  int ny_m = SubmatrixNY(A_sub);
+  int nz_m = SubmatrixNZ(A_sub);
+
+  int si, i, j, k, vi, mi;
+
+
+  yp = SubvectorElt(y_sub, ix, iy, iz);
+
+  if (stencil_size == 7)
+  {
+    double *x0 = SubvectorElt(x_sub, ix + s[0][0], iy + s[0][1], iz + s[0][2]);
+    double *x1 = SubvectorElt(x_sub, ix + s[1][0], iy + s[1][1], iz + s[1][2]);
+    double *x2 = SubvectorElt(x_sub, ix + s[2][0], iy + s[2][1], iz + s[2][2]);
+    double *x3 = SubvectorElt(x_sub, ix + s[3][0], iy + s[3][1], iz + s[3][2]);
+    double *x4 = SubvectorElt(x_sub, ix + s[4][0], iy + s[4][1], iz + s[4][2]);
+    double *x5 = SubvectorElt(x_sub, ix + s[5][0], iy + s[5][1], iz + s[5][2]);
+    double *x6 = SubvectorElt(x_sub, ix + s[6][0], iy + s[6][1], iz + s[6][2]);
+
+    if (MatrixInterleaved(A))
+    {
+      ap = SubmatrixInterleavedElt(A_sub, 7, ix, iy, iz);
+
+      vi = 0; mi = 0;
+      BoxLoopI2(i, j, k,
+                ix, iy, iz, nx, ny, nz,
+                vi, nx_v, ny_v, nz_v, sx, sy, sz,
+                mi, nx_m, ny_m, nz_m, 1, 1, 1,
+      {
+        const double *a = ap + 7 * mi;
+        double sum = yp[vi];
+
+        sum += a[0] * x0[vi];
+        sum += a[1] * x1[vi];
+        sum += a[2] * x2[vi];
+        sum += a[3] * x3[vi];
+        sum += a[4] * x4[vi];
+        sum += a[5] * x5[vi];
+        sum += a[6] * x6[vi];
+        yp[vi] = sum;
+      });
+    }
+    else
+    {
+      MatrixPrecisionSwitch(A, MatvecBox7Point);
+    }
+
+    return;
+  }
+
+  for (si = 0; si < stencil_size; si++)
+  {
+    xp = SubvectorElt(x_sub,
+                      (ix + s[si][0]),
+                      (iy + s[si][1]),
+                      (iz + s[si][2]));
+
+    if (MatrixInterleaved(A))
+    {
+      ap = SubmatrixInterleavedElt(A_sub, stencil_size, ix, iy, iz) + si;
+
+      vi = 0; mi = 0;
+      BoxLoopI2(i, j, k,
+                ix, iy, iz, nx, ny, nz,
+                vi, nx_v, ny_v, nz_v, sx, sy, sz,
+                mi, nx_m, ny_m, nz_m, 1, 1, 1,
+      {
+        yp[vi] += ap[stencil_size * mi] * xp[vi];
+      });
+    }
+    else
+    {
+      MatrixPrecisionSwitch(A, MatvecBoxPlane);
+    }
+  }
+}
+
+
 /*--------------------------------------------------------------------------
  * Matvec
  *--------------------------------------------------------------------------*/
@@ -60,26 +222,19 @@ void            Matvec(
   Subvector      *x_sub = NULL;
   Submatrix      *A_sub = NULL;
 
-  Stencil        *stencil;
-  int stencil_size;
-  StencilElt     *s;
-
-  int compute_i, sg, sra, sr, si, i, j, k;
+  int compute_i, sg, sra, sr, i, j, k;
 
   double temp;
 
-  double         *ap;
-  double         *xp;
   double         *yp;
 
-  int vi, mi;
+  int vi;
 
   int ix, iy, iz;
   int nx, ny, nz;
   int sx, sy, sz;
 
   int nx_v = 0, ny_v = 0, nz_v = 0;
-  int nx_m = 0, ny_m = 0, nz_m = 0;
 
   /*-----------------------------------------------------------------------
    * Begin timing
@@ -251,10 +406,6 @@ void            Matvec(
         nx_v = SubvectorNX(y_sub);
         ny_v = SubvectorNY(y_sub);
         nz_v = SubvectorNZ(y_sub);
-
-        nx_m = SubmatrixNX(A_sub);
-        ny_m = SubmatrixNY(A_sub);
-        nz_m = SubmatrixNZ(A_sub);
       }
 
       /*-----------------------------------------------------------------
@@ -277,29 +428,8 @@ void            Matvec(
         sy = SubregionSY(subregion);
         sz = SubregionSZ(subregion);
 
-        stencil = MatrixStencil(A);
-        stencil_size = StencilSize(stencil);
-        s = StencilShape(stencil);
-
-        yp = SubvectorElt(y_sub, ix, iy, iz);
-
-        for (si = 0; si < stencil_size; si++)
-        {
-          xp = SubvectorElt(x_sub,
-                            (ix + s[si][0]),
-                            (iy + s[si][1]),
-                            (iz + s[si][2]));
-          ap = SubmatrixElt(A_sub, si, ix, iy, iz);
-
-          vi = 0; mi = 0;
-          BoxLoopI2(i, j, k,
-                    ix, iy, iz, nx, ny, nz,
-                    vi, nx_v, ny_v, nz_v, sx, sy, sz,
-                    mi, nx_m, ny_m, nz_m, 1, 1, 1,
-          {
-            yp[vi] += ap[mi] * xp[vi];
-          });
-        }
+        MatvecBox(A, A_sub, x_sub, y_sub,
+                  ix, iy, iz, nx, ny, nz, sx, sy, sz);
 
         if (alpha != 1.0)
         {
@@ -367,14 +497,13 @@ void            MatvecSubMat(
   Submatrix      *JC_sub = NULL;
 
   Stencil        *stencil;
-  int stencil_size;
   StencilElt     *s;
 
   int compute_i, sra, sr, si, sg, i, j, k;
 
   double temp;
 
-  double         *bp, *cp;
+  double         *cp;
   double         *xp;
   double         *yp;
 
@@ -387,7 +516,6 @@ void            MatvecSubMat(
   int sx, sy, sz;
 
   int nx_v = 0, ny_v = 0, nz_v = 0;
-  int nx_m = 0, ny_m = 0, nz_m = 0;
   int nx_mc = 0, ny_mc = 0, nz_mc = 0;
 
   /*-----------------------------------------------------------------------
@@ -567,10 +695,6 @@ void            MatvecSubMat(
         ny_v = SubvectorNY(y_sub);
         nz_v = SubvectorNZ(y_sub);
 
-        nx_m = SubmatrixNX(JB_sub);
-        ny_m = SubmatrixNY(JB_sub);
-        nz_m = SubmatrixNZ(JB_sub);
-
         nx_mc = SubmatrixNX(JC_sub);
         ny_mc = SubmatrixNY(JC_sub);
         nz_mc = SubmatrixNZ(JC_sub);
@@ -594,29 +718,10 @@ void            MatvecSubMat(
         sz = SubregionSZ(subregion);
 
         stencil = MatrixStencil(JB);
-        stencil_size = StencilSize(stencil);
         s = StencilShape(stencil);
 
-        yp = SubvectorElt(y_sub, ix, iy, iz);
-
-        for (si = 0; si < stencil_size; si++)
-        {
-          xp = SubvectorElt(x_sub,
-                            (ix + s[si][0]),
-                            (iy + s[si][1]),
-                            (iz + s[si][2]));
-          bp = SubmatrixElt(JB_sub, si, ix, iy, iz);
-
-          vi = 0; mi = 0;
-
-          BoxLoopI2(i, j, k,
-                    ix, iy, iz, nx, ny, nz,
-                    vi, nx_v, ny_v, nz_v, sx, sy, sz,
-                    mi, nx_m, ny_m, nz_m, 1, 1, 1,
-          {
-            yp[vi] += bp[mi] * xp[vi];
-          });
-        }
+        MatvecBox(JB, JB_sub, x_sub, y_sub,
+                  ix, iy, iz, nx, ny, nz, sx, sy, sz);
 
 	/* Now compute matvec contributions from JC */
         yp = SubvectorData(y_sub);
@@ -45,6 +45,9 @@ typedef struct {
   int max_levels;
   int min_NX, min_NY, min_NZ;
 
+  int single_precision;        /* store coarse and transfer operators
+                                * in single precision? */
+
   int time_index;
 } PublicXtra;
 
@@ -439,7 +442,8 @@ void              SetupCoarseOps(
                                  Matrix **        P_l,
                                  int              num_levels,
                                  SubregionArray **f_sra_l,
-                                 SubregionArray **c_sra_l)
+                                 SubregionArray **c_sra_l,
+                                 int              single_precision)
 {
   SubregionArray *subregion_array;
 
@@ -480,6 +484,17 @@ void              SetupCoarseOps(
 
   for (l = 0; l <= (num_levels - 2); l++)
   {
+    /*--------------------------------------------------------------
+     * In single precision the operators of a level have double
+     * precision data only while they are computed
+     *--------------------------------------------------------------*/
+
+    if (single_precision)
+    {
+      MatrixDoublePrecision(P_l[l], MatrixStencil(P_l[l]));
+      MatrixDoublePrecision(A_l[l + 1], MatrixStencil(A_l[l + 1]));
+    }
+
     /*--------------------------------------------------------------
      * Align prolongation stencil with matrix stencil
      *--------------------------------------------------------------*/
@@ -739,6 +754,21 @@ void              SetupCoarseOps(
         });
       }
     }
+
+    /*--------------------------------------------------------------------
+     * Round the operators no longer needed to single precision; the
+     * fine grid matrix is left alone, so the residual handed back to
+     * the outer solver is always computed in double precision
+     *--------------------------------------------------------------------*/
+
+    if (single_precision)
+    {
+      MatrixSinglePrecision(P_l[l]);
+      if (l > 0)
+        MatrixSinglePrecision(A_l[l]);
+      if (l == (num_levels - 2))
+        MatrixSinglePrecision(A_l[l + 1]);
+    }
   }
 
 #if 0
@@ -1098,7 +1128,8 @@ PFModule     *MGSemiInitInstanceXtra(
                    (instance_xtra->P_l),
                    (instance_xtra->num_levels),
                    (instance_xtra->f_sra_l),
-                   (instance_xtra->c_sra_l));
+                   (instance_xtra->c_sra_l),
+                   (public_xtra->single_precision));
   }
 
   /*-----------------------------------------------------------------------
@@ -1250,6 +1281,7 @@ PFModule   *MGSemiNewPublicXtra(char *name)
   NameArray smoother_na;
 
   NameArray coarse_solve_na;
+  NameArray switch_na;
 
   public_xtra = talloc(PublicXtra, 1);
 
@@ -1324,6 +1356,31 @@ PFModule   *MGSemiNewPublicXtra(char *name)
   sprintf(key, "%s.MaxMinNZ", name);
   public_xtra->min_NZ = GetIntDefault(key, 1);
 
+  switch_na = NA_NewNameArray("False True");
+  sprintf(key, "%s.SinglePrecision", name);
+  switch_name = GetStringDefault(key, "False");
+  switch_value = NA_NameToIndexExitOnError(switch_na, switch_name, key);
+  switch (switch_value)
+  {
+    case 0:
+    {
+      public_xtra->single_precision = 0;
+      break;
+    }
+
+    case 1:
+    {
+      public_xtra->single_precision = 1;
+      break;
+    }
+
+    default:
+    {
+      InputError("Invalid switch value <%s> for key <%s>", switch_name, key);
+    }
+  }
+  NA_FreeNameArray(switch_na);
+
   (public_xtra->time_index) = RegisterTiming("MGSemi");
 
   PFModulePublicXtra(this_module) = public_xtra;
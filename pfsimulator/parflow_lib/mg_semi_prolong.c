@@ -32,6 +32,26 @@
 *****************************************************************************/
 #include "parflow.h"
 
+/*--------------------------------------------------------------------------
+ * Interpolation of the fine points of a subregion for coefficients of P of
+ * type T, see MatrixPrecisionSwitch.
+ *--------------------------------------------------------------------------*/
+
+#define MGSemiProlongLoop(T, Elt)                              \
+  {                                                            \
+    T *p1 = Elt(P_sub, 0, ix, iy, iz);                         \
+    T *p2 = Elt(P_sub, 1, ix, iy, iz);                         \
+                                                               \
+    BoxLoopI2(ii, jj, kk, ix, iy, iz, nx, ny, nz,              \
+              i_c, nx_c, ny_c, nz_c, 1, 1, 1,                  \
+              i_f, nx_f, ny_f, nz_f, sx, sy, sz,               \
+    {                                                          \
+      e_fp[i_f] = (p1[i_c] * e_fp[i_f - stride] +              \
+                   p2[i_c] * e_fp[i_f + stride]);              \
+    });                                                        \
+  }
+
+
 /*--------------------------------------------------------------------------
  * MGSemiProlong
  *--------------------------------------------------------------------------*/
@@ -59,7 +79,6 @@ void             MGSemiProlong(
 
   double         *e_fp, *e_cp;
 
-  double         *p1, *p2;
 
   int ix, iy, iz;
   int nx, ny, nz;
@@ -183,18 +202,9 @@ void             MGSemiProlong(
 
         e_fp = SubvectorElt(e_f_sub, ix, iy, iz);
 
-        p1 = SubmatrixElt(P_sub, 0, ix, iy, iz);
-        p2 = SubmatrixElt(P_sub, 1, ix, iy, iz);
-
         i_c = 0;
         i_f = 0;
-        BoxLoopI2(ii, jj, kk, ix, iy, iz, nx, ny, nz,
-                  i_c, nx_c, ny_c, nz_c, 1, 1, 1,
-                  i_f, nx_f, ny_f, nz_f, sx, sy, sz,
-        {
-          e_fp[i_f] = (p1[i_c] * e_fp[i_f - stride] +
-                       p2[i_c] * e_fp[i_f + stride]);
-        });
+        MatrixPrecisionSwitch(P, MGSemiProlongLoop);
       }
     }
   }
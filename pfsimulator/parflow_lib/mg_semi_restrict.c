@@ -33,6 +33,28 @@
 
 #include "parflow.h"
 
+/*--------------------------------------------------------------------------
+ * Restriction to the coarse points of a subregion for coefficients of P of
+ * type T, see MatrixPrecisionSwitch.
+ *--------------------------------------------------------------------------*/
+
+#define MGSemiRestrictLoop(T, Elt)                                        \
+  {                                                                       \
+    T *p1 = Elt(P_sub, 1, (ix + s[0][0]), (iy + s[0][1]), (iz + s[0][2])); \
+    T *p2 = Elt(P_sub, 0, (ix + s[1][0]), (iy + s[1][1]), (iz + s[1][2])); \
+                                                                          \
+    BoxLoopI3(ii, jj, kk, ix, iy, iz, nx, ny, nz,                         \
+              i_p, nx_p, ny_p, nz_p, 1, 1, 1,                             \
+              i_c, nx_c, ny_c, nz_c, 1, 1, 1,                             \
+              i_f, nx_f, ny_f, nz_f, sx, sy, sz,                          \
+    {                                                                     \
+      r_cp[i_c] =                                                         \
+        r_fp[i_f] + (p1[i_p] * r_fp[i_f - stride] +                       \
+                     p2[i_p] * r_fp[i_f + stride]);                       \
+    });                                                                   \
+  }
+
+
 /*--------------------------------------------------------------------------
  * MGSemiRestrict
  *--------------------------------------------------------------------------*/
@@ -62,7 +84,6 @@ void             MGSemiRestrict(
 
   double         *r_fp, *r_cp;
 
-  double         *p1, *p2;
 
   int ix, iy, iz;
   int nx, ny, nz;
@@ -150,23 +171,10 @@ void             MGSemiRestrict(
 
         s = StencilShape(MatrixStencil(P));
 
-        p1 = SubmatrixElt(P_sub, 1,
-                          (ix + s[0][0]), (iy + s[0][1]), (iz + s[0][2]));
-        p2 = SubmatrixElt(P_sub, 0,
-                          (ix + s[1][0]), (iy + s[1][1]), (iz + s[1][2]));
-
         i_p = 0;
         i_c = 0;
         i_f = 0;
-        BoxLoopI3(ii, jj, kk, ix, iy, iz, nx, ny, nz,
-                  i_p, nx_p, ny_p, nz_p, 1, 1, 1,
-                  i_c, nx_c, ny_c, nz_c, 1, 1, 1,
-                  i_f, nx_f, ny_f, nz_f, sx, sy, sz,
-        {
-          r_cp[i_c] =
-            r_fp[i_f] + (p1[i_p] * r_fp[i_f - stride] +
-                         p2[i_p] * r_fp[i_f + stride]);
-        });
+        MatrixPrecisionSwitch(P, MGSemiRestrictLoop);
       }
     }
   }
@@ -55,6 +55,9 @@ typedef struct {
   PFModule     *overlandflow_module;  //DOK
   PFModule     *overlandflow_module_diff;  //@RMM
   PFModule     *overlandflow_module_kin;
+
+  /* 2D work vectors of the overland flow, set up on first use */
+  Vector       *KW, *KE, *KN, *KS, *qx, *qy;
 } InstanceXtra;
 
 /*---------------------------------------------------------------------
@@ -221,6 +224,7 @@ void NlFunctionEval(Vector *     pressure, /* Current pressure values */
 
   VectorUpdateCommHandle  *handle;
 
+  TelemetryBeginPhase(TelemetryFunctionEvalPhase);
   BeginTiming(public_xtra->time_index);
 
   /* Initialize function values to zero. */
@@ -238,12 +242,29 @@ void NlFunctionEval(Vector *     pressure, /* Current pressure values */
   handle = InitVectorUpdate(pressure, VectorUpdateAll);
   FinalizeVectorUpdate(handle);
 
-  KW = NewVectorType(grid2d, 1, 1, vector_cell_centered_2D);
-  KE = NewVectorType(grid2d, 1, 1, vector_cell_centered_2D);
-  KN = NewVectorType(grid2d, 1, 1, vector_cell_centered_2D);
-  KS = NewVectorType(grid2d, 1, 1, vector_cell_centered_2D);
-  qx = NewVectorType(grid2d, 1, 1, vector_cell_centered_2D);
-  qy = NewVectorType(grid2d, 1, 1, vector_cell_centered_2D);
+  if ((instance_xtra->KW) == NULL)
+  {
+    (instance_xtra->KW) = NewVectorType(grid2d, 1, 1, vector_cell_centered_2D);
+    (instance_xtra->KE) = NewVectorType(grid2d, 1, 1, vector_cell_centered_2D);
+    (instance_xtra->KN) = NewVectorType(grid2d, 1, 1, vector_cell_centered_2D);
+    (instance_xtra->KS) = NewVectorType(grid2d, 1, 1, vector_cell_centered_2D);
+    (instance_xtra->qx) = NewVectorType(grid2d, 1, 1, vector_cell_centered_2D);
+    (instance_xtra->qy) = NewVectorType(grid2d, 1, 1, vector_cell_centered_2D);
+  }
+  KW = (instance_xtra->KW);
+  KE = (instance_xtra->KE);
+  KN = (instance_xtra->KN);
+  KS = (instance_xtra->KS);
+  qx = (instance_xtra->qx);
+  qy = (instance_xtra->qy);
+
+  /* Start from zero, ghost layer included, like newly allocated vectors */
+  InitVectorAll(KW, 0.0);
+  InitVectorAll(KE, 0.0);
+  InitVectorAll(KN, 0.0);
+  InitVectorAll(KS, 0.0);
+  InitVectorAll(qx, 0.0);
+  InitVectorAll(qy, 0.0);
 
   /* Calculate pressure dependent properties: density and saturation */
 
@@ -2193,13 +2214,7 @@ void NlFunctionEval(Vector *     pressure, /* Current pressure values */
                                                              time, pressure, CALCFCN));
 
   EndTiming(public_xtra->time_index);
-
-  FreeVector(KW);
-  FreeVector(KE);
-  FreeVector(KN);
-  FreeVector(KS);
-  FreeVector(qx);
-  FreeVector(qy);
+  TelemetryEndPhase(TelemetryFunctionEvalPhase);
 
   POP_NVTX
 
@@ -2207,6 +2222,21 @@ void NlFunctionEval(Vector *     pressure, /* Current pressure values */
 }
 
 
+/*--------------------------------------------------------------------------
+ * FreeNlFunctionEvalWorkVectors
+ *--------------------------------------------------------------------------*/
+
+static void FreeNlFunctionEvalWorkVectors(InstanceXtra *instance_xtra)
+{
+  FreeVector(instance_xtra->KW);
+  FreeVector(instance_xtra->KE);
+  FreeVector(instance_xtra->KN);
+  FreeVector(instance_xtra->KS);
+  FreeVector(instance_xtra->qx);
+  FreeVector(instance_xtra->qy);
+  (instance_xtra->KW) = NULL;
+}
+
 /*--------------------------------------------------------------------------
  * NlFunctionEvalInitInstanceXtra
  *--------------------------------------------------------------------------*/
@@ -2219,7 +2249,6 @@ PFModule    *NlFunctionEvalInitInstanceXtra(Problem *problem,
   PFModule      *this_module = ThisPFModule;
   InstanceXtra  *instance_xtra;
 
-  (void)grid;
   (void)temp_data;
 
   if (PFModuleInstanceXtra(this_module) == NULL)
@@ -2227,6 +2256,12 @@ PFModule    *NlFunctionEvalInitInstanceXtra(Problem *problem,
   else
     instance_xtra = (InstanceXtra*)PFModuleInstanceXtra(this_module);
 
+  /* The work vectors are set up again for a new grid */
+  if (grid != NULL && (instance_xtra->KW) != NULL)
+  {
+    FreeNlFunctionEvalWorkVectors(instance_xtra);
+  }
+
   if (problem != NULL)
   {
     (instance_xtra->problem) = problem;
@@ -2301,6 +2336,11 @@ void  NlFunctionEvalFreeInstanceXtra()
     PFModuleFreeInstance(instance_xtra->overlandflow_module_diff);      //@RMM
     PFModuleFreeInstance(instance_xtra->overlandflow_module_kin);
 
+    if ((instance_xtra->KW) != NULL)
+    {
+      FreeNlFunctionEvalWorkVectors(instance_xtra);
+    }
+
     tfree(instance_xtra);
   }
 }
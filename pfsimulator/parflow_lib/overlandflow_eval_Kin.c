@@ -32,15 +32,83 @@
  * Structures
  *--------------------------------------------------------------------------*/
 
-typedef void PublicXtra;
+typedef struct {
+  double ov_epsilon;
+  int cache_coefficients;
+} PublicXtra;
+
+typedef struct {
+  /* 1 / (n sqrt(|Sf|)) of the top faces, set up on the first evaluation */
+  Vector *face_coeff;
 
-typedef void InstanceXtra;
+  /* top cells of the patches, set up on the first evaluation */
+  Surface *surface;
+} InstanceXtra;
 
 /*---------------------------------------------------------------------
  * Define macros for function evaluation
  *---------------------------------------------------------------------*/
 #define RPMean(a, b, c, d)   UpstreamMean(a, b, c, d)
 
+/*-------------------------------------------------------------------------
+ * NewFaceCoefficients: the time invariant part of the kinematic wave flux,
+ * 1 / (n sqrt(|Sf|)), of every cell of the 2D grid including its ghost layer
+ *-------------------------------------------------------------------------*/
+
+static Vector *NewFaceCoefficients(ProblemData *problem_data, double ov_epsilon)
+{
+  Vector      *slope_x = ProblemDataTSlopeX(problem_data);
+  Vector      *slope_y = ProblemDataTSlopeY(problem_data);
+  Vector      *mannings = ProblemDataMannings(problem_data);
+  Grid        *grid2d = VectorGrid(slope_x);
+
+  Vector      *face_coeff;
+
+  Subvector   *sx_sub, *sy_sub, *mann_sub, *fc_sub;
+  double      *sx_dat, *sy_dat, *mann_dat, *fc_dat;
+
+  int ix, iy, iz, nx, ny, nz;
+  int is, i, j, k, io;
+
+  face_coeff = NewVectorType(grid2d, 1, 1, vector_cell_centered_2D);
+
+  ForSubgridI(is, GridSubgrids(grid2d))
+  {
+    sx_sub = VectorSubvector(slope_x, is);
+    sy_sub = VectorSubvector(slope_y, is);
+    mann_sub = VectorSubvector(mannings, is);
+    fc_sub = VectorSubvector(face_coeff, is);
+
+    sx_dat = SubvectorData(sx_sub);
+    sy_dat = SubvectorData(sy_sub);
+    mann_dat = SubvectorData(mann_sub);
+    fc_dat = SubvectorData(fc_sub);
+
+    ix = SubvectorIX(fc_sub);
+    iy = SubvectorIY(fc_sub);
+    iz = SubvectorIZ(fc_sub);
+
+    nx = SubvectorNX(fc_sub);
+    ny = SubvectorNY(fc_sub);
+    nz = SubvectorNZ(fc_sub);
+
+    io = 0;
+    BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
+              io, nx, ny, nz, 1, 1, 1,
+    {
+      double Sf_mag = sqrt(sx_dat[io] * sx_dat[io] + sy_dat[io] * sy_dat[io]);
+      if (Sf_mag < ov_epsilon)
+        Sf_mag = ov_epsilon;
+
+      /* A zero Manning's n gives inf, so the flux is inf or NaN as in the
+       * uncached evaluation; ghost cells outside the domain are not used */
+      fc_dat[io] = 1.0 / (sqrt(Sf_mag) * mann_dat[io]);
+    });
+  }
+
+  return face_coeff;
+}
+
 /*-------------------------------------------------------------------------
  * OverlandFlowEval
  *-------------------------------------------------------------------------*/
@@ -67,6 +135,10 @@ void    OverlandFlowEvalKin(
                                                 * fcn = CALCDER => calculate the function
                                                 *                  derivative */
 {
+  PFModule      *this_module = ThisPFModule;
+  PublicXtra    *public_xtra = (PublicXtra*)PFModulePublicXtra(this_module);
+  InstanceXtra  *instance_xtra = (InstanceXtra*)PFModuleInstanceXtra(this_module);
+
   Vector      *slope_x = ProblemDataTSlopeX(problem_data);
   Vector      *slope_y = ProblemDataTSlopeY(problem_data);
   Vector      *mannings = ProblemDataMannings(problem_data);
@@ -74,12 +146,16 @@ void    OverlandFlowEvalKin(
 
   Subvector     *sx_sub, *sy_sub, *mann_sub, *top_sub, *p_sub;
 
-  double        *sx_dat, *sy_dat, *mann_dat, *top_dat, *pp;
+  double        *sx_dat, *sy_dat, *mann_dat, *pp;
+  double        *fc_dat = NULL;
 
-  double ov_epsilon;
+  SurfacePatch  *surface_patch;
+  SurfaceCells  *cells, *interior;
+  int           *index2d, *itop, *ieast, *inorth, *flags;
+
+  double ov_epsilon = (public_xtra->ov_epsilon);
 
-  int i, j, k, ival=0, sy_v;
-  PF_UNUSED(ival);
+  int n, sy_v, sz_p;
 
   p_sub = VectorSubvector(pressure, sg);
 
@@ -93,233 +169,206 @@ void    OverlandFlowEvalKin(
   sx_dat = SubvectorData(sx_sub);
   sy_dat = SubvectorData(sy_sub);
   mann_dat = SubvectorData(mann_sub);
-  top_dat = SubvectorData(top_sub);
 
   sy_v = SubvectorNX(top_sub);
+  sz_p = SubvectorNX(p_sub) * SubvectorNY(p_sub);
 
-  //ov_epsilon= 1.0e-5;
-  ov_epsilon = GetDoubleDefault("Solver.OverlandKinematic.Epsilon", 1.0e-5);
+  /* With cached coefficients the flux is -Sf * fc * h^(5/3) */
+  if (public_xtra->cache_coefficients)
+  {
+    if (instance_xtra->face_coeff == NULL)
+    {
+      instance_xtra->face_coeff = NewFaceCoefficients(problem_data, ov_epsilon);
+    }
+    fc_dat = SubvectorData(VectorSubvector(instance_xtra->face_coeff, sg));
+  }
+
+  if (instance_xtra->surface == NULL)
+  {
+    instance_xtra->surface = NewSurface(bc_struct);
+  }
+  surface_patch = SurfaceGetPatch(instance_xtra->surface, bc_struct, ipatch, sg,
+                                  top, p_sub);
+  cells = SurfacePatchCells(surface_patch);
+  interior = SurfacePatchInterior(surface_patch);
 
+  index2d = SurfaceCellsIndex2D(cells);
+  itop = SurfaceCellsTop(cells);
+  ieast = SurfaceCellsEast(cells);
+  inorth = SurfaceCellsNorth(cells);
+  flags = SurfaceCellsFlags(cells);
 
   if (fcn == CALCFCN)
   {
-    ForPatchCellsPerFaceWithGhost(BC_ALL,
-                                  BeforeAllCells(DoNothing),
-                                  LoopVars(i, j, k, ival, bc_struct, ipatch, sg),
-                                  Locals(int io, itop, ip, ipp1, ippsy;
-                                         int k1, k0x, k0y, k1x, k1y;
-                                         double Sf_x, Sf_y, Sf_mag;
-                                         double Press_x, Press_y;),
-                                  CellSetup(DoNothing),
-                                  FACE(LeftFace, DoNothing), FACE(RightFace, DoNothing),
-                                  FACE(DownFace, DoNothing), FACE(UpFace, DoNothing),
-                                  FACE(BackFace, DoNothing),
-                                  FACE(FrontFace,
-                                  {
-                                    io = SubvectorEltIndex(sx_sub, i, j, 0);
-                                    itop = SubvectorEltIndex(top_sub, i, j, 0);
-
-                                    k1 = (int)top_dat[itop];
-                                    k0x = (int)top_dat[itop - 1];
-                                    k0y = (int)top_dat[itop - sy_v];
-                                    k1x = pfmax((int)top_dat[itop + 1],0);
-                                    k1y = pfmax((int)top_dat[itop + sy_v],0);
-
-                                    if (k1 >= 0)
-                                    {
-                                      ip = SubvectorEltIndex(p_sub, i, j, k1);
-                                      Sf_x = sx_dat[io];
-                                      Sf_y = sy_dat[io];
-                                      ipp1 = (int)SubvectorEltIndex(p_sub, i+1, j, k1x);
-                                      ippsy = (int)SubvectorEltIndex(p_sub, i, j+1, k1y);
-
-                                      Sf_mag = RPowerR(Sf_x * Sf_x + Sf_y * Sf_y, 0.5);
-                                      if (Sf_mag < ov_epsilon)
-                                        Sf_mag = ov_epsilon;
-
-                                      Press_x = RPMean(-Sf_x, 0.0,
-                                                       pfmax((pp[ip]), 0.0),
-                                                       pfmax((pp[ipp1]), 0.0));
-                                      Press_y = RPMean(-Sf_y, 0.0,
-                                                       pfmax((pp[ip]), 0.0),
-                                                       pfmax((pp[ippsy]), 0.0));
-
-                                      qx_v[io] = -(Sf_x / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io]))
-                                                 * RPowerR(Press_x, (5.0 / 3.0));
-                                      qy_v[io] = -(Sf_y / (RPowerR(fabs(Sf_mag), 0.5)
-                                                           * mann_dat[io])) * RPowerR(Press_y, (5.0 / 3.0));
-                                    }
-
-                                    //fix for lower x boundary
-                                    if (k0x < 0.0)
-                                    {
-                                      if (k1 >= 0.0)
-                                      {
-                                        Sf_x = sx_dat[io];
-                                        Sf_y = sy_dat[io];
-
-                                        double Sf_mag = RPowerR(Sf_x * Sf_x + Sf_y * Sf_y, 0.5);
-                                        if (Sf_mag < ov_epsilon)
-                                          Sf_mag = ov_epsilon;
-
-                                        if (Sf_x > 0.0)
-                                        {
-                                          ip = SubvectorEltIndex(p_sub, i, j, k1);
-                                          Press_x = pfmax((pp[ip]), 0.0);
-                                          qx_v[io - 1] = -(Sf_x / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_x, (5.0 / 3.0));
-                                        }
-                                      }
-                                    }
-
-                                    //fix for lower y boundary
-                                    if (k0y < 0.0)
-                                    {
-                                      if (k1 >= 0.0)
-                                      {
-                                        Sf_x = sx_dat[io];
-                                        Sf_y = sy_dat[io];
-
-                                        double Sf_mag = RPowerR(Sf_x * Sf_x + Sf_y * Sf_y, 0.5);
-                                        if (Sf_mag < ov_epsilon)
-                                          Sf_mag = ov_epsilon;
-
-                                        if (Sf_y > 0.0)
-                                        {
-                                          ip = SubvectorEltIndex(p_sub, i, j, k1);
-                                          Press_y = pfmax((pp[ip]), 0.0);
-                                          qy_v[io - sy_v] = -(Sf_y / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_y, (5.0 / 3.0));
-                                        }
-                                      }
-                                    }
-                                  }),
-                                  CellFinalize(DoNothing),
-                                  AfterAllCells(DoNothing)
-      );
-
-    ForPatchCellsPerFace(BC_ALL,
-                         BeforeAllCells(DoNothing),
-                         LoopVars(i, j, k, ival, bc_struct, ipatch, sg),
-                         Locals(int io;),
-                         CellSetup(DoNothing),
-                         FACE(LeftFace, DoNothing), FACE(RightFace, DoNothing),
-                         FACE(DownFace, DoNothing), FACE(UpFace, DoNothing),
-                         FACE(BackFace, DoNothing),
-                         FACE(FrontFace,
-                         {
-                           io = SubvectorEltIndex(sx_sub, i, j, 0);
-                           ke_v[io] = qx_v[io];
-                           kw_v[io] = qx_v[io - 1];
-                           kn_v[io] = qy_v[io];
-                           ks_v[io] = qy_v[io - sy_v];
-                         }),
-                         CellFinalize(DoNothing),
-                         AfterAllCells(DoNothing)
-      );
+    SurfaceCellLoop(n, cells,
+    {
+      int io = index2d[n];
+      int ip = itop[n];
+
+      /* The flux of the face to an inactive column uses its k = 0 cell */
+      int ipp1 = ieast[n] + ((flags[n] & SurfaceEastInactive) ? sz_p : 0);
+      int ippsy = inorth[n] + ((flags[n] & SurfaceNorthInactive) ? sz_p : 0);
+
+      double Sf_x = sx_dat[io];
+      double Sf_y = sy_dat[io];
+      double Sf_mag;
+      double Press_x;
+      double Press_y;
+
+      Press_x = RPMean(-Sf_x, 0.0,
+                       pfmax((pp[ip]), 0.0),
+                       pfmax((pp[ipp1]), 0.0));
+      Press_y = RPMean(-Sf_y, 0.0,
+                       pfmax((pp[ip]), 0.0),
+                       pfmax((pp[ippsy]), 0.0));
+
+      if (fc_dat)
+      {
+        qx_v[io] = -Sf_x * fc_dat[io] * PowerFiveThirds(Press_x);
+        qy_v[io] = -Sf_y * fc_dat[io] * PowerFiveThirds(Press_y);
+      }
+      else
+      {
+        Sf_mag = RPowerR(Sf_x * Sf_x + Sf_y * Sf_y, 0.5);
+        if (Sf_mag < ov_epsilon)
+          Sf_mag = ov_epsilon;
+
+        qx_v[io] = -(Sf_x / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io]))
+                   * RPowerR(Press_x, (5.0 / 3.0));
+        qy_v[io] = -(Sf_y / (RPowerR(fabs(Sf_mag), 0.5)
+                             * mann_dat[io])) * RPowerR(Press_y, (5.0 / 3.0));
+      }
+
+      //fix for lower x boundary
+      if (flags[n] & SurfaceWestInactive)
+      {
+        Sf_mag = RPowerR(Sf_x * Sf_x + Sf_y * Sf_y, 0.5);
+        if (Sf_mag < ov_epsilon)
+          Sf_mag = ov_epsilon;
+
+        if (Sf_x > 0.0)
+        {
+          Press_x = pfmax((pp[ip]), 0.0);
+          if (fc_dat)
+            qx_v[io - 1] = -Sf_x * fc_dat[io] * PowerFiveThirds(Press_x);
+          else
+            qx_v[io - 1] = -(Sf_x / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_x, (5.0 / 3.0));
+        }
+      }
+
+      //fix for lower y boundary
+      if (flags[n] & SurfaceSouthInactive)
+      {
+        Sf_mag = RPowerR(Sf_x * Sf_x + Sf_y * Sf_y, 0.5);
+        if (Sf_mag < ov_epsilon)
+          Sf_mag = ov_epsilon;
+
+        if (Sf_y > 0.0)
+        {
+          Press_y = pfmax((pp[ip]), 0.0);
+          if (fc_dat)
+            qy_v[io - sy_v] = -Sf_y * fc_dat[io] * PowerFiveThirds(Press_y);
+          else
+            qy_v[io - sy_v] = -(Sf_y / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_y, (5.0 / 3.0));
+        }
+      }
+    });
+
+    index2d = SurfaceCellsIndex2D(interior);
+    SurfaceCellLoop(n, interior,
+    {
+      int io = index2d[n];
+
+      ke_v[io] = qx_v[io];
+      kw_v[io] = qx_v[io - 1];
+      kn_v[io] = qy_v[io];
+      ks_v[io] = qy_v[io - sy_v];
+    });
   }
   else          //fcn = CALCDER calculates the derivs
   {
-    ForPatchCellsPerFaceWithGhost(BC_ALL,
-                                  BeforeAllCells(DoNothing),
-                                  LoopVars(i, j, k, ival, bc_struct, ipatch, sg),
-                                  Locals(int io, itop, ip, ipp1, ippsy;
-                                         int k1, k0x, k0y, k1x, k1y;
-                                         double Sf_x, Sf_y, Sf_mag;
-                                         double Press_x, Press_y, qx_temp, qy_temp;),
-                                  CellSetup(DoNothing),
-                                  FACE(LeftFace, DoNothing), FACE(RightFace, DoNothing),
-                                  FACE(DownFace, DoNothing), FACE(UpFace, DoNothing),
-                                  FACE(BackFace, DoNothing),
-                                  FACE(FrontFace,
-                                  {
-                                    io = SubvectorEltIndex(sx_sub, i, j, 0);
-                                    itop = SubvectorEltIndex(top_sub, i, j, 0);
-
-                                    k1 = (int)top_dat[itop];
-                                    k0x = (int)top_dat[itop - 1];
-                                    k0y = (int)top_dat[itop - sy_v];
-                                    k1x = (int)top_dat[itop + 1];
-                                    k1y = (int)top_dat[itop + sy_v];
-
-                                    if (k1 >= 0)
-                                    {
-                                      ip = SubvectorEltIndex(p_sub, i, j, k1);
-                                      ipp1 = (int)SubvectorEltIndex(p_sub, i+1, j, k1x);
-                                      ippsy = (int)SubvectorEltIndex(p_sub, i, j+1, k1y);
-
-                                      Sf_x = sx_dat[io];
-                                      Sf_y = sy_dat[io];
-
-                                      Sf_mag = RPowerR(Sf_x * Sf_x + Sf_y * Sf_y, 0.5);
-                                      if (Sf_mag < ov_epsilon)
-                                        Sf_mag = ov_epsilon;
-
-                                      Press_x = RPMean(-Sf_x, 0.0,
-                                                       pfmax((pp[ip]), 0.0),
-                                                       pfmax((pp[ipp1]), 0.0));
-                                      Press_y = RPMean(-Sf_y, 0.0,
-                                                       pfmax((pp[ip]), 0.0),
-                                                       pfmax((pp[ippsy]), 0.0));
-
-                                      qx_temp = -(5.0 / 3.0) * (Sf_x / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_x, (2.0 / 3.0));
-                                      qy_temp = -(5.0 / 3.0) * (Sf_y / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_y, (2.0 / 3.0));
-
-                                      ke_v[io] = pfmax(qx_temp, 0);
-                                      kw_v[io + 1] = -pfmax(-qx_temp, 0);
-                                      kn_v[io] = pfmax(qy_temp, 0);
-                                      ks_v[io + sy_v] = -pfmax(-qy_temp, 0);
-                                    }
-
-                                    //fix for lower x boundary
-                                    if (k0x < 0.0)
-                                    {
-                                      if (k1 >= 0.0)
-                                      {
-                                        Sf_x = sx_dat[io];
-                                        Sf_y = sy_dat[io];
-
-                                        double Sf_mag = RPowerR(Sf_x * Sf_x + Sf_y * Sf_y, 0.5);
-                                        if (Sf_mag < ov_epsilon)
-                                          Sf_mag = ov_epsilon;
-
-                                        if (Sf_x > 0.0)
-                                        {
-                                          ip = SubvectorEltIndex(p_sub, i, j, k1);
-                                          Press_x = pfmax((pp[ip]), 0.0);
-                                          qx_temp = -(5.0 / 3.0) * (Sf_x / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_x, (2.0 / 3.0));
-
-                                          kw_v[io] = qx_temp;
-                                          ke_v[io - 1] = qx_temp;
-                                        }
-                                      }
-                                    }
-
-                                    //fix for lower y boundary
-                                    if (k0y < 0.0)
-                                    {
-                                      if (k1 >= 0.0)
-                                      {
-                                        Sf_x = sx_dat[io];
-                                        Sf_y = sy_dat[io];
-
-                                        double Sf_mag = RPowerR(Sf_x * Sf_x + Sf_y * Sf_y, 0.5);  //+ov_epsilon;
-                                        if (Sf_mag < ov_epsilon)
-                                          Sf_mag = ov_epsilon;
-
-                                        if (Sf_y > 0.0)
-                                        {
-                                          ip = SubvectorEltIndex(p_sub, i, j, k1);
-                                          Press_y = pfmax((pp[ip]), 0.0);
-                                          qy_temp = -(5.0 / 3.0) * (Sf_y / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_y, (2.0 / 3.0));
-
-                                          ks_v[io] = qy_temp;
-                                          kn_v[io - sy_v] = qy_temp;
-                                        }
-                                      }
-                                    }
-                                  }),
-                                  CellFinalize(DoNothing),
-                                  AfterAllCells(DoNothing)
-      );
+    SurfaceCellLoop(n, cells,
+    {
+      int io = index2d[n];
+      int ip = itop[n];
+      int ipp1 = ieast[n];
+      int ippsy = inorth[n];
+
+      double Sf_x = sx_dat[io];
+      double Sf_y = sy_dat[io];
+      double Sf_mag;
+      double Press_x;
+      double Press_y;
+      double qx_temp;
+      double qy_temp;
+
+      Press_x = RPMean(-Sf_x, 0.0,
+                       pfmax((pp[ip]), 0.0),
+                       pfmax((pp[ipp1]), 0.0));
+      Press_y = RPMean(-Sf_y, 0.0,
+                       pfmax((pp[ip]), 0.0),
+                       pfmax((pp[ippsy]), 0.0));
+
+      if (fc_dat)
+      {
+        qx_temp = -(5.0 / 3.0) * Sf_x * fc_dat[io] * PowerTwoThirds(Press_x);
+        qy_temp = -(5.0 / 3.0) * Sf_y * fc_dat[io] * PowerTwoThirds(Press_y);
+      }
+      else
+      {
+        Sf_mag = RPowerR(Sf_x * Sf_x + Sf_y * Sf_y, 0.5);
+        if (Sf_mag < ov_epsilon)
+          Sf_mag = ov_epsilon;
+
+        qx_temp = -(5.0 / 3.0) * (Sf_x / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_x, (2.0 / 3.0));
+        qy_temp = -(5.0 / 3.0) * (Sf_y / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_y, (2.0 / 3.0));
+      }
+
+      ke_v[io] = pfmax(qx_temp, 0);
+      kw_v[io + 1] = -pfmax(-qx_temp, 0);
+      kn_v[io] = pfmax(qy_temp, 0);
+      ks_v[io + sy_v] = -pfmax(-qy_temp, 0);
+
+      //fix for lower x boundary
+      if (flags[n] & SurfaceWestInactive)
+      {
+        Sf_mag = RPowerR(Sf_x * Sf_x + Sf_y * Sf_y, 0.5);
+        if (Sf_mag < ov_epsilon)
+          Sf_mag = ov_epsilon;
+
+        if (Sf_x > 0.0)
+        {
+          Press_x = pfmax((pp[ip]), 0.0);
+          if (fc_dat)
+            qx_temp = -(5.0 / 3.0) * Sf_x * fc_dat[io] * PowerTwoThirds(Press_x);
+          else
+            qx_temp = -(5.0 / 3.0) * (Sf_x / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_x, (2.0 / 3.0));
+
+          kw_v[io] = qx_temp;
+          ke_v[io - 1] = qx_temp;
+        }
+      }
+
+      //fix for lower y boundary
+      if (flags[n] & SurfaceSouthInactive)
+      {
+        Sf_mag = RPowerR(Sf_x * Sf_x + Sf_y * Sf_y, 0.5);
+        if (Sf_mag < ov_epsilon)
+          Sf_mag = ov_epsilon;
+
+        if (Sf_y > 0.0)
+        {
+          Press_y = pfmax((pp[ip]), 0.0);
+          if (fc_dat)
+            qy_temp = -(5.0 / 3.0) * Sf_y * fc_dat[io] * PowerTwoThirds(Press_y);
+          else
+            qy_temp = -(5.0 / 3.0) * (Sf_y / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_y, (2.0 / 3.0));
+
+          ks_v[io] = qy_temp;
+          kn_v[io - sy_v] = qy_temp;
+        }
+      }
+    });
   }   // else calcder
 }     // function
 
@@ -334,7 +383,22 @@ PFModule  *OverlandFlowEvalKinInitInstanceXtra()
   PFModule      *this_module = ThisPFModule;
   InstanceXtra  *instance_xtra;
 
-  instance_xtra = NULL;
+  if (PFModuleInstanceXtra(this_module) == NULL)
+    instance_xtra = ctalloc(InstanceXtra, 1);
+  else
+    instance_xtra = (InstanceXtra*)PFModuleInstanceXtra(this_module);
+
+  /* The coefficients are set up again on the next evaluation */
+  if (instance_xtra->face_coeff)
+  {
+    FreeVector(instance_xtra->face_coeff);
+    instance_xtra->face_coeff = NULL;
+  }
+  if (instance_xtra->surface)
+  {
+    FreeSurface(instance_xtra->surface);
+    instance_xtra->surface = NULL;
+  }
 
   PFModuleInstanceXtra(this_module) = instance_xtra;
   return this_module;
@@ -352,6 +416,14 @@ void  OverlandFlowEvalKinFreeInstanceXtra()
 
   if (instance_xtra)
   {
+    if (instance_xtra->face_coeff)
+    {
+      FreeVector(instance_xtra->face_coeff);
+    }
+    if (instance_xtra->surface)
+    {
+      FreeSurface(instance_xtra->surface);
+    }
     tfree(instance_xtra);
   }
 }
@@ -365,7 +437,20 @@ PFModule  *OverlandFlowEvalKinNewPublicXtra()
   PFModule      *this_module = ThisPFModule;
   PublicXtra    *public_xtra;
 
-  public_xtra = NULL;
+  char          *switch_name;
+  NameArray switch_na;
+
+  public_xtra = ctalloc(PublicXtra, 1);
+
+  (public_xtra->ov_epsilon) =
+    GetDoubleDefault("Solver.OverlandKinematic.Epsilon", 1.0e-5);
+
+  switch_na = NA_NewNameArray("False True");
+  switch_name = GetStringDefault("Solver.OverlandKinematic.CacheCoefficients", "False");
+  (public_xtra->cache_coefficients) =
+    NA_NameToIndexExitOnError(switch_na, switch_name,
+                              "Solver.OverlandKinematic.CacheCoefficients");
+  NA_FreeNameArray(switch_na);
 
   PFModulePublicXtra(this_module) = public_xtra;
   return this_module;
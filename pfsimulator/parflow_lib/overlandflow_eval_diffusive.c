@@ -45,15 +45,25 @@
  * Structures
  *--------------------------------------------------------------------------*/
 
-typedef void PublicXtra;
+typedef struct {
+  double ov_epsilon;
+  int fast_power;
+} PublicXtra;
 
-typedef void InstanceXtra;
+typedef struct {
+  /* top cells of the patches, set up on the first evaluation */
+  Surface *surface;
+} InstanceXtra;
 
 /*---------------------------------------------------------------------
  * Define macros for function evaluation
  *---------------------------------------------------------------------*/
 #define RPMean(a, b, c, d)   UpstreamMean(a, b, c, d)
 
+/* Depth terms h^(5/3) and h^(2/3) of Manning's equation */
+#define DepthPow53(h)        (fast_power ? PowerFiveThirds(h) : RPowerR((h), (5.0 / 3.0)))
+#define DepthPow23(h)        (fast_power ? PowerTwoThirds(h) : RPowerR((h), (2.0 / 3.0)))
+
 /*-------------------------------------------------------------------------
  * OverlandFlowEval
  *-------------------------------------------------------------------------*/
@@ -81,6 +91,10 @@ void    OverlandFlowEvalDiff(
                                                 * fcn = CALCDER => calculate the function
                                                 *                  derivative */
 {
+  PFModule    *this_module = ThisPFModule;
+  PublicXtra  *public_xtra = (PublicXtra*)PFModulePublicXtra(this_module);
+  InstanceXtra *instance_xtra = (InstanceXtra*)PFModuleInstanceXtra(this_module);
+
   Vector      *slope_x = ProblemDataTSlopeX(problem_data);
   Vector      *slope_y = ProblemDataTSlopeY(problem_data);
   Vector      *mannings = ProblemDataMannings(problem_data);
@@ -91,12 +105,17 @@ void    OverlandFlowEvalDiff(
 
   Subgrid      *subgrid;
 
-  double        *sx_dat, *sy_dat, *mann_dat, *top_dat, *pp, *opp;
+  double        *sx_dat, *sy_dat, *mann_dat, *pp, *opp;
 
-  double dx, dy, ov_epsilon;
+  SurfacePatch  *surface_patch;
+  SurfaceCells  *cells, *interior;
+  int           *index2d, *itop, *ieast, *inorth, *flags;
 
-  int i, j, k, ival, sy_v;
-  PF_UNUSED(ival);
+  double dx, dy;
+  double ov_epsilon = (public_xtra->ov_epsilon);
+  int fast_power = (public_xtra->fast_power);
+
+  int n, sy_v;
 
   p_sub = VectorSubvector(pressure, sg);
   op_sub = VectorSubvector(old_pressure, sg);
@@ -111,7 +130,6 @@ void    OverlandFlowEvalDiff(
   sx_dat = SubvectorData(sx_sub);
   sy_dat = SubvectorData(sy_sub);
   mann_dat = SubvectorData(mann_sub);
-  top_dat = SubvectorData(top_sub);
 
   subgrid = GridSubgrid(grid, sg);
   dx = SubgridDX(subgrid);
@@ -119,314 +137,296 @@ void    OverlandFlowEvalDiff(
 
   sy_v = SubvectorNX(top_sub);
 
-  ov_epsilon = GetDoubleDefault("Solver.OverlandDiffusive.Epsilon", 1.0e-5);
+  if (instance_xtra->surface == NULL)
+  {
+    instance_xtra->surface = NewSurface(bc_struct);
+  }
+  surface_patch = SurfaceGetPatch(instance_xtra->surface, bc_struct, ipatch, sg,
+                                  top, p_sub);
 
   if (fcn == CALCFCN)
   {
-    ForPatchCellsPerFaceWithGhost(BC_ALL,
-                                  BeforeAllCells(DoNothing),
-                                  LoopVars(i, j, k, ival, bc_struct, ipatch, sg),
-                                  Locals(int io, itop, ip=0, ipp1, ippsy;
-                                         int k1, k0x, k0y, k1x, k1y;
-                                         double Press_x=NAN, Press_y;
-                                         double Sf_x=NAN, Sf_y, Sf_xo=NAN, Sf_yo=NAN, Sf_mag;
-                                         double Pupx=NAN, Pupy, Pupox, Pupoy, Pdown, Pdowno;),
-                                  CellSetup(DoNothing),
-                                  FACE(LeftFace, DoNothing), FACE(RightFace, DoNothing),
-                                  FACE(DownFace, DoNothing), FACE(UpFace, DoNothing),
-                                  FACE(BackFace, DoNothing),
-                                  FACE(FrontFace,
-                                  {
-                                    io = SubvectorEltIndex(sx_sub, i, j, 0);
-                                    itop = SubvectorEltIndex(top_sub, i, j, 0);
-
-                                    k1 = (int)top_dat[itop];
-                                    k0x = (int)top_dat[itop - 1];
-                                    k0y = (int)top_dat[itop - sy_v];
-                                    k1x = (int)top_dat[itop + 1];
-                                    k1y = (int)top_dat[itop + sy_v];
-
-                                    if (k1 >= 0)
-                                    {
-                                      ip = SubvectorEltIndex(p_sub, i, j, k1);
-                                      ipp1 = (int)SubvectorEltIndex(p_sub, i+1, j, k1x);
-                                      ippsy = (int)SubvectorEltIndex(p_sub, i, j+1, k1y);
-                                      Pupx = pfmax(pp[ipp1], 0.0);
-                                      Pupy = pfmax(pp[ippsy], 0.0);
-                                      Pupox = pfmax(opp[ipp1], 0.0);
-                                      Pupoy = pfmax(opp[ippsy], 0.0);
-                                      Pdown = pfmax(pp[ip], 0.0);
-                                      Pdowno = pfmax(opp[ip], 0.0);
-
-                                      Sf_x = sx_dat[io] + (Pupx - Pdown) / dx;
-                                      Sf_y = sy_dat[io] + (Pupy - Pdown) / dy;
-
-                                      Sf_xo = sx_dat[io] + (Pupox - Pdowno) / dx;
-                                      Sf_yo = sy_dat[io] + (Pupoy - Pdowno) / dy;
-
-                                      Sf_mag = RPowerR(Sf_xo * Sf_xo + Sf_yo * Sf_yo, 0.5);
-                                      if (Sf_mag < ov_epsilon)
-                                        Sf_mag = ov_epsilon;
-
-                                      Press_x = RPMean(-Sf_x, 0.0, pfmax((pp[ip]), 0.0), pfmax((pp[ipp1]), 0.0));
-                                      Press_y = RPMean(-Sf_y, 0.0, pfmax((pp[ip]), 0.0), pfmax((pp[ippsy]), 0.0));
-
-                                      qx_v[io] = -(Sf_x / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_x, (5.0 / 3.0));
-                                      qy_v[io] = -(Sf_y / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_y, (5.0 / 3.0));
-                                    }
-
-                                    //fix for lower x boundary
-                                    if (k0x < 0.0)
-                                    {
-                                      Press_x = pfmax((pp[ip]), 0.0);
-                                      Sf_x = sx_dat[io] + (Press_x - 0.0) / dx;
-
-                                      Pupox = pfmax(opp[ip], 0.0);
-                                      Sf_xo = sx_dat[io] + (Pupox - 0.0) / dx;
-
-                                      double Sf_mag = RPowerR(Sf_xo * Sf_xo + Sf_yo * Sf_yo, 0.5); //+ov_epsilon;
-                                      if (Sf_mag < ov_epsilon)
-                                        Sf_mag = ov_epsilon;
-                                      if (Sf_x > 0.0)
-                                      {
-                                        qx_v[io - 1] = -(Sf_x / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_x, (5.0 / 3.0));
-                                      }
-                                    }
-
-                                    //fix for lower y boundary
-                                    if (k0y < 0.0)
-                                    {
-                                      Press_y = pfmax((pp[ip]), 0.0);
-                                      Sf_y = sy_dat[io] + (Press_y - 0.0) / dx;
-
-                                      Pupoy = pfmax(opp[ip], 0.0);
-                                      Sf_yo = sy_dat[io] + (Pupoy - 0.0) / dx;
-
-                                      double Sf_mag = RPowerR(Sf_xo * Sf_xo + Sf_yo * Sf_yo, 0.5); //Note that the sf_xo was already corrected above
-                                      if (Sf_mag < ov_epsilon)
-                                        Sf_mag = ov_epsilon;
-
-                                      if (Sf_y > 0.0)
-                                      {
-                                        qy_v[io - sy_v] = -(Sf_y / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_y, (5.0 / 3.0));
-                                      }
-
-                                      // Recalculating the x flow in the case with both the lower and left boundaries
-                                      // This is exactly the same as the q_x in the left boundary conditional above but
-                                      // recalculating qx_v here again becuase the sf_mag will be adjusted with the new sf_yo above
-                                      if (k0x < 0.0)
-                                      {
-                                        if (Sf_x > 0.0)
-                                        {
-                                          qx_v[io - 1] = -(Sf_x / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io])) * RPowerR(Press_x, (5.0 / 3.0));
-                                        }
-                                      }
-                                    }
-                                  }),
-                                  CellFinalize(DoNothing),
-                                  AfterAllCells(DoNothing)
-      );
-
-    ForPatchCellsPerFace(BC_ALL,
-                         BeforeAllCells(DoNothing),
-                         LoopVars(i, j, k, ival, bc_struct, ipatch, sg),
-                         Locals(int io;),
-                         CellSetup(DoNothing),
-                         FACE(LeftFace, DoNothing), FACE(RightFace, DoNothing),
-                         FACE(DownFace, DoNothing), FACE(UpFace, DoNothing),
-                         FACE(BackFace, DoNothing),
-                         FACE(FrontFace,
-                         {
-                           io = SubvectorEltIndex(sx_sub, i, j, 0);
-                           ke_v[io] = qx_v[io];
-                           kw_v[io] = qx_v[io - 1];
-                           kn_v[io] = qy_v[io];
-                           ks_v[io] = qy_v[io - sy_v];
-                           //printf("i=%d j=%d k=%d ke_v=%d kw_v=%d kn_v=%d ks_v=%f\n",i,j,k,ke_v[io],kw_v[io],kn_v[io],ks_v[io]);
-                         }),
-                         CellFinalize(DoNothing),
-                         AfterAllCells(DoNothing)
-      );
+    cells = SurfacePatchCells(surface_patch);
+    index2d = SurfaceCellsIndex2D(cells);
+    itop = SurfaceCellsTop(cells);
+    ieast = SurfaceCellsEast(cells);
+    inorth = SurfaceCellsNorth(cells);
+    flags = SurfaceCellsFlags(cells);
+
+    SurfaceCellLoop(n, cells,
+    {
+      int io = index2d[n];
+      int ip = itop[n];
+      int ipp1 = ieast[n];
+      int ippsy = inorth[n];
+
+      double Press_x;
+      double Press_y;
+      double Sf_x;
+      double Sf_y;
+      double Sf_xo;
+      double Sf_yo;
+      double Sf_mag;
+      double Pupx = pfmax(pp[ipp1], 0.0);
+      double Pupy = pfmax(pp[ippsy], 0.0);
+      double Pupox = pfmax(opp[ipp1], 0.0);
+      double Pupoy = pfmax(opp[ippsy], 0.0);
+      double Pdown = pfmax(pp[ip], 0.0);
+      double Pdowno = pfmax(opp[ip], 0.0);
+      double sqrt_n;
+
+      Sf_x = sx_dat[io] + (Pupx - Pdown) / dx;
+      Sf_y = sy_dat[io] + (Pupy - Pdown) / dy;
+
+      Sf_xo = sx_dat[io] + (Pupox - Pdowno) / dx;
+      Sf_yo = sy_dat[io] + (Pupoy - Pdowno) / dy;
+
+      Sf_mag = RPowerR(Sf_xo * Sf_xo + Sf_yo * Sf_yo, 0.5);
+      if (Sf_mag < ov_epsilon)
+        Sf_mag = ov_epsilon;
+      sqrt_n = RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io];
+
+      Press_x = RPMean(-Sf_x, 0.0, pfmax((pp[ip]), 0.0), pfmax((pp[ipp1]), 0.0));
+      Press_y = RPMean(-Sf_y, 0.0, pfmax((pp[ip]), 0.0), pfmax((pp[ippsy]), 0.0));
+
+      qx_v[io] = -(Sf_x / sqrt_n) * DepthPow53(Press_x);
+      qy_v[io] = -(Sf_y / sqrt_n) * DepthPow53(Press_y);
+
+      //fix for lower x boundary
+      if (flags[n] & SurfaceWestInactive)
+      {
+        Press_x = pfmax((pp[ip]), 0.0);
+        Sf_x = sx_dat[io] + (Press_x - 0.0) / dx;
+
+        Pupox = pfmax(opp[ip], 0.0);
+        Sf_xo = sx_dat[io] + (Pupox - 0.0) / dx;
+
+        Sf_mag = RPowerR(Sf_xo * Sf_xo + Sf_yo * Sf_yo, 0.5); //+ov_epsilon;
+        if (Sf_mag < ov_epsilon)
+          Sf_mag = ov_epsilon;
+        sqrt_n = RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io];
+        if (Sf_x > 0.0)
+        {
+          qx_v[io - 1] = -(Sf_x / sqrt_n) * DepthPow53(Press_x);
+        }
+      }
+
+      //fix for lower y boundary
+      if (flags[n] & SurfaceSouthInactive)
+      {
+        Press_y = pfmax((pp[ip]), 0.0);
+        Sf_y = sy_dat[io] + (Press_y - 0.0) / dx;
+
+        Pupoy = pfmax(opp[ip], 0.0);
+        Sf_yo = sy_dat[io] + (Pupoy - 0.0) / dx;
+
+        Sf_mag = RPowerR(Sf_xo * Sf_xo + Sf_yo * Sf_yo, 0.5); //Note that the sf_xo was already corrected above
+        if (Sf_mag < ov_epsilon)
+          Sf_mag = ov_epsilon;
+        sqrt_n = RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io];
+
+        if (Sf_y > 0.0)
+        {
+          qy_v[io - sy_v] = -(Sf_y / sqrt_n) * DepthPow53(Press_y);
+        }
+
+        // Recalculating the x flow in the case with both the lower and left boundaries
+        // This is exactly the same as the q_x in the left boundary conditional above but
+        // recalculating qx_v here again becuase the sf_mag will be adjusted with the new sf_yo above
+        if (flags[n] & SurfaceWestInactive)
+        {
+          if (Sf_x > 0.0)
+          {
+            qx_v[io - 1] = -(Sf_x / sqrt_n) * DepthPow53(Press_x);
+          }
+        }
+      }
+    });
+
+    interior = SurfacePatchInterior(surface_patch);
+    index2d = SurfaceCellsIndex2D(interior);
+
+    SurfaceCellLoop(n, interior,
+    {
+      int io = index2d[n];
+
+      ke_v[io] = qx_v[io];
+      kw_v[io] = qx_v[io - 1];
+      kn_v[io] = qy_v[io];
+      ks_v[io] = qy_v[io - sy_v];
+    });
   }
   else          //fcn = CALCDER calculates the derivs of KE KW KN KS wrt to current cell (i,j,k)
   {
-    ForPatchCellsPerFace(BC_ALL,
-                         BeforeAllCells(DoNothing),
-                         LoopVars(i, j, k, ival, bc_struct, ipatch, sg),
-                         Locals(int io, itop, ip=0, ipp1, ippsy;
-                                int k1, k0x, k0y, k1x, k1y;
-                                double Pupx=NAN, Pupy, Pupox, Pupoy, Pdown, Pdowno;
-                                double Sf_x=NAN, Sf_y, Sf_xo=NAN, Sf_yo=NAN, Sf_mag;),
-                         CellSetup(DoNothing),
-                         FACE(LeftFace, DoNothing), FACE(RightFace, DoNothing),
-                         FACE(DownFace, DoNothing), FACE(UpFace, DoNothing),
-                         FACE(BackFace, DoNothing),
-                         FACE(FrontFace,
-                         {
-                           io = SubvectorEltIndex(sx_sub, i, j, 0);
-                           itop = SubvectorEltIndex(top_sub, i, j, 0);
-
-                           k1 = (int)top_dat[itop];
-                           k0x = (int)top_dat[itop - 1];
-                           k0y = (int)top_dat[itop - sy_v];
-                           k1x = (int)top_dat[itop + 1];
-                           k1y = (int)top_dat[itop + sy_v];
-
-                           if (k1 >= 0)
-                           {
-                             ip = SubvectorEltIndex(p_sub, i, j, k1);
-                             ipp1 = (int)SubvectorEltIndex(p_sub, i+1, j, k1x);
-                             ippsy = (int)SubvectorEltIndex(p_sub, i, j+1, k1y);
-                             Pupx = pfmax(pp[ipp1], 0.0);
-                             Pupy = pfmax(pp[ippsy], 0.0);
-                             Pupox = pfmax(opp[ipp1], 0.0);
-                             Pupoy = pfmax(opp[ippsy], 0.0);
-                             Pdown = pfmax(pp[ip], 0.0);
-                             Pdowno = pfmax(opp[ip], 0.0);
-
-                             Sf_x = sx_dat[io] + (Pupx - Pdown) / dx;
-                             Sf_y = sy_dat[io] + (Pupy - Pdown) / dy;
-
-                             Sf_xo = sx_dat[io] + (Pupox - Pdowno) / dx;
-                             Sf_yo = sy_dat[io] + (Pupoy - Pdowno) / dy;
-
-                             Sf_mag = RPowerR(Sf_xo * Sf_xo + Sf_yo * Sf_yo, 0.5); //+ov_epsilon;
-                             if (Sf_mag < ov_epsilon)
-                               Sf_mag = ov_epsilon;
-
-                             if (Sf_x < 0)
-                             {
-                               ke_v[io] = (5.0 / 3.0) * (-sx_dat[io] - (Pupx / dx)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io]) * RPowerR(Pdown, (2.0 / 3.0)) +
-                                          (8.0 / 3.0) * RPowerR(Pdown, (5.0 / 3.0)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io] * dx);
-
-                               kw_v[io + 1] = -RPowerR(Pdown, (5.0 / 3.0)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io] * dx);
-
-                               ke_vns[io] = kw_v[io + 1];
-                               kw_vns[io + 1] = ke_v[io];
-                             }
-
-                             if (Sf_x >= 0)
-                             {
-                               ke_v[io] = RPowerR(Pupx, (5.0 / 3.0)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io] * dx);
-
-                               kw_v[io + 1] = (5.0 / 3.0) * (-sx_dat[io] + (Pdown / dx)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io]) * RPowerR(Pupx, (2.0 / 3.0)) -
-                                              (8.0 / 3.0) * RPowerR(Pupx, (5.0 / 3.0)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io] * dx);
-
-                               ke_vns[io] = kw_v[io + 1];
-                               kw_vns[io + 1] = ke_v[io];
-                             }
-
-                             if (Sf_y < 0)
-                             {
-                               kn_v[io] = (5.0 / 3.0) * (-sy_dat[io] - (Pupy / dy)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io]) * RPowerR(Pdown, (2.0 / 3.0)) +
-                                          (8.0 / 3.0) * RPowerR(Pdown, (5.0 / 3.0)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io] * dy);
-
-                               ks_v[io + sy_v] = -RPowerR(Pdown, (5.0 / 3.0)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io] * dy);
-
-                               kn_vns[io] = ks_v[io + sy_v];
-                               ks_vns[io + sy_v] = kn_v[io];
-                             }
-
-                             if (Sf_y >= 0)
-                             {
-                               kn_v[io] = RPowerR(Pupy, (5.0 / 3.0)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io] * dy);
-
-                               ks_v[io + sy_v] = (5.0 / 3.0) * (-sy_dat[io] + (Pdown / dy)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io]) * RPowerR(Pupy, (2.0 / 3.0)) -
-                                                 (8.0 / 3.0) * RPowerR(Pupy, (5.0 / 3.0)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io] * dy);
-
-                               kn_vns[io] = ks_v[io + sy_v];
-                               ks_vns[io + sy_v] = kn_v[io];
-                             }
-                           }
-
-                           //fix for lower x boundary
-                           if (k0x < 0.0)
-                           {
-                             Pupx = pfmax((pp[ip]), 0.0);
-                             Sf_x = sx_dat[io] + (Pupx - 0.0) / dx;
-
-                             Pupox = pfmax(opp[ip], 0.0);
-                             Sf_xo = sx_dat[io] + (Pupox - 0.0) / dx;
-
-                             double Sf_mag = RPowerR(Sf_xo * Sf_xo + Sf_yo * Sf_yo, 0.5);
-                             if (Sf_mag < ov_epsilon)
-                               Sf_mag = ov_epsilon;
-
-                             if (Sf_x < 0)
-                             {
-                               ke_v[io - 1] = 0.0;
-                               kw_v[io] = 0.0;
-                               kw_vns[io] = 0.0;
-                               ke_vns[io - 1] = 0.0;
-                             }
-
-                             if (Sf_x >= 0)
-                             {
-                               ke_v[io - 1] = RPowerR(Pupx, (5.0 / 3.0)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io] * dx);
-                               kw_v[io] = (5.0 / 3.0) * (-sx_dat[io] + 0.0) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io]) * RPowerR(Pupx, (2.0 / 3.0)) -
-                                          (8.0 / 3.0) * RPowerR(Pupx, (5.0 / 3.0)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io] * dx);
-                               ke_vns[io - 1] = kw_v[io];
-                               kw_vns[io] = ke_v[io - 1];
-                             }
-                           }
-
-                           //fix for lower y boundary
-                           if (k0y < 0.0)
-                           {
-                             Pupy = pfmax((pp[ip]), 0.0);
-                             Sf_y = sy_dat[io] + (Pupy - 0.0) / dy;
-
-                             Pupoy = pfmax(opp[ip], 0.0);
-                             Sf_yo = sy_dat[io] + (Pupoy - 0.0) / dy;
-
-                             double Sf_mag = RPowerR(Sf_xo * Sf_xo + Sf_yo * Sf_yo, 0.5); //Note that the sf_xo was already corrected above
-                             if (Sf_mag < ov_epsilon)
-                               Sf_mag = ov_epsilon;
-
-                             if (Sf_y < 0)
-                             {
-                               kn_v[io - sy_v] = 0.0;
-                               ks_v[io] = 0.0;
-                               ks_vns[io] = 0.0;
-                               kn_vns[io - sy_v] = 0.0;
-                             }
-
-                             if (Sf_y >= 0)
-                             {
-                               kn_vns[io - sy_v] = RPowerR(Pupy, (5.0 / 3.0)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io] * dy);
-                               ks_v[io] = (5.0 / 3.0) * (-sy_dat[io] + 0.0) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io]) * RPowerR(Pupy, (2.0 / 3.0)) -
-                                          (8.0 / 3.0) * RPowerR(Pupy, (5.0 / 3.0)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io] * dy);
-                               kn_vns[io - sy_v] = ks_v[io];
-                               ks_vns[io] = kn_v[io - sy_v];
-                             }
-
-                             // Recalculating the x flow in the case with both the lower and left boundaries
-                             // This is exactly the same as the q_x in the left boundary conditional above but
-                             // recalculating qx_v here again becuase the sf_mag will be adjusted with the new sf_yo above
-                             if (k0x < 0.0)
-                             {
-                               if (Sf_x < 0)
-                               {
-                                 kn_v[io - sy_v] = 0.0;
-                                 ks_v[io] = 0.0;
-                                 ks_vns[io] = 0.0;
-                                 kn_vns[io - sy_v] = 0.0;
-                               }
-
-                               if (Sf_x >= 0)
-                               {
-                                 ke_v[io - 1] = RPowerR(Pupx, (5.0 / 3.0)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io] * dx);
-                                 kw_v[io] = (5.0 / 3.0) * (-sx_dat[io] + 0.0) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io]) * RPowerR(Pupx, (2.0 / 3.0)) -
-                                            (8.0 / 3.0) * RPowerR(Pupx, (5.0 / 3.0)) / (RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io] * dx);
-                                 ke_vns[io - 1] = kw_v[io];
-                                 kw_vns[io] = ke_v[io - 1];
-                               }
-                             }
-                           }
-                         }),
-                         CellFinalize(DoNothing),
-                         AfterAllCells(DoNothing)
-      );
+    interior = SurfacePatchInterior(surface_patch);
+    index2d = SurfaceCellsIndex2D(interior);
+    itop = SurfaceCellsTop(interior);
+    ieast = SurfaceCellsEast(interior);
+    inorth = SurfaceCellsNorth(interior);
+    flags = SurfaceCellsFlags(interior);
+
+    SurfaceCellLoop(n, interior,
+    {
+      int io = index2d[n];
+      int ip = itop[n];
+      int ipp1 = ieast[n];
+      int ippsy = inorth[n];
+
+      double Pupx = pfmax(pp[ipp1], 0.0);
+      double Pupy = pfmax(pp[ippsy], 0.0);
+      double Pupox = pfmax(opp[ipp1], 0.0);
+      double Pupoy = pfmax(opp[ippsy], 0.0);
+      double Pdown = pfmax(pp[ip], 0.0);
+      double Pdowno = pfmax(opp[ip], 0.0);
+      double sqrt_n;
+      double Sf_x;
+      double Sf_y;
+      double Sf_xo;
+      double Sf_yo;
+      double Sf_mag;
+
+      Sf_x = sx_dat[io] + (Pupx - Pdown) / dx;
+      Sf_y = sy_dat[io] + (Pupy - Pdown) / dy;
+
+      Sf_xo = sx_dat[io] + (Pupox - Pdowno) / dx;
+      Sf_yo = sy_dat[io] + (Pupoy - Pdowno) / dy;
+
+      Sf_mag = RPowerR(Sf_xo * Sf_xo + Sf_yo * Sf_yo, 0.5); //+ov_epsilon;
+      if (Sf_mag < ov_epsilon)
+        Sf_mag = ov_epsilon;
+      sqrt_n = RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io];
+
+      if (Sf_x < 0)
+      {
+        ke_v[io] = (5.0 / 3.0) * (-sx_dat[io] - (Pupx / dx)) / sqrt_n * DepthPow23(Pdown) +
+                   (8.0 / 3.0) * DepthPow53(Pdown) / (sqrt_n * dx);
+
+        kw_v[io + 1] = -DepthPow53(Pdown) / (sqrt_n * dx);
+
+        ke_vns[io] = kw_v[io + 1];
+        kw_vns[io + 1] = ke_v[io];
+      }
+
+      if (Sf_x >= 0)
+      {
+        ke_v[io] = DepthPow53(Pupx) / (sqrt_n * dx);
+
+        kw_v[io + 1] = (5.0 / 3.0) * (-sx_dat[io] + (Pdown / dx)) / sqrt_n * DepthPow23(Pupx) -
+                       (8.0 / 3.0) * DepthPow53(Pupx) / (sqrt_n * dx);
+
+        ke_vns[io] = kw_v[io + 1];
+        kw_vns[io + 1] = ke_v[io];
+      }
+
+      if (Sf_y < 0)
+      {
+        kn_v[io] = (5.0 / 3.0) * (-sy_dat[io] - (Pupy / dy)) / sqrt_n * DepthPow23(Pdown) +
+                   (8.0 / 3.0) * DepthPow53(Pdown) / (sqrt_n * dy);
+
+        ks_v[io + sy_v] = -DepthPow53(Pdown) / (sqrt_n * dy);
+
+        kn_vns[io] = ks_v[io + sy_v];
+        ks_vns[io + sy_v] = kn_v[io];
+      }
+
+      if (Sf_y >= 0)
+      {
+        kn_v[io] = DepthPow53(Pupy) / (sqrt_n * dy);
+
+        ks_v[io + sy_v] = (5.0 / 3.0) * (-sy_dat[io] + (Pdown / dy)) / sqrt_n * DepthPow23(Pupy) -
+                          (8.0 / 3.0) * DepthPow53(Pupy) / (sqrt_n * dy);
+
+        kn_vns[io] = ks_v[io + sy_v];
+        ks_vns[io + sy_v] = kn_v[io];
+      }
+
+      //fix for lower x boundary
+      if (flags[n] & SurfaceWestInactive)
+      {
+        Pupx = pfmax((pp[ip]), 0.0);
+        Sf_x = sx_dat[io] + (Pupx - 0.0) / dx;
+
+        Pupox = pfmax(opp[ip], 0.0);
+        Sf_xo = sx_dat[io] + (Pupox - 0.0) / dx;
+
+        Sf_mag = RPowerR(Sf_xo * Sf_xo + Sf_yo * Sf_yo, 0.5);
+        if (Sf_mag < ov_epsilon)
+          Sf_mag = ov_epsilon;
+        sqrt_n = RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io];
+
+        if (Sf_x < 0)
+        {
+          ke_v[io - 1] = 0.0;
+          kw_v[io] = 0.0;
+          kw_vns[io] = 0.0;
+          ke_vns[io - 1] = 0.0;
+        }
+
+        if (Sf_x >= 0)
+        {
+          ke_v[io - 1] = DepthPow53(Pupx) / (sqrt_n * dx);
+          kw_v[io] = (5.0 / 3.0) * (-sx_dat[io] + 0.0) / sqrt_n * DepthPow23(Pupx) -
+                     (8.0 / 3.0) * DepthPow53(Pupx) / (sqrt_n * dx);
+          ke_vns[io - 1] = kw_v[io];
+          kw_vns[io] = ke_v[io - 1];
+        }
+      }
+
+      //fix for lower y boundary
+      if (flags[n] & SurfaceSouthInactive)
+      {
+        Pupy = pfmax((pp[ip]), 0.0);
+        Sf_y = sy_dat[io] + (Pupy - 0.0) / dy;
+
+        Pupoy = pfmax(opp[ip], 0.0);
+        Sf_yo = sy_dat[io] + (Pupoy - 0.0) / dy;
+
+        Sf_mag = RPowerR(Sf_xo * Sf_xo + Sf_yo * Sf_yo, 0.5); //Note that the sf_xo was already corrected above
+        if (Sf_mag < ov_epsilon)
+          Sf_mag = ov_epsilon;
+        sqrt_n = RPowerR(fabs(Sf_mag), 0.5) * mann_dat[io];
+
+        if (Sf_y < 0)
+        {
+          kn_v[io - sy_v] = 0.0;
+          ks_v[io] = 0.0;
+          ks_vns[io] = 0.0;
+          kn_vns[io - sy_v] = 0.0;
+        }
+
+        if (Sf_y >= 0)
+        {
+          kn_vns[io - sy_v] = DepthPow53(Pupy) / (sqrt_n * dy);
+          ks_v[io] = (5.0 / 3.0) * (-sy_dat[io] + 0.0) / sqrt_n * DepthPow23(Pupy) -
+                     (8.0 / 3.0) * DepthPow53(Pupy) / (sqrt_n * dy);
+          kn_vns[io - sy_v] = ks_v[io];
+          ks_vns[io] = kn_v[io - sy_v];
+        }
+
+        // Recalculating the x flow in the case with both the lower and left boundaries
+        // This is exactly the same as the q_x in the left boundary conditional above but
+        // recalculating qx_v here again becuase the sf_mag will be adjusted with the new sf_yo above
+        if (flags[n] & SurfaceWestInactive)
+        {
+          if (Sf_x < 0)
+          {
+            kn_v[io - sy_v] = 0.0;
+            ks_v[io] = 0.0;
+            ks_vns[io] = 0.0;
+            kn_vns[io - sy_v] = 0.0;
+          }
+
+          if (Sf_x >= 0)
+          {
+            ke_v[io - 1] = DepthPow53(Pupx) / (sqrt_n * dx);
+            kw_v[io] = (5.0 / 3.0) * (-sx_dat[io] + 0.0) / sqrt_n * DepthPow23(Pupx) -
+                       (8.0 / 3.0) * DepthPow53(Pupx) / (sqrt_n * dx);
+            ke_vns[io - 1] = kw_v[io];
+            kw_vns[io] = ke_v[io - 1];
+          }
+        }
+      }
+    });
   }
 }
 
@@ -440,7 +440,17 @@ PFModule  *OverlandFlowEvalDiffInitInstanceXtra()
   PFModule      *this_module = ThisPFModule;
   InstanceXtra  *instance_xtra;
 
-  instance_xtra = NULL;
+  if (PFModuleInstanceXtra(this_module) == NULL)
+    instance_xtra = ctalloc(InstanceXtra, 1);
+  else
+    instance_xtra = (InstanceXtra*)PFModuleInstanceXtra(this_module);
+
+  /* The surface is set up again on the next evaluation */
+  if (instance_xtra->surface)
+  {
+    FreeSurface(instance_xtra->surface);
+    instance_xtra->surface = NULL;
+  }
 
   PFModuleInstanceXtra(this_module) = instance_xtra;
   return this_module;
@@ -458,6 +468,10 @@ void  OverlandFlowEvalDiffFreeInstanceXtra()
 
   if (instance_xtra)
   {
+    if (instance_xtra->surface)
+    {
+      FreeSurface(instance_xtra->surface);
+    }
     tfree(instance_xtra);
   }
 }
@@ -471,7 +485,20 @@ PFModule  *OverlandFlowEvalDiffNewPublicXtra()
   PFModule      *this_module = ThisPFModule;
   PublicXtra    *public_xtra;
 
-  public_xtra = NULL;
+  char          *switch_name;
+  NameArray switch_na;
+
+  public_xtra = ctalloc(PublicXtra, 1);
+
+  (public_xtra->ov_epsilon) =
+    GetDoubleDefault("Solver.OverlandDiffusive.Epsilon", 1.0e-5);
+
+  switch_na = NA_NewNameArray("False True");
+  switch_name = GetStringDefault("Solver.OverlandDiffusive.FastPower", "False");
+  (public_xtra->fast_power) =
+    NA_NameToIndexExitOnError(switch_na, switch_name,
+                              "Solver.OverlandDiffusive.FastPower");
+  NA_FreeNameArray(switch_na);
 
   PFModulePublicXtra(this_module) = public_xtra;
   return this_module;
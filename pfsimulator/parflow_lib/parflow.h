@@ -48,6 +48,7 @@
 #include "input_database.h"
 #include "logging.h"
 #include "timing.h"
+#include "telemetry.h"
 #include "loops.h"
 #include "background.h"
 #include "communication.h"
@@ -64,11 +65,13 @@
 #include "globals.h"
 #include "time_cycle_data.h"
 #include "problem_bc.h"
+#include "surface.h"
 #include "problem_eval.h"
 #include "well.h"
 #include "bc_pressure.h"
 #include "problem.h"
 #include "solver.h"
+#include "checkpoint.h"
 #include "nl_function_eval.h"
 #include "parflow_proto.h"
 #include "parflow_proto_f.h"
@@ -1,10 +1,10 @@
 typedef PFModule * (*NewDefault)(void);
 
-typedef void (*AdvectionConcentrationInvoke) (ProblemData *problem_data, int phase, int concentration, Vector *old_concentration, Vector *new_concentration, Vector *x_velocity, Vector *y_velocity, Vector *z_velocity, Vector *solid_mass_factor, double time, double deltat, int order);
+typedef void (*AdvectionConcentrationInvoke) (ProblemData *problem_data, int phase, int num_concentrations, Vector **old_concentrations, Vector **new_concentrations, Vector *x_velocity, Vector *y_velocity, Vector *z_velocity, Vector **solid_mass_factors, double time, double deltat, int order);
 typedef PFModule *(*AdvectionConcentrationInitInstanceXtraType) (Problem *problem, Grid *grid, double *temp_data);
 
 /* advection_godunov.c */
-void Godunov(ProblemData *problem_data, int phase, int concentration, Vector *old_concentration, Vector *new_concentration, Vector *x_velocity, Vector *y_velocity, Vector *z_velocity, Vector *solid_mass_factor, double time, double deltat, int order);
+void Godunov(ProblemData *problem_data, int phase, int num_concentrations, Vector **old_concentrations, Vector **new_concentrations, Vector *x_velocity, Vector *y_velocity, Vector *z_velocity, Vector **solid_mass_factors, double time, double deltat, int order);
 PFModule *GodunovInitInstanceXtra(Problem *problem, Grid *grid, double *temp_data);
 void GodunovFreeInstanceXtra(void);
 PFModule *GodunovNewPublicXtra(void);
@@ -67,6 +67,17 @@ void InitCharVector(CharVector *v, char value);
 void InitCharVectorAll(CharVector *v, char value);
 void InitCharVectorInc(CharVector *v, char value, int inc);
 
+/* checkpoint.c */
+Checkpoint *NewCheckpoint(double wall_clock_interval, int step_interval);
+void FreeCheckpoint(Checkpoint *checkpoint);
+void ClearCheckpoint(Checkpoint *checkpoint);
+void CheckpointAddInt(Checkpoint *checkpoint, int *value);
+void CheckpointAddDouble(Checkpoint *checkpoint, double *value);
+void CheckpointAddVector(Checkpoint *checkpoint, char *name, Vector *vector);
+int CheckpointDue(Checkpoint *checkpoint, int step);
+void WriteCheckpoint(Checkpoint *checkpoint, char *file_prefix);
+int ReadCheckpoint(Checkpoint *checkpoint, char *file_prefix);
+
 typedef void (*ChebyshevInvoke) (Vector *x, Vector *b, double tol, int zero, double ia, double ib, int num_iter);
 typedef PFModule *(*ChebyshevInitInstanceXtraInvoke) (Problem *problem, Grid *grid, ProblemData *problem_data, Matrix *A, double *temp_data);
 typedef PFModule *(*ChebyshevNewPublicXtraInvoke) (char *name);
@@ -88,6 +99,7 @@ void FreeComputePkgs(Grid *grid);
 /* communication.c */
 int NewCommPkgInfo(Subregion *data_sr, Subregion *comm_sr, int index, int num_vars, int *loop_array);
 CommPkg *NewCommPkg(Region *send_region, Region *recv_region, SubregionArray *data_space, int num_vars, double *data);
+CommPkg *NewMultiCommPkg(Region *send_region, Region *recv_region, SubregionArray *data_space, int num_vars, int num_data, double **data);
 void FreeCommPkg(CommPkg *pkg);
 // SGS what's up with this?
 CommHandle *InitCommunication(CommPkg *comm_pkg);
@@ -167,6 +179,14 @@ double ddot_(int *n, double *dx, int *incx, double *dy, int *incy);
 int dposl_(double *a, int *lda, int *n, double *b);
 int daxpy_(int *n, double *da, double *dx, int *incx, double *dy, int *incy);
 
+/* fftRF.c */
+void FFTRF(GeomSolid *geounit, GrGeomSolid *gr_geounit, Vector *field, RFCondData *cdata);
+PFModule *FFTRFInitInstanceXtra(Grid *grid, double *temp_data);
+void FFTRFFreeInstanceXtra(void);
+PFModule *FFTRFNewPublicXtra(char *geom_name);
+void FFTRFFreePublicXtra(void);
+int FFTRFSizeOfTempData(void);
+
 /* gauinv.c */
 int gauinv_(double *p, double *xp, int *ierr);
 
@@ -200,6 +220,16 @@ void NewGlobals(char *run_name);
 void FreeGlobals(void);
 void LogGlobals(void);
 
+/* grgeom_cache.c */
+unsigned long long GrGeomCacheHash(unsigned long long hash, const void *data, long size);
+unsigned long long GrGeomCacheHashGlobals(unsigned long long hash);
+unsigned long long GrGeomCacheHashGeomSolid(unsigned long long hash, GeomSolid *solid);
+unsigned long long GrGeomCacheHashVector(unsigned long long hash, Vector *vector);
+unsigned long long GrGeomCacheHashSubgrids(unsigned long long hash, SubgridArray *subgrids);
+void GrGeomCacheFilename(char *filename, char *directory, unsigned long long global_key);
+void GrGeomWriteCache(char *filename, unsigned long long global_key, unsigned long long local_key, GrGeomSolid **solids, int num_solids);
+int GrGeomReadCache(char *filename, unsigned long long global_key, unsigned long long local_key, GrGeomSolid **solids, int num_solids);
+
 /* grgeom_list.c */
 ListMember *NewListMember(double value, int normal_component, int triangle_id);
 void FreeListMember(ListMember *member);
@@ -235,6 +265,7 @@ int GrGeomGetOctreeInfo(double *xlp, double *ylp, double *zlp, double *xup, doub
 GrGeomExtentArray *GrGeomNewExtentArray(GrGeomExtents *extents, int size);
 void GrGeomFreeExtentArray(GrGeomExtentArray *extent_array);
 GrGeomExtentArray *GrGeomCreateExtentArray(SubgridArray *subgrids, int xl_ghost, int xu_ghost, int yl_ghost, int yu_ghost, int zl_ghost, int zu_ghost);
+GrGeomSolid *GrGeomAllocSolid(GrGeomOctree *data, GrGeomOctree **patches, int num_patches, int octree_bg_level, int octree_ix, int octree_iy, int octree_iz);
 GrGeomSolid *GrGeomNewSolid(GrGeomOctree *data, GrGeomOctree **patches, int num_patches, int octree_bg_level, int octree_ix, int octree_iy, int octree_iz);
 void GrGeomFreeSolid(GrGeomSolid *solid);
 void GrGeomSolidFromInd(GrGeomSolid **solid_ptr, Vector *indicator_field, int indicator);
@@ -293,14 +324,14 @@ PFModule *InputRFNewPublicXtra(char *geom_name);
 void InputRFFreePublicXtra(void);
 int InputRFSizeOfTempData(void);
 
-typedef int (*NonlinSolverInvoke) (Vector *pressure, Vector *density, Vector *old_density, Vector *saturation, Vector *old_saturation, double t, double dt, ProblemData *problem_data, Vector *old_pressure, Vector *evap_trans, Vector *ovrl_bc_flx, Vector *x_velocity, Vector *y_velocity, Vector *z_velocity);
+typedef int (*NonlinSolverInvoke) (Vector *pressure, Vector *density, Vector *old_density, Vector *saturation, Vector *old_saturation, double t, double dt, ProblemData *problem_data, Vector *old_pressure, Vector *evap_trans, Vector *ovrl_bc_flx, Vector *x_velocity, Vector *y_velocity, Vector *z_velocity, int *nonlin_iters, int *lin_iters);
 typedef PFModule *(*NonlinSolverInitInstanceXtraInvoke) (Problem *problem, Grid *grid, ProblemData *problem_data, double *temp_data);
 
 /* kinsol_nonlin_solver.c */
 int KINSolInitPC(int neq, N_Vector pressure, N_Vector uscale, N_Vector fval, N_Vector fscale, N_Vector vtemp1, N_Vector vtemp2, void *nl_function, double uround, long int *nfePtr, void *current_state);
 int KINSolCallPC(int neq, N_Vector pressure, N_Vector uscale, N_Vector fval, N_Vector fscale, N_Vector vtem, N_Vector ftem, void *nl_function, double uround, long int *nfePtr, void *current_state);
 void PrintFinalStats(FILE *out_file, long int *integer_outputs_now, long int *integer_outputs_total);
-int KinsolNonlinSolver(Vector *pressure, Vector *density, Vector *old_density, Vector *saturation, Vector *old_saturation, double t, double dt, ProblemData *problem_data, Vector *old_pressure, Vector *evap_trans, Vector *ovrl_bc_flx, Vector *x_velocity, Vector *y_velocity, Vector *z_velocity);
+int KinsolNonlinSolver(Vector *pressure, Vector *density, Vector *old_density, Vector *saturation, Vector *old_saturation, double t, double dt, ProblemData *problem_data, Vector *old_pressure, Vector *evap_trans, Vector *ovrl_bc_flx, Vector *x_velocity, Vector *y_velocity, Vector *z_velocity, int *nonlin_iters, int *lin_iters);
 PFModule *KinsolNonlinSolverInitInstanceXtra(Problem *problem, Grid *grid, ProblemData *problem_data, double *temp_data);
 void KinsolNonlinSolverFreeInstanceXtra(void);
 PFModule *KinsolNonlinSolverNewPublicXtra(void);
@@ -366,6 +397,9 @@ Matrix *NewMatrixType(Grid *grid, SubregionArray *range, Stencil *stencil, int s
 void FreeStencil(Stencil *stencil);
 void FreeMatrix(Matrix *matrix);
 void InitMatrix(Matrix *A, double value);
+void MatrixInterleave(Matrix *A);
+void MatrixSinglePrecision(Matrix *A);
+void MatrixDoublePrecision(Matrix *A, Stencil *ghost);
 
 /* matvec.c */
 void Matvec(double alpha, Matrix *A, Vector *x, double beta, Vector *y);
@@ -409,7 +443,7 @@ typedef PFModule *(*PrecondNewPublicXtra) (char *name);
 
 /* mg_semi.c */
 void MGSemi(Vector *x, Vector *b, double tol, int zero);
-void SetupCoarseOps(Matrix **A_l, Matrix **P_l, int num_levels, SubregionArray **f_sra_l, SubregionArray **c_sra_l);
+void SetupCoarseOps(Matrix **A_l, Matrix **P_l, int num_levels, SubregionArray **f_sra_l, SubregionArray **c_sra_l, int single_precision);
 PFModule *MGSemiInitInstanceXtra(Problem *problem, Grid *grid, ProblemData *problem_data, Matrix *A, double *temp_data);
 void MGSemiFreeInstanceXtra(void);
 PFModule *MGSemiNewPublicXtra(char *name);
@@ -1150,6 +1184,7 @@ int SolverRichardsSizeOfTempData(void);
 ProblemData *GetProblemDataRichards(PFModule *this_module);
 Problem  *GetProblemRichards(PFModule *this_module);
 PFModule *GetICPhasePressureRichards(PFModule *this_module);
+void GetStateRichards(PFModule *this_module, Vector **pressure, Vector **old_pressure, Vector **saturation, Vector **old_saturation, Vector **density, Vector **old_density, Vector **evap_trans, Vector **ovrl_bc_flx, Vector **x_velocity, Vector **y_velocity, Vector **z_velocity);
 void AdvanceRichards(PFModule *this_module,
                      double    start_time,   /* Starting time */
                      double    stop_time,    /* Stopping time */
@@ -1160,6 +1195,7 @@ void AdvanceRichards(PFModule *this_module,
                      Vector ** saturation_out
                      );
 void SetupRichards(PFModule *this_module);
+void TeardownRichards(PFModule *this_module);
 
 
 typedef void (*SubsrfSimInvoke) (ProblemData *problem_data, Vector *perm_x, Vector *perm_y, Vector *perm_z, int num_geounits, GeomSolid **geounits, GrGeomSolid **gr_geounits);
@@ -1173,6 +1209,17 @@ PFModule *SubsrfSimNewPublicXtra(void);
 void SubsrfSimFreePublicXtra(void);
 int SubsrfSimSizeOfTempData(void);
 
+/* surface.c */
+Surface *NewSurface(BCStruct *bc_struct);
+void FreeSurface(Surface *surface);
+SurfacePatch *SurfaceGetPatch(Surface *surface, BCStruct *bc_struct, int ipatch, int is, Vector *top, Subvector *p_sub);
+
+/* telemetry.c */
+void NewTelemetry(char *filename, int flush_interval);
+void TelemetryBeginStep(void);
+void TelemetryEndStep(int step, double t, double dt, int attempts, int nonlin_iters, int lin_iters);
+void FreeTelemetry(void);
+
 /* time_cycle_data.c */
 TimeCycleData *NewTimeCycleData(int number_of_cycles, int *number_of_intervals);
 void FreeTimeCycleData(TimeCycleData *time_cycle_data);
@@ -1182,6 +1229,18 @@ double TimeCycleDataComputeNextTransition(Problem *problem, double time, TimeCyc
 void ReadGlobalTimeCycleData(void);
 void FreeGlobalTimeCycleData(void);
 
+typedef void (*TimeStepControllerInvoke) (double *dt_next, int *accept, int converged, int nonlin_iters, int lin_iters, double dt, Vector *pressure, Vector *old_pressure, ProblemData *problem_data);
+typedef PFModule *(*TimeStepControllerInitInstanceXtraInvoke) (Grid *grid);
+
+/* time_step_controller.c */
+void TimeStepController(double *dt_next, int *accept, int converged, int nonlin_iters, int lin_iters, double dt, Vector *pressure, Vector *old_pressure, ProblemData *problem_data);
+PFModule *TimeStepControllerInitInstanceXtra(Grid *grid);
+void TimeStepControllerFreeInstanceXtra(void);
+PFModule *TimeStepControllerNewPublicXtra(void);
+void TimeStepControllerFreePublicXtra(void);
+int TimeStepControllerSizeOfTempData(void);
+void TimeStepControllerCheckpoint(PFModule *this_module, Checkpoint *checkpoint);
+
 /* timing.c */
 #if defined(PF_TIMING)
 void NewTiming(void);
@@ -1227,6 +1286,8 @@ void FreeUserGrid(Grid *user_grid);
 
 /* vector.c */
 CommPkg *NewVectorCommPkg(Vector *vector, ComputePkg *compute_pkg);
+CommPkg *NewVectorGroupCommPkg(Vector **vectors, int num_vectors, ComputePkg *compute_pkg);
+VectorUpdateCommHandle *InitVectorGroupUpdate(Vector **vectors, int num_vectors, int update_mode, CommPkg *comm_pkg);
 VectorUpdateCommHandle  *InitVectorUpdate(
                                           Vector *vector,
                                           int     update_mode);
@@ -1289,6 +1350,8 @@ int WJacobiSizeOfTempData(void);
 /* well.c */
 WellData *NewWellData(void);
 void FreeWellData(WellData *well_data);
+WellSubgridMap *GetWellSubgridMap(WellData *well_data, Grid *grid);
+void FreeWellSubgridMap(WellSubgridMap *well_subgrid_map);
 void PrintWellData(WellData *well_data, unsigned int print_mask);
 void WriteWells(char *file_prefix, Problem *problem, WellData *well_data, double time, int write_header);
 
@@ -1385,3 +1448,4 @@ void OverlandSum(ProblemData *problem_data,
                  Vector *     overland_sum);
 
 Grid      *ReadProcessGrid();
+Grid      *BalancedProcessGrid(Grid *user_grid);
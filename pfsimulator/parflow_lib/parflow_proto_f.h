@@ -76,6 +76,35 @@ void ADVECT(double *s, double *sn,
             double *sleft, double *sright, double *sfluxz,
             double *dxscr, double *dyscr, double *dzscr, double *dzfrm);
 
+#if defined(_CRAYMPP)
+#define ADVECTPLANE ADVECTPLANE
+#elif defined(__bg__)
+#define ADVECTPLANE advectplane
+#else
+#define ADVECTPLANE advectplane_
+#endif
+
+#define CALL_ADVECTPLANE(s, sn, uedge, vedge, wedge, phi,                      \
+                         slx, sly, slz,                                        \
+                         lo, hi, dlo, dhi, hx, dt, fstord, k, km, kc, kp,      \
+                         sbot, stop, sbotp, sfrt, sbck, sleft, sright, sfluxz, \
+                         dxscr, dyscr, dzscr, dzfrm)                           \
+  ADVECTPLANE(s, sn, uedge, vedge, wedge, phi,                                 \
+              slx, sly, slz,                                                   \
+              lo, hi, dlo, dhi, hx, &dt, &fstord, &k, &km, &kc, &kp,           \
+              sbot, stop, sbotp, sfrt, sbck, sleft, sright, sfluxz,            \
+              dxscr, dyscr, dzscr, dzfrm)
+
+void ADVECTPLANE(double *s, double *sn,
+                 double *uedge, double *vedge, double *wedge, double *phi,
+                 double *slx, double *sly, double *slz,
+                 int *lo, int *hi, int *dlo, int *dhi, double *hx, double *dt, int *fstord,
+                 int *k, int *km, int *kc, int *kp,
+                 double *sbot, double *stop, double *sbotp,
+                 double *sfrt, double *sbck,
+                 double *sleft, double *sright, double *sfluxz,
+                 double *dxscr, double *dyscr, double *dzscr, double *dzfrm);
+
 /* sadvect.f */
 #if defined(_CRAYMPP)
 #define SADVECT SADVECT
@@ -132,7 +161,8 @@ void SADVECT(double *s, double *sn,
                      clm_dump_interval, clm_1d_out, clm_forc_veg, clm_file_dir, clm_file_dir_length, clm_bin_out_dir, write_CLM_binary, slope_accounting_CLM,                                       \
                      clm_beta_function, clm_veg_function, clm_veg_wilting, clm_veg_fieldc, clm_res_sat,                                                                        \
                      clm_irr_type, clm_irr_cycle, clm_irr_rate, clm_irr_start, clm_irr_stop,                                                                                   \
-                     clm_irr_threshold, qirr, qirr_inst, iflag, clm_irr_thresholdtype, soi_z, clm_next, clm_write_logs, clm_last_rst, clm_daily_rst, clm_nlevsoi, clm_nlevlak) \
+                     clm_irr_threshold, qirr, qirr_inst, iflag, clm_irr_thresholdtype, soi_z, clm_next, clm_write_logs, clm_last_rst, clm_daily_rst, clm_nlevsoi, clm_nlevlak, \
+                     clm_rst_pfb, clm_rst_nz, clm_rst_data, clm_rst_found, clm_rst_step)                                                                                       \
   CLM_LSM(pressure_data, saturation_data, evap_trans_data, mask, porosity_data,                                                                                                \
           dz_mult_data, &istep, &dt, &t, &start_time, &dx, &dy, &dz, &ix, &iy, &nx, &ny, &nz, &nx_f, &ny_f, &nz_f, &nz_rz, &ip, &p, &q, &r, &gnx, &gny, &rank,                 \
           sw_data, lw_data, prcp_data, tas_data, u_data, v_data, patm_data, qatm_data,                                                                                         \
@@ -144,7 +174,8 @@ void SADVECT(double *s, double *sn,
           &clm_dump_interval, &clm_1d_out, &clm_forc_veg, clm_file_dir, &clm_file_dir_length, &clm_bin_out_dir,                                                                \
           &write_CLM_binary, &slope_accounting_CLM, &clm_beta_function, &clm_veg_function, &clm_veg_wilting, &clm_veg_fieldc,                                                                         \
           &clm_res_sat, &clm_irr_type, &clm_irr_cycle, &clm_irr_rate, &clm_irr_start, &clm_irr_stop,                                                                           \
-          &clm_irr_threshold, qirr, qirr_inst, iflag, &clm_irr_thresholdtype, &soi_z, &clm_next, &clm_write_logs, &clm_last_rst, &clm_daily_rst, &clm_nlevsoi, &clm_nlevlak);
+          &clm_irr_threshold, qirr, qirr_inst, iflag, &clm_irr_thresholdtype, &soi_z, &clm_next, &clm_write_logs, &clm_last_rst, &clm_daily_rst, &clm_nlevsoi, &clm_nlevlak,   \
+          &clm_rst_pfb, &clm_rst_nz, clm_rst_data, &clm_rst_found, &clm_rst_step);
 
 void CLM_LSM(double *pressure_data, double *saturation_data, double *evap_trans_data, double *mask, double *porosity_data,
              double *dz_mult_data, int *istep, double *dt, double *t, double *start_time,
@@ -160,7 +191,8 @@ void CLM_LSM(double *pressure_data, double *saturation_data, double *evap_trans_
              int *clm_veg_function, double *clm_veg_wilting, double *clm_veg_fieldc, double *clm_res_sat,
              int *clm_irr_type, int *clm_irr_cycle, double *clm_irr_rate, double *clm_irr_start, double *clm_irr_stop,
              double *clm_irr_threshold, double *qirr, double *qirr_inst, double *iflag, int *clm_irr_thresholdtype, int *soi_z,
-             int *clm_next, int *clm_write_logs, int *clm_last_rst, int *clm_daily_rst, int *clm_nlevsoi, int *clm_nlevlak);
+             int *clm_next, int *clm_write_logs, int *clm_last_rst, int *clm_daily_rst, int *clm_nlevsoi, int *clm_nlevlak,
+             int *clm_rst_pfb, int *clm_rst_nz, double *clm_rst_data, int *clm_rst_found, int *clm_rst_step);
 
 /* @RMM CRUNCHFLOW.F90*/
 //#define CRUNCHFLOW crunchflow_
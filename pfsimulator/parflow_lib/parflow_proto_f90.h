@@ -60,6 +60,35 @@ void ADVECT(double *s, double *sn,
             double *sleft, double *sright, double *sfluxz,
             double *dxscr, double *dyscr, double *dzscr, double *dzfrm);
 
+#if defined(_CRAYMPP)
+#define ADVECTPLANE ADVECTPLANE
+#elif defined(__bg__)
+#define ADVECTPLANE advectplane
+#else
+#define ADVECTPLANE advectplane_
+#endif
+
+#define CALL_ADVECTPLANE(s, sn, uedge, vedge, wedge, phi,                      \
+                         slx, sly, slz,                                        \
+                         lo, hi, dlo, dhi, hx, dt, fstord, k, km, kc, kp,      \
+                         sbot, stop, sbotp, sfrt, sbck, sleft, sright, sfluxz, \
+                         dxscr, dyscr, dzscr, dzfrm)                           \
+  ADVECTPLANE(s, sn, uedge, vedge, wedge, phi,                                 \
+              slx, sly, slz,                                                   \
+              lo, hi, dlo, dhi, hx, &dt, &fstord, &k, &km, &kc, &kp,           \
+              sbot, stop, sbotp, sfrt, sbck, sleft, sright, sfluxz,            \
+              dxscr, dyscr, dzscr, dzfrm)
+
+void ADVECTPLANE(double *s, double *sn,
+                 double *uedge, double *vedge, double *wedge, double *phi,
+                 double *slx, double *sly, double *slz,
+                 int *lo, int *hi, int *dlo, int *dhi, double *hx, double *dt, int *fstord,
+                 int *k, int *km, int *kc, int *kp,
+                 double *sbot, double *stop, double *sbotp,
+                 double *sfrt, double *sbck,
+                 double *sleft, double *sright, double *sfluxz,
+                 double *dxscr, double *dyscr, double *dzscr, double *dzfrm);
+
 /* sadvect.f */
 #if defined(_CRAYMPP)
 #define SADVECT SADVECT
@@ -0,0 +1,418 @@
+/*BHEADER*********************************************************************
+ *
+ *  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+ *  for the GNU Lesser General Public License.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License (as published
+ *  by the Free Software Foundation) version 2.1 dated February 1999.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+ *  and conditions of the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ *  USA
+ **********************************************************************EHEADER*/
+
+#ifndef _PF_SIMDLOOPS_H_
+#define _PF_SIMDLOOPS_H_
+
+/** @file
+ * @brief SIMD loop definitions
+ *
+ * The BoxLoops of the SIMD backend run serially like the default loops,
+ * but the body is a lambda called from a function template whose inner
+ * loop over i is an `omp simd` loop.  The templates are instantiated
+ * twice: with unit strides in x known at compile time, so the compiler
+ * sees contiguous accesses, and with the strides of the call for the
+ * generic case.  The bodies have to be free of dependencies between the
+ * iterations, as for the OpenMP and CUDA backends.
+ */
+
+/**
+ * @brief Interior macro for creating OpenMP pragma statements inside macro.  Relies on C99 _Pragma operator.
+ **/
+#define PRAGMA(args) _Pragma( #args )
+
+extern "C++"{
+
+  /**************************************************************************
+   * Reduction Variants
+   **************************************************************************/
+
+  /** Helper struct for type comparison (not for direct use). */
+  template <typename T>
+  struct ReduceMaxRes {T lambda_result;};
+#define ReduceMax_simd(a, b) struct ReduceMaxRes<decltype(a)> reduce_struct {.lambda_result = b}; return reduce_struct;
+
+  /** Helper struct for type comparison (not for direct use). */
+  template <typename T>
+  struct ReduceMinRes {T lambda_result;};
+#define ReduceMin_simd(a, b) struct ReduceMinRes<decltype(a)> reduce_struct {.lambda_result = b}; return reduce_struct;
+
+  /** Helper struct for type comparison (not for direct use). */
+  template <typename T>
+  struct ReduceSumRes {T lambda_result;};
+#define ReduceSum_simd(a, b) struct ReduceSumRes<decltype(a)> reduce_struct {.lambda_result = b}; return reduce_struct;
+
+  /**
+   * @brief Reduce the n results of row into sum.
+   *
+   * The overload is chosen by the result type of the loop body, so a body
+   * not ending in one of the above Reduce helpers does not compile.
+   **/
+  template <typename T, typename Row>
+  static inline void
+  SimdReduceRow(ReduceSumRes<T>, T &sum, int n, Row row)
+  {
+    T res = sum;
+
+    PRAGMA(omp simd reduction(+:res))
+    for (int i = 0; i < n; i++)
+    {
+      res += row(i).lambda_result;
+    }
+    sum = res;
+  }
+
+  template <typename T, typename Row>
+  static inline void
+  SimdReduceRow(ReduceMaxRes<T>, T &sum, int n, Row row)
+  {
+    T res = sum;
+
+    PRAGMA(omp simd reduction(max:res))
+    for (int i = 0; i < n; i++)
+    {
+      T val = row(i).lambda_result;
+      res = res > val ? res : val;
+    }
+    sum = res;
+  }
+
+  template <typename T, typename Row>
+  static inline void
+  SimdReduceRow(ReduceMinRes<T>, T &sum, int n, Row row)
+  {
+    T res = sum;
+
+    PRAGMA(omp simd reduction(min:res))
+    for (int i = 0; i < n; i++)
+    {
+      T val = row(i).lambda_result;
+      res = res < val ? res : val;
+    }
+    sum = res;
+  }
+
+  /**************************************************************************
+   * Loop templates
+   **************************************************************************/
+
+  /**
+   * @brief Stride in x of an index in the inner loop.
+   *
+   * @tparam Unit True if the strides in x of the loop are known to be 1
+   * @param sx X striding factor of the call
+   **/
+  template <bool Unit>
+  static inline int
+  SimdStride(int sx)
+  {
+    return Unit ? 1 : sx;
+  }
+
+  template <typename Body>
+  static inline void
+  SimdBoxLoopI0(int ix, int iy, int iz, int nx, int ny, int nz,
+                Body body)
+  {
+    for (int k = 0; k < nz; k++)
+    {
+      for (int j = 0; j < ny; j++)
+      {
+        PRAGMA(omp simd)
+        for (int i = 0; i < nx; i++)
+        {
+          body(ix + i, iy + j, iz + k);
+        }
+      }
+    }
+  }
+
+  template <bool Unit, typename Body>
+  static inline void
+  SimdBoxLoopI1(int ix, int iy, int iz, int nx, int ny, int nz,
+                int i1, int sx1, int jinc1, int kinc1,
+                Body body)
+  {
+    const int s1 = SimdStride<Unit>(sx1);
+
+    for (int k = 0; k < nz; k++)
+    {
+      for (int j = 0; j < ny; j++)
+      {
+        PRAGMA(omp simd)
+        for (int i = 0; i < nx; i++)
+        {
+          body(ix + i, iy + j, iz + k, i1 + i * s1);
+        }
+        i1 += nx * s1 + jinc1;
+      }
+      i1 += kinc1;
+    }
+  }
+
+  template <bool Unit, typename Body>
+  static inline void
+  SimdBoxLoopI2(int ix, int iy, int iz, int nx, int ny, int nz,
+                int i1, int sx1, int jinc1, int kinc1,
+                int i2, int sx2, int jinc2, int kinc2,
+                Body body)
+  {
+    const int s1 = SimdStride<Unit>(sx1);
+    const int s2 = SimdStride<Unit>(sx2);
+
+    for (int k = 0; k < nz; k++)
+    {
+      for (int j = 0; j < ny; j++)
+      {
+        PRAGMA(omp simd)
+        for (int i = 0; i < nx; i++)
+        {
+          body(ix + i, iy + j, iz + k, i1 + i * s1, i2 + i * s2);
+        }
+        i1 += nx * s1 + jinc1;
+        i2 += nx * s2 + jinc2;
+      }
+      i1 += kinc1;
+      i2 += kinc2;
+    }
+  }
+
+  template <bool Unit, typename Body>
+  static inline void
+  SimdBoxLoopI3(int ix, int iy, int iz, int nx, int ny, int nz,
+                int i1, int sx1, int jinc1, int kinc1,
+                int i2, int sx2, int jinc2, int kinc2,
+                int i3, int sx3, int jinc3, int kinc3,
+                Body body)
+  {
+    const int s1 = SimdStride<Unit>(sx1);
+    const int s2 = SimdStride<Unit>(sx2);
+    const int s3 = SimdStride<Unit>(sx3);
+
+    for (int k = 0; k < nz; k++)
+    {
+      for (int j = 0; j < ny; j++)
+      {
+        PRAGMA(omp simd)
+        for (int i = 0; i < nx; i++)
+        {
+          body(ix + i, iy + j, iz + k, i1 + i * s1, i2 + i * s2, i3 + i * s3);
+        }
+        i1 += nx * s1 + jinc1;
+        i2 += nx * s2 + jinc2;
+        i3 += nx * s3 + jinc3;
+      }
+      i1 += kinc1;
+      i2 += kinc2;
+      i3 += kinc3;
+    }
+  }
+
+  template <bool Unit, typename T, typename Body>
+  static inline void
+  SimdBoxLoopReduceI1(T &sum,
+                      int ix, int iy, int iz, int nx, int ny, int nz,
+                      int i1, int sx1, int jinc1, int kinc1,
+                      Body body)
+  {
+    typedef decltype(body(0, 0, 0, 0)) Result;
+    const int s1 = SimdStride<Unit>(sx1);
+
+    for (int k = 0; k < nz; k++)
+    {
+      for (int j = 0; j < ny; j++)
+      {
+        SimdReduceRow(Result(), sum, nx,
+                      [&](const int i)
+        {
+          return body(ix + i, iy + j, iz + k, i1 + i * s1);
+        });
+        i1 += nx * s1 + jinc1;
+      }
+      i1 += kinc1;
+    }
+  }
+
+  template <bool Unit, typename T, typename Body>
+  static inline void
+  SimdBoxLoopReduceI2(T &sum,
+                      int ix, int iy, int iz, int nx, int ny, int nz,
+                      int i1, int sx1, int jinc1, int kinc1,
+                      int i2, int sx2, int jinc2, int kinc2,
+                      Body body)
+  {
+    typedef decltype(body(0, 0, 0, 0, 0)) Result;
+    const int s1 = SimdStride<Unit>(sx1);
+    const int s2 = SimdStride<Unit>(sx2);
+
+    for (int k = 0; k < nz; k++)
+    {
+      for (int j = 0; j < ny; j++)
+      {
+        SimdReduceRow(Result(), sum, nx,
+                      [&](const int i)
+        {
+          return body(ix + i, iy + j, iz + k, i1 + i * s1, i2 + i * s2);
+        });
+        i1 += nx * s1 + jinc1;
+        i2 += nx * s2 + jinc2;
+      }
+      i1 += kinc1;
+      i2 += kinc2;
+    }
+  }
+
+} // Extern C++
+
+/**************************************************************************
+ * SIMD BoxLoop Variants
+ **************************************************************************/
+
+#define BoxLoopI0_simd(i, j, k, ix, iy, iz, nx, ny, nz, body)           \
+  {                                                                     \
+    auto PV_body = [&](const int i, const int j, const int k)           \
+                   {                                                    \
+                     body;                                              \
+                   };                                                   \
+    SimdBoxLoopI0(ix, iy, iz, nx, ny, nz, PV_body);                     \
+  }
+
+#define BoxLoopI1_simd(i, j, k,                                         \
+                       ix, iy, iz, nx, ny, nz,                          \
+                       i1, nx1, ny1, nz1, sx1, sy1, sz1,                \
+                       body)                                            \
+  {                                                                     \
+    DeclareInc(PV_jinc_1, PV_kinc_1, nx, ny, nz, nx1, ny1, nz1, sx1, sy1, sz1); \
+    auto PV_body = [&](const int i, const int j, const int k,           \
+                       const int i1)                                    \
+                   {                                                    \
+                     body;                                              \
+                   };                                                   \
+    if ((sx1) == 1)                                                     \
+      SimdBoxLoopI1<true>(ix, iy, iz, nx, ny, nz,                       \
+                          i1, sx1, PV_jinc_1, PV_kinc_1, PV_body);      \
+    else                                                                \
+      SimdBoxLoopI1<false>(ix, iy, iz, nx, ny, nz,                      \
+                           i1, sx1, PV_jinc_1, PV_kinc_1, PV_body);     \
+  }
+
+#define BoxLoopI2_simd(i, j, k,                                         \
+                       ix, iy, iz, nx, ny, nz,                          \
+                       i1, nx1, ny1, nz1, sx1, sy1, sz1,                \
+                       i2, nx2, ny2, nz2, sx2, sy2, sz2,                \
+                       body)                                            \
+  {                                                                     \
+    DeclareInc(PV_jinc_1, PV_kinc_1, nx, ny, nz, nx1, ny1, nz1, sx1, sy1, sz1); \
+    DeclareInc(PV_jinc_2, PV_kinc_2, nx, ny, nz, nx2, ny2, nz2, sx2, sy2, sz2); \
+    auto PV_body = [&](const int i, const int j, const int k,           \
+                       const int i1, const int i2)                      \
+                   {                                                    \
+                     body;                                              \
+                   };                                                   \
+    if ((sx1) == 1 && (sx2) == 1)                                       \
+      SimdBoxLoopI2<true>(ix, iy, iz, nx, ny, nz,                       \
+                          i1, sx1, PV_jinc_1, PV_kinc_1,                \
+                          i2, sx2, PV_jinc_2, PV_kinc_2, PV_body);      \
+    else                                                                \
+      SimdBoxLoopI2<false>(ix, iy, iz, nx, ny, nz,                      \
+                           i1, sx1, PV_jinc_1, PV_kinc_1,               \
+                           i2, sx2, PV_jinc_2, PV_kinc_2, PV_body);     \
+  }
+
+#define BoxLoopI3_simd(i, j, k,                                         \
+                       ix, iy, iz, nx, ny, nz,                          \
+                       i1, nx1, ny1, nz1, sx1, sy1, sz1,                \
+                       i2, nx2, ny2, nz2, sx2, sy2, sz2,                \
+                       i3, nx3, ny3, nz3, sx3, sy3, sz3,                \
+                       body)                                            \
+  {                                                                     \
+    DeclareInc(PV_jinc_1, PV_kinc_1, nx, ny, nz, nx1, ny1, nz1, sx1, sy1, sz1); \
+    DeclareInc(PV_jinc_2, PV_kinc_2, nx, ny, nz, nx2, ny2, nz2, sx2, sy2, sz2); \
+    DeclareInc(PV_jinc_3, PV_kinc_3, nx, ny, nz, nx3, ny3, nz3, sx3, sy3, sz3); \
+    auto PV_body = [&](const int i, const int j, const int k,           \
+                       const int i1, const int i2, const int i3)        \
+                   {                                                    \
+                     body;                                              \
+                   };                                                   \
+    if ((sx1) == 1 && (sx2) == 1 && (sx3) == 1)                         \
+      SimdBoxLoopI3<true>(ix, iy, iz, nx, ny, nz,                       \
+                          i1, sx1, PV_jinc_1, PV_kinc_1,                \
+                          i2, sx2, PV_jinc_2, PV_kinc_2,                \
+                          i3, sx3, PV_jinc_3, PV_kinc_3, PV_body);      \
+    else                                                                \
+      SimdBoxLoopI3<false>(ix, iy, iz, nx, ny, nz,                      \
+                           i1, sx1, PV_jinc_1, PV_kinc_1,               \
+                           i2, sx2, PV_jinc_2, PV_kinc_2,               \
+                           i3, sx3, PV_jinc_3, PV_kinc_3, PV_body);     \
+  }
+
+/** SIMD BoxLoopReduceI1 definition.
+    Last statement in the body of the loop must be one of the above Reduce helper structures.
+    The results are reduced row by row, so the order of a sum differs from the default loops.
+    See innerprod.c or vector_utilities.c for example usages
+ */
+#define BoxLoopReduceI1_simd(sum,                                       \
+                             i, j, k,                                   \
+                             ix, iy, iz, nx, ny, nz,                    \
+                             i1, nx1, ny1, nz1, sx1, sy1, sz1,          \
+                             body)                                      \
+  {                                                                     \
+    DeclareInc(PV_jinc_1, PV_kinc_1, nx, ny, nz, nx1, ny1, nz1, sx1, sy1, sz1); \
+    auto PV_body = [&](const int i, const int j, const int k,           \
+                       const int i1)                                    \
+                   {                                                    \
+                     body;                                              \
+                   };                                                   \
+    if ((sx1) == 1)                                                     \
+      SimdBoxLoopReduceI1<true>(sum, ix, iy, iz, nx, ny, nz,            \
+                                i1, sx1, PV_jinc_1, PV_kinc_1, PV_body); \
+    else                                                                \
+      SimdBoxLoopReduceI1<false>(sum, ix, iy, iz, nx, ny, nz,           \
+                                 i1, sx1, PV_jinc_1, PV_kinc_1, PV_body); \
+  }
+
+/** SIMD BoxLoopReduceI2 definition.
+    Last statement in the body of the loop must be one of the above Reduce helper structures.
+ */
+#define BoxLoopReduceI2_simd(sum,                                       \
+                             i, j, k,                                   \
+                             ix, iy, iz, nx, ny, nz,                    \
+                             i1, nx1, ny1, nz1, sx1, sy1, sz1,          \
+                             i2, nx2, ny2, nz2, sx2, sy2, sz2,          \
+                             body)                                      \
+  {                                                                     \
+    DeclareInc(PV_jinc_1, PV_kinc_1, nx, ny, nz, nx1, ny1, nz1, sx1, sy1, sz1); \
+    DeclareInc(PV_jinc_2, PV_kinc_2, nx, ny, nz, nx2, ny2, nz2, sx2, sy2, sz2); \
+    auto PV_body = [&](const int i, const int j, const int k,           \
+                       const int i1, const int i2)                      \
+                   {                                                    \
+                     body;                                              \
+                   };                                                   \
+    if ((sx1) == 1 && (sx2) == 1)                                       \
+      SimdBoxLoopReduceI2<true>(sum, ix, iy, iz, nx, ny, nz,            \
+                                i1, sx1, PV_jinc_1, PV_kinc_1,          \
+                                i2, sx2, PV_jinc_2, PV_kinc_2, PV_body); \
+    else                                                                \
+      SimdBoxLoopReduceI2<false>(sum, ix, iy, iz, nx, ny, nz,           \
+                                 i1, sx1, PV_jinc_1, PV_kinc_1,         \
+                                 i2, sx2, PV_jinc_2, PV_kinc_2, PV_body); \
+  }
+
+#endif // _PF_SIMDLOOPS_H_
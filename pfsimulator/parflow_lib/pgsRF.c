@@ -39,6 +39,10 @@
 #include <limits.h>
 #include <float.h>
 
+#ifdef PARFLOW_HAVE_OMP
+#include <omp.h>
+#endif
+
 /*--------------------------------------------------------------------------
  * Structures
  *--------------------------------------------------------------------------*/
@@ -66,6 +70,257 @@ typedef struct {
 } InstanceXtra;
 
 
+/*--------------------------------------------------------------------------
+ * Kriging data shared by all nodes of one region of the random path.
+ * The previously simulated points around every node of a region sit at
+ * the same offsets, so the factorization of their covariance matrix
+ * (A11) and the weights w are computed once per region.  External
+ * conditioning points only differ from node to node in which offsets
+ * they occupy; the columns A12 and A11^-1 A12 of an offset are computed
+ * the first time the offset is met and reused for the whole region.
+ *--------------------------------------------------------------------------*/
+
+typedef struct {
+  int npts;                     /* Simulated points in the neighborhood */
+  int       *stencil;           /* Their index offsets in tmpRF */
+  int       *ixx, *iyy, *izz;   /* Their positions in the marker box */
+  double    *b;                 /* Their covariances with the node */
+  double    *w;                 /* Kriging weights, A11 w = b */
+  double csigma;                /* Conditional std. dev. without ext. data */
+
+  int rpx, rpy, rpz;
+  int i_search, j_search, k_search;
+  int iLx, iLy, iLz;
+  int nLx, nLy;
+  int sy, sz;                   /* Strides of the tmpRF subvector */
+  int max_cpts;
+  int dist_type;
+  double low_cutoff;
+  double high_cutoff;
+  double tiny;
+
+  char      ***marker;
+  double    ***cov;
+  double    **cond_cols;        /* A12 and A11^-1 A12 column by offset */
+} PGSRegion;
+
+typedef struct {
+  int       *cii, *cjj, *ckk;   /* Offsets of the external points */
+  double    *cval;              /* Their values */
+  double    *b2;
+  double    *x2;
+  double    *w2;
+  double    *A22;
+} PGSNodeWork;
+
+#define PGSOffsetIndex(region, ii, jj, kk)                              \
+  ((((kk) + (region)->iLz) * (region)->nLy + ((jj) + (region)->iLy))    \
+   * (region)->nLx + ((ii) + (region)->iLx))
+
+
+/*--------------------------------------------------------------------------
+ * PGSCacheCondColumns:
+ *   Compute the kriging columns of the external conditioning points in
+ *   the search neighborhood of the node at index2 that are not cached yet.
+ *--------------------------------------------------------------------------*/
+
+static void PGSCacheCondColumns(
+                                PGSRegion *region,
+                                double *   A11,
+                                double *   tmpRFp,
+                                int        index2)
+{
+  int npts = region->npts;
+  int rpx = region->rpx;
+  int rpy = region->rpy;
+  int rpz = region->rpz;
+  double ***cov = region->cov;
+  double *col;
+  int ii, jj, kk, m, id;
+
+  for (kk = -region->k_search; kk <= region->k_search; kk++)
+    for (jj = -region->j_search; jj <= region->j_search; jj++)
+      for (ii = -region->i_search; ii <= region->i_search; ii++)
+      {
+        if (region->marker[rpx + ii][rpy + jj][rpz + kk] ||
+            !(fabs(tmpRFp[index2 + ii + jj * region->sy + kk * region->sz])
+              > region->tiny))
+          continue;
+
+        id = PGSOffsetIndex(region, ii, jj, kk);
+        if (region->cond_cols[id])
+          continue;
+
+        col = talloc(double, 2 * npts + 1);
+        for (m = 0; m < npts; m++)
+        {
+          col[m] = cov[abs(region->ixx[m] - rpx - ii)]
+                   [abs(region->iyy[m] - rpy - jj)]
+                   [abs(region->izz[m] - rpz - kk)];
+          col[npts + m] = col[m];
+        }
+        if (npts > 0)
+          dposl_(A11, &npts, &npts, col + npts);
+
+        region->cond_cols[id] = col;
+      }
+}
+
+
+/*--------------------------------------------------------------------------
+ * PGSSimulateNode:
+ *   Krige the node at index2 from the simulated points of its region and
+ *   any external conditioning data around it, then draw its value from
+ *   the conditional distribution with the standard normal deviate gau.
+ *--------------------------------------------------------------------------*/
+
+static void PGSSimulateNode(
+                            PGSRegion *  region,
+                            PGSNodeWork *work,
+                            double *     tmpRFp,
+                            int          index2,
+                            double       gau)
+{
+  int npts = region->npts;
+  int rpx = region->rpx;
+  int rpy = region->rpy;
+  int rpz = region->rpz;
+  double ***cov = region->cov;
+  double *w = region->w;
+  double *b = region->b;
+  double cmean, csigma, sum, value;
+  double *col1, *col2;
+  int ci_search, cj_search, ck_search;
+  int ii, jj, kk, m, c1, c2, cpts, ierr;
+
+  /* Collect the external conditioning data, reducing the size of the
+   * search neighborhood one axis at a time if there are too many */
+  cpts = 0;
+  if (region->cond_cols)
+  {
+    ci_search = region->i_search;
+    cj_search = region->j_search;
+    ck_search = region->k_search;
+    do
+    {
+      if (cpts > region->max_cpts)
+      {
+        /* If ci_search is the biggest, reduce it by one. */
+        if ((ci_search >= cj_search) && (ci_search >= ck_search))
+          ci_search--;
+
+        /* Or, if cj_search is the biggest, reduce it by one. */
+        else if ((cj_search >= ci_search) && (cj_search >= ck_search))
+          cj_search--;
+
+        /* Otherwise, reduce ck_search by one. */
+        else
+          ck_search--;
+      }
+
+      cpts = 0;
+      for (kk = -ck_search; kk <= ck_search; kk++)
+        for (jj = -cj_search; jj <= cj_search; jj++)
+          for (ii = -ci_search; ii <= ci_search; ii++)
+          {
+            value = tmpRFp[index2 + ii + jj * region->sy + kk * region->sz];
+            if (!(region->marker[rpx + ii][rpy + jj][rpz + kk]) &&
+                (fabs(value) > region->tiny))
+            {
+              work->cii[cpts] = ii;
+              work->cjj[cpts] = jj;
+              work->ckk[cpts] = kk;
+              work->cval[cpts++] = value;
+            }
+          }
+    }
+    while (cpts > region->max_cpts);
+  }
+
+  if (cpts == 0)
+  {
+    cmean = 0.0;
+    for (m = 0; m < npts; m++)
+      cmean += w[m] * tmpRFp[index2 + region->stencil[m]];
+    csigma = region->csigma;
+  }
+
+  /*--------------------------------------------------
+   * Conditioning to external data is done here.
+   *--------------------------------------------------*/
+  else
+  {
+    /* Compute b2' = b2 - A21 * A11_inv * b1 and
+     * A22' = A22 - A21 * A11_inv * A12 */
+    for (c2 = 0; c2 < cpts; c2++)
+    {
+      col2 = region->cond_cols[PGSOffsetIndex(region, work->cii[c2],
+                                              work->cjj[c2], work->ckk[c2])];
+      sum = 0.0;
+      for (m = 0; m < npts; m++)
+        sum += col2[m] * w[m];
+      work->b2[c2] = cov[abs(work->cii[c2])][abs(work->cjj[c2])]
+                     [abs(work->ckk[c2])] - sum;
+
+      for (c1 = 0; c1 < cpts; c1++)
+      {
+        col1 = region->cond_cols[PGSOffsetIndex(region, work->cii[c1],
+                                                work->cjj[c1], work->ckk[c1])];
+        sum = 0.0;
+        for (m = 0; m < npts; m++)
+          sum += col1[m] * col2[npts + m];
+        work->A22[c2 * cpts + c1] =
+          cov[abs(work->cii[c1] - work->cii[c2])]
+          [abs(work->cjj[c1] - work->cjj[c2])]
+          [abs(work->ckk[c1] - work->ckk[c2])] - sum;
+      }
+    }
+
+    /* Compute x2 where A22' * x2 = b2' */
+    for (c1 = 0; c1 < cpts; c1++)
+      work->x2[c1] = work->b2[c1];
+    dpofa_(work->A22, &cpts, &cpts, &ierr);
+    dposl_(work->A22, &cpts, &cpts, work->x2);
+
+    /* Compute w2 = A11_inv * (b1 - A12 * x2) */
+    for (m = 0; m < npts; m++)
+      work->w2[m] = w[m];
+    for (c1 = 0; c1 < cpts; c1++)
+    {
+      col1 = region->cond_cols[PGSOffsetIndex(region, work->cii[c1],
+                                              work->cjj[c1], work->ckk[c1])];
+      for (m = 0; m < npts; m++)
+        work->w2[m] -= work->x2[c1] * col1[npts + m];
+    }
+
+    cmean = 0.0;
+    csigma = 0.0;
+    for (m = 0; m < npts; m++)
+    {
+      cmean += work->w2[m] * tmpRFp[index2 + region->stencil[m]];
+      csigma += work->w2[m] * b[m];
+    }
+    for (c1 = 0; c1 < cpts; c1++)
+    {
+      cmean += work->x2[c1] * work->cval[c1];
+      csigma += work->x2[c1] * work->b2[c1];
+    }
+    csigma = sqrt(cov[0][0][0] - csigma);
+  }
+
+  tmpRFp[index2] = csigma * gau + cmean;
+
+  /* Cutoff tail values if required */
+  if (region->dist_type > 1)
+  {
+    if (tmpRFp[index2] < region->low_cutoff)
+      tmpRFp[index2] = region->low_cutoff;
+    if (tmpRFp[index2] > region->high_cutoff)
+      tmpRFp[index2] = region->high_cutoff;
+  }
+}
+
+
 /*--------------------------------------------------------------------------
  * PGSRF
  *--------------------------------------------------------------------------*/
@@ -119,11 +374,10 @@ void         PGSRF(
   int gridloop;
   int i, j, k, n, m;
   int ii, jj, kk;
-  int i2, j2, k2;
   int imin, jmin, kmin;
   int rpx, rpy, rpz;
   int npts;
-  int index1, index2, index3;
+  int index1, index2;
 
   /* Spatial variables */
   double    *fieldp;
@@ -137,29 +391,28 @@ void         PGSRF(
   int ref;
   int ix2, iy2, iz2;
   int i_search, j_search, k_search;
-  int ci_search, cj_search, ck_search;
+  int sy, sz;
   double X0, Y0, Z0;
 
   /* Variables used in kriging  algorithm */
-  double cmean, csigma;         /* Conditional mean and std. dev. from kriging */
-  double A;
-  double    *A_sub;             /* Sub-covariance matrix for external cond pts */
+  double csigma;                /* Conditional std. dev. from kriging */
   double    *A11;               /* Submatrix; note that A11 is 1-dim */
-  double    **A12, **A21, **A22;/* Submatrices for external conditioning data */
-  double    **M;                /* Used as a temporary matrix */
   double    *b;                 /* Covariance vector for conditioning points */
-  double    *b_tmp, *b2;
-  double    *w, *w_tmp;         /* Solution vector to Aw=b */
+  double    *w;                 /* Solution vector to Aw=b */
   int       *ixx, *iyy, *izz;
-  double    *value;
+  int       *stencil;
   int di, dj, dk;
   double uni, gau;
   double    ***cov;
   int ierr;
+  PGSRegion region;
 
-  /* Conditioning data variables */
-  int cpts;                     /* N cond pts for a single simulated node */
-  double    *cval;              /* Values for cond data for single node */
+  /* Nodes of the current region and per thread work space */
+  int num_nodes;
+  int       *node_index;
+  double    *node_gau;
+  PGSNodeWork *node_work;
+  int num_threads, max_cpts_node;
 
   /* Communications */
   VectorUpdateCommHandle *handle;
@@ -171,7 +424,6 @@ void         PGSRF(
   int p, r, modulus;
   double a1, a2, a3;
   double cx, cy, cz;
-  double sum;
 
   // FIXME Shouldn't we get this from numeric_limits?
   double Tiny = 1.0e-12;
@@ -311,29 +563,33 @@ void         PGSRF(
 
   /* Allocate memory for variables that will be used in kriging */
   A11 = ctalloc(double, nLxyz * nLxyz);
-  A_sub = ctalloc(double, nLxyz * nLxyz);
-  A12 = ctalloc(double*, nLxyz);
-  A21 = ctalloc(double*, nLxyz);
-  A22 = ctalloc(double*, nLxyz);
-  M = ctalloc(double*, nLxyz);
-  for (i = 0; i < nLxyz; i++)
-  {
-    A12[i] = ctalloc(double, nLxyz);
-    A21[i] = ctalloc(double, nLxyz);
-    A22[i] = ctalloc(double, nLxyz);
-    M[i] = ctalloc(double, nLxyz);
-  }
-
   b = ctalloc(double, nLxyz);
-  b2 = ctalloc(double, nLxyz);
-  b_tmp = ctalloc(double, nLxyz);
   w = ctalloc(double, nLxyz);
-  w_tmp = ctalloc(double, nLxyz);
-  value = ctalloc(double, nLxyz);
-  cval = ctalloc(double, nLxyz);
   ixx = ctalloc(int, nLxyz);
   iyy = ctalloc(int, nLxyz);
   izz = ctalloc(int, nLxyz);
+  stencil = ctalloc(int, nLxyz);
+
+  /* Work space for kriging the nodes with external conditioning
+   * data, one per thread */
+#ifdef PARFLOW_HAVE_OMP
+  num_threads = omp_get_max_threads();
+#else
+  num_threads = 1;
+#endif
+  max_cpts_node = pfmin(max_cpts, nLxyz);
+  node_work = ctalloc(PGSNodeWork, num_threads);
+  for (n = 0; n < num_threads; n++)
+  {
+    node_work[n].cii = ctalloc(int, nLxyz);
+    node_work[n].cjj = ctalloc(int, nLxyz);
+    node_work[n].ckk = ctalloc(int, nLxyz);
+    node_work[n].cval = ctalloc(double, nLxyz);
+    node_work[n].b2 = ctalloc(double, nLxyz);
+    node_work[n].x2 = ctalloc(double, nLxyz);
+    node_work[n].w2 = ctalloc(double, nLxyz);
+    node_work[n].A22 = ctalloc(double, max_cpts_node * max_cpts_node + 1);
+  }
 
   /* Allocate space for the "marker" used to keep track of which
    * points in a representative correlation box have been simulated
@@ -376,6 +632,28 @@ void         PGSRF(
     }
   }
 
+  region.stencil = stencil;
+  region.ixx = ixx;
+  region.iyy = iyy;
+  region.izz = izz;
+  region.b = b;
+  region.w = w;
+  region.iLx = iLx;
+  region.iLy = iLy;
+  region.iLz = iLz;
+  region.nLx = nLx;
+  region.nLy = nLy;
+  region.max_cpts = max_cpts;
+  region.dist_type = dist_type;
+  region.low_cutoff = low_cutoff;
+  region.high_cutoff = high_cutoff;
+  region.tiny = Tiny;
+  region.marker = marker;
+  region.cov = cov;
+  region.cond_cols = NULL;
+  if (nc > 0)
+    region.cond_cols = ctalloc(double*, nLxyz);
+
   /*--------------------------------------------------------------------
    * Start pGs algorithm
    *--------------------------------------------------------------------*/
@@ -402,6 +680,16 @@ void         PGSRF(
     /* RDF: assume resolution is the same in all 3 directions */
     ref = SubgridRX(subgrid);
 
+    sy = SubvectorNX(sub_tmpRF);
+    sz = SubvectorNX(sub_tmpRF) * SubvectorNY(sub_tmpRF);
+    region.sy = sy;
+    region.sz = sz;
+
+    /* Every region holds at most one node per (iLx+1, iLy+1, iLz+1) box */
+    num_nodes = (nx / iLxp1 + 1) * (ny / iLyp1 + 1) * (nz / iLzp1 + 1);
+    node_index = talloc(int, num_nodes);
+    node_gau = talloc(double, num_nodes);
+
     /* Initialize tmpRF vector */
     GrGeomInLoop(i, j, k, gr_geounit, ref, ix, iy, iz, nx, ny, nz,
     {
@@ -598,225 +886,75 @@ void         PGSRF(
           csigma += w[i] * b[i];
         csigma = sqrt(cov[0][0][0] - csigma);
 
+        /* Index offsets of the simulated points from the node */
+        for (m = 0; m < npts; m++)
+          stencil[m] = (ixx[m] - rpx) + (iyy[m] - rpy) * sy
+                       + (izz[m] - rpz) * sz;
+
+        region.npts = npts;
+        region.csigma = csigma;
+        region.rpx = rpx;
+        region.rpy = rpy;
+        region.rpz = rpz;
+        region.i_search = i_search;
+        region.j_search = j_search;
+        region.k_search = k_search;
+
         /* The following loop hits every point in the current
          * region. That is, it skips by max_search_rad+1
          * through the subgrid. In this way, all the points
          * in this loop may simulated simultaneously; each is
-         * outside the search radius of all the others. */
+         * outside the search radius of all the others.
+         *
+         * Only simulate points that don't already have a value.
+         * If a node already has a value, it was assigned as
+         * external conditioning data, so we don't need to
+         * simulate it.  The random numbers are drawn here in
+         * path order so the nodes can then be kriged in any order. */
         nxG = (nx + ix);
         nyG = (ny + iy);
         nzG = (nz + iz);
 
+        num_nodes = 0;
         for (k = iz2; k < nzG; k += iLzp1)
           for (j = iy2; j < nyG; j += iLyp1)
             for (i = ix2; i < nxG; i += iLxp1)
             {
-              index1 = SubvectorEltIndex(sub_field, i, j, k);
               index2 = SubvectorEltIndex(sub_tmpRF, i, j, k);
 
-              /* Only simulate points in this geounit and that don't
-               * already have a value. If a node already has a value,
-               * it was assigned as external conditioning data,
-               * so we don't need to simulate it.  */
               if (fabs(tmpRFp[index2]) < Tiny)
               {
-                /* Condition the random variable */
-                m = 0;
-                cpts = 0;
-
-                for (kk = -k_search; kk <= k_search; kk++)
-                  for (jj = -j_search; jj <= j_search; jj++)
-                    for (ii = -i_search; ii <= i_search; ii++)
-                    {
-                      value[m] = 0.0;
-                      index3 = SubvectorEltIndex(sub_tmpRF, i + ii, j + jj, k + kk);
-
-                      if (marker[ii + rpx][jj + rpy][kk + rpz])
-                      {
-                        value[m++] = tmpRFp[index3];
-                      }
-
-                      /* In this case, there is a value at this point,
-                       * but it wasn't simulated yet (as indicated by the
-                       * fact that the marker has no place for it). Thus,
-                       * it must be external conditioning data.  */
-                      else if (fabs(tmpRFp[index3]) > Tiny)
-                      {
-                        ixx[npts + cpts] = rpx + ii;
-                        iyy[npts + cpts] = rpy + jj;
-                        izz[npts + cpts] = rpz + kk;
-                        cval[cpts++] = tmpRFp[index3];
-                      }
-                    }
-
-                /* If cpts is too large, reduce the size of the
-                 * search neighborhood, one axis at a time. */
-                /* Define the size of the search neighborhood */
-                ci_search = i_search;
-                cj_search = j_search;
-                ck_search = k_search;
-                while (cpts > max_cpts)
-                {
-                  /* If ci_search is the biggest, reduce it by one. */
-                  if ((ci_search >= cj_search) && (ci_search >= ck_search))
-                    ci_search--;
-
-                  /* Or, if cj_search is the biggest, reduce it by one. */
-                  else if ((cj_search >= ci_search) && (cj_search >= ck_search))
-                    cj_search--;
-
-                  /* Otherwise, reduce ck_search by one. */
-                  else
-                    ck_search--;
-
-                  /* Now recount the conditioning data points */
-                  m = 0;
-                  cpts = 0;
-                  for (kk = -ck_search; kk <= ck_search; kk++)
-                    for (jj = -cj_search; jj <= cj_search; jj++)
-                      for (ii = -ci_search; ii <= ci_search; ii++)
-                      {
-                        index3 = SubvectorEltIndex(sub_tmpRF, i + ii, j + jj, k + kk);
-
-                        if (!(marker[rpx + ii][rpy + jj][rpz + kk]) &&
-                            (fabs(tmpRFp[index3]) > Tiny))
-                        {
-                          ixx[npts + cpts] = rpx + ii;
-                          iyy[npts + cpts] = rpy + jj;
-                          izz[npts + cpts] = rpz + kk;
-                          cval[cpts++] = tmpRFp[index3];
-                        }
-                      }
-                }
+                if (region.cond_cols)
+                  PGSCacheCondColumns(&region, A11, tmpRFp, index2);
 
-                for (i2 = 0; i2 < npts; i2++)
-                  w_tmp[i2] = w[i2];
-
-                /*--------------------------------------------------
-                 * Conditioning to external data is done here.
-                 *--------------------------------------------------*/
-                if (cpts > 0)
-                {
-                  /* Compute the submatrices */
-                  for (j2 = 0; j2 < npts + cpts; j2++)
-                  {
-                    di = abs(rpx - ixx[j2]);
-                    dj = abs(rpy - iyy[j2]);
-                    dk = abs(rpz - izz[j2]);
-                    b[j2] = cov[di][dj][dk];
-
-                    for (i2 = 0; i2 < npts + cpts; i2++)
-                    {
-                      di = abs(ixx[i2] - ixx[j2]);
-                      dj = abs(iyy[i2] - iyy[j2]);
-                      dk = abs(izz[i2] - izz[j2]);
-                      A = cov[di][dj][dk];
-                      if (i2 < npts && j2 >= npts)
-                        A12[i2][j2 - npts] = A;
-                      if (i2 >= npts && j2 < npts)
-                        A21[i2 - npts][j2] = A;
-                      if (i2 >= npts && j2 >= npts)
-                        A22[i2 - npts][j2 - npts] = A;
-                    }
-                  }
-
-                  /* Compute b2' = b2 - A21 * A11_inv * b1 and augment b1 */
-                  for (i2 = 0; i2 < cpts; i2++)
-                    b2[i2] = b[i2 + npts];
-                  for (i2 = 0; i2 < npts; i2++)
-                    b_tmp[i2] = b[i2];
-                  dposl_(A11, &npts, &npts, b_tmp);
-
-                  for (i2 = 0; i2 < cpts; i2++)
-                  {
-                    sum = 0.0;
-                    for (j2 = 0; j2 < npts; j2++)
-                    {
-                      sum += A21[i2][j2] * b_tmp[j2];
-                    }
-                    b2[i2] -= sum;
-                  }
-                  for (i2 = 0; i2 < cpts; i2++)
-                    b[i2 + npts] = b2[i2];
-
-                  /* Compute A22' = A22 - A21 * A11_inv * A12 */
-                  for (j2 = 0; j2 < cpts; j2++)
-                    for (i2 = 0; i2 < npts; i2++)
-                      M[j2][i2] = A12[i2][j2];
-
-                  if (npts > 0)
-                  {
-                    for (i2 = 0; i2 < cpts; i2++)
-                      dposl_(A11, &npts, &npts, M[i2]);
-                  }
-
-                  for (j2 = 0; j2 < cpts; j2++)
-                    for (i2 = 0; i2 < cpts; i2++)
-                    {
-                      sum = 0.0;
-                      for (k2 = 0; k2 < npts; k2++)
-                        sum += A21[i2][k2] * M[j2][k2];
-                      A22[i2][j2] -= sum;
-                    }
-
-                  m = 0;
-                  for (j2 = 0; j2 < cpts; j2++)
-                    for (i2 = 0; i2 < cpts; i2++)
-                      A_sub[m++] = A22[i2][j2];
-
-                  /* Compute x2 where A22*x2 = b2' */
-                  dpofa_(A_sub, &cpts, &cpts, &ierr);
-                  dposl_(A_sub, &cpts, &cpts, b2);
-
-                  /* Compute w_tmp where A11*w_tmp = (b1 - A12*b2) */
-                  if (npts > 0)
-                  {
-                    for (i2 = 0; i2 < npts; i2++)
-                    {
-                      sum = 0.0;
-                      for (k2 = 0; k2 < cpts; k2++)
-                        sum += A12[i2][k2] * b2[k2];
-                      w_tmp[i2] = b[i2] - sum;
-                    }
-                    dposl_(A11, &npts, &npts, w_tmp);
-                  }
-
-                  /* Fill in the rest of w_tmp with b2 */
-                  for (i2 = npts; i2 < npts + cpts; i2++)
-                  {
-                    w_tmp[i2] = b2[i2];
-                    value[i2] = cval[i2 - npts];
-                  }
-
-                  /* Recompute csigma */
-                  csigma = 0.0;
-                  for (i2 = 0; i2 < npts + cpts; i2++)
-                    csigma += w_tmp[i2] * b[i2];
-                  csigma = sqrt(cov[0][0][0] - csigma);
-                }
-                /*--------------------------------------------------
-                 * End of external conditioning
-                 *--------------------------------------------------*/
-                cmean = 0.0;
-                for (m = 0; m < npts + cpts; m++)
-                  cmean += w_tmp[m] * value[m];
-
-                /* uni = fieldp[index1]; */
                 uni = Rand();
                 gauinv_(&uni, &gau, &ierr);
-                tmpRFp[index2] = csigma * gau + cmean;
-
-                /* Cutoff tail values if required */
-                if (dist_type > 1)
-                {
-                  if (tmpRFp[index2] < low_cutoff)
-                    tmpRFp[index2] = low_cutoff;
-                  if (tmpRFp[index2] > high_cutoff)
-                    tmpRFp[index2] = high_cutoff;
-                }
-              }        /* if( abs(tmpRFp[index2]) < Tiny )  */
+                node_index[num_nodes] = index2;
+                node_gau[num_nodes++] = gau;
+              }
             }
-        /* end of triple for-loops over i,j,k  */
+
+#ifdef PARFLOW_HAVE_OMP
+        #pragma omp parallel for schedule(dynamic, 16)
+#endif
+        for (m = 0; m < num_nodes; m++)
+        {
+#ifdef PARFLOW_HAVE_OMP
+          PGSNodeWork *work = node_work + omp_get_thread_num();
+#else
+          PGSNodeWork *work = node_work;
+#endif
+          PGSSimulateNode(&region, work, tmpRFp, node_index[m], node_gau[m]);
+        }
+
+        if (region.cond_cols)
+        {
+          for (m = 0; m < nLxyz; m++)
+          {
+            tfree(region.cond_cols[m]);
+            region.cond_cols[m] = NULL;
+          }
+        }
 
         /* Update the marker vector */
         imin = rpx - iLxp1; if (imin < -iLx)
@@ -857,6 +995,9 @@ void         PGSRF(
         fieldp[index1] = mean + sigma * tmpRFp[index2];
       });
     }
+
+    tfree(node_index);
+    tfree(node_gau);
   }  /* gridloop */
 
   /*-----------------------------------------------------------------------
@@ -875,29 +1016,27 @@ void         PGSRF(
   }
   tfree(cov);
 
-  for (i = 0; i < nLxyz; i++)
-  {
-    tfree(A12[i]);
-    tfree(A21[i]);
-    tfree(A22[i]);
-    tfree(M[i]);
-  }
   tfree(A11);
-  tfree(A_sub);
-  tfree(A12);
-  tfree(A21);
-  tfree(A22);
-  tfree(M);
   tfree(b);
-  tfree(b2);
-  tfree(b_tmp);
   tfree(w);
-  tfree(w_tmp);
-  tfree(value);
-  tfree(cval);
   tfree(ixx);
   tfree(iyy);
   tfree(izz);
+  tfree(stencil);
+  tfree(region.cond_cols);
+
+  for (n = 0; n < num_threads; n++)
+  {
+    tfree(node_work[n].cii);
+    tfree(node_work[n].cjj);
+    tfree(node_work[n].ckk);
+    tfree(node_work[n].cval);
+    tfree(node_work[n].b2);
+    tfree(node_work[n].x2);
+    tfree(node_work[n].w2);
+    tfree(node_work[n].A22);
+  }
+  tfree(node_work);
 
   for (i = -iLx; i <= 2 * iLx; i++)
   {
@@ -37,6 +37,8 @@
 #include "parflow.h"
 #include "problem.h"
 
+#include <string.h>
+
 
 /*--------------------------------------------------------------------------
  * NewProblem
@@ -124,6 +126,12 @@ Problem   *NewProblem(
     ProblemSelectTimeStep(problem) =
       PFModuleNewModule(SelectTimeStep, ());
   }
+  else if (strcmp(GetStringDefault("TimeStep.Type", "Constant"), "Adaptive") == 0)
+  {
+    /* Only the Richards solver feeds the TimeStepController */
+    InputError("Error: <%s> for key <%s> is only available with the Richards solver\n",
+               "Adaptive", "TimeStep.Type");
+  }
 
   /*-----------------------------------------------------------------------
    * ProblemDomain
@@ -56,6 +56,9 @@ typedef struct {
   int time_index;
   int pfsol_time_index;
 
+  int use_cache;
+  char           *cache_directory;
+
   /* Geometry input names are for each "type" of geometry
    * the user is inputing */
   NameArray geom_input_names;
@@ -171,6 +174,10 @@ void           Geometries(
 
   VectorUpdateCommHandle         *handle;
 
+  unsigned long long global_key = GrGeomCacheHashInit;
+  unsigned long long local_key = GrGeomCacheHashInit;
+  char cache_filename[2048];
+
   int i, k;
 
   BeginTiming(public_xtra->time_index);
@@ -182,6 +189,60 @@ void           Geometries(
 
   gr_solids = ctalloc(GrGeomSolid *, num_solids);
 
+  /*-----------------------------------------------------------------------
+   * Look for solids cached by a previous run on the same inputs.  The
+   * indicator fields are part of the local key, so they are read here.
+   *-----------------------------------------------------------------------*/
+
+  if (public_xtra->use_cache)
+  {
+    global_key = GrGeomCacheHashGlobals(global_key);
+    for (i = 0; i < num_solids; i++)
+    {
+      if (solids[i])
+      {
+        global_key = GrGeomCacheHashGeomSolid(global_key, solids[i]);
+      }
+    }
+
+    local_key = GrGeomCacheHashSubgrids(local_key, GridSubgrids(grid));
+    for (current_indicator_data = indicator_data;
+         current_indicator_data != NULL;
+         current_indicator_data = (current_indicator_data->next_indicator_data))
+    {
+      InitVectorAll(tmp_indicator_field, -1.0);
+      ReadPFBinary((current_indicator_data->filename), tmp_indicator_field);
+      handle = InitVectorUpdate(tmp_indicator_field, VectorUpdateAll);
+      FinalizeVectorUpdate(handle);
+
+      local_key = GrGeomCacheHashVector(local_key, tmp_indicator_field);
+      local_key = GrGeomCacheHash(local_key, current_indicator_data->indicators,
+                                  (current_indicator_data->num_indicators) * sizeof(int));
+    }
+
+    GrGeomCacheFilename(cache_filename, public_xtra->cache_directory,
+                        global_key);
+
+    if (GrGeomReadCache(cache_filename, global_key, local_key,
+                        gr_solids, num_solids))
+    {
+      if (!amps_Rank(amps_CommWorld))
+      {
+        amps_Printf("Geometries read from cache %s\n", cache_filename);
+      }
+
+      EndTiming(public_xtra->time_index);
+
+      ProblemDataNumSolids(problem_data) = num_solids;
+      ProblemDataSolids(problem_data) = solids;
+      ProblemDataGrSolids(problem_data) = gr_solids;
+
+      FreeVector(tmp_indicator_field);
+
+      return;
+    }
+  }
+
   /*-----------------------------------------------------------------------
    * Convert Geom solids to GrGeom solids
    *-----------------------------------------------------------------------*/
@@ -232,6 +293,12 @@ void           Geometries(
     current_indicator_data = (current_indicator_data->next_indicator_data);
   }
 
+  if (public_xtra->use_cache)
+  {
+    GrGeomWriteCache(cache_filename, global_key, local_key,
+                     gr_solids, num_solids);
+  }
+
   EndTiming(public_xtra->time_index);
 
   ProblemDataNumSolids(problem_data) = num_solids;
@@ -328,6 +395,8 @@ PFModule   *GeometriesNewPublicXtra()
 
   char *patch_names;
 
+  char *switch_name;
+
   /*----------------------------------------------------------
    * The name array to map names to switch values
    *----------------------------------------------------------*/
@@ -539,11 +608,20 @@ PFModule   *GeometriesNewPublicXtra()
 
   (public_xtra->time_index) = RegisterTiming("Geometries");
 
-  /* Geometries need to be world accessible */
-  GlobalsGeometries = solids;
+  NA_FreeNameArray(switch_na);
 
+  switch_na = NA_NewNameArray("False True");
+  switch_name = GetStringDefault("UseGeometryCache", "False");
+  (public_xtra->use_cache) =
+    NA_NameToIndexExitOnError(switch_na, switch_name, "UseGeometryCache");
   NA_FreeNameArray(switch_na);
 
+  (public_xtra->cache_directory) =
+    strdup(GetStringDefault("GeometryCache.Directory", "."));
+
+  /* Geometries need to be world accessible */
+  GlobalsGeometries = solids;
+
   PFModulePublicXtra(this_module) = public_xtra;
   return this_module;
 }
@@ -566,6 +644,8 @@ void  GeometriesFreePublicXtra()
   {
     NA_FreeNameArray(public_xtra->geom_input_names);
 
+    tfree(public_xtra->cache_directory);
+
     NA_FreeNameArray(GlobalsGeomNames);
 
     for (g = 0; g < (public_xtra->num_solids); g++)
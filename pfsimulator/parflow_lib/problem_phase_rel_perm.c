@@ -29,6 +29,7 @@
 #include "parflow.h"
 
 #include <assert.h>
+#include <string.h>
 
 /*--------------------------------------------------------------------------
  * Structures
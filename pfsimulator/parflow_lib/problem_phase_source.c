@@ -55,6 +55,7 @@ void         PhaseSource(
   WellData         *well_data = ProblemDataWellData(problem_data);
   WellDataPhysical *well_data_physical;
   WellDataValue    *well_data_value;
+  WellSubgridMap   *well_subgrid_map;
 
   TimeCycleData    *time_cycle_data;
 
@@ -69,7 +70,7 @@ void         PhaseSource(
 
   SubgridArray     *subgrids = GridSubgrids(grid);
 
-  Subgrid          *subgrid, *well_subgrid, *tmp_subgrid;
+  Subgrid          *subgrid, *tmp_subgrid;
   Subvector        *px_sub, *py_sub, *pz_sub, *ps_sub;
 
   double           *data, *px, *py, *pz;
@@ -84,7 +85,7 @@ void         PhaseSource(
   int is, i, j, k;
 
   /* Locals associated with wells */
-  int well;
+  int well, n;
   int cycle_number, interval_number;
   double volume, flux, well_value;
 
@@ -275,111 +276,108 @@ void         PhaseSource(
   {
     time_cycle_data = WellDataTimeCycleData(well_data);
 
-    for (well = 0; well < WellDataNumFluxWells(well_data); well++)
+    /* Only the wells intersecting the local subgrids are visited */
+    well_subgrid_map = GetWellSubgridMap(well_data, grid);
+
+    ForSubgridI(is, subgrids)
     {
-      well_data_physical = WellDataFluxWellPhysical(well_data, well);
-      cycle_number = WellDataPhysicalCycleNumber(well_data_physical);
+      px_sub = VectorSubvector(perm_x, is);
+      py_sub = VectorSubvector(perm_y, is);
+      pz_sub = VectorSubvector(perm_z, is);
 
-      interval_number = TimeCycleDataComputeIntervalNumber(problem, time, time_cycle_data, cycle_number);
+      ps_sub = VectorSubvector(phase_source, is);
 
-      well_data_value = WellDataFluxWellIntervalValue(well_data, well, interval_number);
+      nx_p = SubvectorNX(ps_sub);
+      ny_p = SubvectorNY(ps_sub);
+      nz_p = SubvectorNZ(ps_sub);
 
-      well_subgrid = WellDataPhysicalSubgrid(well_data_physical);
+      nx_ps = SubvectorNX(ps_sub);
+      ny_ps = SubvectorNY(ps_sub);
+      nz_ps = SubvectorNZ(ps_sub);
 
-      well_value = 0.0;
-      if (WellDataPhysicalAction(well_data_physical) == INJECTION_WELL)
+      for (n = 0; n < WellSubgridMapNumFluxWells(well_subgrid_map, is); n++)
       {
-        well_value = WellDataValuePhaseValue(well_data_value, phase);
-      }
-      else if (WellDataPhysicalAction(well_data_physical)
-               == EXTRACTION_WELL)
+        well = WellSubgridMapFluxWell(well_subgrid_map, is, n);
 
-      {
-        well_value = -WellDataValuePhaseValue(well_data_value, phase);
-      }
+        well_data_physical = WellDataFluxWellPhysical(well_data, well);
+        cycle_number = WellDataPhysicalCycleNumber(well_data_physical);
 
-      volume = WellDataPhysicalSize(well_data_physical);
-      flux = well_value / volume;
+        interval_number = TimeCycleDataComputeIntervalNumber(problem, time, time_cycle_data, cycle_number);
 
-      avg_x = WellDataPhysicalAveragePermeabilityX(well_data_physical);
-      avg_y = WellDataPhysicalAveragePermeabilityY(well_data_physical);
-      avg_z = WellDataPhysicalAveragePermeabilityZ(well_data_physical);
+        well_data_value = WellDataFluxWellIntervalValue(well_data, well, interval_number);
 
-      ForSubgridI(is, subgrids)
-      {
-        subgrid = SubgridArraySubgrid(subgrids, is);
+        well_value = 0.0;
+        if (WellDataPhysicalAction(well_data_physical) == INJECTION_WELL)
+        {
+          well_value = WellDataValuePhaseValue(well_data_value, phase);
+        }
+        else if (WellDataPhysicalAction(well_data_physical)
+                 == EXTRACTION_WELL)
 
-        px_sub = VectorSubvector(perm_x, is);
-        py_sub = VectorSubvector(perm_y, is);
-        pz_sub = VectorSubvector(perm_z, is);
+        {
+          well_value = -WellDataValuePhaseValue(well_data_value, phase);
+        }
 
-        ps_sub = VectorSubvector(phase_source, is);
+        volume = WellDataPhysicalSize(well_data_physical);
+        flux = well_value / volume;
 
-        nx_p = SubvectorNX(ps_sub);
-        ny_p = SubvectorNY(ps_sub);
-        nz_p = SubvectorNZ(ps_sub);
+        avg_x = WellDataPhysicalAveragePermeabilityX(well_data_physical);
+        avg_y = WellDataPhysicalAveragePermeabilityY(well_data_physical);
+        avg_z = WellDataPhysicalAveragePermeabilityZ(well_data_physical);
 
-        nx_ps = SubvectorNX(ps_sub);
-        ny_ps = SubvectorNY(ps_sub);
-        nz_ps = SubvectorNZ(ps_sub);
+        /*  Loop over the intersection of the well with the subgrid  */
+        tmp_subgrid = WellSubgridMapFluxWellSubgrid(well_subgrid_map, is, n);
 
-        /*  Get the intersection of the well with the subgrid  */
-        if ((tmp_subgrid = IntersectSubgrids(subgrid, well_subgrid)))
-        {
-          /*  If an intersection;  loop over it, and insert value  */
-          ix = SubgridIX(tmp_subgrid);
-          iy = SubgridIY(tmp_subgrid);
-          iz = SubgridIZ(tmp_subgrid);
+        ix = SubgridIX(tmp_subgrid);
+        iy = SubgridIY(tmp_subgrid);
+        iz = SubgridIZ(tmp_subgrid);
 
-          nx = SubgridNX(tmp_subgrid);
-          ny = SubgridNY(tmp_subgrid);
-          nz = SubgridNZ(tmp_subgrid);
+        nx = SubgridNX(tmp_subgrid);
+        ny = SubgridNY(tmp_subgrid);
+        nz = SubgridNZ(tmp_subgrid);
 
-          dx = SubgridDX(tmp_subgrid);
-          dy = SubgridDY(tmp_subgrid);
-          dz = SubgridDZ(tmp_subgrid);
+        dx = SubgridDX(tmp_subgrid);
+        dy = SubgridDY(tmp_subgrid);
+        dz = SubgridDZ(tmp_subgrid);
 
-          area_x = dy * dz;
-          area_y = dx * dz;
-          area_z = dx * dy;
-          area_sum = area_x + area_y + area_z;
+        area_x = dy * dz;
+        area_y = dx * dz;
+        area_z = dx * dy;
+        area_sum = area_x + area_y + area_z;
 
-          px = SubvectorElt(px_sub, ix, iy, iz);
-          py = SubvectorElt(py_sub, ix, iy, iz);
-          pz = SubvectorElt(pz_sub, ix, iy, iz);
+        px = SubvectorElt(px_sub, ix, iy, iz);
+        py = SubvectorElt(py_sub, ix, iy, iz);
+        pz = SubvectorElt(pz_sub, ix, iy, iz);
 
-          data = SubvectorElt(ps_sub, ix, iy, iz);
+        data = SubvectorElt(ps_sub, ix, iy, iz);
 
-          int ip = 0;
-          int ips = 0;          
+        int ip = 0;
+        int ips = 0;
 
+        if (WellDataPhysicalMethod(well_data_physical)
+            == FLUX_WEIGHTED)
+        {
+          BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+                    ip, nx_p, ny_p, nz_p, 1, 1, 1,
+                    ips, nx_ps, ny_ps, nz_ps, 1, 1, 1,
+          {
+            double weight = (px[ip] / avg_x) * (area_x / area_sum)
+                            + (py[ip] / avg_y) * (area_y / area_sum)
+                            + (pz[ip] / avg_z) * (area_z / area_sum);
+            data[ips] += weight * flux;
+          });
+        }else{
+          double weight = -FLT_MAX;
           if (WellDataPhysicalMethod(well_data_physical)
-              == FLUX_WEIGHTED)
+              == FLUX_STANDARD)weight = 1.0;
+          else if (WellDataPhysicalMethod(well_data_physical)
+                   == FLUX_PATTERNED)weight = 0.0;
+          BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+                    ip, nx_p, ny_p, nz_p, 1, 1, 1,
+                    ips, nx_ps, ny_ps, nz_ps, 1, 1, 1,
           {
-            BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
-                      ip, nx_p, ny_p, nz_p, 1, 1, 1,
-                      ips, nx_ps, ny_ps, nz_ps, 1, 1, 1,
-            {
-              double weight = (px[ip] / avg_x) * (area_x / area_sum)
-                      + (py[ip] / avg_y) * (area_y / area_sum)
-                      + (pz[ip] / avg_z) * (area_z / area_sum);
-              data[ips] += weight * flux;
-            });
-          }else{
-            double weight = -FLT_MAX;            
-            if (WellDataPhysicalMethod(well_data_physical)
-                == FLUX_STANDARD)weight = 1.0;
-            else if (WellDataPhysicalMethod(well_data_physical)
-                     == FLUX_PATTERNED)weight = 0.0;
-            BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
-                      ip, nx_p, ny_p, nz_p, 1, 1, 1,
-                      ips, nx_ps, ny_ps, nz_ps, 1, 1, 1,
-            {
-              data[ips] += weight * flux;
-            });
-          }
-          /* done with this temporay subgrid */
-          FreeSubgrid(tmp_subgrid);
+            data[ips] += weight * flux;
+          });
         }
       }
     }
@@ -79,6 +79,7 @@ void RichardsBCInternal(
   WellData         *well_data = ProblemDataWellData(problem_data);
   WellDataPhysical *well_data_physical;
   WellDataValue    *well_data_value;
+  WellSubgridMap   *well_subgrid_map = NULL;
 
   TimeCycleData    *time_cycle_data;
 
@@ -163,10 +164,15 @@ void RichardsBCInternal(
    *--------------------------------------------------------------------*/
 
   num_wells = WellDataNumPressWells(well_data);
-  total_num = num_conditions + num_wells;
 
   if ((num_conditions > 0) || (num_wells > 0))
   {
+    /* Only the wells intersecting the local subgrids are visited */
+    if (num_wells > 0)
+    {
+      well_subgrid_map = GetWellSubgridMap(well_data, grid);
+    }
+
     /* Set explicit pressure assignments*/
 
     for (grid_index = 0; grid_index < GridNumSubgrids(grid); grid_index++)
@@ -176,6 +182,12 @@ void RichardsBCInternal(
       p_sub = VectorSubvector(pressure, grid_index);
       pp = SubvectorData(p_sub);
 
+      total_num = num_conditions;
+      if (num_wells > 0)
+      {
+        total_num += WellSubgridMapNumPressWells(well_subgrid_map, grid_index);
+      }
+
 
       for (index = 0; index < total_num; index++)
       {
@@ -186,7 +198,8 @@ void RichardsBCInternal(
         }
         else
         {
-          well = index - num_conditions;
+          well = WellSubgridMapPressWell(well_subgrid_map, grid_index,
+                                         index - num_conditions);
           time_cycle_data = WellDataTimeCycleData(well_data);
           well_data_physical = WellDataPressWellPhysical(well_data, well);
           cycle_number = WellDataPhysicalCycleNumber(well_data_physical);
@@ -197,7 +210,8 @@ void RichardsBCInternal(
           well_data_value =
             WellDataPressWellIntervalValue(well_data, well,
                                            interval_number);
-          subgrid_ind = WellDataPhysicalSubgrid(well_data_physical);
+          subgrid_ind = WellSubgridMapPressWellSubgrid(well_subgrid_map, grid_index,
+                                                       index - num_conditions);
           value = WellDataValuePhaseValue(well_data_value, 0);
         }
 
@@ -34,6 +34,9 @@
 *****************************************************************************/
 
 #include "parflow.h"
+#include "pfb_reader.h"
+
+#include <math.h>
 
 /*--------------------------------------------------------------------------
  * ReadProcessSubgrid
@@ -109,6 +112,269 @@ Grid      *ReadProcessGrid()
 }
 
 
+/*--------------------------------------------------------------------------
+ * Macros for BalancedProcessGrid
+ *--------------------------------------------------------------------------*/
+
+/* Load of the columns [x0,x1) x [y0,y1) from the summed load table */
+#define ColumnLoad(load, sx, x0, y0, x1, y1)                 \
+  ((load)[(y1) * (sx) + (x1)] - (load)[(y0) * (sx) + (x1)]   \
+   - (load)[(y1) * (sx) + (x0)] + (load)[(y0) * (sx) + (x0)])
+
+/*--------------------------------------------------------------------------
+ * BisectColumns:
+ *   Splits the columns [x0,x1) x [y0,y1) over num_parts processes starting
+ *   at first_proc, cutting across the longer side where the load is divided
+ *   in proportion to the processes on each side.
+ *--------------------------------------------------------------------------*/
+
+static void  BisectColumns(
+                           double *      load,
+                           int           sx,
+                           Subgrid *     user_subgrid,
+                           int           x0,
+                           int           y0,
+                           int           x1,
+                           int           y1,
+                           int           first_proc,
+                           int           num_parts,
+                           SubgridArray *all_subgrids,
+                           double *      max_load)
+{
+  int num_lo = num_parts / 2;
+  int num_hi = num_parts - num_lo;
+  double target, diff, best_diff;
+  int lo[2], hi[2];
+  int axis, extent, width, c, cut, cut_axis;
+
+  if (num_parts == 1)
+  {
+    AppendSubgrid(NewSubgrid(SubgridIX(user_subgrid) + x0,
+                             SubgridIY(user_subgrid) + y0,
+                             SubgridIZ(user_subgrid),
+                             x1 - x0, y1 - y0, SubgridNZ(user_subgrid),
+                             0, 0, 0, first_proc),
+                  all_subgrids);
+
+    *max_load = pfmax(*max_load, ColumnLoad(load, sx, x0, y0, x1, y1));
+    return;
+  }
+
+  target = ColumnLoad(load, sx, x0, y0, x1, y1) * num_lo / num_parts;
+
+  /* Try the longer side first; each side of the cut needs at least one
+   * column per process */
+  cut = -1;
+  cut_axis = ((x1 - x0) >= (y1 - y0)) ? 0 : 1;
+  best_diff = 0.0;
+  for (axis = cut_axis; cut < 0 && axis < cut_axis + 2; axis++)
+  {
+    lo[0] = x0; lo[1] = y0;
+    hi[0] = x1; hi[1] = y1;
+    extent = hi[axis % 2] - lo[axis % 2];
+    width = hi[(axis + 1) % 2] - lo[(axis + 1) % 2];
+
+    for (c = lo[axis % 2] + 1; c < hi[axis % 2]; c++)
+    {
+      if ((c - lo[axis % 2]) * width < num_lo
+          || (hi[axis % 2] - c) * width < num_hi)
+        continue;
+
+      if (axis % 2 == 0)
+        diff = fabs(ColumnLoad(load, sx, x0, y0, c, y1) - target);
+      else
+        diff = fabs(ColumnLoad(load, sx, x0, y0, x1, c) - target);
+
+      /* Among equal loads, e.g. across inactive columns, keep the cut
+       * closest to dividing the cells in proportion */
+      if (cut < 0 || diff < best_diff
+          || (diff == best_diff
+              && abs((c - lo[axis % 2]) * num_parts - extent * num_lo)
+              < abs((cut - lo[axis % 2]) * num_parts - extent * num_lo)))
+      {
+        cut = c;
+        best_diff = diff;
+        cut_axis = axis % 2;
+      }
+    }
+  }
+
+  if (cut < 0)
+  {
+    InputError("Error: can not split the grid columns over the processes%s%s\n",
+               "", "");
+  }
+
+  if (cut_axis == 0)
+  {
+    BisectColumns(load, sx, user_subgrid, x0, y0, cut, y1,
+                  first_proc, num_lo, all_subgrids, max_load);
+    BisectColumns(load, sx, user_subgrid, cut, y0, x1, y1,
+                  first_proc + num_lo, num_hi, all_subgrids, max_load);
+  }
+  else
+  {
+    BisectColumns(load, sx, user_subgrid, x0, y0, x1, cut,
+                  first_proc, num_lo, all_subgrids, max_load);
+    BisectColumns(load, sx, user_subgrid, x0, cut, x1, y1,
+                  first_proc + num_lo, num_hi, all_subgrids, max_load);
+  }
+}
+
+
+/*--------------------------------------------------------------------------
+ * BalancedProcessGrid:
+ *   Distributes the columns of the user grid so every process gets about
+ *   the same number of active cells, by recursive coordinate bisection on
+ *   the active cell counts of the columns in a mask file.  Columns are kept
+ *   whole, so every process owns a single subgrid spanning all of z.
+ *   Returns NULL unless Process.Topology.Decomposition is ActiveCells.
+ *--------------------------------------------------------------------------*/
+
+Grid      *BalancedProcessGrid(
+                               Grid *user_grid)
+{
+  Subgrid       *user_subgrid = GridSubgrid(user_grid, 0);
+
+  SubgridArray  *process_all_subgrids;
+  SubgridArray  *process_subgrids;
+  PFBReader     *reader;
+
+  NameArray decomposition_na;
+  char          *decomposition_name;
+  char          *mask_filename;
+  double inactive_weight;
+
+  double        *layer;
+  double        *active;
+  double        *load;
+  double max_load;
+
+  int nx, ny, nz;
+  int mask_nx, mask_ny, mask_nz;
+  int num_procs;
+  int sx, i, j, k, n;
+
+  decomposition_na = NA_NewNameArray("Uniform ActiveCells");
+  decomposition_name = GetStringDefault("Process.Topology.Decomposition",
+                                        "Uniform");
+  n = NA_NameToIndexExitOnError(decomposition_na, decomposition_name,
+                                "Process.Topology.Decomposition");
+  NA_FreeNameArray(decomposition_na);
+
+  if (n == 0)
+  {
+    return NULL;
+  }
+
+  mask_filename = GetString("Process.Topology.Decomposition.MaskFile");
+  inactive_weight =
+    GetDoubleDefault("Process.Topology.Decomposition.InactiveWeight", 0.1);
+
+  nx = SubgridNX(user_subgrid);
+  ny = SubgridNY(user_subgrid);
+  nz = SubgridNZ(user_subgrid);
+
+  num_procs = GlobalsNumProcs;
+  if (num_procs > nx * ny)
+  {
+    InputError("Error: more processes than grid columns for the %s decomposition%s\n",
+               decomposition_name, "");
+  }
+
+  /*-----------------------------------------------------------------------
+   * Count the active cells of every column.  All ranks read the mask and
+   * compute the same decomposition, one layer at a time.  A mask with a
+   * single layer marks whole columns as active.
+   *-----------------------------------------------------------------------*/
+
+  if ((reader = PFBReaderOpen(mask_filename)) == NULL)
+  {
+    InputError("Error: can't open mask file %s: %s\n", mask_filename,
+               PFBReaderError());
+  }
+
+  PFBReaderSize(reader, &mask_nx, &mask_ny, &mask_nz);
+  if (mask_nx != nx || mask_ny != ny || (mask_nz != nz && mask_nz != 1))
+  {
+    InputError("Error: mask file %s does not match the computational grid%s\n",
+               mask_filename, "");
+  }
+
+  layer = talloc(double, nx * ny);
+  active = ctalloc(double, nx * ny);
+
+  for (k = 0; k < mask_nz; k++)
+  {
+    for (n = 0; n < nx * ny; n++)
+      layer[n] = 0.0;
+
+    PFBReaderReadBox(reader, 0, 0, k, nx, ny, 1, layer, 1, nx, 0, 1);
+
+    for (n = 0; n < nx * ny; n++)
+    {
+      if (layer[n] > 0.0)
+        active[n] += (mask_nz == 1) ? nz : 1;
+    }
+  }
+
+  PFBReaderClose(reader);
+  tfree(layer);
+
+  /*-----------------------------------------------------------------------
+   * Summed table of the column loads; inactive cells still cost something
+   * in the vector operations
+   *-----------------------------------------------------------------------*/
+
+  sx = nx + 1;
+  load = ctalloc(double, sx * (ny + 1));
+  for (j = 0; j < ny; j++)
+  {
+    for (i = 0; i < nx; i++)
+    {
+      n = j * nx + i;
+      load[(j + 1) * sx + (i + 1)] = active[n]
+                                     + inactive_weight * (nz - active[n])
+                                     + load[j * sx + (i + 1)]
+                                     + load[(j + 1) * sx + i]
+                                     - load[j * sx + i];
+    }
+  }
+  tfree(active);
+
+  process_all_subgrids = NewSubgridArray();
+  max_load = 0.0;
+  BisectColumns(load, sx, user_subgrid, 0, 0, nx, ny, 0, num_procs,
+                process_all_subgrids, &max_load);
+
+  {
+    static char first_call = 1;
+    if (first_call && !amps_Rank(amps_CommWorld))
+    {
+      amps_Printf("Using active cell decomposition, load imbalance (max/mean) %f\n",
+                  (load[ny * sx + nx] > 0.0) ?
+                  max_load * num_procs / load[ny * sx + nx] : 1.0);
+      first_call = 0;
+    }
+  }
+
+  tfree(load);
+
+  process_subgrids = NewSubgridArray();
+  ForSubgridI(n, process_all_subgrids)
+  {
+    Subgrid* subgrid = SubgridArraySubgrid(process_all_subgrids, n);
+
+    if (amps_Rank(amps_CommWorld) == SubgridProcess(subgrid))
+    {
+      AppendSubgrid(subgrid, process_subgrids);
+    }
+  }
+
+  return NewGrid(process_subgrids, process_all_subgrids);
+}
+
+
 /*--------------------------------------------------------------------------
  * FreeUserGrid
  *--------------------------------------------------------------------------*/
@@ -49,6 +49,53 @@ typedef struct {
 } InstanceXtra;
 
 
+/*--------------------------------------------------------------------------
+ * Loops over a subregion for coefficients of type T, see
+ * MatrixPrecisionSwitch.
+ *--------------------------------------------------------------------------*/
+
+/* x = b / a0 */
+#define RedBlackGSPointDiagonal(T, Elt)                    \
+  {                                                        \
+    T *a0 = Elt(A_sub, 0, ix, iy, iz);                     \
+                                                           \
+    BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,             \
+              iv, nx_v, ny_v, nz_v, sx, sy, sz,            \
+              im, nx_m, ny_m, nz_m, sx, sy, sz,            \
+    {                                                      \
+      x0[iv] = bp[iv] / a0[im];                            \
+                                                           \
+      SKIP_PARALLEL_SYNC;                                  \
+    });                                                    \
+  }
+
+/* x = (b - sum of a_s x_s over the neighbours s) / a0 */
+#define RedBlackGSPointSweep(T, Elt)                       \
+  {                                                        \
+    T *a0 = Elt(A_sub, 0, ix, iy, iz);                     \
+    T *a1 = Elt(A_sub, 1, ix, iy, iz);                     \
+    T *a2 = Elt(A_sub, 2, ix, iy, iz);                     \
+    T *a3 = Elt(A_sub, 3, ix, iy, iz);                     \
+    T *a4 = Elt(A_sub, 4, ix, iy, iz);                     \
+    T *a5 = Elt(A_sub, 5, ix, iy, iz);                     \
+    T *a6 = Elt(A_sub, 6, ix, iy, iz);                     \
+                                                           \
+    BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,             \
+              iv, nx_v, ny_v, nz_v, sx, sy, sz,            \
+              im, nx_m, ny_m, nz_m, sx, sy, sz,            \
+    {                                                      \
+      x0[iv] = (bp[iv] - (a1[im] * x1[iv] +                \
+                          a2[im] * x2[iv] +                \
+                          a3[im] * x3[iv] +                \
+                          a4[im] * x4[iv] +                \
+                          a5[im] * x5[iv] +                \
+                          a6[im] * x6[iv])) / a0[im];      \
+                                                           \
+      SKIP_PARALLEL_SYNC;                                  \
+    });                                                    \
+  }
+
+
 /*--------------------------------------------------------------------------
  * RedBlackGSPoint:
  *--------------------------------------------------------------------------*/
@@ -82,7 +129,6 @@ void     RedBlackGSPoint(
 
   StencilElt     *s;
 
-  double         *a0, *a1, *a2, *a3, *a4, *a5, *a6;
   double         *x0, *x1, *x2, *x3, *x4, *x5, *x6;
   double         *bp;
 
@@ -201,20 +247,12 @@ void     RedBlackGSPoint(
           sy = SubregionSY(subregion);
           sz = SubregionSZ(subregion);
 
-          a0 = SubmatrixElt(A_sub, 0, ix, iy, iz);
           x0 = SubvectorElt(x_sub, ix, iy, iz);
           bp = SubvectorElt(b_sub, ix, iy, iz);
 
           iv = im = 0;
 
-          BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
-                    iv, nx_v, ny_v, nz_v, sx, sy, sz,
-                    im, nx_m, ny_m, nz_m, sx, sy, sz,
-          {
-            x0[iv] = bp[iv] / a0[im];
-
-            SKIP_PARALLEL_SYNC;
-          });
+          MatrixPrecisionSwitch(A, RedBlackGSPointDiagonal);
         }
       }
     }
@@ -301,14 +339,6 @@ void     RedBlackGSPoint(
 
           s = StencilShape(MatrixStencil(A));
 
-          a0 = SubmatrixElt(A_sub, 0, ix, iy, iz);
-          a1 = SubmatrixElt(A_sub, 1, ix, iy, iz);
-          a2 = SubmatrixElt(A_sub, 2, ix, iy, iz);
-          a3 = SubmatrixElt(A_sub, 3, ix, iy, iz);
-          a4 = SubmatrixElt(A_sub, 4, ix, iy, iz);
-          a5 = SubmatrixElt(A_sub, 5, ix, iy, iz);
-          a6 = SubmatrixElt(A_sub, 6, ix, iy, iz);
-
           x0 = SubvectorElt(x_sub, ix, iy, iz);
           x1 = SubvectorElt(x_sub,
                             (ix + s[1][0]),
@@ -338,20 +368,8 @@ void     RedBlackGSPoint(
           bp = SubvectorElt(b_sub, ix, iy, iz);
 
           iv = im = 0;
-          
-          BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
-                    iv, nx_v, ny_v, nz_v, sx, sy, sz,
-                    im, nx_m, ny_m, nz_m, sx, sy, sz,
-          {
-            x0[iv] = (bp[iv] - (a1[im] * x1[iv] +
-                                a2[im] * x2[iv] +
-                                a3[im] * x3[iv] +
-                                a4[im] * x4[iv] +
-                                a5[im] * x5[iv] +
-                                a6[im] * x6[iv])) / a0[im];
-                                
-            SKIP_PARALLEL_SYNC;                                
-          });
+
+          MatrixPrecisionSwitch(A, RedBlackGSPointSweep);
         }
       }
     }
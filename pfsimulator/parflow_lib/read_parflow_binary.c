@@ -31,6 +31,7 @@
 *
 *****************************************************************************/
 #include "parflow.h"
+#include "pfb_reader.h"
 
 #include <string.h>
 #include <math.h>
@@ -77,6 +78,76 @@ void ReadPFBinary_Subvector(
 }
 
 
+/*--------------------------------------------------------------------------
+ * ReadPFBinary_Mapped: read each local subgrid straight out of the
+ * memory mapped file.  The file may have been written on any process
+ * topology.  Returns 0 if the file does not cover the local subgrids, in
+ * which case the caller falls back to the distributed (amps) read.
+ *--------------------------------------------------------------------------*/
+
+static int ReadPFBinary_Mapped(
+                               char *  filename,
+                               Vector *v)
+{
+  Grid           *grid = VectorGrid(v);
+  SubgridArray   *subgrids = GridSubgrids(grid);
+  Subgrid        *subgrid;
+  Subvector      *subvector;
+  PFBReader      *reader;
+  amps_Invoice invoice;
+
+  int ix, iy, iz, nx, ny, nz;
+  int nx_v, ny_v;
+  int g;
+  double covered;
+
+  reader = PFBReaderOpen(filename);
+  covered = (reader != NULL);
+
+  if (reader)
+  {
+    ForSubgridI(g, subgrids)
+    {
+      subgrid = SubgridArraySubgrid(subgrids, g);
+      subvector = VectorSubvector(v, g);
+
+      ix = SubgridIX(subgrid);
+      iy = SubgridIY(subgrid);
+      iz = SubgridIZ(subgrid);
+
+      nx = SubgridNX(subgrid);
+      ny = SubgridNY(subgrid);
+      nz = SubgridNZ(subgrid);
+
+      nx_v = SubvectorNX(subvector);
+      ny_v = SubvectorNY(subvector);
+
+      if (PFBReaderReadBox(reader, ix, iy, iz, nx, ny, nz,
+                           SubvectorElt(subvector, ix, iy, iz),
+                           1, nx_v, nx_v * ny_v, 1) != (long)nx * ny * nz)
+        covered = 0;
+    }
+
+    PFBReaderClose(reader);
+  }
+
+  /* The distributed read is collective, so all ranks must agree */
+  invoice = amps_NewInvoice("%d", &covered);
+  amps_AllReduce(amps_CommWorld, invoice, amps_Min);
+  amps_FreeInvoice(invoice);
+
+  return (covered > 0);
+}
+
+
+/*--------------------------------------------------------------------------
+ * ReadPFBinary: if the UseMappedPFBReader key is set every process maps
+ * the whole file and reads its subgrids out of it, which works for files
+ * written on any topology.  Otherwise (or if that fails) the file is read
+ * with the distributed amps read, which needs the .dist file of the
+ * topology of this run.
+ *--------------------------------------------------------------------------*/
+
 void ReadPFBinary(
                   char *  filename,
                   Vector *v)
@@ -107,6 +178,12 @@ void ReadPFBinary(
     exit(1);
   }
 
+  if (GlobalsUseMappedPFBReader && ReadPFBinary_Mapped(filename, v))
+  {
+    EndTiming(PFBTimingIndex);
+    return;
+  }
+
   if ((file = amps_FFopen(amps_CommWorld, filename, "rb", 0)) == NULL)
   {
     amps_Printf("Error: can't open input file %s\n", filename);
@@ -62,6 +62,7 @@ typedef struct {
   double SpinupDampP1; // NBE
   double SpinupDampP2; // NBE
   int tfgupwind;  // @RMM
+  int interleave;   /* keep a cell-major copy of J for KINSolMatVec */
 } PublicXtra;
 
 typedef struct {
@@ -96,7 +97,11 @@ typedef struct {
    * analytic Jacobian for the subsurface flow is invoked instead.
    */
   Matrix       *J;
-  Matrix       *JC;
+  Matrix       *JC;        /* only allocated for overland flow problems */
+  int symmetric_jac;
+
+  /* 2D work vectors of the overland flow, set up on first use */
+  Vector       *KW, *KE, *KN, *KS, *KWns, *KEns, *KNns, *KSns;
 
   Grid         *grid;
   double       *temp_data;
@@ -151,6 +156,7 @@ int       KINSolMatVec(
   double time = StateTime(((State*)current_state));
 
   InstanceXtra  *instance_xtra = (InstanceXtra*)PFModuleInstanceXtra(richards_jacobian_eval);
+  PublicXtra    *public_xtra = (PublicXtra*)PFModulePublicXtra(richards_jacobian_eval);
 
   PFModule    *bc_pressure = (instance_xtra->bc_pressure);
 
@@ -167,6 +173,11 @@ int       KINSolMatVec(
                        (pressure, old_pressure, &J, &JC, saturation, density, problem_data,
                         dt, time, 0));
 
+    /* J is applied many times per Newton step; pay for the
+     * conversion to the interleaved layout once */
+    if (public_xtra->interleave)
+      MatrixInterleave(J);
+
     *recompute = 0;
     StateJac(((State*)current_state)) = J;
     StateJacC(((State*)current_state)) = JC;
@@ -201,6 +212,7 @@ void    RichardsJacobianEval(
                                                       * full Jacobian */
 {
   PUSH_NVTX("RichardsJacobianEval",1)
+  TelemetryBeginPhase(TelemetryJacobianPhase);
 
   PFModule      *this_module = ThisPFModule;
   InstanceXtra  *instance_xtra = (InstanceXtra*)PFModuleInstanceXtra(this_module);
@@ -353,23 +365,35 @@ void    RichardsJacobianEval(
   FinalizeVectorUpdate(vector_update_handle);
 
 /* Define grid for surface contribution */
-  KW = NewVectorType(grid2d, 1, 1, vector_cell_centered);
-  KE = NewVectorType(grid2d, 1, 1, vector_cell_centered);
-  KN = NewVectorType(grid2d, 1, 1, vector_cell_centered);
-  KS = NewVectorType(grid2d, 1, 1, vector_cell_centered);
-  KWns = NewVectorType(grid2d, 1, 1, vector_cell_centered);
-  KEns = NewVectorType(grid2d, 1, 1, vector_cell_centered);
-  KNns = NewVectorType(grid2d, 1, 1, vector_cell_centered);
-  KSns = NewVectorType(grid2d, 1, 1, vector_cell_centered);
-
-  InitVector(KW, 0.0);
-  InitVector(KE, 0.0);
-  InitVector(KN, 0.0);
-  InitVector(KS, 0.0);
-  InitVector(KWns, 0.0);
-  InitVector(KEns, 0.0);
-  InitVector(KNns, 0.0);
-  InitVector(KSns, 0.0);
+  if ((instance_xtra->KW) == NULL)
+  {
+    (instance_xtra->KW) = NewVectorType(grid2d, 1, 1, vector_cell_centered);
+    (instance_xtra->KE) = NewVectorType(grid2d, 1, 1, vector_cell_centered);
+    (instance_xtra->KN) = NewVectorType(grid2d, 1, 1, vector_cell_centered);
+    (instance_xtra->KS) = NewVectorType(grid2d, 1, 1, vector_cell_centered);
+    (instance_xtra->KWns) = NewVectorType(grid2d, 1, 1, vector_cell_centered);
+    (instance_xtra->KEns) = NewVectorType(grid2d, 1, 1, vector_cell_centered);
+    (instance_xtra->KNns) = NewVectorType(grid2d, 1, 1, vector_cell_centered);
+    (instance_xtra->KSns) = NewVectorType(grid2d, 1, 1, vector_cell_centered);
+  }
+  KW = (instance_xtra->KW);
+  KE = (instance_xtra->KE);
+  KN = (instance_xtra->KN);
+  KS = (instance_xtra->KS);
+  KWns = (instance_xtra->KWns);
+  KEns = (instance_xtra->KEns);
+  KNns = (instance_xtra->KNns);
+  KSns = (instance_xtra->KSns);
+
+  /* Start from zero, ghost layer included, like newly allocated vectors */
+  InitVectorAll(KW, 0.0);
+  InitVectorAll(KE, 0.0);
+  InitVectorAll(KN, 0.0);
+  InitVectorAll(KS, 0.0);
+  InitVectorAll(KWns, 0.0);
+  InitVectorAll(KEns, 0.0);
+  InitVectorAll(KNns, 0.0);
+  InitVectorAll(KSns, 0.0);
 
   // SGS set this to 1 since the off/on behavior does not work in
   // parallel.
@@ -377,8 +401,21 @@ void    RichardsJacobianEval(
   ovlnd_flag[0] = 1;  // determines whether or not to set up data structs for overland flow contribution
 
   /* Initialize matrix values to zero. */
+  /* JC has the size of J but is only used with overland flow, so it is
+   * not allocated until the first overland flow evaluation */
+  if (public_xtra->type == overland_flow && JC == NULL)
+  {
+    Stencil *stencil_C = NewStencil(jacobian_stencil_shape, 7);
+
+    JC = NewMatrixType(grid, NULL, stencil_C,
+                       instance_xtra->symmetric_jac ? ON : OFF, stencil_C,
+                       matrix_cell_centered);
+    instance_xtra->JC = JC;
+  }
+
   InitMatrix(J, 0.0);
-  InitMatrix(JC, 0.0);
+  if (JC)
+    InitMatrix(JC, 0.0);
 
   /* Calculate time term contributions. */
 
@@ -1869,14 +1906,6 @@ void    RichardsJacobianEval(
     lp = SubmatrixStencilData(J_sub, 5);
     up = SubmatrixStencilData(J_sub, 6);
 
-    /* for Cmat */
-    JC_sub = MatrixSubmatrix(JC, is);
-    cp_c = SubmatrixStencilData(JC_sub, 0);
-    wp_c = SubmatrixStencilData(JC_sub, 1);
-    ep_c = SubmatrixStencilData(JC_sub, 2);
-    sop_c = SubmatrixStencilData(JC_sub, 3);
-    np_c = SubmatrixStencilData(JC_sub, 4);
-
     GrGeomOutLoop(i, j, k, gr_domain, r, ix, iy, iz, nx, ny, nz,
     {
       int im = SubmatrixEltIndex(J_sub, i, j, k);
@@ -1941,23 +1970,33 @@ void    RichardsJacobianEval(
 
   FreeVector(density_der);
   FreeVector(saturation_der);
-  FreeVector(KW);
-  FreeVector(KE);
-  FreeVector(KN);
-  FreeVector(KS);
-  FreeVector(KWns);
-  FreeVector(KEns);
-  FreeVector(KNns);
-  FreeVector(KSns);
 
   tfree(ovlnd_flag);
 
+  TelemetryEndPhase(TelemetryJacobianPhase);
   POP_NVTX
 
   return;
 }
 
 
+/*--------------------------------------------------------------------------
+ * FreeRichardsJacobianEvalWorkVectors
+ *--------------------------------------------------------------------------*/
+
+static void FreeRichardsJacobianEvalWorkVectors(InstanceXtra *instance_xtra)
+{
+  FreeVector(instance_xtra->KW);
+  FreeVector(instance_xtra->KE);
+  FreeVector(instance_xtra->KN);
+  FreeVector(instance_xtra->KS);
+  FreeVector(instance_xtra->KWns);
+  FreeVector(instance_xtra->KEns);
+  FreeVector(instance_xtra->KNns);
+  FreeVector(instance_xtra->KSns);
+  (instance_xtra->KW) = NULL;
+}
+
 /*--------------------------------------------------------------------------
  * RichardsJacobianEvalInitInstanceXtra
  *--------------------------------------------------------------------------*/
@@ -1972,7 +2011,7 @@ PFModule    *RichardsJacobianEvalInitInstanceXtra(
   PFModule      *this_module = ThisPFModule;
   InstanceXtra  *instance_xtra;
 
-  Stencil       *stencil, *stencil_C;
+  Stencil       *stencil;
 
   (void)problem_data;
 
@@ -1987,30 +2026,30 @@ PFModule    *RichardsJacobianEvalInitInstanceXtra(
     if ((instance_xtra->grid) != NULL)
     {
       FreeMatrix(instance_xtra->J);
-      FreeMatrix(instance_xtra->JC);      /* DOK */
+      if (instance_xtra->JC)
+        FreeMatrix(instance_xtra->JC);      /* DOK */
     }
+    if ((instance_xtra->KW) != NULL)
+      FreeRichardsJacobianEvalWorkVectors(instance_xtra);
 
     /* set new data */
     (instance_xtra->grid) = grid;
 
-    /* set up jacobian matrix */
+    /* set up jacobian matrix; JC is set up on first use */
     stencil = NewStencil(jacobian_stencil_shape, 7);
-    stencil_C = NewStencil(jacobian_stencil_shape, 7);  //DOK
 
     if (symmetric_jac)
     {
       (instance_xtra->J) = NewMatrixType(grid, NULL, stencil, ON, stencil,
                                          matrix_cell_centered);
-      (instance_xtra->JC) = NewMatrixType(grid, NULL, stencil_C, ON, stencil_C,
-                                          matrix_cell_centered);
     }
     else
     {
       (instance_xtra->J) = NewMatrixType(grid, NULL, stencil, OFF, stencil,
                                          matrix_cell_centered);
-      (instance_xtra->JC) = NewMatrixType(grid, NULL, stencil_C, OFF, stencil_C,
-                                          matrix_cell_centered);
     }
+    (instance_xtra->JC) = NULL;
+    (instance_xtra->symmetric_jac) = symmetric_jac;
   }
 
   if (temp_data != NULL)
@@ -2084,7 +2123,11 @@ void  RichardsJacobianEvalFreeInstanceXtra()
 
     FreeMatrix(instance_xtra->J);
 
-    FreeMatrix(instance_xtra->JC);     /* DOK */
+    if (instance_xtra->JC)
+      FreeMatrix(instance_xtra->JC);     /* DOK */
+
+    if ((instance_xtra->KW) != NULL)
+      FreeRichardsJacobianEvalWorkVectors(instance_xtra);
 
     tfree(instance_xtra);
   }
@@ -2171,6 +2214,29 @@ PFModule   *RichardsJacobianEvalNewPublicXtra(char *name)
       InputError("Invalid switch value <%s> for key <%s>", switch_name, key);
     }
   }
+
+  sprintf(key, "Solver.Nonlinear.InterleavedJacobian");
+  switch_name = GetStringDefault(key, "False");
+  switch_value = NA_NameToIndexExitOnError(switch_na, switch_name, key);
+  switch (switch_value)
+  {
+    case 0:
+    {
+      public_xtra->interleave = 0;
+      break;
+    }
+
+    case 1:
+    {
+      public_xtra->interleave = 1;
+      break;
+    }
+
+    default:
+    {
+      InputError("Invalid switch value <%s> for key <%s>", switch_name, key);
+    }
+  }
   NA_FreeNameArray(switch_na);
 
   PFModulePublicXtra(this_module) = public_xtra;
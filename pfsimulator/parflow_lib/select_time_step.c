@@ -50,6 +50,12 @@ typedef struct {
   double max_step;
 } Type1;                       /* step increases to a max value */
 
+typedef struct {
+  double initial_step;
+  double min_step;
+  double max_step;
+} Type2;                       /* step chosen by the TimeStepController */
+
 /*--------------------------------------------------------------------------
  * SelectTimeStep:
  *    This routine returns a time step size.
@@ -69,6 +75,7 @@ void     SelectTimeStep(
 
   Type0         *dummy0;
   Type1         *dummy1;
+  Type2         *dummy2;
 
   double well_dt, bc_dt;
 
@@ -116,6 +123,27 @@ void     SelectTimeStep(
 
       break;
     }    /* End case 1 */
+
+    case 2:
+    {
+      /* The step size is proposed by the caller through the
+       * TimeStepController module; only keep it within bounds here. */
+      dummy2 = (Type2*)(public_xtra->data);
+
+      if ((*dt) == 0.0)
+      {
+        (*dt) = (dummy2->initial_step);
+      }
+      else
+      {
+        if ((*dt) < (dummy2->min_step))
+          (*dt) = (dummy2->min_step);
+        if ((*dt) > (dummy2->max_step))
+          (*dt) = (dummy2->max_step);
+      }
+
+      break;
+    }    /* End case 2 */
   }      /* End switch */
 
   /*-----------------------------------------------------------------
@@ -198,12 +226,13 @@ PFModule  *SelectTimeStepNewPublicXtra()
 
   Type0            *dummy0;
   Type1            *dummy1;
+  Type2            *dummy2;
 
   char *switch_name;
 
   NameArray type_na;
 
-  type_na = NA_NewNameArray("Constant Growth");
+  type_na = NA_NewNameArray("Constant Growth Adaptive");
 
   public_xtra = ctalloc(PublicXtra, 1);
 
@@ -237,6 +266,19 @@ PFModule  *SelectTimeStepNewPublicXtra()
       break;
     }
 
+    case 2:
+    {
+      dummy2 = ctalloc(Type2, 1);
+
+      dummy2->initial_step = GetDouble("TimeStep.InitialStep");
+      dummy2->max_step = GetDouble("TimeStep.MaxStep");
+      dummy2->min_step = GetDouble("TimeStep.MinStep");
+
+      (public_xtra->data) = (void*)dummy2;
+
+      break;
+    }
+
     default:
     {
       InputError("Invalid switch value <%s> for key <%s>", switch_name, "TimeStep.Type");
@@ -261,6 +303,7 @@ void  SelectTimeStepFreePublicXtra()
 
   Type0        *dummy0;
   Type1        *dummy1;
+  Type2        *dummy2;
 
   if (public_xtra)
   {
@@ -279,6 +322,13 @@ void  SelectTimeStepFreePublicXtra()
         tfree(dummy1);
         break;
       }
+
+      case 2:
+      {
+        dummy2 = (Type2*)(public_xtra->data);
+        tfree(dummy2);
+        break;
+      }
     }
 
     tfree(public_xtra);
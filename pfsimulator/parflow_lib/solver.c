@@ -100,9 +100,23 @@ NewSolver()
     switch_na = NA_NewNameArray("False True");
     switch_name = GetStringDefault("UseClustering", "True");
     GlobalsUseClustering = NA_NameToIndexExitOnError(switch_na, switch_name, "UseClustering");
+
+    switch_name = GetStringDefault("UseVectorRowPadding", "False");
+    GlobalsUseVectorRowPadding = NA_NameToIndexExitOnError(switch_na, switch_name, "UseVectorRowPadding");
+
+    switch_name = GetStringDefault("UseMappedPFBReader", "False");
+    GlobalsUseMappedPFBReader = NA_NameToIndexExitOnError(switch_na, switch_name, "UseMappedPFBReader");
     NA_FreeNameArray(switch_na);
   }
 
+#ifdef HAVE_SAMRAI
+  if (GlobalsUseVectorRowPadding)
+  {
+    InputError("Error: <%s> used for key <%s> but SAMRAI vectors can not be padded\n",
+               "True", "UseVectorRowPadding");
+  }
+#endif
+
   /*-----------------------------------------------------------------------
    * Initialize SAMRAI hierarchy
    *-----------------------------------------------------------------------*/
@@ -120,6 +134,13 @@ NewSolver()
     solver = NA_NameToIndexExitOnError(solver_na, switch_name, "Solver");
     NA_FreeNameArray(solver_na);
 
+    /* The Fortran advection of the Impes solver needs unpadded vectors */
+    if (GlobalsUseVectorRowPadding && solver != 0)
+    {
+      InputError("Error: <%s> used for key <%s> but only the Richards solver supports padded vectors\n",
+                 "True", "UseVectorRowPadding");
+    }
+
     switch (solver)
     {
       case 0:
@@ -46,6 +46,11 @@
 #define HarmonicMeanDZ(a, b, c, d) (((c * b) + (a * d)) ?  (((c + d) * a * b) / ((b * c) + (a * d))) : 0)
 #define UpstreamMean(a, b, c, d) (((a - b) >= 0) ? c : d)
 
+/* x^(5/3) and x^(2/3) of Manning's equation through cbrt, which is several
+ * times cheaper than pow; like RPowerR they are zero for x <= 0 */
+#define PowerFiveThirds(x)    (((x) > 0.0) ? (x) * cbrt((x) * (x)) : 0.0)
+#define PowerTwoThirds(x)     (((x) > 0.0) ? cbrt((x) * (x)) : 0.0)
+
 #define CellFaceConductivity  HarmonicMean
 
 
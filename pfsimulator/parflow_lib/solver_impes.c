@@ -62,6 +62,7 @@ typedef struct {
   int sadvect_order;
   int advect_order;
   double CFL;
+  int max_subcycles;                         /* transport substeps per step */
   int max_iterations;
   double rel_tol;                            /* relative tolerance */
   double abs_tol;                            /* absolute tolerance */
@@ -111,6 +112,27 @@ typedef struct {
 } InstanceXtra;
 
 
+/*-------------------------------------------------------------------------
+ * NumSubcycles:
+ *   Number of advection substeps of a time step `dt' whose CFL limited
+ *   step is `cfl_dt'.
+ *-------------------------------------------------------------------------*/
+
+static int NumSubcycles(double dt, double cfl_dt, int max_subcycles)
+{
+  int num_subcycles;
+
+  if (max_subcycles == 1 || cfl_dt <= 0.0)
+  {
+    return 1;
+  }
+
+  num_subcycles = (int)ceil(dt / cfl_dt);
+
+  return pfmax(1, pfmin(num_subcycles, max_subcycles));
+}
+
+
 /*-------------------------------------------------------------------------
  * SolverImpes
  *-------------------------------------------------------------------------*/
@@ -126,6 +148,7 @@ void      SolverImpes()
   int sadvect_order = (public_xtra->sadvect_order);
   int advect_order = (public_xtra->advect_order);
   double CFL = (public_xtra->CFL);
+  int max_subcycles = (public_xtra->max_subcycles);
   int max_iterations = (public_xtra->max_iterations);
 /*   double        rel_tol             = (public_xtra -> rel_tol);  */
   double abs_tol = (public_xtra->abs_tol);
@@ -170,7 +193,7 @@ void      SolverImpes()
   Vector       *temp_mobility_y = NULL;
   Vector       *temp_mobility_z = NULL;
   Vector       *stemp = NULL;
-  Vector       *ctemp = NULL;
+  Vector      **ctemps = NULL;
 
   int start_count = ProblemStartCount(problem);
   double start_time = ProblemStartTime(problem);
@@ -188,7 +211,8 @@ void      SolverImpes()
   Vector       *total_x_velocity = NULL, *total_y_velocity = NULL, *total_z_velocity = NULL;
   Vector       *z_permeability = NULL;
 
-  Vector       *solidmassfactor = NULL;
+  Vector      **solidmassfactors = NULL;
+  CommPkg      *solidmassfactor_comm_pkg = NULL;
 
   Matrix       *A;
   Vector       *f;
@@ -205,6 +229,8 @@ void      SolverImpes()
 
   double t;
   double dt;
+  double sub_t, sub_dt;
+  int substep, num_satur_substeps = 1, num_concen_substeps = 1;
   double       *phase_dt = NULL, min_phase_dt = 0.0, total_dt = 0.0, print_dt, well_dt, bc_dt;
   double phase_maximum, total_maximum;
   double dtmp, *phase_densities;
@@ -232,7 +258,6 @@ void      SolverImpes()
     temp_mobility_z = NewVectorType(instance_xtra->grid, 1, 1, vector_cell_centered);
     stemp = NewVectorType(instance_xtra->grid, 1, 3, vector_cell_centered);
   }
-  ctemp = NewVectorType(instance_xtra->grid, 1, 3, vector_cell_centered);
 
 
   IfLogging(1)
@@ -406,7 +431,23 @@ void      SolverImpes()
 
       if (ProblemNumContaminants(problem) > 0)
       {
-        solidmassfactor = NewVectorType(grid, 1, 2, vector_cell_centered);
+        /*----------------------------------------------------------------
+         * The contaminants of a phase are advected together, each one
+         * with its own copy of the old concentration and its own
+         * retardation
+         *----------------------------------------------------------------*/
+
+        ctemps = ctalloc(Vector *, ProblemNumContaminants(problem));
+        solidmassfactors = ctalloc(Vector *, ProblemNumContaminants(problem));
+        for (concen = 0; concen < ProblemNumContaminants(problem); concen++)
+        {
+          ctemps[concen] = NewVectorType(grid, 1, 3, vector_cell_centered);
+          solidmassfactors[concen] = NewVectorType(grid, 1, 2, vector_cell_centered);
+        }
+        solidmassfactor_comm_pkg =
+          NewVectorGroupCommPkg(solidmassfactors,
+                                ProblemNumContaminants(problem),
+                                GridComputePkg(grid, VectorUpdateAll2));
 
         /*----------------------------------------------------------------
          * Allocate and set up initial concentrations
@@ -881,11 +922,11 @@ void      SolverImpes()
       {
         if (is_multiphase)
         {
-          dt = pfmin(total_dt, min_phase_dt);
+          dt = max_subcycles * pfmin(total_dt, min_phase_dt);
         }
         else
         {
-          dt = phase_dt[0];
+          dt = max_subcycles * phase_dt[0];
         }
 
         if (well_dt < 0.0)
@@ -905,7 +946,7 @@ void      SolverImpes()
 
         if (is_multiphase)
         {
-          if (dt == total_dt)
+          if (dt == max_subcycles * total_dt)
           {
             recompute_pressure = 1;
             evolve_saturations = 1;
@@ -1041,6 +1082,21 @@ void      SolverImpes()
         }
 
         t += dt;
+
+        /*-------------------------------------------------------------
+         * The advection takes as many substeps of the step as its CFL
+         * limit requires, with the velocities of the step.
+         *-------------------------------------------------------------*/
+
+        if (is_multiphase)
+        {
+          num_satur_substeps = NumSubcycles(dt, total_dt, max_subcycles);
+          num_concen_substeps = NumSubcycles(dt, min_phase_dt, max_subcycles);
+        }
+        else
+        {
+          num_concen_substeps = NumSubcycles(dt, phase_dt[0], max_subcycles);
+        }
       }
 
       /******************************************************************/
@@ -1054,35 +1110,42 @@ void      SolverImpes()
       {
         if (evolve_saturations)
         {
-          for (phase = 0; phase < ProblemNumPhases(problem) - 1; phase++)
+          sub_dt = dt / num_satur_substeps;
+          for (substep = 0; substep < num_satur_substeps; substep++)
           {
-            InitVectorAll(stemp, 0.0);
-            Copy(saturations[phase], stemp);
-            PFModuleInvokeType(BCPhaseSaturationInvoke, bc_phase_saturation,
-                               (stemp, phase, gr_domain));
-
-
-            /* Evolve to the new time */
-            PFModuleInvokeType(AdvectionSaturationInvoke, advect_satur,
-                               (problem_data, phase,
-                                stemp, saturations[phase],
-                                total_x_velocity,
-                                total_y_velocity,
-                                total_z_velocity,
-                                z_permeability,
-                                ProblemDataPorosity(problem_data),
-                                ProblemPhaseViscosities(problem),
-                                phase_densities,
-                                ProblemGravity(problem),
-                                t, dt, sadvect_order));
-          }
-          InitVectorAll(saturations[ProblemNumPhases(problem) - 1], 0.0);
-          PFModuleInvokeType(SaturationConstitutiveInvoke, constitutive, (saturations));
+            sub_t = (substep == num_satur_substeps - 1) ?
+                    t : t - dt + (substep + 1) * sub_dt;
 
-          handle = InitVectorUpdate(saturations[
-                                      ProblemNumPhases(problem) - 1],
-                                    VectorUpdateGodunov);
-          FinalizeVectorUpdate(handle);
+            for (phase = 0; phase < ProblemNumPhases(problem) - 1; phase++)
+            {
+              InitVectorAll(stemp, 0.0);
+              Copy(saturations[phase], stemp);
+              PFModuleInvokeType(BCPhaseSaturationInvoke, bc_phase_saturation,
+                                 (stemp, phase, gr_domain));
+
+
+              /* Evolve to the new time */
+              PFModuleInvokeType(AdvectionSaturationInvoke, advect_satur,
+                                 (problem_data, phase,
+                                  stemp, saturations[phase],
+                                  total_x_velocity,
+                                  total_y_velocity,
+                                  total_z_velocity,
+                                  z_permeability,
+                                  ProblemDataPorosity(problem_data),
+                                  ProblemPhaseViscosities(problem),
+                                  phase_densities,
+                                  ProblemGravity(problem),
+                                  sub_t, sub_dt, sadvect_order));
+            }
+            InitVectorAll(saturations[ProblemNumPhases(problem) - 1], 0.0);
+            PFModuleInvokeType(SaturationConstitutiveInvoke, constitutive, (saturations));
+
+            handle = InitVectorUpdate(saturations[
+                                        ProblemNumPhases(problem) - 1],
+                                      VectorUpdateGodunov);
+            FinalizeVectorUpdate(handle);
+          }
 
           /* Print the saturation values at this time-step? */
           if (dump_files)
@@ -1121,31 +1184,46 @@ void      SolverImpes()
       {
         if (ProblemNumContaminants(problem) > 0)
         {
+          /* The retardation depends on the contaminant only */
+          for (concen = 0; concen < ProblemNumContaminants(problem); concen++)
+          {
+            PFModuleInvokeType(RetardationInvoke, retardation,
+                               (solidmassfactors[concen],
+                                concen,
+                                problem_data));
+          }
+          handle = InitVectorGroupUpdate(solidmassfactors,
+                                         ProblemNumContaminants(problem),
+                                         VectorUpdateAll2,
+                                         solidmassfactor_comm_pkg);
+          FinalizeVectorUpdate(handle);
+
           /* Solve for the concentration values at this time-step. */
-          indx = 0;
-          for (phase = 0; phase < ProblemNumPhases(problem); phase++)
+          sub_dt = dt / num_concen_substeps;
+          for (substep = 0; substep < num_concen_substeps; substep++)
           {
-            for (concen = 0; concen < ProblemNumContaminants(problem); concen++)
-            {
-              PFModuleInvokeType(RetardationInvoke, retardation,
-                                 (solidmassfactor,
-                                  concen,
-                                  problem_data));
-              handle = InitVectorUpdate(solidmassfactor, VectorUpdateAll2);
-              FinalizeVectorUpdate(handle);
+            sub_t = (substep == num_concen_substeps - 1) ?
+                    t : t - dt + (substep + 1) * sub_dt;
 
-              InitVectorAll(ctemp, 0.0);
-              Copy(concentrations[indx], ctemp);
+            indx = 0;
+            for (phase = 0; phase < ProblemNumPhases(problem); phase++)
+            {
+              for (concen = 0; concen < ProblemNumContaminants(problem); concen++)
+              {
+                InitVectorAll(ctemps[concen], 0.0);
+                Copy(concentrations[indx + concen], ctemps[concen]);
+              }
 
               PFModuleInvokeType(AdvectionConcentrationInvoke, advect_concen,
-                                 (problem_data, phase, concen,
-                                  ctemp, concentrations[indx],
+                                 (problem_data, phase,
+                                  ProblemNumContaminants(problem),
+                                  ctemps, concentrations + indx,
                                   phase_x_velocity[phase],
                                   phase_y_velocity[phase],
                                   phase_z_velocity[phase],
-                                  solidmassfactor,
-                                  t, dt, advect_order));
-              indx++;
+                                  solidmassfactors,
+                                  sub_t, sub_dt, advect_order));
+              indx += ProblemNumContaminants(problem);
             }
           }
 
@@ -1393,7 +1471,14 @@ void      SolverImpes()
       }
       tfree(concentrations);
 
-      FreeVector(solidmassfactor);
+      FreeCommPkg(solidmassfactor_comm_pkg);
+      for (concen = 0; concen < ProblemNumContaminants(problem); concen++)
+      {
+        FreeVector(solidmassfactors[concen]);
+        FreeVector(ctemps[concen]);
+      }
+      tfree(solidmassfactors);
+      tfree(ctemps);
     }
   }
 
@@ -1418,8 +1503,6 @@ void      SolverImpes()
     FreeVector(temp_mobility_y);
     FreeVector(temp_mobility_z);
   }
-  FreeVector(ctemp);
-
   FreeVector(total_mobility_x);
   FreeVector(total_mobility_y);
   FreeVector(total_mobility_z);
@@ -2003,6 +2086,15 @@ PFModule   *SolverImpesNewPublicXtra(char *name)
   sprintf(key, "%s.CFL", name);
   public_xtra->CFL = GetDoubleDefault(key, 0.7);
 
+  sprintf(key, "%s.MaxSubcycles", name);
+  public_xtra->max_subcycles = GetIntDefault(key, 1);
+  if (public_xtra->max_subcycles < 1)
+  {
+    char tmp_str[100];
+    sprintf(tmp_str, "%d", public_xtra->max_subcycles);
+    InputError("Error: Invalid value <%s> for key <%s>, must be >= 1\n", tmp_str, key);
+  }
+
   sprintf(key, "%s.MaxIter", name);
   public_xtra->max_iterations = GetIntDefault(key, 1000000);
 
@@ -147,7 +147,7 @@ void      SolverDiffusion()
   Vector       *temp_mobility_y = NULL;
   Vector       *temp_mobility_z = NULL;
   Vector       *stemp = NULL;
-  Vector       *ctemp = NULL;
+  Vector      **ctemps = NULL;
 
   int start_count = ProblemStartCount(problem);
   double start_time = ProblemStartTime(problem);
@@ -167,7 +167,8 @@ void      SolverDiffusion()
   Vector       *total_x_velocity, *total_y_velocity, *total_z_velocity;
   Vector       *z_permeability;
 
-  Vector       *solidmassfactor;
+  Vector      **solidmassfactors = NULL;
+  CommPkg      *solidmassfactor_comm_pkg = NULL;
 
   Matrix       *A;
   Vector       *f;
@@ -215,7 +216,6 @@ void      SolverDiffusion()
     temp_mobility_z = NewVectorType(grid, 1, 1, vector_cell_centered);
     stemp = NewVectorType(grid, 1, 3, vector_cell_centered);
   }
-  ctemp = NewVectorType(grid, 1, 3, vector_cell_centered);
 
 
   IfLogging(1)
@@ -377,7 +377,25 @@ void      SolverDiffusion()
       if (is_multiphase)
         eval_struct = NewEvalStruct(problem);
 
-      solidmassfactor = NewVectorType(grid, 1, 2, vector_cell_centered);
+      /*-------------------------------------------------------------------
+       * The contaminants of a phase are advected together, each one with
+       * its own copy of the old concentration and its own retardation
+       *-------------------------------------------------------------------*/
+
+      if (ProblemNumContaminants(problem) > 0)
+      {
+        ctemps = ctalloc(Vector *, ProblemNumContaminants(problem));
+        solidmassfactors = ctalloc(Vector *, ProblemNumContaminants(problem));
+        for (concen = 0; concen < ProblemNumContaminants(problem); concen++)
+        {
+          ctemps[concen] = NewVectorType(grid, 1, 3, vector_cell_centered);
+          solidmassfactors[concen] = NewVectorType(grid, 1, 2, vector_cell_centered);
+        }
+        solidmassfactor_comm_pkg =
+          NewVectorGroupCommPkg(solidmassfactors,
+                                ProblemNumContaminants(problem),
+                                GridComputePkg(grid, VectorUpdateAll2));
+      }
 
       /*-------------------------------------------------------------------
        * Allocate and set up initial concentrations
@@ -1090,34 +1108,42 @@ void      SolverDiffusion()
       /*            Solve for and print the concentrations                   */
       /***********************************************************************/
 
-      if (evolve_concentrations)
+      if (evolve_concentrations && ProblemNumContaminants(problem) > 0)
       {
+        /* The retardation depends on the contaminant only */
+        for (concen = 0; concen < ProblemNumContaminants(problem); concen++)
+        {
+          PFModuleInvokeType(RetardationInvoke, retardation,
+                             (solidmassfactors[concen],
+                              concen,
+                              problem_data));
+        }
+        handle = InitVectorGroupUpdate(solidmassfactors,
+                                       ProblemNumContaminants(problem),
+                                       VectorUpdateAll2,
+                                       solidmassfactor_comm_pkg);
+        FinalizeVectorUpdate(handle);
+
         /* Solve for the concentration values at this time-step. */
         indx = 0;
         for (phase = 0; phase < ProblemNumPhases(problem); phase++)
         {
           for (concen = 0; concen < ProblemNumContaminants(problem); concen++)
           {
-            PFModuleInvokeType(RetardationInvoke, retardation,
-                               (solidmassfactor,
-                                concen,
-                                problem_data));
-            handle = InitVectorUpdate(solidmassfactor, VectorUpdateAll2);
-            FinalizeVectorUpdate(handle);
-
-            InitVectorAll(ctemp, 0.0);
-            Copy(concentrations[indx], ctemp);
-
-            PFModuleInvokeType(AdvectionConcentrationInvoke, advect_concen,
-                               (problem_data, phase, concen,
-                                ctemp, concentrations[indx],
-                                phase_x_velocity[phase],
-                                phase_y_velocity[phase],
-                                phase_z_velocity[phase],
-                                solidmassfactor,
-                                t, dt, advect_order));
-            indx++;
+            InitVectorAll(ctemps[concen], 0.0);
+            Copy(concentrations[indx + concen], ctemps[concen]);
           }
+
+          PFModuleInvokeType(AdvectionConcentrationInvoke, advect_concen,
+                             (problem_data, phase,
+                              ProblemNumContaminants(problem),
+                              ctemps, concentrations + indx,
+                              phase_x_velocity[phase],
+                              phase_y_velocity[phase],
+                              phase_z_velocity[phase],
+                              solidmassfactors,
+                              t, dt, advect_order));
+          indx += ProblemNumContaminants(problem);
         }
 
         /* Print the concentration values at this time-step? */
@@ -1235,7 +1261,17 @@ void      SolverDiffusion()
     }
     tfree(concentrations);
 
-    FreeVector(solidmassfactor);
+    if (ProblemNumContaminants(problem) > 0)
+    {
+      FreeCommPkg(solidmassfactor_comm_pkg);
+      for (concen = 0; concen < ProblemNumContaminants(problem); concen++)
+      {
+        FreeVector(solidmassfactors[concen]);
+        FreeVector(ctemps[concen]);
+      }
+      tfree(solidmassfactors);
+      tfree(ctemps);
+    }
   }
 
   if (is_multiphase)
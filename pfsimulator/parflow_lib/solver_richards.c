@@ -52,6 +52,12 @@
 
 #define PF_CLM_MAX_ROOT_NZ 20
 
+/* Number of CLM snow layers, must match nlevsno in clm_varpar.F90 */
+#define PF_CLM_NLEVSNO 5
+
+/* Number of layers in the PFB CLM restart state, see drv_restart_pf.F90 */
+#define PF_CLM_RST_NZ(clm_nz) (21 + 6 * (PF_CLM_NLEVSNO + (clm_nz)))
+
 /*--------------------------------------------------------------------------
  * Structures
  *--------------------------------------------------------------------------*/
@@ -61,6 +67,7 @@ typedef struct {
   PFModule *advect_concen;
   PFModule *set_problem_data;
   PFModule *nonlin_solver;
+  PFModule *time_step_controller;       /* NULL unless TimeStep.Type is Adaptive */
 
   Problem *problem;
 
@@ -170,8 +177,17 @@ typedef struct {
   int clm_write_logs;           /* NBE: Write the processor logs for CLM or not */
   int clm_last_rst;             /* NBE: Only write/overwrite one rst file or write a lot of them */
   int clm_daily_rst;            /* NBE: Write daily RST files or hourly */
+  int clm_rst_pfb;              /* Write/read CLM restarts as a single PFB instead of per-rank files */
 #endif
 
+  int checkpoint;               /* write or restore checkpoints of the solver state? */
+  double checkpoint_wall_clock_interval;        /* seconds between checkpoints */
+  int checkpoint_step_interval; /* time steps between checkpoints */
+  int checkpoint_restore;       /* continue from the last checkpoint? */
+
+  int write_telemetry;          /* write the per time step telemetry stream? */
+  int telemetry_flush_interval; /* time steps between telemetry writes */
+
   int print_lsm_sink;           /* print LSM sink term? */
   int write_silo_CLM;           /* write CLM output as silo? */
   int write_silopmpio_CLM;      /* write CLM output as silo as PMPIO? */
@@ -218,6 +234,7 @@ typedef struct {
   PFModule *select_time_step;
   PFModule *l2_error_norm;
   PFModule *nonlin_solver;
+  PFModule *time_step_controller;
 
   Grid *grid;
   Grid *grid2d;
@@ -288,6 +305,9 @@ typedef struct {
 
   Grid *snglclm;                /* NBE: New grid for single file CLM ouptut */
   Vector *clm_out_grid;         /* NBE - Holds multi-layer, single file output of CLM */
+
+  Grid *gridRst;                /* Grid for the PFB CLM restart state (nx*ny*PF_CLM_RST_NZ) */
+  Vector *clm_rst;              /* CLM restart state, one layer per restart field */
 #endif
 
   double *time_log;
@@ -302,6 +322,9 @@ typedef struct {
   int iteration_number;
   double dump_index;
   double clm_dump_index;
+
+  Checkpoint *checkpoint;       /* NULL unless checkpoints are enabled */
+  int checkpoint_restored;      /* has the checkpoint been restored? */
 } InstanceXtra;
 
 static const char* dswr_filenames[] = { "DSWR" };
@@ -869,6 +892,15 @@ SetupRichards(PFModule * this_module)
       InitVectorAll(instance_xtra->clm_out_grid, 0.0);
     }
 
+    /* CLM restart state written/read as a single PFB, also used to
+     * carry the CLM state in solver checkpoints */
+    if (public_xtra->clm_rst_pfb || public_xtra->checkpoint)
+    {
+      instance_xtra->clm_rst =
+        NewVectorType(instance_xtra->gridRst, 1, 1, vector_clm_topsoil);
+      InitVectorAll(instance_xtra->clm_rst, 0.0);
+    }
+
     /*IMF Initialize variables for printing CLM output */
     instance_xtra->eflx_lh_tot =
       NewVectorType(grid2d, 1, 1, vector_cell_centered_2D);
@@ -1553,6 +1585,7 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
   PFModule *select_time_step = (instance_xtra->select_time_step);
   PFModule *l2_error_norm = (instance_xtra->l2_error_norm);
   PFModule *nonlin_solver = (instance_xtra->nonlin_solver);
+  PFModule *time_step_controller = (instance_xtra->time_step_controller);
 
   ProblemData *problem_data = (instance_xtra->problem_data);
 
@@ -1634,6 +1667,13 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
     *qirr, *qirr_inst;
   int clm_file_dir_length;
 
+  /* CLM restart state as a single PFB */
+  double *clm_rst_data;
+  int clm_rst_nz = PF_CLM_RST_NZ(public_xtra->clm_nz);
+  int clm_rst_found = 0;
+  int clm_rst_step, clm_rst_written;
+  int clm_rst_mode;
+
   double print_cdt;
   int clm_dump_files = 0;
   int rank = amps_Rank(amps_CommWorld);
@@ -1648,6 +1688,12 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
   int take_more_time_steps;
   int conv_failures;
   int max_failures = public_xtra->max_convergence_failures;
+  int nonlin_iters = 0;
+  int lin_iters = 0;
+  int step_attempts;
+  int step_nonlin_iters;
+  int step_lin_iters;
+  int step_accepted;
 
   double t;
   double dt = 0.0;
@@ -1655,6 +1701,7 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
   double cdt = 0.0;
   double print_dt;
   double dtmp, err_norm;
+  double next_dt = 0.0;         /* step proposed by the time step controller */
   double gravity = ProblemGravity(problem);
 
   VectorUpdateCommHandle *handle;
@@ -1665,6 +1712,9 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
 
   int first_tstep = 1;
 
+  Checkpoint *checkpoint = (instance_xtra->checkpoint);
+  int checkpoint_due = 0;
+
   sprintf(file_prefix, "%s", GlobalsOutFileName);
 
   //CPS oasis definition phase
@@ -1741,8 +1791,88 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
   fstop = 0;                    // init to something, only used with 3D met forcing
 #endif
 
+  /*
+   * Register everything needed to continue the time loop from the end
+   * of a step.  old_* vectors are not needed; they are copied from the
+   * current state at the start of each step.
+   */
+  if (checkpoint)
+  {
+    ClearCheckpoint(checkpoint);
+
+    CheckpointAddInt(checkpoint, &(instance_xtra->iteration_number));
+    CheckpointAddInt(checkpoint, &(instance_xtra->file_number));
+    CheckpointAddDouble(checkpoint, &t);
+    CheckpointAddDouble(checkpoint, &dt);
+    CheckpointAddDouble(checkpoint, &next_dt);
+    CheckpointAddDouble(checkpoint, &(instance_xtra->dump_index));
+    CheckpointAddDouble(checkpoint, &(instance_xtra->clm_dump_index));
+
+    CheckpointAddVector(checkpoint, "press", instance_xtra->pressure);
+    CheckpointAddVector(checkpoint, "satur", instance_xtra->saturation);
+    CheckpointAddVector(checkpoint, "density", instance_xtra->density);
+    CheckpointAddVector(checkpoint, "evaptranssum", evap_trans_sum);
+    CheckpointAddVector(checkpoint, "overlandsum", overland_sum);
+
+    if (time_step_controller)
+    {
+      TimeStepControllerCheckpoint(time_step_controller, checkpoint);
+    }
+
+#ifdef HAVE_CLM
+    if (public_xtra->lsm == 1)
+    {
+      CheckpointAddInt(checkpoint, &istep);
+      CheckpointAddInt(checkpoint, &clm_next);
+      CheckpointAddInt(checkpoint, &Stepcount);
+      CheckpointAddInt(checkpoint, &Loopcount);
+      CheckpointAddVector(checkpoint, "clm", instance_xtra->clm_rst);
+    }
+#endif
+
+    if (public_xtra->checkpoint_restore
+        && !(instance_xtra->checkpoint_restored))
+    {
+      (instance_xtra->checkpoint_restored) = 1;
+
+      if (ReadCheckpoint(checkpoint, file_prefix))
+      {
+        if (!amps_Rank(amps_CommWorld))
+        {
+          amps_Printf("Restored checkpoint at time %e\n", t);
+        }
+
+        /* Continue as if this run had started at the checkpoint */
+        start_time = t;
+        ct = t;
+#ifdef HAVE_CLM
+        /* CLM takes its state and time from the checkpoint */
+        clm_rst_found = 2;
+#endif
+      }
+      else if (!amps_Rank(amps_CommWorld))
+      {
+        amps_Printf("No checkpoint found, starting from the initial conditions\n");
+      }
+    }
+  }
+
   do                            /* while take_more_time_steps */
   {
+    TelemetryBeginStep();
+    step_attempts = 0;
+    step_nonlin_iters = 0;
+    step_lin_iters = 0;
+
+    /* Decide at the start of a step whether it ends with a checkpoint,
+     * so CLM can pack its state during this step's land surface call */
+    if (checkpoint && !checkpoint_due
+        && (public_xtra->lsm == 0 || t == ct))
+    {
+      checkpoint_due =
+        CheckpointDue(checkpoint, instance_xtra->iteration_number + 1);
+    }
+
     if (t == ct)
     {
       ct += cdt;
@@ -1795,6 +1925,7 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
 
       /* IMF: The following are only used w/ CLM */
 #ifdef HAVE_CLM
+      TelemetryBeginPhase(TelemetryCLMPhase);
       BeginTiming(CLMTimingIndex);
 
       /* sk: call to the land surface model/subroutine */
@@ -1940,7 +2071,7 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
             if (fflag == 0)
             {
               fflag = 1;
-              fstart = (public_xtra->clm_istep_start) - fstep;                  // first time value in 3D met file names
+              fstart = istep - fstep;                   // first time value in 3D met file names
               fstop = fstart - 1 + public_xtra->clm_metnt;              // second time value in 3D met file names
             }
             else
@@ -2164,6 +2295,30 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
         }
       }
 
+      /* Read the PFB CLM restart on the first CLM step.  The file is read
+       * onto the current process topology, so it does not need to match the
+       * topology of the run that wrote it.  CLM decides from drv_clmin.dat
+       * whether the state is actually used. */
+      if (public_xtra->clm_rst_pfb && t == start_time && clm_rst_found != 2)
+      {
+        sprintf(filename, "%s.clm_rst.%05d.pfb", GlobalsOutFileName,
+                clm_last_rst ? 0 : istep - 1);
+        clm_rst_found = (access(filename, 0) != -1);
+        if (clm_rst_found)
+        {
+          if (!amps_Rank(amps_CommWorld))
+          {
+            amps_Printf("Reading CLM restart %s\n", filename);
+          }
+          ReadPFBinary(filename, instance_xtra->clm_rst);
+        }
+      }
+      clm_rst_written = -1;
+
+      /* Restart mode passed to CLM: 1 selects the PFB restart format,
+       * 2 asks CLM to pack its state into clm_rst for a checkpoint */
+      clm_rst_mode = public_xtra->clm_rst_pfb + (checkpoint_due ? 2 : 0);
+
 
 
       ForSubgridI(is, GridSubgrids(grid))
@@ -2371,6 +2526,13 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
           qatm_data = SubvectorData(qatm_forc_sub);
         }
 
+        clm_rst_data = NULL;
+        if (public_xtra->clm_rst_pfb || checkpoint)
+        {
+          clm_rst_data =
+            SubvectorData(VectorSubvector(instance_xtra->clm_rst, is));
+        }
+
         ip = SubvectorEltIndex(p_sub, ix, iy, iz);
         switch (public_xtra->lsm)
         {
@@ -2418,7 +2580,11 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
                          clm_next, clm_write_logs, clm_last_rst,
                          clm_daily_rst,
                          public_xtra->clm_nz,
-                         public_xtra->clm_nz);
+                         public_xtra->clm_nz,
+                         clm_rst_mode,
+                         clm_rst_nz, clm_rst_data,
+                         clm_rst_found, clm_rst_step);
+            clm_rst_written = pfmax(clm_rst_written, clm_rst_step);
 
             break;
           }
@@ -2430,6 +2596,19 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
         }                       /* switch on LSM */
       }
 
+      /* CLM packed its restart state into clm_rst; write it as one PFB */
+      if (public_xtra->clm_rst_pfb)
+      {
+        amps_Invoice rst_invoice = amps_NewInvoice("%i", &clm_rst_written);
+        amps_AllReduce(amps_CommWorld, rst_invoice, amps_Max);
+        amps_FreeInvoice(rst_invoice);
+
+        if (clm_rst_written >= 0)
+        {
+          sprintf(file_postfix, "clm_rst.%05d", clm_rst_written);
+          WritePFBinary(file_prefix, file_postfix, instance_xtra->clm_rst);
+        }
+      }
 
       handle = InitVectorUpdate(evap_trans, VectorUpdateAll);
       FinalizeVectorUpdate(handle);
@@ -2503,6 +2682,7 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
       //istep  = istep + 1;
 
       EndTiming(CLMTimingIndex);
+      TelemetryEndPhase(TelemetryCLMPhase);
 
 
       /* =============================================================
@@ -2535,6 +2715,11 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
       /*******************************************************************/
       if (converged)
       {
+        if (time_step_controller && next_dt > 0.0)
+        {
+          dt = next_dt;
+        }
+
         if (time_step_control)
         {
           PFModuleInvokeType(SelectTimeStepInvoke, time_step_control,
@@ -2559,6 +2744,11 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
 
         double new_dt = 0.5 * dt;
 
+        if (time_step_controller)
+        {
+          new_dt = next_dt;
+        }
+
         // If time increment is too small don't try to cut in half.
         {
           double test_time = t + new_dt;
@@ -2880,7 +3070,13 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
                                    instance_xtra->ovrl_bc_flx,
                                    instance_xtra->x_velocity,
                                    instance_xtra->y_velocity,
-                                   instance_xtra->z_velocity));
+                                   instance_xtra->z_velocity,
+                                   &nonlin_iters,
+                                   &lin_iters));
+
+      step_attempts++;
+      step_nonlin_iters += nonlin_iters;
+      step_lin_iters += lin_iters;
 
       if (retval != 0)
       {
@@ -2892,6 +3088,25 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
         converged = 1;
       }
 
+      if (time_step_controller)
+      {
+        PFModuleInvokeType(TimeStepControllerInvoke, time_step_controller,
+                           (&next_dt, &step_accepted, (retval == 0),
+                            nonlin_iters, lin_iters, dt,
+                            instance_xtra->pressure,
+                            instance_xtra->old_pressure,
+                            problem_data));
+
+        /* A converged step rejected by the error estimate is retried
+         * with a smaller step and counts against
+         * Solver.MaxConvergenceFailures like a failed solve */
+        if (converged && !step_accepted)
+        {
+          converged = 0;
+          conv_failures++;
+        }
+      }
+
       if (conv_failures >= max_failures)
       {
         take_more_time_steps = 0;
@@ -3850,6 +4065,13 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
       clm_file_dumped = 0;
     }
 
+    /* The step is complete; save what is needed to continue from here */
+    if (checkpoint_due && converged && (public_xtra->lsm == 0 || t == ct))
+    {
+      WriteCheckpoint(checkpoint, file_prefix);
+      checkpoint_due = 0;
+    }
+
     if (take_more_time_steps)
     {
       take_more_time_steps =
@@ -3889,6 +4111,10 @@ AdvanceRichards(PFModule * this_module, double start_time,      /* Starting time
       }
     }
 #endif
+
+    TelemetryEndStep(instance_xtra->iteration_number, t, dt, step_attempts,
+                     step_nonlin_iters, step_lin_iters);
+
     if(first_tstep)
     {
       BeginTiming(RichardsExclude1stTimeStepIndex);
@@ -4129,6 +4355,11 @@ TeardownRichards(PFModule * this_module)
     FreeVector(instance_xtra->z0m_forc);
     FreeVector(instance_xtra->displa_forc);
     FreeVector(instance_xtra->veg_map_forc);
+
+    if (public_xtra->clm_rst_pfb || public_xtra->checkpoint)
+    {
+      FreeVector(instance_xtra->clm_rst);
+    }
   }
 
 
@@ -4404,6 +4635,24 @@ SolverRichardsInitInstanceXtra()
   gridTs = NewGrid(new_subgrids, new_all_subgrids);
   CreateComputePkgs(gridTs);
   (instance_xtra->gridTs) = gridTs;
+
+  /* Grid for the PFB CLM restart state (nx*ny*PF_CLM_RST_NZ) */
+  if (public_xtra->clm_rst_pfb || public_xtra->checkpoint)
+  {
+    all_subgrids = GridAllSubgrids(grid);
+    new_all_subgrids = NewSubgridArray();
+    ForSubgridI(i, all_subgrids)
+    {
+      subgrid = SubgridArraySubgrid(all_subgrids, i);
+      new_subgrid = DuplicateSubgrid(subgrid);
+      SubgridIZ(new_subgrid) = 0;
+      SubgridNZ(new_subgrid) = PF_CLM_RST_NZ(public_xtra->clm_nz);
+      AppendSubgrid(new_subgrid, new_all_subgrids);
+    }
+    new_subgrids = GetGridSubgrids(new_all_subgrids);
+    instance_xtra->gridRst = NewGrid(new_subgrids, new_all_subgrids);
+    CreateComputePkgs(instance_xtra->gridRst);
+  }
 #endif
 
   /*-------------------------------------------------------------------
@@ -4458,6 +4707,25 @@ SolverRichardsInitInstanceXtra()
                               public_xtra->nonlin_solver,
                               (problem, grid, instance_xtra->problem_data,
                                NULL));
+    if (public_xtra->time_step_controller)
+    {
+      (instance_xtra->time_step_controller) =
+        PFModuleNewInstanceType(TimeStepControllerInitInstanceXtraInvoke,
+                                public_xtra->time_step_controller, (grid));
+    }
+    if (public_xtra->checkpoint)
+    {
+      (instance_xtra->checkpoint) =
+        NewCheckpoint(public_xtra->checkpoint_wall_clock_interval,
+                      public_xtra->checkpoint_step_interval);
+    }
+    if (public_xtra->write_telemetry)
+    {
+      char filename[2048];
+
+      sprintf(filename, "%s.telemetry.jsonl", GlobalsOutFileName);
+      NewTelemetry(filename, public_xtra->telemetry_flush_interval);
+    }
   }
   else
   {
@@ -4490,6 +4758,12 @@ SolverRichardsInitInstanceXtra()
     PFModuleReNewInstance((instance_xtra->select_time_step), ());
     PFModuleReNewInstance((instance_xtra->l2_error_norm), ());
     PFModuleReNewInstance((instance_xtra->nonlin_solver), ());
+    if (instance_xtra->time_step_controller)
+    {
+      PFModuleReNewInstanceType(TimeStepControllerInitInstanceXtraInvoke,
+                                (instance_xtra->time_step_controller),
+                                (NULL));
+    }
   }
 
   /*-------------------------------------------------------------------
@@ -4615,6 +4889,15 @@ SolverRichardsFreeInstanceXtra()
     PFModuleFreeInstance((instance_xtra->select_time_step));
     PFModuleFreeInstance((instance_xtra->l2_error_norm));
     PFModuleFreeInstance((instance_xtra->nonlin_solver));
+    if (instance_xtra->time_step_controller)
+    {
+      PFModuleFreeInstance((instance_xtra->time_step_controller));
+    }
+    if (instance_xtra->checkpoint)
+    {
+      FreeCheckpoint((instance_xtra->checkpoint));
+    }
+    FreeTelemetry();
 
     PFModuleFreeInstance((instance_xtra->permeability_face));
 
@@ -4631,6 +4914,7 @@ SolverRichardsFreeInstanceXtra()
     FreeGrid((instance_xtra->gridTs));
 
     FreeGrid((instance_xtra->snglclm));         //NBE
+    FreeGrid((instance_xtra->gridRst));
 #endif
 
     tfree(instance_xtra);
@@ -4657,6 +4941,7 @@ SolverRichardsNewPublicXtra(char *name)
 
 #ifdef HAVE_CLM
   NameArray beta_switch_na;
+  NameArray rstformat_switch_na;
   NameArray vegtype_switch_na;
   NameArray metforce_switch_na;
   NameArray irrtype_switch_na;
@@ -4693,6 +4978,17 @@ SolverRichardsNewPublicXtra(char *name)
   }
   NA_FreeNameArray(nonlin_switch_na);
 
+  /* The Adaptive time step type needs feedback from each solve */
+  if (strcmp(GetString("TimeStep.Type"), "Adaptive") == 0)
+  {
+    (public_xtra->time_step_controller) =
+      PFModuleNewModule(TimeStepController, ());
+  }
+  else
+  {
+    (public_xtra->time_step_controller) = NULL;
+  }
+
   lsm_switch_na = NA_NewNameArray("none CLM");
   sprintf(key, "%s.LSM", name);
   switch_name = GetStringDefault(key, "none");
@@ -4708,6 +5004,12 @@ SolverRichardsNewPublicXtra(char *name)
     case 1:
     {
 #ifdef HAVE_CLM
+      /* CLM indexes the ParFlow subvectors as unpadded arrays */
+      if (GlobalsUseVectorRowPadding)
+      {
+        InputError("Error: <%s> used for key <%s> but CLM does not support UseVectorRowPadding\n",
+                   switch_name, key);
+      }
       public_xtra->lsm = 1;
 #else
       InputError
@@ -4823,6 +5125,15 @@ SolverRichardsNewPublicXtra(char *name)
   switch_value = NA_NameToIndexExitOnError(switch_na, switch_name, key);
   public_xtra->clm_daily_rst = switch_value;
 
+  /* Restart format for CLM: per-rank Fortran files or a single PFB that
+   * can be read back on a different processor topology */
+  rstformat_switch_na = NA_NewNameArray("Fortran PFB");
+  sprintf(key, "%s.CLM.RestartFormat", name);
+  switch_name = GetStringDefault(key, "Fortran");
+  switch_value = NA_NameToIndexExitOnError(rstformat_switch_na, switch_name, key);
+  public_xtra->clm_rst_pfb = switch_value;
+  NA_FreeNameArray(rstformat_switch_na);
+
 
   // -------------------
 
@@ -5690,6 +6001,32 @@ SolverRichardsNewPublicXtra(char *name)
   sprintf(key, "%s.EvapTrans.FileName", name);
   public_xtra->evap_trans_filename = GetStringDefault(key, "");
 
+  /* Checkpoints of the full solver state */
+  sprintf(key, "%s.Checkpoint.WallClockInterval", name);
+  public_xtra->checkpoint_wall_clock_interval = GetDoubleDefault(key, 0.0);
+
+  sprintf(key, "%s.Checkpoint.StepInterval", name);
+  public_xtra->checkpoint_step_interval = GetIntDefault(key, 0);
+
+  sprintf(key, "%s.Checkpoint.Restore", name);
+  switch_name = GetStringDefault(key, "False");
+  switch_value = NA_NameToIndexExitOnError(switch_na, switch_name, key);
+  public_xtra->checkpoint_restore = switch_value;
+
+  public_xtra->checkpoint =
+    (public_xtra->checkpoint_wall_clock_interval > 0.0)
+    || (public_xtra->checkpoint_step_interval > 0)
+    || public_xtra->checkpoint_restore;
+
+  /* Per time step telemetry stream */
+  sprintf(key, "%s.Telemetry", name);
+  switch_name = GetStringDefault(key, "False");
+  switch_value = NA_NameToIndexExitOnError(switch_na, switch_name, key);
+  public_xtra->write_telemetry = switch_value;
+
+  sprintf(key, "%s.Telemetry.FlushInterval", name);
+  public_xtra->telemetry_flush_interval = GetIntDefault(key, 10);
+
 
   /* Initialize silo if necessary */
   if (public_xtra->write_silopmpio_subsurf_data ||
@@ -5734,6 +6071,10 @@ SolverRichardsFreePublicXtra()
     PFModuleFreeModule(public_xtra->advect_concen);
     PFModuleFreeModule(public_xtra->permeability_face);
     PFModuleFreeModule(public_xtra->nonlin_solver);
+    if (public_xtra->time_step_controller)
+    {
+      PFModuleFreeModule(public_xtra->time_step_controller);
+    }
     tfree(public_xtra);
   }
 }
@@ -5811,3 +6152,37 @@ GetICPhasePressureRichards(PFModule * this_module)
 
   return(instance_xtra->ic_phase_pressure);
 }
+
+/*
+ * State vectors of the solver after SetupRichards, for driving the
+ * Richards kernels directly (see pfkernelbench).
+ */
+void
+GetStateRichards(PFModule * this_module,
+                 Vector **  pressure,
+                 Vector **  old_pressure,
+                 Vector **  saturation,
+                 Vector **  old_saturation,
+                 Vector **  density,
+                 Vector **  old_density,
+                 Vector **  evap_trans,
+                 Vector **  ovrl_bc_flx,
+                 Vector **  x_velocity,
+                 Vector **  y_velocity,
+                 Vector **  z_velocity)
+{
+  InstanceXtra *instance_xtra =
+    (InstanceXtra*)PFModuleInstanceXtra(this_module);
+
+  *pressure = instance_xtra->pressure;
+  *old_pressure = instance_xtra->old_pressure;
+  *saturation = instance_xtra->saturation;
+  *old_saturation = instance_xtra->old_saturation;
+  *density = instance_xtra->density;
+  *old_density = instance_xtra->old_density;
+  *evap_trans = instance_xtra->evap_trans;
+  *ovrl_bc_flx = instance_xtra->ovrl_bc_flx;
+  *x_velocity = instance_xtra->x_velocity;
+  *y_velocity = instance_xtra->y_velocity;
+  *z_velocity = instance_xtra->z_velocity;
+}
@@ -690,7 +690,7 @@ PFModule   *SubsrfSimNewPublicXtra()
   (public_xtra->geo_indexes) = ctalloc(int, num_geo_indexes);
   (public_xtra->KFieldSimulators) = ctalloc(PFModule*, num_geo_indexes);
 
-  switch_na = NA_NewNameArray("Constant TurnBands ParGauss PFBFile");
+  switch_na = NA_NewNameArray("Constant TurnBands ParGauss PFBFile FFT");
 
   for (i = 0; i < num_geo_indexes; i++)
   {
@@ -742,6 +742,13 @@ PFModule   *SubsrfSimNewPublicXtra()
         break;
       }
 
+      case 4:
+      {
+        (public_xtra->KFieldSimulators)[i] =
+          PFModuleNewModuleType(KFieldSimulatorNewPublicXtra, FFTRF, (geom_name));
+        break;
+      }
+
       default:
       {
 	InputError("Invalid switch value <%s> for key <%s>", sim_type_name, key);
@@ -0,0 +1,311 @@
+/*BHEADER*********************************************************************
+ *
+ *  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+ *  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+ *  by the Parflow Team (see the CONTRIBUTORS file)
+ *  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+ *
+ *  This file is part of Parflow. For details, see
+ *  http://www.llnl.gov/casc/parflow
+ *
+ *  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+ *  for the GNU Lesser General Public License.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License (as published
+ *  by the Free Software Foundation) version 2.1 dated February 1999.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+ *  and conditions of the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ *  USA
+ **********************************************************************EHEADER*/
+/*****************************************************************************
+*
+* Routines to set up the compact surface of the overland flow boundary
+* conditions; see surface.h.
+*
+*****************************************************************************/
+
+#include "parflow.h"
+
+/*--------------------------------------------------------------------------
+ * AddSurfaceCell: counts the top cell of column (i, j) and, once the
+ * arrays of the list are allocated, stores it.
+ *--------------------------------------------------------------------------*/
+
+static void AddSurfaceCell(
+                           SurfaceCells *cells,
+                           Subvector *   top_sub,
+                           Subvector *   p_sub,
+                           int           i,
+                           int           j)
+{
+  double  *top_dat = SubvectorData(top_sub);
+  int sy_v = SubvectorNX(top_sub);
+  int itop = SubvectorEltIndex(top_sub, i, j, 0);
+
+  int k1, k0x, k0y, k1x, k1y;
+  int n;
+
+  /* The column of a cell of a patch always has a top cell */
+  k1 = (int)top_dat[itop];
+  if (k1 < 0)
+    return;
+
+  n = (cells->num_cells)++;
+  if (cells->index2d == NULL)
+    return;
+
+  k0x = (int)top_dat[itop - 1];
+  k0y = (int)top_dat[itop - sy_v];
+  k1x = (int)top_dat[itop + 1];
+  k1y = (int)top_dat[itop + sy_v];
+
+  (cells->index2d[n]) = itop;
+  (cells->top[n]) = SubvectorEltIndex(p_sub, i, j, k1);
+  (cells->east[n]) = SubvectorEltIndex(p_sub, i + 1, j, k1x);
+  (cells->north[n]) = SubvectorEltIndex(p_sub, i, j + 1, k1y);
+
+  (cells->flags[n]) = 0;
+  if (k0x < 0)
+    (cells->flags[n]) |= SurfaceWestInactive;
+  if (k0y < 0)
+    (cells->flags[n]) |= SurfaceSouthInactive;
+  if (k1x < 0)
+    (cells->flags[n]) |= SurfaceEastInactive;
+  if (k1y < 0)
+    (cells->flags[n]) |= SurfaceNorthInactive;
+}
+
+/*--------------------------------------------------------------------------
+ * WalkSurfaceCells: adds the top cells of a patch in the order of the
+ * patch loops of the overland flow modules.
+ *--------------------------------------------------------------------------*/
+
+static void WalkSurfaceCells(
+                             SurfaceCells *cells,
+                             BCStruct *    bc_struct,
+                             int           ipatch,
+                             int           is,
+                             Subvector *   top_sub,
+                             Subvector *   p_sub,
+                             int           with_ghost)
+{
+  int i, j, k, ival = 0;
+
+  PF_UNUSED(ival);
+
+  (cells->num_cells) = 0;
+
+  if (with_ghost)
+  {
+    ForPatchCellsPerFaceWithGhost(BC_ALL,
+                                  BeforeAllCells(DoNothing),
+                                  LoopVars(i, j, k, ival, bc_struct, ipatch, is),
+                                  Locals(),
+                                  CellSetup(DoNothing),
+                                  FACE(LeftFace, DoNothing), FACE(RightFace, DoNothing),
+                                  FACE(DownFace, DoNothing), FACE(UpFace, DoNothing),
+                                  FACE(BackFace, DoNothing),
+                                  FACE(FrontFace,
+                                  {
+                                    AddSurfaceCell(cells, top_sub, p_sub, i, j);
+                                  }),
+                                  CellFinalize(DoNothing),
+                                  AfterAllCells(DoNothing)
+      );
+  }
+  else
+  {
+    ForPatchCellsPerFace(BC_ALL,
+                         BeforeAllCells(DoNothing),
+                         LoopVars(i, j, k, ival, bc_struct, ipatch, is),
+                         Locals(),
+                         CellSetup(DoNothing),
+                         FACE(LeftFace, DoNothing), FACE(RightFace, DoNothing),
+                         FACE(DownFace, DoNothing), FACE(UpFace, DoNothing),
+                         FACE(BackFace, DoNothing),
+                         FACE(FrontFace,
+                         {
+                           AddSurfaceCell(cells, top_sub, p_sub, i, j);
+                         }),
+                         CellFinalize(DoNothing),
+                         AfterAllCells(DoNothing)
+      );
+  }
+}
+
+/*--------------------------------------------------------------------------
+ * NewSurfaceCells
+ *--------------------------------------------------------------------------*/
+
+static SurfaceCells *NewSurfaceCells(
+                                     BCStruct * bc_struct,
+                                     int        ipatch,
+                                     int        is,
+                                     Subvector *top_sub,
+                                     Subvector *p_sub,
+                                     int        with_ghost)
+{
+  SurfaceCells  *cells;
+  int num_cells;
+
+  cells = ctalloc(SurfaceCells, 1);
+
+  /* Count the cells, then store them */
+  WalkSurfaceCells(cells, bc_struct, ipatch, is, top_sub, p_sub, with_ghost);
+  num_cells = SurfaceCellsNumCells(cells);
+
+  if (num_cells > 0)
+  {
+    (cells->index2d) = ctalloc(int, num_cells);
+    (cells->top) = ctalloc(int, num_cells);
+    (cells->east) = ctalloc(int, num_cells);
+    (cells->north) = ctalloc(int, num_cells);
+    (cells->flags) = ctalloc(int, num_cells);
+
+    WalkSurfaceCells(cells, bc_struct, ipatch, is, top_sub, p_sub, with_ghost);
+  }
+
+  return cells;
+}
+
+/*--------------------------------------------------------------------------
+ * FreeSurfaceCells
+ *--------------------------------------------------------------------------*/
+
+static void FreeSurfaceCells(SurfaceCells *cells)
+{
+  tfree(cells->index2d);
+  tfree(cells->top);
+  tfree(cells->east);
+  tfree(cells->north);
+  tfree(cells->flags);
+  tfree(cells);
+}
+
+/*--------------------------------------------------------------------------
+ * NewSurfacePatch
+ *--------------------------------------------------------------------------*/
+
+static SurfacePatch *NewSurfacePatch(
+                                     BCStruct * bc_struct,
+                                     int        ipatch,
+                                     int        is,
+                                     Subvector *top_sub,
+                                     Subvector *p_sub)
+{
+  SurfacePatch  *patch;
+
+  patch = ctalloc(SurfacePatch, 1);
+
+  (patch->patch_index) = BCStructPatchIndex(bc_struct, ipatch);
+
+  (patch->ix) = SubvectorIX(p_sub);
+  (patch->iy) = SubvectorIY(p_sub);
+  (patch->iz) = SubvectorIZ(p_sub);
+  (patch->nx) = SubvectorNX(p_sub);
+  (patch->ny) = SubvectorNY(p_sub);
+  (patch->nz) = SubvectorNZ(p_sub);
+
+  (patch->cells) = NewSurfaceCells(bc_struct, ipatch, is, top_sub, p_sub, 1);
+  (patch->interior) = NewSurfaceCells(bc_struct, ipatch, is, top_sub, p_sub, 0);
+
+  return patch;
+}
+
+/*--------------------------------------------------------------------------
+ * FreeSurfacePatch
+ *--------------------------------------------------------------------------*/
+
+static void FreeSurfacePatch(SurfacePatch *patch)
+{
+  FreeSurfaceCells(patch->cells);
+  FreeSurfaceCells(patch->interior);
+  tfree(patch);
+}
+
+/*--------------------------------------------------------------------------
+ * NewSurface
+ *--------------------------------------------------------------------------*/
+
+Surface  *NewSurface(
+                     BCStruct *bc_struct)
+{
+  Surface  *surface;
+
+  surface = ctalloc(Surface, 1);
+
+  (surface->num_patches) = BCStructNumPatches(bc_struct);
+  (surface->num_subgrids) = SubgridArraySize(BCStructSubgrids(bc_struct));
+  (surface->patches) = ctalloc(SurfacePatch *,
+                               (surface->num_patches) * (surface->num_subgrids));
+
+  return surface;
+}
+
+/*--------------------------------------------------------------------------
+ * FreeSurface
+ *--------------------------------------------------------------------------*/
+
+void      FreeSurface(
+                      Surface *surface)
+{
+  int n;
+
+  for (n = 0; n < (surface->num_patches) * (surface->num_subgrids); n++)
+  {
+    if (surface->patches[n])
+      FreeSurfacePatch(surface->patches[n]);
+  }
+  tfree(surface->patches);
+  tfree(surface);
+}
+
+/*--------------------------------------------------------------------------
+ * SurfaceGetPatch: the surface of patch ipatch of bc_struct on subgrid is
+ * for 3D subvectors like p_sub, set up on the first call.
+ *--------------------------------------------------------------------------*/
+
+SurfacePatch  *SurfaceGetPatch(
+                               Surface *  surface,
+                               BCStruct * bc_struct,
+                               int        ipatch,
+                               int        is,
+                               Vector *   top,
+                               Subvector *p_sub)
+{
+  SurfacePatch  *patch;
+  int n = ipatch * (surface->num_subgrids) + is;
+
+  patch = surface->patches[n];
+
+  /* Set the patch up again if it no longer matches, which the cheap test
+   * here catches for a changed patch or vector layout */
+  if (patch && ((patch->patch_index) != BCStructPatchIndex(bc_struct, ipatch)
+                || (patch->ix) != SubvectorIX(p_sub)
+                || (patch->iy) != SubvectorIY(p_sub)
+                || (patch->iz) != SubvectorIZ(p_sub)
+                || (patch->nx) != SubvectorNX(p_sub)
+                || (patch->ny) != SubvectorNY(p_sub)
+                || (patch->nz) != SubvectorNZ(p_sub)))
+  {
+    FreeSurfacePatch(patch);
+    patch = NULL;
+  }
+
+  if (patch == NULL)
+  {
+    patch = NewSurfacePatch(bc_struct, ipatch, is,
+                            VectorSubvector(top, is), p_sub);
+    surface->patches[n] = patch;
+  }
+
+  return patch;
+}
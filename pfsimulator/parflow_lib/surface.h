@@ -0,0 +1,132 @@
+/*BHEADER*********************************************************************
+ *
+ *  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+ *  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+ *  by the Parflow Team (see the CONTRIBUTORS file)
+ *  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+ *
+ *  This file is part of Parflow. For details, see
+ *  http://www.llnl.gov/casc/parflow
+ *
+ *  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+ *  for the GNU Lesser General Public License.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License (as published
+ *  by the Free Software Foundation) version 2.1 dated February 1999.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+ *  and conditions of the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ *  USA
+ **********************************************************************EHEADER*/
+/*****************************************************************************
+*
+* Header file for the compact surface of the overland flow boundary
+* conditions.
+*
+* The overland flow modules visit the top cells of a patch once per
+* evaluation through the patch loops, looking up the top of every column
+* and of its neighbours in the top vector.  The surface keeps the result
+* of that walk: for every patch and subgrid a contiguous list of the top
+* cells in the order of the patch loop, with the 2D index of the column,
+* the 3D indices of its top cell and of the top cells of its east and north
+* neighbours, and flags marking inactive neighbour columns.
+*
+* Each patch has two lists.  The cells list also holds the cells of the
+* ghost layer around the subgrid, which the overland fluxes need on the
+* faces between subgrids; it is the halo of the surface and is filled from
+* the top vector, which is exchanged once when it is computed.  The
+* interior list holds the cells of the subgrid only.
+*
+*****************************************************************************/
+
+#ifndef _SURFACE_HEADER
+#define _SURFACE_HEADER
+
+/*--------------------------------------------------------------------------
+ * Flags of a surface cell; an inactive column has no top cell.
+ *--------------------------------------------------------------------------*/
+
+#define SurfaceWestInactive   1
+#define SurfaceSouthInactive  2
+#define SurfaceEastInactive   4
+#define SurfaceNorthInactive  8
+
+/*--------------------------------------------------------------------------
+ * SurfaceCells: the top cells of a patch on a subgrid.
+ *
+ * The neighbour indices of an inactive column refer to k = -1, like the
+ * top vector, so the cell one layer up is east + sz of the subvector.
+ *--------------------------------------------------------------------------*/
+
+typedef struct {
+  int num_cells;
+
+  int    *index2d;       /* index of the column in the 2D subvectors */
+  int    *top;           /* index of the top cell in the 3D subvectors */
+  int    *east;          /* index of the top cell of the column at i + 1 */
+  int    *north;         /* index of the top cell of the column at j + 1 */
+  int    *flags;
+} SurfaceCells;
+
+/*--------------------------------------------------------------------------
+ * SurfacePatch: the surface of a patch on a subgrid.  The 3D indices are
+ * those of subvectors with the given box, i.e. of the pressure.
+ *--------------------------------------------------------------------------*/
+
+typedef struct {
+  int patch_index;
+
+  int ix, iy, iz;
+  int nx, ny, nz;
+
+  SurfaceCells  *cells;    /* subgrid and its ghost layer */
+  SurfaceCells  *interior; /* subgrid only */
+} SurfacePatch;
+
+/*--------------------------------------------------------------------------
+ * Surface: the surface patches of a module instance, set up on first use.
+ *--------------------------------------------------------------------------*/
+
+typedef struct {
+  int num_patches;
+  int num_subgrids;
+
+  SurfacePatch  **patches;  /* indexed by ipatch * num_subgrids + subgrid */
+} Surface;
+
+/*--------------------------------------------------------------------------
+ * Accessor macros
+ *--------------------------------------------------------------------------*/
+
+#define SurfaceCellsNumCells(cells)   ((cells)->num_cells)
+#define SurfaceCellsIndex2D(cells)    ((cells)->index2d)
+#define SurfaceCellsTop(cells)        ((cells)->top)
+#define SurfaceCellsEast(cells)       ((cells)->east)
+#define SurfaceCellsNorth(cells)      ((cells)->north)
+#define SurfaceCellsFlags(cells)      ((cells)->flags)
+
+#define SurfacePatchCells(patch)      ((patch)->cells)
+#define SurfacePatchInterior(patch)   ((patch)->interior)
+
+/*--------------------------------------------------------------------------
+ * Looping macro: n runs over the cells of a list.  The loop is a BoxLoop
+ * over the list, so it runs on the accelerator backend like the patch
+ * loops it replaces; variables of the body are to be declared in it.
+ *--------------------------------------------------------------------------*/
+
+#define SurfaceCellLoop(n, cells, body)                           \
+  {                                                               \
+    int PV_sj, PV_sk;                                             \
+    (void)PV_sj; (void)PV_sk;                                     \
+    BoxLoopI0(n, PV_sj, PV_sk, 0, 0, 0,                           \
+              SurfaceCellsNumCells(cells), 1, 1, body);           \
+  }
+
+#endif
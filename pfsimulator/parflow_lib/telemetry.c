@@ -0,0 +1,218 @@
+/*BHEADER*********************************************************************
+ *
+ *  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+ *  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+ *  by the Parflow Team (see the CONTRIBUTORS file)
+ *  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+ *
+ *  This file is part of Parflow. For details, see
+ *  http://www.llnl.gov/casc/parflow
+ *
+ *  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+ *  for the GNU Lesser General Public License.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License (as published
+ *  by the Free Software Foundation) version 2.1 dated February 1999.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+ *  and conditions of the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ *  USA
+ **********************************************************************EHEADER*/
+/*****************************************************************************
+*
+* Routines for the per time step telemetry stream.
+*
+* Every rank times a few solver phases for each time step; at the end of
+* the step the times are reduced and rank 0 appends one JSON record per
+* line to <run name>.out.telemetry.jsonl.  Records are buffered in memory
+* and written every flush interval steps so the solver does not wait on
+* the file system at every step.
+*
+*****************************************************************************/
+
+#include <string.h>
+#include "parflow.h"
+#include "telemetry.h"
+
+static const char *TelemetryPhaseName[TelemetryNumPhases] =
+{
+  "function_eval",
+  "jacobian",
+  "pc_setup",
+  "pc_apply",
+  "halo_wait",
+  "io",
+  "clm"
+};
+
+/* Upper bound on the length of one record */
+#define TelemetryMaxRecordSize (512 + 4 * 32 * (TelemetryNumPhases + 1))
+
+
+/*--------------------------------------------------------------------------
+ * NewTelemetry
+ *--------------------------------------------------------------------------*/
+
+void  NewTelemetry(
+                   char *filename,
+                   int   flush_interval)
+{
+  telemetry = ctalloc(TelemetryType, 1);
+
+  telemetry->flush_interval = (flush_interval > 0) ? flush_interval : 1;
+
+  if (!amps_Rank(amps_CommWorld))
+  {
+    if ((telemetry->file = fopen(filename, "w")) == NULL)
+    {
+      InputError("Error: can't open output file %s%s\n", filename, "");
+    }
+
+    telemetry->buffer_size = telemetry->flush_interval * TelemetryMaxRecordSize;
+    telemetry->buffer = talloc(char, telemetry->buffer_size);
+  }
+}
+
+
+/*--------------------------------------------------------------------------
+ * FlushTelemetry
+ *--------------------------------------------------------------------------*/
+
+static void  FlushTelemetry()
+{
+  if (telemetry->file && telemetry->buffer_used)
+  {
+    fwrite(telemetry->buffer, 1, (size_t)telemetry->buffer_used,
+           telemetry->file);
+    fflush(telemetry->file);
+    telemetry->buffer_used = 0;
+  }
+}
+
+
+/*--------------------------------------------------------------------------
+ * TelemetryBeginStep
+ *--------------------------------------------------------------------------*/
+
+void  TelemetryBeginStep()
+{
+  int i;
+
+  if (!telemetry)
+    return;
+
+  for (i = 0; i < TelemetryNumPhases; i++)
+    telemetry->phase_time[i] = 0;
+
+  telemetry->residual_norm = 0.0;
+  telemetry->step_time = -amps_Clock();
+}
+
+
+/*--------------------------------------------------------------------------
+ * TelemetryEndStep:
+ *   Reduce the step and phase times over the ranks and record the step.
+ *   Must be called by all ranks.
+ *--------------------------------------------------------------------------*/
+
+void  TelemetryEndStep(
+                       int    step,
+                       double t,
+                       double dt,
+                       int    attempts,
+                       int    nonlin_iters,
+                       int    lin_iters)
+{
+  /* Step time followed by the phase times; the max is taken over the
+   * times and their negatives to get the min in the same reduction */
+  double max_time[2 * (TelemetryNumPhases + 1)];
+  double sum_time[TelemetryNumPhases + 1];
+  int n = TelemetryNumPhases + 1;
+  int num_procs = amps_Size(amps_CommWorld);
+
+  amps_ReduceRequest max_request;
+  amps_ReduceRequest sum_request;
+
+  char *record;
+  int i;
+
+  if (!telemetry)
+    return;
+
+  telemetry->step_time += amps_Clock();
+
+  max_time[0] = (double)telemetry->step_time / AMPS_TICKS_PER_SEC;
+  for (i = 0; i < TelemetryNumPhases; i++)
+    max_time[i + 1] = (double)telemetry->phase_time[i] / AMPS_TICKS_PER_SEC;
+  for (i = 0; i < n; i++)
+  {
+    sum_time[i] = max_time[i];
+    max_time[n + i] = -max_time[i];
+  }
+
+  /* Both reductions are in flight at the same time */
+  amps_IAllReduceDoubles(amps_CommWorld, max_time, 2 * n, amps_Max,
+                         &max_request);
+  amps_IAllReduceDoubles(amps_CommWorld, sum_time, n, amps_Add,
+                         &sum_request);
+  amps_WaitReduce(&max_request);
+  amps_WaitReduce(&sum_request);
+
+  if (telemetry->file)
+  {
+    record = telemetry->buffer + telemetry->buffer_used;
+
+    record += sprintf(record,
+                      "{\"step\":%d,\"t\":%.17g,\"dt\":%.17g,\"attempts\":%d,"
+                      "\"nonlin_iters\":%d,\"lin_iters\":%d,"
+                      "\"residual_norm\":%.6e,\"ranks\":%d,"
+                      "\"wall\":{\"min\":%.6g,\"max\":%.6g,\"avg\":%.6g}",
+                      step, t, dt, attempts, nonlin_iters, lin_iters,
+                      telemetry->residual_norm, num_procs,
+                      -max_time[n], max_time[0], sum_time[0] / num_procs);
+
+    for (i = 0; i < TelemetryNumPhases; i++)
+    {
+      record += sprintf(record,
+                        ",\"%s\":{\"min\":%.6g,\"max\":%.6g,\"avg\":%.6g}",
+                        TelemetryPhaseName[i], -max_time[n + i + 1],
+                        max_time[i + 1], sum_time[i + 1] / num_procs);
+    }
+
+    record += sprintf(record, "}\n");
+
+    telemetry->buffer_used = (int)(record - telemetry->buffer);
+  }
+
+  telemetry->num_steps++;
+  if (telemetry->num_steps % telemetry->flush_interval == 0)
+    FlushTelemetry();
+}
+
+
+/*--------------------------------------------------------------------------
+ * FreeTelemetry
+ *--------------------------------------------------------------------------*/
+
+void  FreeTelemetry()
+{
+  if (!telemetry)
+    return;
+
+  FlushTelemetry();
+
+  if (telemetry->file)
+    fclose(telemetry->file);
+
+  tfree(telemetry->buffer);
+  tfree(telemetry);
+
+  telemetry = NULL;
+}
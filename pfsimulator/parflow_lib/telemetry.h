@@ -0,0 +1,99 @@
+/*BHEADER*********************************************************************
+ *
+ *  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+ *  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+ *  by the Parflow Team (see the CONTRIBUTORS file)
+ *  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+ *
+ *  This file is part of Parflow. For details, see
+ *  http://www.llnl.gov/casc/parflow
+ *
+ *  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+ *  for the GNU Lesser General Public License.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License (as published
+ *  by the Free Software Foundation) version 2.1 dated February 1999.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+ *  and conditions of the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ *  USA
+ **********************************************************************EHEADER*/
+/*****************************************************************************
+*
+* Header file for the per time step telemetry stream.
+*
+*****************************************************************************/
+
+#ifndef _TELEMETRY_HEADER
+#define _TELEMETRY_HEADER
+
+/*--------------------------------------------------------------------------
+ * Phases timed for every time step.  Phases are inclusive and may nest;
+ * e.g. the halo wait of a function evaluation is counted in both.
+ * These values need to be in sync with the names in telemetry.c
+ *--------------------------------------------------------------------------*/
+#define TelemetryFunctionEvalPhase 0
+#define TelemetryJacobianPhase 1
+#define TelemetryPCSetupPhase 2
+#define TelemetryPCApplyPhase 3
+#define TelemetryHaloWaitPhase 4
+#define TelemetryIOPhase 5
+#define TelemetryCLMPhase 6
+#define TelemetryNumPhases 7
+
+/*--------------------------------------------------------------------------
+ * Global telemetry structure
+ *--------------------------------------------------------------------------*/
+
+typedef struct {
+  amps_Clock_t phase_time[TelemetryNumPhases];
+  amps_Clock_t step_time;
+
+  double residual_norm;        /* Of the last nonlinear solve */
+
+  FILE        *file;           /* Only open on rank 0 */
+  char        *buffer;         /* Records not written yet */
+  int buffer_size;
+  int buffer_used;
+  int flush_interval;          /* Write the buffer every this many steps */
+  int num_steps;
+} TelemetryType;
+
+#ifdef PARFLOW_GLOBALS
+amps_ThreadLocalDcl(TelemetryType *, telemetry_ptr);
+#else
+amps_ThreadLocalDcl(extern TelemetryType *, telemetry_ptr);
+#endif
+
+#define telemetry amps_ThreadLocal(telemetry_ptr)
+
+/*--------------------------------------------------------------------------
+ * Telemetry macros; these do nothing unless the stream is enabled
+ *--------------------------------------------------------------------------*/
+
+#define TelemetryBeginPhase(i)                            \
+  {                                                       \
+    if (telemetry)                                        \
+      telemetry->phase_time[(i)] -= amps_Clock();         \
+  }
+
+#define TelemetryEndPhase(i)                              \
+  {                                                       \
+    if (telemetry)                                        \
+      telemetry->phase_time[(i)] += amps_Clock();         \
+  }
+
+#define TelemetrySetResidualNorm(norm)                    \
+  {                                                       \
+    if (telemetry)                                        \
+      telemetry->residual_norm = (norm);                  \
+  }
+
+#endif
@@ -0,0 +1,524 @@
+/*BHEADER*********************************************************************
+ *
+ *  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+ *  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+ *  by the Parflow Team (see the CONTRIBUTORS file)
+ *  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+ *
+ *  This file is part of Parflow. For details, see
+ *  http://www.llnl.gov/casc/parflow
+ *
+ *  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+ *  for the GNU Lesser General Public License.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License (as published
+ *  by the Free Software Foundation) version 2.1 dated February 1999.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+ *  and conditions of the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ *  USA
+ **********************************************************************EHEADER*/
+
+/*****************************************************************************
+ *
+ * Adaptive time step controller for the Richards solver.
+ *
+ * After every attempted step the solver reports whether the nonlinear
+ * solve converged and how many nonlinear and linear iterations it took.
+ * The controller combines
+ *
+ *   - the ratio of the nonlinear iteration count to a target count,
+ *   - the ratio of the linear iterations per Newton step to a target count,
+ *   - an estimate of the local truncation error of the implicit Euler step,
+ *     obtained by comparing the solution with a linear extrapolation of the
+ *     two previous pressures,
+ *
+ * into a single step size factor.  The error based factor is smoothed with
+ * a PI controller (Gustafsson) so the step size does not oscillate.  Steps
+ * whose error estimate exceeds the tolerance are rejected.
+ *
+ * The controller is used when TimeStep.Type is "Adaptive".
+ *
+ *****************************************************************************/
+
+#include "parflow.h"
+
+#include <math.h>
+
+/*--------------------------------------------------------------------------
+ * Structures
+ *--------------------------------------------------------------------------*/
+
+typedef struct {
+  double min_step;
+  double max_step;
+
+  double nonlin_iter_target;    /* desired Newton iterations per step */
+  double lin_iter_target;       /* desired Krylov iterations per Newton step */
+
+  int error_control;            /* use the truncation error estimate? */
+  int reject_steps;             /* reject steps exceeding the error tolerance? */
+  double rel_tol;
+  double abs_tol;
+
+  double safety;
+  double max_growth;
+  double min_reduction;
+  double failure_reduction;
+
+  double pi_integral_gain;
+  double pi_proportional_gain;
+} PublicXtra;
+
+typedef struct {
+  Grid     *grid;
+
+  Vector   *prev_pressure;      /* pressure at the start of the previous step */
+
+  double prev_dt;               /* size of the last accepted step */
+  double prev_error;            /* error estimate of the last accepted step */
+  double proposed_dt;           /* step size proposed after the last step */
+  int last_failed;              /* was the last attempted step rejected? */
+} InstanceXtra;
+
+
+/*--------------------------------------------------------------------------
+ * TimeStepControllerErrorEstimate:
+ *    Weighted root mean square norm of the local truncation error of the
+ *    step from old_pressure to pressure, taken over the active domain.
+ *
+ *    The predictor is the linear extrapolation through prev_pressure and
+ *    old_pressure.  For implicit Euler the truncation error is
+ *    dt / (dt + prev_dt) times the difference between the corrector and
+ *    the predictor.
+ *--------------------------------------------------------------------------*/
+
+static double TimeStepControllerErrorEstimate(
+                                              Vector *     pressure,
+                                              Vector *     old_pressure,
+                                              Vector *     prev_pressure,
+                                              double       dt,
+                                              double       prev_dt,
+                                              double       rel_tol,
+                                              double       abs_tol,
+                                              ProblemData *problem_data)
+{
+  Grid             *grid = VectorGrid(pressure);
+  GrGeomSolid      *gr_domain = ProblemDataGrDomain(problem_data);
+
+  Subgrid          *subgrid;
+  Subvector        *p_sub, *op_sub, *pp_sub;
+  double           *pp, *opp, *ppp;
+
+  amps_Invoice result_invoice;
+
+  double ratio = dt / prev_dt;
+  double sum_err = 0.0;
+  double num_cells = 0.0;
+  double pred, err;
+
+  int ix, iy, iz;
+  int nx, ny, nz;
+  int r;
+  int is, i, j, k, ip;
+
+  ForSubgridI(is, GridSubgrids(grid))
+  {
+    subgrid = GridSubgrid(grid, is);
+
+    p_sub = VectorSubvector(pressure, is);
+    op_sub = VectorSubvector(old_pressure, is);
+    pp_sub = VectorSubvector(prev_pressure, is);
+
+    r = SubgridRX(subgrid);
+
+    ix = SubgridIX(subgrid);
+    iy = SubgridIY(subgrid);
+    iz = SubgridIZ(subgrid);
+
+    nx = SubgridNX(subgrid);
+    ny = SubgridNY(subgrid);
+    nz = SubgridNZ(subgrid);
+
+    pp = SubvectorData(p_sub);
+    opp = SubvectorData(op_sub);
+    ppp = SubvectorData(pp_sub);
+
+    GrGeomInLoop(i, j, k, gr_domain, r, ix, iy, iz, nx, ny, nz,
+    {
+      ip = SubvectorEltIndex(p_sub, i, j, k);
+
+      pred = opp[ip] + ratio * (opp[ip] - ppp[ip]);
+      err = (pp[ip] - pred) / (abs_tol + rel_tol * fabs(pp[ip]));
+      sum_err += err * err;
+      num_cells += 1.0;
+    });
+  }
+
+  result_invoice = amps_NewInvoice("%d%d", &sum_err, &num_cells);
+  amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
+  amps_FreeInvoice(result_invoice);
+
+  if (num_cells == 0.0)
+    return 0.0;
+
+  return (dt / (dt + prev_dt)) * sqrt(sum_err / num_cells);
+}
+
+
+/*--------------------------------------------------------------------------
+ * TimeStepController:
+ *    Computes the size of the next step from the outcome of the step of
+ *    size `dt' that was just attempted.  On return `accept' indicates if
+ *    the step may be kept; if not the caller must restore the old state
+ *    and retry with `dt_next'.
+ *--------------------------------------------------------------------------*/
+
+void     TimeStepController(
+                            double *     dt_next, /* Size of the next step */
+                            int *        accept, /* Can the step be kept? */
+                            int          converged, /* Did the solver converge? */
+                            int          nonlin_iters, /* Newton iterations used */
+                            int          lin_iters, /* Krylov iterations used */
+                            double       dt, /* Size of the step just taken */
+                            Vector *     pressure,
+                            Vector *     old_pressure,
+                            ProblemData *problem_data)
+{
+  PFModule      *this_module = ThisPFModule;
+  PublicXtra    *public_xtra = (PublicXtra*)PFModulePublicXtra(this_module);
+  InstanceXtra  *instance_xtra = (InstanceXtra*)PFModuleInstanceXtra(this_module);
+
+  double min_step = (public_xtra->min_step);
+  double max_step = (public_xtra->max_step);
+  double safety = (public_xtra->safety);
+  double max_growth = (public_xtra->max_growth);
+  double min_reduction = (public_xtra->min_reduction);
+
+  double base_dt, factor, err_factor, err;
+
+  /*-----------------------------------------------------------------------
+   * Failed nonlinear solve: cut the step and remember the failure so the
+   * step after the retry does not grow right away.
+   *-----------------------------------------------------------------------*/
+
+  if (!converged)
+  {
+    (*accept) = 0;
+    (*dt_next) = dt * (public_xtra->failure_reduction);
+
+    (instance_xtra->last_failed) = 1;
+    (instance_xtra->proposed_dt) = (*dt_next);
+    return;
+  }
+
+  /*-----------------------------------------------------------------------
+   * If the step was shortened to hit an output, boundary condition or
+   * stop time, grow from the step size that was proposed rather than
+   * from the shortened one.
+   *-----------------------------------------------------------------------*/
+
+  base_dt = dt;
+  if ((instance_xtra->proposed_dt) > dt)
+    base_dt = (instance_xtra->proposed_dt);
+
+  factor = max_growth;
+
+  /*-----------------------------------------------------------------------
+   * Iteration count criteria
+   *-----------------------------------------------------------------------*/
+
+  if (nonlin_iters > 0)
+  {
+    if ((public_xtra->nonlin_iter_target) > 0.0)
+    {
+      factor = pfmin(factor,
+                     (public_xtra->nonlin_iter_target) / (double)nonlin_iters);
+    }
+
+    if ((public_xtra->lin_iter_target) > 0.0)
+    {
+      double lin_per_nonlin = (double)lin_iters / (double)nonlin_iters;
+
+      if (lin_per_nonlin > 0.0)
+      {
+        factor = pfmin(factor,
+                       (public_xtra->lin_iter_target) / lin_per_nonlin);
+      }
+    }
+  }
+
+  /*-----------------------------------------------------------------------
+   * Truncation error criterion with PI smoothing
+   *-----------------------------------------------------------------------*/
+
+  if ((public_xtra->error_control) && (instance_xtra->prev_dt) > 0.0)
+  {
+    err = TimeStepControllerErrorEstimate(pressure, old_pressure,
+                                          (instance_xtra->prev_pressure),
+                                          dt, (instance_xtra->prev_dt),
+                                          (public_xtra->rel_tol),
+                                          (public_xtra->abs_tol),
+                                          problem_data);
+    err = pfmax(err, 1.0e-10);
+
+    if ((public_xtra->reject_steps) && (err > 1.0) && (dt > min_step))
+    {
+      (*accept) = 0;
+      (*dt_next) = dt * pfmax(min_reduction, safety / sqrt(err));
+      (*dt_next) = pfmax((*dt_next), min_step);
+
+      (instance_xtra->last_failed) = 1;
+      (instance_xtra->proposed_dt) = (*dt_next);
+      return;
+    }
+
+    /* Implicit Euler is first order, so the exponents are divided by 2 */
+    err_factor = safety * pow(err, -0.5 * (public_xtra->pi_integral_gain));
+    if ((instance_xtra->prev_error) > 0.0)
+    {
+      err_factor *= pow((instance_xtra->prev_error) / err,
+                        0.5 * (public_xtra->pi_proportional_gain));
+    }
+
+    factor = pfmin(factor, err_factor);
+    (instance_xtra->prev_error) = err;
+  }
+
+  if (instance_xtra->last_failed)
+  {
+    factor = pfmin(factor, 1.0);
+  }
+
+  factor = pfmax(factor, min_reduction);
+  factor = pfmin(factor, max_growth);
+
+  (*dt_next) = base_dt * factor;
+  (*dt_next) = pfmax((*dt_next), min_step);
+  (*dt_next) = pfmin((*dt_next), max_step);
+
+  /*-----------------------------------------------------------------------
+   * The step is accepted; shift the history used by the error estimate.
+   *-----------------------------------------------------------------------*/
+
+  if (public_xtra->error_control)
+  {
+    PFVCopy(old_pressure, (instance_xtra->prev_pressure));
+  }
+  (instance_xtra->prev_dt) = dt;
+
+  (*accept) = 1;
+  (instance_xtra->last_failed) = 0;
+  (instance_xtra->proposed_dt) = (*dt_next);
+}
+
+
+/*--------------------------------------------------------------------------
+ * TimeStepControllerInitInstanceXtra
+ *--------------------------------------------------------------------------*/
+
+PFModule  *TimeStepControllerInitInstanceXtra(
+                                              Grid *grid)
+{
+  PFModule      *this_module = ThisPFModule;
+  PublicXtra    *public_xtra = (PublicXtra*)PFModulePublicXtra(this_module);
+  InstanceXtra  *instance_xtra;
+
+  if (PFModuleInstanceXtra(this_module) == NULL)
+    instance_xtra = ctalloc(InstanceXtra, 1);
+  else
+    instance_xtra = (InstanceXtra*)PFModuleInstanceXtra(this_module);
+
+  /*-----------------------------------------------------------------------
+   * Initialize data associated with argument `grid'
+   *-----------------------------------------------------------------------*/
+
+  if (grid != NULL)
+  {
+    /* free old data */
+    if ((instance_xtra->prev_pressure) != NULL)
+    {
+      FreeVector(instance_xtra->prev_pressure);
+    }
+
+    /* set new data */
+    (instance_xtra->grid) = grid;
+
+    (instance_xtra->prev_pressure) = NULL;
+    if (public_xtra->error_control)
+    {
+      (instance_xtra->prev_pressure) =
+        NewVectorType(grid, 1, 1, vector_cell_centered);
+      InitVectorAll((instance_xtra->prev_pressure), 0.0);
+    }
+
+    (instance_xtra->prev_dt) = 0.0;
+    (instance_xtra->prev_error) = 0.0;
+    (instance_xtra->proposed_dt) = 0.0;
+    (instance_xtra->last_failed) = 0;
+  }
+
+  PFModuleInstanceXtra(this_module) = instance_xtra;
+  return this_module;
+}
+
+
+/*--------------------------------------------------------------------------
+ * TimeStepControllerFreeInstanceXtra
+ *--------------------------------------------------------------------------*/
+
+void  TimeStepControllerFreeInstanceXtra()
+{
+  PFModule      *this_module = ThisPFModule;
+  InstanceXtra  *instance_xtra = (InstanceXtra*)PFModuleInstanceXtra(this_module);
+
+  if (instance_xtra)
+  {
+    if ((instance_xtra->prev_pressure) != NULL)
+    {
+      FreeVector(instance_xtra->prev_pressure);
+    }
+    tfree(instance_xtra);
+  }
+}
+
+
+/*--------------------------------------------------------------------------
+ * TimeStepControllerNewPublicXtra
+ *--------------------------------------------------------------------------*/
+
+PFModule  *TimeStepControllerNewPublicXtra()
+{
+  PFModule      *this_module = ThisPFModule;
+  PublicXtra    *public_xtra;
+
+  char          *switch_name;
+  NameArray switch_na;
+
+  switch_na = NA_NewNameArray("False True");
+
+  public_xtra = ctalloc(PublicXtra, 1);
+
+  (public_xtra->min_step) = GetDouble("TimeStep.MinStep");
+  (public_xtra->max_step) = GetDouble("TimeStep.MaxStep");
+
+  (public_xtra->nonlin_iter_target) =
+    GetDoubleDefault("TimeStep.Adaptive.NonlinearIterTarget", 6.0);
+  (public_xtra->lin_iter_target) =
+    GetDoubleDefault("TimeStep.Adaptive.LinearIterTarget", 25.0);
+
+  switch_name = GetStringDefault("TimeStep.Adaptive.ErrorControl", "True");
+  (public_xtra->error_control) =
+    NA_NameToIndexExitOnError(switch_na, switch_name,
+                              "TimeStep.Adaptive.ErrorControl");
+
+  switch_name = GetStringDefault("TimeStep.Adaptive.RejectSteps", "True");
+  (public_xtra->reject_steps) =
+    NA_NameToIndexExitOnError(switch_na, switch_name,
+                              "TimeStep.Adaptive.RejectSteps");
+
+  (public_xtra->rel_tol) =
+    GetDoubleDefault("TimeStep.Adaptive.RelTol", 1.0e-2);
+  (public_xtra->abs_tol) =
+    GetDoubleDefault("TimeStep.Adaptive.AbsTol", 1.0e-2);
+
+  (public_xtra->safety) =
+    GetDoubleDefault("TimeStep.Adaptive.SafetyFactor", 0.9);
+  (public_xtra->max_growth) =
+    GetDoubleDefault("TimeStep.Adaptive.MaxGrowthFactor", 2.0);
+  (public_xtra->min_reduction) =
+    GetDoubleDefault("TimeStep.Adaptive.MinReductionFactor", 0.2);
+  (public_xtra->failure_reduction) =
+    GetDoubleDefault("TimeStep.Adaptive.FailureReductionFactor", 0.5);
+
+  (public_xtra->pi_integral_gain) =
+    GetDoubleDefault("TimeStep.Adaptive.IntegralGain", 0.3);
+  (public_xtra->pi_proportional_gain) =
+    GetDoubleDefault("TimeStep.Adaptive.ProportionalGain", 0.4);
+
+  if ((public_xtra->min_step) <= 0.0)
+  {
+    InputError("Error: the key <%s> must be positive%s\n",
+               "TimeStep.MinStep", "");
+  }
+
+  if ((public_xtra->max_step) < (public_xtra->min_step))
+  {
+    InputError("Error: the key <%s> must not be smaller than <%s>\n",
+               "TimeStep.MaxStep", "TimeStep.MinStep");
+  }
+
+  if ((public_xtra->max_growth) < 1.0)
+  {
+    InputError("Error: the key <%s> must be at least 1.0%s\n",
+               "TimeStep.Adaptive.MaxGrowthFactor", "");
+  }
+
+  if ((public_xtra->min_reduction) <= 0.0 || (public_xtra->min_reduction) > 1.0
+      || (public_xtra->failure_reduction) <= 0.0
+      || (public_xtra->failure_reduction) >= 1.0)
+  {
+    InputError("Error: the keys <%s> and <%s> must be in (0, 1)\n",
+               "TimeStep.Adaptive.MinReductionFactor",
+               "TimeStep.Adaptive.FailureReductionFactor");
+  }
+
+  NA_FreeNameArray(switch_na);
+
+  PFModulePublicXtra(this_module) = public_xtra;
+  return this_module;
+}
+
+
+/*-------------------------------------------------------------------------
+ * TimeStepControllerFreePublicXtra
+ *-------------------------------------------------------------------------*/
+
+void  TimeStepControllerFreePublicXtra()
+{
+  PFModule    *this_module = ThisPFModule;
+  PublicXtra  *public_xtra = (PublicXtra*)PFModulePublicXtra(this_module);
+
+  if (public_xtra)
+  {
+    tfree(public_xtra);
+  }
+}
+
+
+/*--------------------------------------------------------------------------
+ * TimeStepControllerSizeOfTempData
+ *--------------------------------------------------------------------------*/
+
+int  TimeStepControllerSizeOfTempData()
+{
+  return 0;
+}
+
+
+/*--------------------------------------------------------------------------
+ * TimeStepControllerCheckpoint:
+ *    Registers the step history with a checkpoint so that a restored run
+ *    proposes the same step sizes as an uninterrupted one.
+ *--------------------------------------------------------------------------*/
+
+void  TimeStepControllerCheckpoint(
+                                   PFModule *  this_module,
+                                   Checkpoint *checkpoint)
+{
+  InstanceXtra  *instance_xtra = (InstanceXtra*)PFModuleInstanceXtra(this_module);
+
+  CheckpointAddInt(checkpoint, &(instance_xtra->last_failed));
+  CheckpointAddDouble(checkpoint, &(instance_xtra->prev_dt));
+  CheckpointAddDouble(checkpoint, &(instance_xtra->prev_error));
+  CheckpointAddDouble(checkpoint, &(instance_xtra->proposed_dt));
+  CheckpointAddVector(checkpoint, "step_control_press",
+                      (instance_xtra->prev_pressure));
+}
@@ -166,7 +166,7 @@ extern EventTiming[][6];
 #define IncFLOPCount(inc)
 #define StartTiming()
 #define StopTiming()
-#define BeginTiming(i) if (i == 0)
+#define BeginTiming(i) (void)(i)
 #define EndTiming(i)
 #define NewTiming()
 #define RegisterTiming(name) 0
@@ -76,6 +76,93 @@ CommPkg  *NewVectorCommPkg(
   return new_commpkg;
 }
 
+/*--------------------------------------------------------------------------
+ * NewVectorGroupCommPkg:
+ *   CommPkg updating the `num_vectors' vectors `vectors' together.  The
+ *   vectors must share their grid and number of ghost layers.
+ *--------------------------------------------------------------------------*/
+
+CommPkg  *NewVectorGroupCommPkg(
+                                Vector **   vectors,
+                                int         num_vectors,
+                                ComputePkg *compute_pkg)
+{
+  CommPkg     *new_commpkg = NULL;
+
+  double     **data;
+  int i;
+
+  Grid *grid = VectorGrid(vectors[0]);
+
+  if (GridNumSubgrids(grid) > 1)
+  {
+    PARFLOW_ERROR("NewVectorGroupCommPkg can't be used with number subgrids > 1");
+  }
+  else
+  {
+    data = talloc(double *, num_vectors);
+    for (i = 0; i < num_vectors; i++)
+    {
+      data[i] = SubvectorData(VectorSubvector(vectors[i], 0));
+    }
+
+    new_commpkg = NewMultiCommPkg(ComputePkgSendRegion(compute_pkg),
+                                  ComputePkgRecvRegion(compute_pkg),
+                                  VectorDataSpace(vectors[0]), 1,
+                                  num_vectors, data);
+
+    tfree(data);
+  }
+
+  return new_commpkg;
+}
+
+/*--------------------------------------------------------------------------
+ * InitVectorGroupUpdate:
+ *   Starts the update of `vectors' with the CommPkg `comm_pkg' built by
+ *   NewVectorGroupCommPkg, i.e. one message per neighbor for all of the
+ *   vectors.  The update is completed with FinalizeVectorUpdate.
+ *--------------------------------------------------------------------------*/
+
+VectorUpdateCommHandle  *InitVectorGroupUpdate(
+                                               Vector ** vectors,
+                                               int       num_vectors,
+                                               int       update_mode,
+                                               CommPkg * comm_pkg)
+{
+  VectorUpdateCommHandle *handle;
+  CommHandle             *amps_com_handle = NULL;
+  int i;
+
+  if (vectors[0]->type == vector_non_samrai)
+  {
+#ifdef SHMEM_OBJECTS
+    amps_com_handle = NULL;
+#else
+#ifdef NO_VECTOR_UPDATE
+    amps_com_handle = NULL;
+#else
+    amps_com_handle = InitCommunication(comm_pkg);
+#endif
+#endif
+  }
+  else
+  {
+    /* SAMRAI vectors are filled one at a time */
+    for (i = 0; i < num_vectors; i++)
+    {
+      FinalizeVectorUpdate(InitVectorUpdate(vectors[i], update_mode));
+    }
+  }
+
+  handle = talloc(VectorUpdateCommHandle, 1);
+  memset(handle, 0, sizeof(VectorUpdateCommHandle));
+  handle->vector = vectors[0];
+  handle->comm_handle = amps_com_handle;
+
+  return handle;
+}
+
 /*--------------------------------------------------------------------------
  * InitVectorUpdate
  *--------------------------------------------------------------------------*/
@@ -236,6 +323,7 @@ static Vector  *NewTempVector(
 
   int data_size;
   int i, n;
+  int nx_data;
 
   (void)nc;
 
@@ -257,11 +345,20 @@ static Vector  *NewTempVector(
 
     subgrid = GridSubgrid(grid, i);
 
+    /* Padded x rows end past the ghost layer, so every row of the data
+     * starts on a cache line */
+    nx_data = SubgridNX(subgrid) + 2 * num_ghost;
+    if (GlobalsUseVectorRowPadding)
+    {
+      nx_data = ((nx_data + SubvectorRowPadding - 1) / SubvectorRowPadding)
+                * SubvectorRowPadding;
+    }
+
     SubvectorDataSpace(new_sub) =
       NewSubgrid(SubgridIX(subgrid) - num_ghost,
                  SubgridIY(subgrid) - num_ghost,
                  SubgridIZ(subgrid) - num_ghost,
-                 SubgridNX(subgrid) + 2 * num_ghost,
+                 nx_data,
                  SubgridNY(subgrid) + 2 * num_ghost,
                  SubgridNZ(subgrid) + 2 * num_ghost,
                  SubgridRX(subgrid),
@@ -294,6 +391,54 @@ static Vector  *NewTempVector(
 }
 
 
+/*--------------------------------------------------------------------------
+ * AllocateSubvectorData: allocates the zeroed data of a subvector.
+ *
+ * On the CPU the data is aligned to a cache line and zeroed by a BoxLoop
+ * over the data space.  With the OpenMP backend that loop has the schedule
+ * of the vector kernels, so each page is first touched, and placed on the
+ * NUMA node of, the thread that works on it.
+ *--------------------------------------------------------------------------*/
+
+static double  *AllocateSubvectorData(
+                                      Subvector *subvector)
+{
+  double     *data;
+
+#if defined(PARFLOW_HAVE_CUDA) || defined(PARFLOW_HAVE_KOKKOS)
+  data = ctalloc_amps(double, SubvectorDataSize(subvector));
+#else
+  int ix = SubvectorIX(subvector);
+  int iy = SubvectorIY(subvector);
+  int iz = SubvectorIZ(subvector);
+
+  int nx = SubvectorNX(subvector);
+  int ny = SubvectorNY(subvector);
+  int nz = SubvectorNZ(subvector);
+
+  int i, j, k, iv;
+
+  if (SubvectorDataSize(subvector) <= 0)
+    return NULL;
+
+  /* Freed by tfree_amps, which is free() for the CPU layers of amps */
+  if (posix_memalign((void**)&data, SubvectorDataAlignment,
+                     SubvectorDataSize(subvector) * sizeof(double)) != 0)
+  {
+    PARFLOW_ERROR("out of memory");
+  }
+
+  iv = 0;
+  BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
+            iv, nx, ny, nz, 1, 1, 1,
+  {
+    data[iv] = 0.0;
+  });
+#endif
+
+  return data;
+}
+
 /*--------------------------------------------------------------------------
  * SetTempVectorData
  *--------------------------------------------------------------------------*/
@@ -318,7 +463,7 @@ static void     AllocateVectorData(
 
     SubvectorDataSize(subvector) = data_size;
 
-    double  *data = ctalloc_amps(double, data_size);
+    double  *data = AllocateSubvectorData(subvector);
     VectorSubvector(vector, i)->allocated = TRUE;
 
     SubvectorData(VectorSubvector(vector, i)) = data;
@@ -53,6 +53,14 @@ enum vector_type {
   vector_non_samrai
 };
 
+/*--------------------------------------------------------------------------
+ * Subvector data layout: the data of a subvector starts on a cache line and,
+ * with UseVectorRowPadding, its x rows are padded to whole cache lines.
+ *--------------------------------------------------------------------------*/
+
+#define SubvectorDataAlignment  64    /* bytes */
+#define SubvectorRowPadding     (SubvectorDataAlignment / (int)sizeof(double))
+
 /*--------------------------------------------------------------------------
  * Subvector
  *--------------------------------------------------------------------------*/
@@ -691,8 +691,6 @@ double PFVDotProd(
 
   int sg, i, j, k, i_x, i_y;
 
-  amps_Invoice result_invoice;
-
   ForSubgridI(sg, GridSubgrids(grid))
   {
     subgrid = GridSubgrid(grid, sg);
@@ -731,9 +729,7 @@ double PFVDotProd(
     });
   }
 
-  result_invoice = amps_NewInvoice("%d", &sum);
-  amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
-  amps_FreeInvoice(result_invoice);
+  amps_AllReduceDoubles(amps_CommWorld, &sum, 1, amps_Add);
 
   IncFLOPCount(2 * VectorSize(x));
 
@@ -758,8 +754,6 @@ double PFVMaxNorm(
 
   int sg, i, j, k, i_x;
 
-  amps_Invoice result_invoice;
-
   ForSubgridI(sg, GridSubgrids(grid))
   {
     subgrid = GridSubgrid(grid, sg);
@@ -790,9 +784,7 @@ double PFVMaxNorm(
     });
   }
 
-  result_invoice = amps_NewInvoice("%d", &max_val);
-  amps_AllReduce(amps_CommWorld, result_invoice, amps_Max);
-  amps_FreeInvoice(result_invoice);
+  amps_AllReduceDoubles(amps_CommWorld, &max_val, 1, amps_Max);
 
   return(max_val);
 }
@@ -819,8 +811,6 @@ double PFVWrmsNorm(
 
   int sg, i, j, k, i_x, i_w;
 
-  amps_Invoice result_invoice;
-
   ForSubgridI(sg, GridSubgrids(grid))
   {
     subgrid = GridSubgrid(grid, sg);
@@ -860,9 +850,7 @@ double PFVWrmsNorm(
     });
   }
 
-  result_invoice = amps_NewInvoice("%d", &sum);
-  amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
-  amps_FreeInvoice(result_invoice);
+  amps_AllReduceDoubles(amps_CommWorld, &sum, 1, amps_Add);
 
   IncFLOPCount(3 * VectorSize(x));
 
@@ -891,8 +879,6 @@ double PFVWL2Norm(
 
   int sg, i, j, k, i_x, i_w;
 
-  amps_Invoice result_invoice;
-
   ForSubgridI(sg, GridSubgrids(grid))
   {
     subgrid = GridSubgrid(grid, sg);
@@ -932,9 +918,7 @@ double PFVWL2Norm(
     });
   }
 
-  result_invoice = amps_NewInvoice("%d", &sum);
-  amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
-  amps_FreeInvoice(result_invoice);
+  amps_AllReduceDoubles(amps_CommWorld, &sum, 1, amps_Add);
 
   IncFLOPCount(3 * VectorSize(x));
 
@@ -959,8 +943,6 @@ double PFVL1Norm(
 
   int sg, i, j, k, i_x;
 
-  amps_Invoice result_invoice;
-
   ForSubgridI(sg, GridSubgrids(grid))
   {
     subgrid = GridSubgrid(grid, sg);
@@ -990,9 +972,7 @@ double PFVL1Norm(
     });
   }
 
-  result_invoice = amps_NewInvoice("%d", &sum);
-  amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
-  amps_FreeInvoice(result_invoice);
+  amps_AllReduceDoubles(amps_CommWorld, &sum, 1, amps_Add);
 
   return(sum);
 }
@@ -1015,10 +995,6 @@ double PFVMin(
 
   int sg, i, j, k, i_x;
 
-  amps_Invoice result_invoice;
-
-  result_invoice = amps_NewInvoice("%d", &min_val);
-
   grid = VectorGrid(x);
 
   ForSubgridI(sg, GridSubgrids(grid))
@@ -1062,8 +1038,7 @@ double PFVMin(
     });
   }
 
-  amps_AllReduce(amps_CommWorld, result_invoice, amps_Min);
-  amps_FreeInvoice(result_invoice);
+  amps_AllReduceDoubles(amps_CommWorld, &min_val, 1, amps_Min);
 
   return(min_val);
 }
@@ -1086,8 +1061,6 @@ double PFVMax(
 
   int sg, i, j, k, i_x;
 
-  amps_Invoice result_invoice;
-
   ForSubgridI(sg, GridSubgrids(grid))
   {
     subgrid = GridSubgrid(grid, sg);
@@ -1130,9 +1103,7 @@ double PFVMax(
     });
   }
 
-  result_invoice = amps_NewInvoice("%d", &max_val);
-  amps_AllReduce(amps_CommWorld, result_invoice, amps_Max);
-  amps_FreeInvoice(result_invoice);
+  amps_AllReduceDoubles(amps_CommWorld, &max_val, 1, amps_Max);
 
   return(max_val);
 }
@@ -51,6 +51,48 @@ typedef struct {
 } InstanceXtra;
 
 
+/*--------------------------------------------------------------------------
+ * Loops over a subregion for coefficients of type T, see
+ * MatrixPrecisionSwitch.
+ *--------------------------------------------------------------------------*/
+
+/* x = b / a0 */
+#define WJacobiDiagonalSolve(T, Elt)                       \
+  {                                                        \
+    T *ap = Elt(A_sub, 0, ix, iy, iz);                     \
+    BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,             \
+              iv, nx_v, ny_v, nz_v, sx, sy, sz,            \
+              im, nx_m, ny_m, nz_m, sx, sy, sz,            \
+    {                                                      \
+      xp[iv] = bp[iv] / ap[im];                            \
+    });                                                    \
+  }
+
+/* t -= a_si x_si */
+#define WJacobiOffDiagonal(T, Elt)                         \
+  {                                                        \
+    T *ap = Elt(A_sub, si, ix, iy, iz);                    \
+    BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,             \
+              iv, nx_v, ny_v, nz_v, sx, sy, sz,            \
+              im, nx_m, ny_m, nz_m, sx, sy, sz,            \
+    {                                                      \
+      tp[iv] -= ap[im] * xp[iv];                           \
+    });                                                    \
+  }
+
+/* t /= a0 */
+#define WJacobiDiagonalScale(T, Elt)                       \
+  {                                                        \
+    T *ap = Elt(A_sub, 0, ix, iy, iz);                     \
+    BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,             \
+              iv, nx_v, ny_v, nz_v, sx, sy, sz,            \
+              im, nx_m, ny_m, nz_m, sx, sy, sz,            \
+    {                                                      \
+      tp[iv] /= ap[im];                                    \
+    });                                                    \
+  }
+
+
 /*--------------------------------------------------------------------------
  * WJacobi:
  *   Solves A x = b.
@@ -88,7 +130,6 @@ void     WJacobi(
   int stencil_size;
   StencilElt     *s;
 
-  double         *ap;
   double         *xp;
   double         *bp, *tp;
 
@@ -168,17 +209,11 @@ void     WJacobi(
       sy = SubregionSY(subregion);
       sz = SubregionSZ(subregion);
 
-      ap = SubmatrixElt(A_sub, 0, ix, iy, iz);
       xp = SubvectorElt(x_sub, ix, iy, iz);
       bp = SubvectorElt(b_sub, ix, iy, iz);
 
       iv = im = 0;
-      BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
-                iv, nx_v, ny_v, nz_v, sx, sy, sz,
-                im, nx_m, ny_m, nz_m, sx, sy, sz,
-      {
-        xp[iv] = bp[iv] / ap[im];
-      });
+      MatrixPrecisionSwitch(A, WJacobiDiagonalSolve);
     }
 
     if (weight != 1.0)
@@ -259,25 +294,13 @@ void     WJacobi(
                               (ix + s[si][0]),
                               (iy + s[si][1]),
                               (iz + s[si][2]));
-            ap = SubmatrixElt(A_sub, si, ix, iy, iz);
 
             iv = im = 0;
-            BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
-                      iv, nx_v, ny_v, nz_v, sx, sy, sz,
-                      im, nx_m, ny_m, nz_m, sx, sy, sz,
-            {
-              tp[iv] -= ap[im] * xp[iv];
-            });
+            MatrixPrecisionSwitch(A, WJacobiOffDiagonal);
           }
 
-          ap = SubmatrixElt(A_sub, 0, ix, iy, iz);
           iv = im = 0;
-          BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
-                    iv, nx_v, ny_v, nz_v, sx, sy, sz,
-                    im, nx_m, ny_m, nz_m, sx, sy, sz,
-          {
-            tp[iv] /= ap[im];
-          });
+          MatrixPrecisionSwitch(A, WJacobiDiagonalScale);
         }
       }
     }
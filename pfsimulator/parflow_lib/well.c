@@ -74,6 +74,8 @@ WellData *NewWellData()
   WellDataFluxWellValues(well_data) = NULL;
   WellDataFluxWellStats(well_data) = NULL;
 
+  WellDataSubgridMap(well_data) = NULL;
+
   return well_data;
 }
 
@@ -285,11 +287,171 @@ void FreeWellData(
       }
       FreeTimeCycleData(time_cycle_data);
     }
+    FreeWellSubgridMap(WellDataSubgridMap(well_data));
     tfree(well_data);
   }
 }
 
 
+/*--------------------------------------------------------------------------
+ * MapWellsToSubgrids:
+ *   Compressed lists of the wells intersecting each subgrid and the
+ *   intersections.  The overlap of the index boxes is tested before
+ *   calling IntersectSubgrids, so the wells away from a subgrid cost a
+ *   few compares and no allocation.
+ *--------------------------------------------------------------------------*/
+
+static void MapWellsToSubgrids(
+                               SubgridArray *     subgrids,
+                               int                num_wells,
+                               WellDataPhysical **well_physicals,
+                               int **             starts_ptr,
+                               int **             wells_ptr,
+                               Subgrid ***        well_subgrids_ptr)
+{
+  Subgrid   *subgrid, *well_subgrid, *tmp_subgrid;
+
+  int       *starts, *wells;
+  Subgrid  **well_subgrids;
+
+  int is, well, num_entries, max_entries;
+
+  starts = ctalloc(int, SubgridArraySize(subgrids) + 1);
+
+  max_entries = 16;
+  wells = talloc(int, max_entries);
+  well_subgrids = talloc(Subgrid *, max_entries);
+
+  num_entries = 0;
+  ForSubgridI(is, subgrids)
+  {
+    subgrid = SubgridArraySubgrid(subgrids, is);
+
+    for (well = 0; well < num_wells; well++)
+    {
+      well_subgrid = WellDataPhysicalSubgrid(well_physicals[well]);
+
+      if ((SubgridLevel(well_subgrid) == SubgridLevel(subgrid)) &&
+          ((SubgridIX(well_subgrid) >= SubgridIX(subgrid) + SubgridNX(subgrid)) ||
+           (SubgridIX(well_subgrid) + SubgridNX(well_subgrid) <= SubgridIX(subgrid)) ||
+           (SubgridIY(well_subgrid) >= SubgridIY(subgrid) + SubgridNY(subgrid)) ||
+           (SubgridIY(well_subgrid) + SubgridNY(well_subgrid) <= SubgridIY(subgrid)) ||
+           (SubgridIZ(well_subgrid) >= SubgridIZ(subgrid) + SubgridNZ(subgrid)) ||
+           (SubgridIZ(well_subgrid) + SubgridNZ(well_subgrid) <= SubgridIZ(subgrid))))
+      {
+        continue;
+      }
+
+      if ((tmp_subgrid = IntersectSubgrids(subgrid, well_subgrid)))
+      {
+        if (num_entries == max_entries)
+        {
+          int      *tmp_wells = wells;
+          Subgrid **tmp_well_subgrids = well_subgrids;
+
+          wells = talloc(int, 2 * max_entries);
+          well_subgrids = talloc(Subgrid *, 2 * max_entries);
+          memcpy(wells, tmp_wells, max_entries * sizeof(int));
+          memcpy(well_subgrids, tmp_well_subgrids, max_entries * sizeof(Subgrid *));
+          tfree(tmp_wells);
+          tfree(tmp_well_subgrids);
+          max_entries *= 2;
+        }
+        wells[num_entries] = well;
+        well_subgrids[num_entries] = tmp_subgrid;
+        num_entries++;
+      }
+    }
+
+    starts[is + 1] = num_entries;
+  }
+
+  *starts_ptr = starts;
+  *wells_ptr = wells;
+  *well_subgrids_ptr = well_subgrids;
+}
+
+
+/*--------------------------------------------------------------------------
+ * GetWellSubgridMap:
+ *   Return the wells intersecting each subgrid of grid.  The map is built
+ *   the first time it is asked for and kept with the well data; it is only
+ *   rebuilt if a different grid is passed in.
+ *--------------------------------------------------------------------------*/
+
+WellSubgridMap *GetWellSubgridMap(
+                                  WellData *well_data,
+                                  Grid *    grid)
+{
+  WellSubgridMap *well_subgrid_map = WellDataSubgridMap(well_data);
+
+  if (well_subgrid_map && WellSubgridMapGrid(well_subgrid_map) == grid)
+  {
+    return well_subgrid_map;
+  }
+
+  FreeWellSubgridMap(well_subgrid_map);
+
+  well_subgrid_map = ctalloc(WellSubgridMap, 1);
+  WellSubgridMapGrid(well_subgrid_map) = grid;
+
+  MapWellsToSubgrids(GridSubgrids(grid),
+                     pfmax(WellDataNumPressWells(well_data), 0),
+                     WellDataPressWellPhysicals(well_data),
+                     &(well_subgrid_map->press_well_starts),
+                     &(well_subgrid_map->press_wells),
+                     &(well_subgrid_map->press_well_subgrids));
+
+  MapWellsToSubgrids(GridSubgrids(grid),
+                     pfmax(WellDataNumFluxWells(well_data), 0),
+                     WellDataFluxWellPhysicals(well_data),
+                     &(well_subgrid_map->flux_well_starts),
+                     &(well_subgrid_map->flux_wells),
+                     &(well_subgrid_map->flux_well_subgrids));
+
+  WellDataSubgridMap(well_data) = well_subgrid_map;
+
+  return well_subgrid_map;
+}
+
+
+/*--------------------------------------------------------------------------
+ * FreeWellSubgridMap
+ *--------------------------------------------------------------------------*/
+
+void FreeWellSubgridMap(
+                        WellSubgridMap *well_subgrid_map)
+{
+  Grid  *grid;
+  int n, num_entries;
+
+  if (well_subgrid_map)
+  {
+    grid = WellSubgridMapGrid(well_subgrid_map);
+
+    num_entries = (well_subgrid_map->press_well_starts)[GridNumSubgrids(grid)];
+    for (n = 0; n < num_entries; n++)
+    {
+      FreeSubgrid((well_subgrid_map->press_well_subgrids)[n]);
+    }
+    tfree(well_subgrid_map->press_well_starts);
+    tfree(well_subgrid_map->press_wells);
+    tfree(well_subgrid_map->press_well_subgrids);
+
+    num_entries = (well_subgrid_map->flux_well_starts)[GridNumSubgrids(grid)];
+    for (n = 0; n < num_entries; n++)
+    {
+      FreeSubgrid((well_subgrid_map->flux_well_subgrids)[n]);
+    }
+    tfree(well_subgrid_map->flux_well_starts);
+    tfree(well_subgrid_map->flux_wells);
+    tfree(well_subgrid_map->flux_well_subgrids);
+
+    tfree(well_subgrid_map);
+  }
+}
+
+
 /*--------------------------------------------------------------------------
  * PrintWellData
  *--------------------------------------------------------------------------*/
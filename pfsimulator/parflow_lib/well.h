@@ -75,6 +75,27 @@ typedef struct {
   double        *contaminant_stats;   /* num_phases * num_contaminants */
 } WellDataStat;
 
+/*----------------------------------------------------------------
+ * Well Subgrid Map structure
+ *
+ * For each subgrid of a grid, the wells intersecting it and the
+ * intersections, in increasing well order.  The lists are stored
+ * compressed: the wells of subgrid is are entries
+ * starts[is] .. starts[is + 1] - 1.
+ *----------------------------------------------------------------*/
+
+typedef struct {
+  Grid          *grid;
+
+  int           *press_well_starts;    /*   num_subgrids + 1   */
+  int           *press_wells;
+  Subgrid      **press_well_subgrids;
+
+  int           *flux_well_starts;     /*   num_subgrids + 1   */
+  int           *flux_wells;
+  Subgrid      **flux_well_subgrids;
+} WellSubgridMap;
+
 /*----------------------------------------------------------------
  * Well Data structure
  *----------------------------------------------------------------*/
@@ -101,6 +122,9 @@ typedef struct {
 
   /* time info */
   TimeCycleData      *time_cycle_data;
+
+  /* wells intersecting the local subgrids, built on first use */
+  WellSubgridMap     *subgrid_map;
 } WellData;
 
 /*--------------------------------------------------------------------------
@@ -226,6 +250,28 @@ typedef struct {
 #define WellDataStatContaminantStat(well_data_stat, i) \
   ((well_data_stat)->contaminant_stats[i])
 
+/*--------------------------------------------------------------------------
+ * Accessor macros: WellSubgridMap
+ *--------------------------------------------------------------------------*/
+#define WellSubgridMapGrid(well_subgrid_map) \
+  ((well_subgrid_map)->grid)
+
+#define WellSubgridMapNumPressWells(well_subgrid_map, is) \
+  ((well_subgrid_map)->press_well_starts[(is) + 1] - \
+   (well_subgrid_map)->press_well_starts[is])
+#define WellSubgridMapPressWell(well_subgrid_map, is, n) \
+  ((well_subgrid_map)->press_wells[(well_subgrid_map)->press_well_starts[is] + (n)])
+#define WellSubgridMapPressWellSubgrid(well_subgrid_map, is, n) \
+  ((well_subgrid_map)->press_well_subgrids[(well_subgrid_map)->press_well_starts[is] + (n)])
+
+#define WellSubgridMapNumFluxWells(well_subgrid_map, is) \
+  ((well_subgrid_map)->flux_well_starts[(is) + 1] - \
+   (well_subgrid_map)->flux_well_starts[is])
+#define WellSubgridMapFluxWell(well_subgrid_map, is, n) \
+  ((well_subgrid_map)->flux_wells[(well_subgrid_map)->flux_well_starts[is] + (n)])
+#define WellSubgridMapFluxWellSubgrid(well_subgrid_map, is, n) \
+  ((well_subgrid_map)->flux_well_subgrids[(well_subgrid_map)->flux_well_starts[is] + (n)])
+
 /*--------------------------------------------------------------------------
  * Accessor macros: WellData
  *--------------------------------------------------------------------------*/
@@ -236,6 +282,8 @@ typedef struct {
 
 #define WellDataTimeCycleData(well_data) ((well_data)->time_cycle_data)
 
+#define WellDataSubgridMap(well_data) ((well_data)->subgrid_map)
+
 /*-------------------------- Pressure well data ----------------------------*/
 #define WellDataNumPressWells(well_data) ((well_data)->num_press_wells)
 
@@ -130,6 +130,10 @@ void         WellPackage(
   double x_lower, x_upper, y_lower, y_upper,
     z_lower, z_upper;
 
+  /* Any well to subgrid map was built for the previous wells */
+  FreeWellSubgridMap(WellDataSubgridMap(well_data));
+  WellDataSubgridMap(well_data) = NULL;
+
   /* Allocate the well data */
   WellDataNumPhases(well_data) = (public_xtra->num_phases);
   WellDataNumContaminants(well_data) = (public_xtra->num_contaminants);
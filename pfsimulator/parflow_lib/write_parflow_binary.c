@@ -137,6 +137,7 @@ void     WritePFBinary(
   char filename[255];
   amps_File file;
 
+  TelemetryBeginPhase(TelemetryIOPhase);
   BeginTiming(PFBTimingIndex);
 
   p = amps_Rank(amps_CommWorld);
@@ -202,6 +203,7 @@ void     WritePFBinary(
   amps_FFclose(file);
 
   EndTiming(PFBTimingIndex);
+  TelemetryEndPhase(TelemetryIOPhase);
 }
 
 long SizeofPFSBinarySubvector(
@@ -330,6 +332,7 @@ void     WritePFSBinary(
 
   long size;
 
+  TelemetryBeginPhase(TelemetryIOPhase);
   BeginTiming(PFSBTimingIndex);
 
   p = amps_Rank(amps_CommWorld);
@@ -385,4 +388,5 @@ void     WritePFSBinary(
   amps_FFclose(file);
 
   EndTiming(PFSBTimingIndex);
+  TelemetryEndPhase(TelemetryIOPhase);
 }
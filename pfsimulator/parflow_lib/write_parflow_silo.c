@@ -338,6 +338,7 @@ void     WriteSilo(char *  file_prefix,
   DBfile *db_file;
 #endif
 
+  TelemetryBeginPhase(TelemetryIOPhase);
   BeginTiming(PFBTimingIndex);
 
 #ifdef HAVE_SILO
@@ -526,5 +527,6 @@ void     WriteSilo(char *  file_prefix,
 #endif
 
   EndTiming(PFBTimingIndex);
+  TelemetryEndPhase(TelemetryIOPhase);
 }
 
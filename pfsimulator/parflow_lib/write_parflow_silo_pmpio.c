@@ -235,6 +235,7 @@ void     WriteSiloPMPIO(char *  file_prefix,
   DBfile *db_header_file;
 #endif
 
+  TelemetryBeginPhase(TelemetryIOPhase);
   BeginTiming(PFBTimingIndex);
 
 #if defined(HAVE_SILO) && defined(HAVE_MPI)
@@ -581,6 +582,7 @@ void     WriteSiloPMPIO(char *  file_prefix,
 #endif
 
   EndTiming(PFBTimingIndex);
+  TelemetryEndPhase(TelemetryIOPhase);
 }
 
 
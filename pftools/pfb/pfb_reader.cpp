@@ -0,0 +1,425 @@
+/*BHEADER*********************************************************************
+ *
+ *  Copyright (c) 1995-2024, Lawrence Livermore National Security,
+ *  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+ *  by the Parflow Team (see the CONTRIBUTORS file)
+ *  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+ *
+ *  This file is part of Parflow. For details, see
+ *  http://www.llnl.gov/casc/parflow
+ *
+ *  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+ *  for the GNU Lesser General Public License.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License (as published
+ *  by the Free Software Foundation) version 2.1 dated February 1999.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+ *  and conditions of the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ *  USA
+ **********************************************************************EHEADER*/
+/*****************************************************************************
+*
+* Memory mapped PFB reader.
+*
+* PFB layout (all values big-endian):
+*
+*   double X Y Z; int NX NY NZ; double DX DY DZ; int num_subgrids   (64 bytes)
+*   per subgrid:
+*     int ix iy iz nx ny nz rx ry rz                                   (36 bytes)
+*     double data[nz][ny][nx]
+*
+*****************************************************************************/
+
+#include "pfb_reader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PFB_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const size_t HeaderSize = 64;
+const size_t SubgridHeaderSize = 36;
+
+thread_local std::string last_error;
+
+bool HostIsBigEndian()
+{
+  const uint32_t one = 1;
+  unsigned char b;
+
+  std::memcpy(&b, &one, 1);
+  return b == 0;
+}
+
+inline uint64_t LoadBE64(const unsigned char *p)
+{
+  uint64_t v;
+
+  std::memcpy(&v, p, 8);
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap64(v);
+#else
+  return ((v & 0x00000000000000FFull) << 56) | ((v & 0x000000000000FF00ull) << 40) |
+         ((v & 0x0000000000FF0000ull) << 24) | ((v & 0x00000000FF000000ull) << 8) |
+         ((v & 0x000000FF00000000ull) >> 8) | ((v & 0x0000FF0000000000ull) >> 24) |
+         ((v & 0x00FF000000000000ull) >> 40) | ((v & 0xFF00000000000000ull) >> 56);
+#endif
+}
+
+inline int32_t ReadInt(const unsigned char *p)
+{
+  uint32_t v = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) |
+               (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+  int32_t i;
+
+  std::memcpy(&i, &v, 4);
+  return i;
+}
+
+inline double ReadDouble(const unsigned char *p)
+{
+  uint64_t v = 0;
+  double d;
+
+  for (int b = 0; b < 8; b++)
+    v = (v << 8) | p[b];
+  std::memcpy(&d, &v, 8);
+  return d;
+}
+
+/* Convert n consecutive big-endian doubles to native order */
+void CopyRow(const unsigned char *src, double *dst, long n, long stride,
+             bool big_endian)
+{
+  if (big_endian)
+  {
+    if (stride == 1)
+      std::memcpy(dst, src, size_t(n) * 8);
+    else
+      for (long i = 0; i < n; i++)
+        std::memcpy(dst + i * stride, src + 8 * i, 8);
+    return;
+  }
+
+  for (long i = 0; i < n; i++)
+  {
+    uint64_t v = LoadBE64(src + 8 * i);
+    std::memcpy(dst + i * stride, &v, 8);
+  }
+}
+
+struct Subgrid {
+  PFBSubgrid box;
+  const unsigned char *data;
+};
+
+}  /* namespace */
+
+struct PFBReader {
+  const unsigned char *base;
+  size_t size;
+  bool mapped;
+  std::vector<unsigned char> buffer;
+
+  double X, Y, Z;
+  int NX, NY, NZ;
+  double DX, DY, DZ;
+  std::vector<Subgrid> subgrids;
+
+  PFBReader() : base(nullptr), size(0), mapped(false) {}
+
+  ~PFBReader()
+  {
+#ifdef PFB_HAVE_MMAP
+    if (mapped)
+      munmap(const_cast<unsigned char *>(base), size);
+#endif
+  }
+
+  bool Map(const char *filename)
+  {
+#ifdef PFB_HAVE_MMAP
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+      last_error = std::string("can't open ") + filename;
+      return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+      void *p = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED)
+      {
+        base = static_cast<const unsigned char *>(p);
+        size = size_t(st.st_size);
+        mapped = true;
+        close(fd);
+        return true;
+      }
+    }
+    close(fd);
+#endif
+
+    /* No mmap available (or it failed): read the whole file */
+    FILE *file = std::fopen(filename, "rb");
+    if (!file)
+    {
+      last_error = std::string("can't open ") + filename;
+      return false;
+    }
+    std::fseek(file, 0, SEEK_END);
+    long length = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    if (length > 0)
+    {
+      buffer.resize(size_t(length));
+      if (std::fread(buffer.data(), 1, buffer.size(), file) != buffer.size())
+      {
+        std::fclose(file);
+        last_error = std::string("short read on ") + filename;
+        return false;
+      }
+    }
+    std::fclose(file);
+    base = buffer.data();
+    size = buffer.size();
+    return true;
+  }
+
+  bool ParseIndex(const char *filename)
+  {
+    if (size < HeaderSize)
+    {
+      last_error = std::string(filename) + " is too short for a PFB header";
+      return false;
+    }
+
+    X = ReadDouble(base);
+    Y = ReadDouble(base + 8);
+    Z = ReadDouble(base + 16);
+    NX = ReadInt(base + 24);
+    NY = ReadInt(base + 28);
+    NZ = ReadInt(base + 32);
+    DX = ReadDouble(base + 36);
+    DY = ReadDouble(base + 44);
+    DZ = ReadDouble(base + 52);
+    int num_subgrids = ReadInt(base + 60);
+
+    if (NX < 0 || NY < 0 || NZ < 0 || num_subgrids < 0)
+    {
+      last_error = std::string(filename) + " has an invalid PFB header";
+      return false;
+    }
+
+    subgrids.resize(size_t(num_subgrids));
+
+    size_t offset = HeaderSize;
+    for (int g = 0; g < num_subgrids; g++)
+    {
+      if (offset + SubgridHeaderSize > size)
+      {
+        last_error = std::string(filename) + " is truncated in the subgrid headers";
+        return false;
+      }
+
+      const unsigned char *p = base + offset;
+      PFBSubgrid &box = subgrids[size_t(g)].box;
+      box.ix = ReadInt(p);
+      box.iy = ReadInt(p + 4);
+      box.iz = ReadInt(p + 8);
+      box.nx = ReadInt(p + 12);
+      box.ny = ReadInt(p + 16);
+      box.nz = ReadInt(p + 20);
+      box.rx = ReadInt(p + 24);
+      box.ry = ReadInt(p + 28);
+      box.rz = ReadInt(p + 32);
+      offset += SubgridHeaderSize;
+
+      if (box.nx < 0 || box.ny < 0 || box.nz < 0)
+      {
+        last_error = std::string(filename) + " has an invalid subgrid header";
+        return false;
+      }
+
+      size_t bytes = size_t(box.nx) * size_t(box.ny) * size_t(box.nz) * 8;
+      if (offset + bytes > size)
+      {
+        last_error = std::string(filename) + " is truncated in the subgrid data";
+        return false;
+      }
+      subgrids[size_t(g)].data = base + offset;
+      offset += bytes;
+    }
+
+    return true;
+  }
+};
+
+extern "C" {
+
+PFBReader *PFBReaderOpen(const char *filename)
+{
+  PFBReader *reader = new PFBReader;
+
+  if (!reader->Map(filename) || !reader->ParseIndex(filename))
+  {
+    delete reader;
+    return nullptr;
+  }
+
+  return reader;
+}
+
+void PFBReaderClose(PFBReader *reader)
+{
+  delete reader;
+}
+
+const char *PFBReaderError(void)
+{
+  return last_error.c_str();
+}
+
+void PFBReaderOrigin(const PFBReader *reader, double *x, double *y, double *z)
+{
+  *x = reader->X;
+  *y = reader->Y;
+  *z = reader->Z;
+}
+
+void PFBReaderSize(const PFBReader *reader, int *nx, int *ny, int *nz)
+{
+  *nx = reader->NX;
+  *ny = reader->NY;
+  *nz = reader->NZ;
+}
+
+void PFBReaderSpacing(const PFBReader *reader, double *dx, double *dy, double *dz)
+{
+  *dx = reader->DX;
+  *dy = reader->DY;
+  *dz = reader->DZ;
+}
+
+int PFBReaderNumSubgrids(const PFBReader *reader)
+{
+  return int(reader->subgrids.size());
+}
+
+int PFBReaderSubgridInfo(const PFBReader *reader, int i, PFBSubgrid *subgrid)
+{
+  if (i < 0 || i >= int(reader->subgrids.size()))
+    return 0;
+
+  *subgrid = reader->subgrids[size_t(i)].box;
+  return 1;
+}
+
+const void *PFBReaderSubgridData(const PFBReader *reader, int i)
+{
+  if (i < 0 || i >= int(reader->subgrids.size()))
+    return nullptr;
+
+  return reader->subgrids[size_t(i)].data;
+}
+
+long PFBReaderReadBox(const PFBReader *reader,
+                      int ix, int iy, int iz, int nx, int ny, int nz,
+                      double *data, long sx, long sy, long sz,
+                      int num_threads)
+{
+  /* One task per (overlapping subgrid, z plane) */
+  struct Task {
+    const Subgrid *subgrid;
+    int x0, y0, x1, y1, k;
+  };
+
+  std::vector<Task> tasks;
+  long copied = 0;
+
+  for (const Subgrid &s : reader->subgrids)
+  {
+    const PFBSubgrid &b = s.box;
+    int x0 = std::max(ix, b.ix), x1 = std::min(ix + nx, b.ix + b.nx);
+    int y0 = std::max(iy, b.iy), y1 = std::min(iy + ny, b.iy + b.ny);
+    int z0 = std::max(iz, b.iz), z1 = std::min(iz + nz, b.iz + b.nz);
+
+    if (x0 >= x1 || y0 >= y1 || z0 >= z1)
+      continue;
+
+    for (int k = z0; k < z1; k++)
+    {
+      Task t = { &s, x0, y0, x1, y1, k };
+      tasks.push_back(t);
+    }
+    copied += long(x1 - x0) * long(y1 - y0) * long(z1 - z0);
+  }
+
+  const bool big_endian = HostIsBigEndian();
+
+  auto run = [&](const Task &t) {
+                const PFBSubgrid &b = t.subgrid->box;
+                long row = t.x1 - t.x0;
+                for (int j = t.y0; j < t.y1; j++)
+                {
+                  const unsigned char *src = t.subgrid->data +
+                                             8 * ((size_t(t.k - b.iz) * size_t(b.ny) + size_t(j - b.iy)) * size_t(b.nx)
+                                                  + size_t(t.x0 - b.ix));
+                  double *dst = data + long(t.x0 - ix) * sx + long(j - iy) * sy + long(t.k - iz) * sz;
+                  CopyRow(src, dst, row, sx, big_endian);
+                }
+              };
+
+  if (num_threads <= 0)
+    num_threads = int(std::max(1u, std::thread::hardware_concurrency()));
+  num_threads = int(std::min(size_t(num_threads), tasks.size()));
+
+  if (num_threads <= 1)
+  {
+    for (const Task &t : tasks)
+      run(t);
+    return copied;
+  }
+
+  std::atomic<size_t> next(0);
+  auto worker = [&]() {
+                  size_t n;
+                  while ((n = next.fetch_add(1)) < tasks.size())
+                    run(tasks[n]);
+                };
+
+  std::vector<std::thread> threads;
+  for (int n = 1; n < num_threads; n++)
+    threads.emplace_back(worker);
+  worker();
+  for (std::thread &thread : threads)
+    thread.join();
+
+  return copied;
+}
+
+}  /* extern "C" */
@@ -0,0 +1,101 @@
+/*BHEADER*********************************************************************
+ *
+ *  Copyright (c) 1995-2024, Lawrence Livermore National Security,
+ *  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+ *  by the Parflow Team (see the CONTRIBUTORS file)
+ *  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+ *
+ *  This file is part of Parflow. For details, see
+ *  http://www.llnl.gov/casc/parflow
+ *
+ *  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+ *  for the GNU Lesser General Public License.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License (as published
+ *  by the Free Software Foundation) version 2.1 dated February 1999.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+ *  and conditions of the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ *  USA
+ **********************************************************************EHEADER*/
+/*****************************************************************************
+* Header file for the shared PFB reader library (libpfbreader).
+*
+* The reader memory maps a ParFlow binary (PFB) file, walks the subgrid
+* index once on open and then hands out either zero-copy views of the
+* (big-endian) subgrid data or gathers an arbitrary box of the domain into a
+* strided, native-endian double array.  The gather may be split over
+* several threads.
+*
+* The interface is plain C so the simulator, pftools and the Python
+* bindings (through ctypes) can all link against the same library.
+*
+*****************************************************************************/
+
+#ifndef PFB_READER_HEADER
+#define PFB_READER_HEADER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct PFBReader PFBReader;
+
+/* Placement of one subgrid in the file, in global index space */
+typedef struct {
+  int ix, iy, iz;
+  int nx, ny, nz;
+  int rx, ry, rz;
+} PFBSubgrid;
+
+/*--------------------------------------------------------------------------
+ * Open / close.  PFBReaderOpen returns NULL if the file can not be read
+ * or is not a well formed PFB file; PFBReaderError then describes why.
+ *--------------------------------------------------------------------------*/
+
+PFBReader *PFBReaderOpen(const char *filename);
+void PFBReaderClose(PFBReader *reader);
+const char *PFBReaderError(void);
+
+/*--------------------------------------------------------------------------
+ * Header information
+ *--------------------------------------------------------------------------*/
+
+void PFBReaderOrigin(const PFBReader *reader, double *x, double *y, double *z);
+void PFBReaderSize(const PFBReader *reader, int *nx, int *ny, int *nz);
+void PFBReaderSpacing(const PFBReader *reader, double *dx, double *dy, double *dz);
+int PFBReaderNumSubgrids(const PFBReader *reader);
+int PFBReaderSubgridInfo(const PFBReader *reader, int i, PFBSubgrid *subgrid);
+
+/*--------------------------------------------------------------------------
+ * Zero-copy access: pointer to the nx*ny*nz big-endian doubles of subgrid
+ * i (x fastest).  Valid until PFBReaderClose.
+ *--------------------------------------------------------------------------*/
+
+const void *PFBReaderSubgridData(const PFBReader *reader, int i);
+
+/*--------------------------------------------------------------------------
+ * Gather the box [ix,ix+nx) x [iy,iy+ny) x [iz,iz+nz) into data, converting
+ * to native byte order.  Element (i,j,k) of the box is stored at
+ * data[(i-ix)*sx + (j-iy)*sy + (k-iz)*sz].  Cells not covered by any
+ * subgrid are left untouched.  num_threads <= 0 uses the hardware
+ * concurrency.  Returns the number of cells copied.
+ *--------------------------------------------------------------------------*/
+
+long PFBReaderReadBox(const PFBReader *reader,
+                      int ix, int iy, int iz, int nx, int ny, int nz,
+                      double *data, long sx, long sy, long sz,
+                      int num_threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -48,6 +48,7 @@ from .hydrology import (
     calculate_water_table_depth,
 )
 from .fs import get_absolute_path
+from .pfb_native import NativePFBReader
 from .helper import sort_dict, get_or_create_dict
 
 try:
@@ -83,6 +84,22 @@ def read_pfb(file: str, keys: dict=None, mode: str='full', z_first: bool=True,
     :return:
         An nd array containing the data from the pfb file.
     """
+    if mode == 'full' and NativePFBReader.available():
+        with NativePFBReader(file) as pfb:
+            if not keys:
+                return pfb.read(z_first=z_first)
+            header = pfb.header
+            start_x = keys.get('x', {}).get('start', None) or 0
+            start_y = keys.get('y', {}).get('start', None) or 0
+            start_z = keys.get('z', {}).get('start', None) or 0
+            stop_x = keys.get('x', {}).get('stop', None) or header['nx']
+            stop_y = keys.get('y', {}).get('stop', None) or header['ny']
+            stop_z = keys.get('z', {}).get('stop', None) or header['nz']
+            return pfb.read_box(start_x, start_y, start_z,
+                                max(stop_x - start_x, 1),
+                                max(stop_y - start_y, 1),
+                                max(stop_z - start_z, 1), z_first=z_first)
+
     with ParflowBinaryReader(file, read_sg_info=read_sg_info) as pfb:
         if not keys:
             data = pfb.read_all_subgrids(mode=mode, z_first=z_first)
@@ -308,6 +325,21 @@ def read_pfb_sequence(
     else:
         seq_size = (len(file_seq), nx, ny, nz)
     pfb_seq = np.empty(seq_size, dtype=np.float64)
+    if NativePFBReader.available():
+        # Gather each file straight into its slot of the sequence
+        if not keys:
+            start_x, start_y, start_z = 0, 0, 0
+        for i, f in enumerate(file_seq):
+            with NativePFBReader(f) as pfb:
+                pfb.read_box(start_x, start_y, start_z, nx, ny, nz,
+                             z_first=z_first, out=pfb_seq[i])
+        if z_is == 'time':
+            if z_first:
+                pfb_seq = np.concatenate(pfb_seq, axis=0)
+            else:
+                pfb_seq = np.concatenate(pfb_seq, axis=-1)
+        return pfb_seq
+
     for i, f in enumerate(file_seq):
         with ParflowBinaryReader(
             f, precompute_subgrid_info=False, header=base_header
@@ -0,0 +1,188 @@
+# -*- coding: utf-8 -*-
+"""pfb_native module
+
+ctypes bindings to the memory mapped PFB reader library (libpfbreader)
+shared with the simulator and the TCL pftools.
+
+The library is looked up in ``$PFBREADER_LIBRARY``, then in
+``$PARFLOW_DIR/lib`` and finally on the system library path. If it can not
+be found ``NativePFBReader.available()`` is ``False`` and callers fall back
+to the pure Python reader.
+"""
+
+import ctypes
+import ctypes.util
+import os
+import sys
+
+import numpy as np
+
+
+class _PFBSubgrid(ctypes.Structure):
+    _fields_ = [(name, ctypes.c_int) for name in
+                ('ix', 'iy', 'iz', 'nx', 'ny', 'nz', 'rx', 'ry', 'rz')]
+
+
+_lib = None
+_lib_loaded = False
+
+
+def _library_candidates():
+    if sys.platform == 'darwin':
+        lib_name = 'libpfbreader.dylib'
+    elif sys.platform.startswith('win'):
+        lib_name = 'pfbreader.dll'
+    else:
+        lib_name = 'libpfbreader.so'
+
+    if os.environ.get('PFBREADER_LIBRARY'):
+        yield os.environ['PFBREADER_LIBRARY']
+    if os.environ.get('PARFLOW_DIR'):
+        yield os.path.join(os.environ['PARFLOW_DIR'], 'lib', lib_name)
+    found = ctypes.util.find_library('pfbreader')
+    if found:
+        yield found
+
+
+def _load_library():
+    global _lib, _lib_loaded
+    if _lib_loaded:
+        return _lib
+    _lib_loaded = True
+
+    for candidate in _library_candidates():
+        try:
+            lib = ctypes.CDLL(candidate)
+        except OSError:
+            continue
+
+        c_int_p = ctypes.POINTER(ctypes.c_int)
+        c_double_p = ctypes.POINTER(ctypes.c_double)
+
+        lib.PFBReaderOpen.restype = ctypes.c_void_p
+        lib.PFBReaderOpen.argtypes = [ctypes.c_char_p]
+        lib.PFBReaderClose.restype = None
+        lib.PFBReaderClose.argtypes = [ctypes.c_void_p]
+        lib.PFBReaderError.restype = ctypes.c_char_p
+        lib.PFBReaderError.argtypes = []
+        lib.PFBReaderOrigin.restype = None
+        lib.PFBReaderOrigin.argtypes = [ctypes.c_void_p] + [c_double_p] * 3
+        lib.PFBReaderSize.restype = None
+        lib.PFBReaderSize.argtypes = [ctypes.c_void_p] + [c_int_p] * 3
+        lib.PFBReaderSpacing.restype = None
+        lib.PFBReaderSpacing.argtypes = [ctypes.c_void_p] + [c_double_p] * 3
+        lib.PFBReaderNumSubgrids.restype = ctypes.c_int
+        lib.PFBReaderNumSubgrids.argtypes = [ctypes.c_void_p]
+        lib.PFBReaderSubgridInfo.restype = ctypes.c_int
+        lib.PFBReaderSubgridInfo.argtypes = [
+            ctypes.c_void_p, ctypes.c_int, ctypes.POINTER(_PFBSubgrid)]
+        lib.PFBReaderSubgridData.restype = ctypes.c_void_p
+        lib.PFBReaderSubgridData.argtypes = [ctypes.c_void_p, ctypes.c_int]
+        lib.PFBReaderReadBox.restype = ctypes.c_long
+        lib.PFBReaderReadBox.argtypes = (
+            [ctypes.c_void_p] + [ctypes.c_int] * 6 + [ctypes.c_void_p]
+            + [ctypes.c_long] * 3 + [ctypes.c_int])
+
+        _lib = lib
+        break
+
+    return _lib
+
+
+class NativePFBReader:
+    """Memory mapped PFB file.
+
+    Subgrid views returned by ``subgrid_view`` alias the mapping, so the
+    reader must stay open while they are in use.
+    """
+
+    @staticmethod
+    def available():
+        return _load_library() is not None
+
+    def __init__(self, file, num_threads=0):
+        self._lib = _load_library()
+        if self._lib is None:
+            raise OSError('libpfbreader is not available')
+        self.num_threads = num_threads
+        self._handle = self._lib.PFBReaderOpen(os.fsencode(str(file)))
+        if not self._handle:
+            raise OSError(self._lib.PFBReaderError().decode())
+
+        x, y, z = (ctypes.c_double(), ctypes.c_double(), ctypes.c_double())
+        nx, ny, nz = (ctypes.c_int(), ctypes.c_int(), ctypes.c_int())
+        dx, dy, dz = (ctypes.c_double(), ctypes.c_double(), ctypes.c_double())
+        self._lib.PFBReaderOrigin(self._handle, ctypes.byref(x),
+                                  ctypes.byref(y), ctypes.byref(z))
+        self._lib.PFBReaderSize(self._handle, ctypes.byref(nx),
+                                ctypes.byref(ny), ctypes.byref(nz))
+        self._lib.PFBReaderSpacing(self._handle, ctypes.byref(dx),
+                                   ctypes.byref(dy), ctypes.byref(dz))
+        self.header = {
+            'x': x.value, 'y': y.value, 'z': z.value,
+            'nx': nx.value, 'ny': ny.value, 'nz': nz.value,
+            'dx': dx.value, 'dy': dy.value, 'dz': dz.value,
+            'n_subgrids': self._lib.PFBReaderNumSubgrids(self._handle),
+        }
+
+    def close(self):
+        if self._handle:
+            self._lib.PFBReaderClose(self._handle)
+            self._handle = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def __del__(self):
+        self.close()
+
+    def subgrid(self, i):
+        """Placement of subgrid ``i`` as a dict of ix..rz."""
+        info = _PFBSubgrid()
+        if not self._lib.PFBReaderSubgridInfo(self._handle, i,
+                                              ctypes.byref(info)):
+            raise IndexError(i)
+        return {name: getattr(info, name) for name, _ in _PFBSubgrid._fields_}
+
+    def subgrid_view(self, i):
+        """Zero-copy, read-only (nz, ny, nx) big-endian view of subgrid ``i``."""
+        sg = self.subgrid(i)
+        count = sg['nx'] * sg['ny'] * sg['nz']
+        address = self._lib.PFBReaderSubgridData(self._handle, i)
+        if count == 0:
+            return np.empty((sg['nz'], sg['ny'], sg['nx']), dtype='>f8')
+        buffer = (ctypes.c_char * (8 * count)).from_address(address)
+        view = np.frombuffer(buffer, dtype='>f8', count=count)
+        return view.reshape((sg['nz'], sg['ny'], sg['nx']))
+
+    def read_box(self, ix, iy, iz, nx, ny, nz, z_first=True, out=None):
+        """Gather a box of the domain into a native-endian array.
+
+        :param out:
+            Optional C-contiguous float64 array of the result shape to fill
+            in place ((nz, ny, nx) if ``z_first`` else (nx, ny, nz)).
+        """
+        nx, ny, nz = int(nx), int(ny), int(nz)
+        shape = (nz, ny, nx) if z_first else (nx, ny, nz)
+        if out is None:
+            out = np.empty(shape, dtype=np.float64)
+        elif (out.shape != shape or out.dtype != np.float64
+              or not out.flags['C_CONTIGUOUS']):
+            raise ValueError('out must be a C-contiguous float64 array '
+                             f'of shape {shape}')
+        if z_first:
+            strides = (1, nx, nx * ny)
+        else:
+            strides = (ny * nz, nz, 1)
+        self._lib.PFBReaderReadBox(
+            self._handle, int(ix), int(iy), int(iz), nx, ny, nz,
+            out.ctypes.data, *strides, self.num_threads)
+        return out
+
+    def read(self, z_first=True, out=None):
+        """Gather the full domain into a dense native-endian array."""
+        return self.read_box(0, 0, 0, self.header['nx'], self.header['ny'],
+                             self.header['nz'], z_first=z_first, out=out)
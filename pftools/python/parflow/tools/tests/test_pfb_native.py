@@ -0,0 +1,67 @@
+"""
+    Unit test for the memory mapped PFB reader bindings.
+    Compares the native reader against the pure Python ParflowBinaryReader
+    on the test data .pfb files. Skipped if libpfbreader is not installed.
+"""
+
+
+import sys
+import os
+import unittest
+import numpy as np
+rootdir = os.path.abspath(os.path.join(os.path.dirname(__file__), "../.."))
+sys.path.append(rootdir)
+from parflow import ParflowBinaryReader, read_pfb_sequence
+from parflow.tools.pfb_native import NativePFBReader
+
+EXAMPLE_PFB_FILE_PATH_0 = f"{rootdir}/tools/tests/data/forsyth5.out.press.00000.pfb"
+EXAMPLE_PFB_FILE_PATH_1 = f"{rootdir}/tools/tests/data/forsyth5.out.press.00001.pfb"
+
+
+@unittest.skipUnless(NativePFBReader.available(), "libpfbreader not found")
+class TestPFBNative(unittest.TestCase):
+    def test_read_full(self):
+        """The threaded gather matches the Python reader in both layouts."""
+        with ParflowBinaryReader(EXAMPLE_PFB_FILE_PATH_0, read_sg_info=True) as pfb:
+            expected = pfb.read_all_subgrids(mode='full', z_first=True)
+
+        with NativePFBReader(EXAMPLE_PFB_FILE_PATH_0, num_threads=4) as pfb:
+            self.assertEqual(46, pfb.header['nx'])
+            self.assertEqual(46, pfb.header['ny'])
+            self.assertEqual(21, pfb.header['nz'])
+            np.testing.assert_array_equal(expected, pfb.read(z_first=True))
+            np.testing.assert_array_equal(np.transpose(expected),
+                                          pfb.read(z_first=False))
+
+    def test_subgrid_views(self):
+        """Zero-copy subgrid views land where the full read puts them."""
+        with NativePFBReader(EXAMPLE_PFB_FILE_PATH_0) as pfb:
+            full = pfb.read()
+            for i in range(pfb.header['n_subgrids']):
+                sg = pfb.subgrid(i)
+                view = pfb.subgrid_view(i)
+                self.assertFalse(view.flags['WRITEABLE'])
+                np.testing.assert_array_equal(
+                    full[sg['iz']:sg['iz'] + sg['nz'],
+                         sg['iy']:sg['iy'] + sg['ny'],
+                         sg['ix']:sg['ix'] + sg['nx']], view)
+
+    def test_read_box(self):
+        """A box spanning several subgrids matches slicing the full array."""
+        with NativePFBReader(EXAMPLE_PFB_FILE_PATH_0) as pfb:
+            full = pfb.read()
+            box = pfb.read_box(5, 7, 3, 30, 20, 10)
+            np.testing.assert_array_equal(full[3:13, 7:27, 5:35], box)
+
+    def test_read_sequence(self):
+        """read_pfb_sequence gathers each file into its slot."""
+        files = [EXAMPLE_PFB_FILE_PATH_0, EXAMPLE_PFB_FILE_PATH_1]
+        seq = read_pfb_sequence(files)
+        for i, f in enumerate(files):
+            with ParflowBinaryReader(f, read_sg_info=True) as pfb:
+                np.testing.assert_array_equal(
+                    pfb.read_all_subgrids(mode='full'), seq[i])
+
+
+if __name__ == "__main__":
+    unittest.main()
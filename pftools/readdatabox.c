@@ -41,6 +41,7 @@
 
 #include "readdatabox.h"
 #include "tools_io.h"
+#include "pfb_reader.h"
 
 #ifdef HAVE_SILO
 #include "silo.h"
@@ -326,74 +327,34 @@ Databox         *ReadParflowB(
 {
   Databox         *v;
 
-  FILE           *fp;
+  PFBReader       *reader;
 
   double X, Y, Z;
   int NX, NY, NZ;
   double DX, DY, DZ;
-  int num_subgrids;
-
-  int x, y, z;
-  int nx, ny, nz;
-  int rx, ry, rz;
 
-  int nsg, j, k;
 
-  double         *ptr;
-
-
-  /* open the input file */
-  if ((fp = fopen(file_name, "rb")) == NULL)
+  /* map the input file and index its subgrids */
+  if ((reader = PFBReaderOpen(file_name)) == NULL)
     return NULL;
 
   /* read in header info */
-  tools_ReadDouble(fp, &X, 1);
-  tools_ReadDouble(fp, &Y, 1);
-  tools_ReadDouble(fp, &Z, 1);
-
-  tools_ReadInt(fp, &NX, 1);
-  tools_ReadInt(fp, &NY, 1);
-  tools_ReadInt(fp, &NZ, 1);
-
-  tools_ReadDouble(fp, &DX, 1);
-  tools_ReadDouble(fp, &DY, 1);
-  tools_ReadDouble(fp, &DZ, 1);
-
-  tools_ReadInt(fp, &num_subgrids, 1);
+  PFBReaderOrigin(reader, &X, &Y, &Z);
+  PFBReaderSize(reader, &NX, &NY, &NZ);
+  PFBReaderSpacing(reader, &DX, &DY, &DZ);
 
   /* create the new databox structure */
   if ((v = NewDataboxDefault(NX, NY, NZ, X, Y, Z, DX, DY, DZ, default_value)) == NULL)
   {
-    fclose(fp);
+    PFBReaderClose(reader);
     return((Databox*)NULL);
   }
 
-  /* read in the databox data */
-  for (nsg = num_subgrids; nsg--;)
-  {
-    tools_ReadInt(fp, &x, 1);
-    tools_ReadInt(fp, &y, 1);
-    tools_ReadInt(fp, &z, 1);
-
-    tools_ReadInt(fp, &nx, 1);
-    tools_ReadInt(fp, &ny, 1);
-    tools_ReadInt(fp, &nz, 1);
+  /* gather the subgrids into the databox, using all available threads */
+  PFBReaderReadBox(reader, 0, 0, 0, NX, NY, NZ, DataboxCoeffs(v),
+                   1, NX, (long)NX * NY, 0);
 
-    tools_ReadInt(fp, &rx, 1);
-    tools_ReadInt(fp, &ry, 1);
-    tools_ReadInt(fp, &rz, 1);
-
-
-
-    for (k = 0; k < nz; k++)
-      for (j = 0; j < ny; j++)
-      {
-        ptr = DataboxCoeff(v, x, (y + j), (z + k));
-        tools_ReadDouble(fp, ptr, nx);
-      }
-  }
-
-  fclose(fp);
+  PFBReaderClose(reader);
   return v;
 }
 
@@ -0,0 +1,346 @@
+# Statistics of a log normal permeability field generated with the FFT
+# moving average simulator (Perm.Type FFT), conditioned to one point.
+
+#
+# Import the ParFlow TCL package
+#
+lappend auto_path $env(PARFLOW_DIR)/bin
+package require parflow
+namespace import Parflow::*
+
+set runname fft_rf
+
+#-----------------------------------------------------------------------------
+# File input version number
+#-----------------------------------------------------------------------------
+pfset FileVersion 4
+
+#-----------------------------------------------------------------------------
+# Process Topology
+#-----------------------------------------------------------------------------
+
+pfset Process.Topology.P        1
+pfset Process.Topology.Q        1
+pfset Process.Topology.R        1
+
+#-----------------------------------------------------------------------------
+# Computational Grid
+#-----------------------------------------------------------------------------
+pfset ComputationalGrid.Lower.X                0.0
+pfset ComputationalGrid.Lower.Y                0.0
+pfset ComputationalGrid.Lower.Z                0.0
+
+pfset ComputationalGrid.DX                     1.0
+pfset ComputationalGrid.DY                     1.0
+pfset ComputationalGrid.DZ                     0.5
+
+pfset ComputationalGrid.NX                     48
+pfset ComputationalGrid.NY                     48
+pfset ComputationalGrid.NZ                     24
+
+#-----------------------------------------------------------------------------
+# The Names of the GeomInputs
+#-----------------------------------------------------------------------------
+pfset GeomInput.Names "domain_input"
+
+#-----------------------------------------------------------------------------
+# Domain Geometry Input
+#-----------------------------------------------------------------------------
+pfset GeomInput.domain_input.InputType            Box
+pfset GeomInput.domain_input.GeomName             domain
+
+#-----------------------------------------------------------------------------
+# Domain Geometry
+#-----------------------------------------------------------------------------
+pfset Geom.domain.Lower.X                        0.0
+pfset Geom.domain.Lower.Y                        0.0
+pfset Geom.domain.Lower.Z                        0.0
+
+pfset Geom.domain.Upper.X                        48.0
+pfset Geom.domain.Upper.Y                        48.0
+pfset Geom.domain.Upper.Z                        12.0
+
+pfset Geom.domain.Patches "left right front back bottom top"
+
+#-----------------------------------------------------------------------------
+# Perm
+#-----------------------------------------------------------------------------
+pfset Geom.Perm.Names "domain"
+
+pfset Geom.domain.Perm.Type         FFT
+pfset Geom.domain.Perm.LambdaX      4.0
+pfset Geom.domain.Perm.LambdaY      4.0
+pfset Geom.domain.Perm.LambdaZ      1.0
+pfset Geom.domain.Perm.GeomMean     10.0
+pfset Geom.domain.Perm.Sigma        1.0
+pfset Geom.domain.Perm.KernelRadius 4.0
+pfset Geom.domain.Perm.Seed         33335
+pfset Geom.domain.Perm.LogNormal    Log
+
+# one measured value in the center of cell (12, 20, 6)
+set cond_file [open $runname.cond.txt w]
+puts $cond_file "1"
+puts $cond_file "12.5 20.5 3.25 50.0"
+close $cond_file
+pfset Perm.Conditioning.FileName    $runname.cond.txt
+
+pfset Perm.TensorType               TensorByGeom
+
+pfset Geom.Perm.TensorByGeom.Names  "domain"
+
+pfset Geom.domain.Perm.TensorValX  1.0
+pfset Geom.domain.Perm.TensorValY  1.0
+pfset Geom.domain.Perm.TensorValZ  1.0
+
+#-----------------------------------------------------------------------------
+# Specific Storage
+#-----------------------------------------------------------------------------
+# specific storage does not figure into the impes (fully sat) case but we still
+# need a key for it
+
+pfset SpecificStorage.Type            Constant
+pfset SpecificStorage.GeomNames       ""
+pfset Geom.domain.SpecificStorage.Value 1.0e-4
+
+#-----------------------------------------------------------------------------
+# Phases
+#-----------------------------------------------------------------------------
+
+pfset Phase.Names "water"
+
+pfset Phase.water.Density.Type	Constant
+pfset Phase.water.Density.Value	1.0
+
+pfset Phase.water.Viscosity.Type	Constant
+pfset Phase.water.Viscosity.Value	1.0
+
+#-----------------------------------------------------------------------------
+# Contaminants
+#-----------------------------------------------------------------------------
+pfset Contaminants.Names			""
+
+
+#-----------------------------------------------------------------------------
+# Gravity
+#-----------------------------------------------------------------------------
+
+pfset Gravity				1.0
+
+#-----------------------------------------------------------------------------
+# Setup timing info
+#-----------------------------------------------------------------------------
+
+pfset TimingInfo.BaseUnit		1.0
+pfset TimingInfo.StartCount		-1
+pfset TimingInfo.StartTime		0.0
+pfset TimingInfo.StopTime            0.0
+pfset TimingInfo.DumpInterval	       -1
+
+#-----------------------------------------------------------------------------
+# Porosity
+#-----------------------------------------------------------------------------
+
+pfset Geom.Porosity.GeomNames          domain
+
+pfset Geom.domain.Porosity.Type    Constant
+pfset Geom.domain.Porosity.Value   0.390
+
+#-----------------------------------------------------------------------------
+# Domain
+#-----------------------------------------------------------------------------
+pfset Domain.GeomName domain
+
+#-----------------------------------------------------------------------------
+# Mobility
+#-----------------------------------------------------------------------------
+pfset Phase.water.Mobility.Type        Constant
+pfset Phase.water.Mobility.Value       1.0
+
+
+#-----------------------------------------------------------------------------
+# Wells
+#-----------------------------------------------------------------------------
+pfset Wells.Names ""
+
+
+#-----------------------------------------------------------------------------
+# Time Cycles
+#-----------------------------------------------------------------------------
+pfset Cycle.Names constant
+pfset Cycle.constant.Names		"alltime"
+pfset Cycle.constant.alltime.Length	 1
+pfset Cycle.constant.Repeat		-1
+
+#-----------------------------------------------------------------------------
+# Boundary Conditions: Pressure
+#-----------------------------------------------------------------------------
+pfset BCPressure.PatchNames "left right front back bottom top"
+
+pfset Patch.left.BCPressure.Type			DirEquilRefPatch
+pfset Patch.left.BCPressure.Cycle			"constant"
+pfset Patch.left.BCPressure.RefGeom			domain
+pfset Patch.left.BCPressure.RefPatch			bottom
+pfset Patch.left.BCPressure.alltime.Value		10.0
+
+pfset Patch.right.BCPressure.Type			DirEquilRefPatch
+pfset Patch.right.BCPressure.Cycle			"constant"
+pfset Patch.right.BCPressure.RefGeom			domain
+pfset Patch.right.BCPressure.RefPatch			bottom
+pfset Patch.right.BCPressure.alltime.Value		9.97501
+
+pfset Patch.front.BCPressure.Type			FluxConst
+pfset Patch.front.BCPressure.Cycle			"constant"
+pfset Patch.front.BCPressure.alltime.Value		0.0
+
+pfset Patch.back.BCPressure.Type			FluxConst
+pfset Patch.back.BCPressure.Cycle			"constant"
+pfset Patch.back.BCPressure.alltime.Value		0.0
+
+pfset Patch.bottom.BCPressure.Type			FluxConst
+pfset Patch.bottom.BCPressure.Cycle			"constant"
+pfset Patch.bottom.BCPressure.alltime.Value		0.0
+
+pfset Patch.top.BCPressure.Type			        FluxConst
+pfset Patch.top.BCPressure.Cycle			"constant"
+pfset Patch.top.BCPressure.alltime.Value		0.0
+
+#---------------------------------------------------------
+# Topo slopes in x-direction
+#---------------------------------------------------------
+# topo slopes do not figure into the impes (fully sat) case but we still
+# need keys for them
+
+pfset TopoSlopesX.Type "Constant"
+pfset TopoSlopesX.GeomNames ""
+
+pfset TopoSlopesX.Geom.domain.Value 0.0
+
+#---------------------------------------------------------
+# Topo slopes in y-direction
+#---------------------------------------------------------
+
+pfset TopoSlopesY.Type "Constant"
+pfset TopoSlopesY.GeomNames ""
+
+pfset TopoSlopesY.Geom.domain.Value 0.0
+
+#---------------------------------------------------------
+# Mannings coefficient
+#---------------------------------------------------------
+# mannings roughnesses do not figure into the impes (fully sat) case but we still
+# need a key for them
+
+pfset Mannings.Type "Constant"
+pfset Mannings.GeomNames ""
+pfset Mannings.Geom.domain.Value 0.
+
+#-----------------------------------------------------------------------------
+# Phase sources:
+#-----------------------------------------------------------------------------
+
+pfset PhaseSources.water.Type                         Constant
+pfset PhaseSources.water.GeomNames                    domain
+pfset PhaseSources.water.Geom.domain.Value        0.0
+
+#-----------------------------------------------------------------------------
+#  Solver Impes
+#-----------------------------------------------------------------------------
+pfset Solver.MaxIter 50
+pfset Solver.AbsTol  1E-10
+pfset Solver.Drop   1E-15
+
+#-----------------------------------------------------------------------------
+# Run and Unload the ParFlow output files
+#-----------------------------------------------------------------------------
+
+pfrun $runname
+pfundist $runname
+
+file delete $runname.cond.txt
+
+#
+# Tests
+#
+source pftest.tcl
+
+set passed 1
+
+set perm [pfload $runname.out.perm_x.pfb]
+set nx 48
+set ny 48
+set nz 24
+
+# moments of ln(K / GeomMean), which should be N(0, Sigma^2)
+set n 0
+set sum 0.0
+set sum2 0.0
+for {set k 0} {$k < $nz} {incr k} {
+    for {set j 0} {$j < $ny} {incr j} {
+	for {set i 0} {$i < $nx} {incr i} {
+	    set y [expr log([pfgetelt $perm $i $j $k] / 10.0)]
+	    set ly($i,$j,$k) $y
+	    set sum [expr $sum + $y]
+	    set sum2 [expr $sum2 + $y * $y]
+	    incr n
+	}
+    }
+}
+set mean [expr $sum / $n]
+set std [expr sqrt($sum2 / $n - $mean * $mean)]
+
+# correlation at a lag of one correlation length in x and in z,
+# exp(-1) for the exponential covariance
+proc lagCorrelation {name di dj dk nx ny nz mean std} {
+    upvar $name ly
+    set n 0
+    set sum 0.0
+    for {set k 0} {$k < $nz - $dk} {incr k} {
+	for {set j 0} {$j < $ny - $dj} {incr j} {
+	    for {set i 0} {$i < $nx - $di} {incr i} {
+		set ip [expr $i + $di]
+		set jp [expr $j + $dj]
+		set kp [expr $k + $dk]
+		set sum [expr $sum + ($ly($i,$j,$k) - $mean) * ($ly($ip,$jp,$kp) - $mean)]
+		incr n
+	    }
+	}
+    }
+    return [expr $sum / $n / ($std * $std)]
+}
+
+set rho_x [lagCorrelation ly 4 0 0 $nx $ny $nz $mean $std]
+set rho_z [lagCorrelation ly 0 0 2 $nx $ny $nz $mean $std]
+
+puts [format "ln(K/Kg) mean %.3f std %.3f, correlation at lambda x %.3f z %.3f" \
+	  $mean $std $rho_x $rho_z]
+
+if {abs($mean) > 0.3} {
+    puts "FAILED : mean of ln(K/Kg) $mean is not 0"
+    set passed 0
+}
+
+if {abs($std - 1.0) > 0.2} {
+    puts "FAILED : standard deviation of ln(K/Kg) $std is not 1"
+    set passed 0
+}
+
+if {abs($rho_x - exp(-1.0)) > 0.15} {
+    puts "FAILED : correlation at lag lambda in x $rho_x is not exp(-1)"
+    set passed 0
+}
+
+if {abs($rho_z - exp(-1.0)) > 0.15} {
+    puts "FAILED : correlation at lag lambda in z $rho_z is not exp(-1)"
+    set passed 0
+}
+
+# the conditioning point is honored
+if ![pftestIsEqual [pfgetelt $perm 12 20 6] 50.0 "Conditioned perm"] {
+    set passed 0
+}
+
+if $passed {
+    puts "$runname : PASSED"
+} {
+    puts "$runname : FAILED"
+}
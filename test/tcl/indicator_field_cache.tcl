@@ -1,18 +1,27 @@
-#  This is a 2D sloped problem w/ time varying input and topography
-#  it is used as a test of active/inactive efficiency
 #
-#    Reed Maxwell, 11/08
-#      
+# Problem to test the geometry cache: the solids (a solid file and an
+# indicator field) of a first run are cached and read back by a second
+# run, which must give the same results.
+#
 
 #
 # Import the ParFlow TCL package
 #
-lappend auto_path $env(PARFLOW_DIR)/bin 
+lappend auto_path $env(PARFLOW_DIR)/bin
 package require parflow
 namespace import Parflow::*
 
 pfset FileVersion 4
 
+set name "indicator_field_cache"
+
+#
+# Control use of indicator field:
+# 0 = use domain
+# 1 = use indicator field
+#
+set useIndicatorField 1
+
 pfset Process.Topology.P 1
 pfset Process.Topology.Q 1
 pfset Process.Topology.R 1
@@ -24,13 +33,13 @@ pfset ComputationalGrid.Lower.X           0.0
 pfset ComputationalGrid.Lower.Y           0.0
 pfset ComputationalGrid.Lower.Z           0.0
 
-pfset ComputationalGrid.NX                [expr 100*$size]
-pfset ComputationalGrid.NY                1
-pfset ComputationalGrid.NZ                [expr 100*$size]
+pfset ComputationalGrid.NX                12
+pfset ComputationalGrid.NY                12
+pfset ComputationalGrid.NZ                12
 
-set   UpperX                              [expr 400*$size]
-set   UpperY                              1.0
-set   UpperZ                              [expr 200*$size]
+set   UpperX                              440
+set   UpperY                              120
+set   UpperZ                              220
 
 set   LowerX                              [pfget ComputationalGrid.Lower.X]
 set   LowerY                              [pfget ComputationalGrid.Lower.Y]
@@ -48,44 +57,36 @@ pfset ComputationalGrid.DZ	          [expr ($UpperZ - $LowerZ) / $NZ]
 # The Names of the GeomInputs
 #---------------------------------------------------------
 
-pfset GeomInput.Names                 "solidinput background"
-
-pfset GeomInput.solidinput.InputType  SolidFile
-pfset GeomInput.solidinput.GeomNames  domain
-pfset GeomInput.solidinput.FileName   crater2D.pfsol
-
+pfset GeomInput.Names                 "solid_input indicator_input"
 
-pfset GeomInput.background.InputType  Box
-pfset GeomInput.background.GeomName   background
-
-pfset Geom.background.Lower.X         -99999999.0
-pfset Geom.background.Lower.Y         -99999999.0
-pfset Geom.background.Lower.Z         -99999999.0
-pfset Geom.background.Upper.X         99999999.0
-pfset Geom.background.Upper.Y         99999999.0
-pfset Geom.background.Upper.Z         99999999.0
+pfset GeomInput.solid_input.InputType  SolidFile
+pfset GeomInput.solid_input.GeomNames  domain
+pfset GeomInput.solid_input.FileName   ../input/small_domain.pfsol
 
 pfset Geom.domain.Patches             "infiltration z-upper x-lower y-lower \
                                       x-upper y-upper z-lower"
 
+pfset GeomInput.indicator_input.InputType    IndicatorField
+pfset GeomInput.indicator_input.GeomNames    "indicator"
+pfset Geom.indicator_input.FileName          "small_domain_indicator_field.pfb"
+
+pfset GeomInput.indicator.Value		1
 
 #-----------------------------------------------------------------------------
 # Perm
 #-----------------------------------------------------------------------------
 pfset Geom.Perm.Names                 domain
 
-
-
 pfset Geom.domain.Perm.Type            Constant
 pfset Geom.domain.Perm.Value           1.0
 
 pfset Perm.TensorType               TensorByGeom
 
-pfset Geom.Perm.TensorByGeom.Names  "background"
+pfset Geom.Perm.TensorByGeom.Names  "domain"
 
-pfset Geom.background.Perm.TensorValX  1.0
-pfset Geom.background.Perm.TensorValY  1.0
-pfset Geom.background.Perm.TensorValZ  1.0
+pfset Geom.domain.Perm.TensorValX  1.0
+pfset Geom.domain.Perm.TensorValY  1.0
+pfset Geom.domain.Perm.TensorValZ  1.0
 
 #-----------------------------------------------------------------------------
 # Specific Storage
@@ -113,14 +114,12 @@ pfset Phase.water.Viscosity.Value	1.0
 
 pfset Contaminants.Names			""
 
-
 #-----------------------------------------------------------------------------
 # Retardation
 #-----------------------------------------------------------------------------
 
 pfset Geom.Retardation.GeomNames           ""
 
-
 #-----------------------------------------------------------------------------
 # Gravity
 #-----------------------------------------------------------------------------
@@ -135,12 +134,10 @@ pfset TimingInfo.BaseUnit		1.0
 pfset TimingInfo.StartCount		0
 pfset TimingInfo.StartTime		0.0
 pfset TimingInfo.StopTime               [expr 30.0*1]
-pfset TimingInfo.DumpInterval	        0 
-pfset TimingInfo.DumpInterval	        0 
-pfset TimingInfo.DumpAtEnd              True
+pfset TimingInfo.DumpInterval	        0
 pfset TimeStep.Type                     Constant
 pfset TimeStep.Value                    10.0
-
+pfset TimingInfo.DumpAtEnd              True
 
 #-----------------------------------------------------------------------------
 # Porosity
@@ -162,10 +159,16 @@ pfset Domain.GeomName domain
 #-----------------------------------------------------------------------------
 
 pfset Phase.RelPerm.Type               VanGenuchten
-pfset Phase.RelPerm.GeomNames          domain
 
-pfset Geom.domain.RelPerm.Alpha         3.34
-pfset Geom.domain.RelPerm.N             1.982 
+if $useIndicatorField {
+    pfset Phase.RelPerm.GeomNames          indicator
+    pfset Geom.indicator.RelPerm.Alpha         3.34
+    pfset Geom.indicator.RelPerm.N             1.982
+} {
+    pfset Phase.RelPerm.GeomNames          domain
+    pfset Geom.domain.RelPerm.Alpha         3.34
+    pfset Geom.domain.RelPerm.N             1.982
+}
 
 #---------------------------------------------------------
 # Saturation
@@ -250,7 +253,7 @@ pfset TopoSlopesY.GeomNames ""
 pfset TopoSlopesY.Geom.domain.Value 0.0
 
 #---------------------------------------------------------
-# Mannings coefficient 
+# Mannings coefficient
 #---------------------------------------------------------
 
 pfset Mannings.Type "Constant"
@@ -276,9 +279,9 @@ pfset Geom.infiltration.ICPressure.RefGeom                  domain
 # Phase sources:
 #-----------------------------------------------------------------------------
 
-pfset PhaseSources.Type                         Constant
-pfset PhaseSources.GeomNames                    background
-pfset PhaseSources.Geom.background.Value        0.0
+pfset PhaseSources.water.Type                         Constant
+pfset PhaseSources.water.GeomNames                    domain
+pfset PhaseSources.water.Geom.domain.Value        0.0
 
 
 #-----------------------------------------------------------------------------
@@ -291,7 +294,7 @@ pfset KnownSolution                                    NoKnownSolution
 # Set solver parameters
 #-----------------------------------------------------------------------------
 pfset Solver                                             Richards
-pfset Solver.MaxIter                                     10000
+pfset Solver.MaxIter                                     1
 
 pfset Solver.Nonlinear.MaxIter                           15
 pfset Solver.Nonlinear.ResidualTol                       1e-9
@@ -307,9 +310,77 @@ pfset Solver.Linear.Preconditioner                       MGSemi
 pfset Solver.Linear.Preconditioner.MGSemi.MaxIter        1
 pfset Solver.Linear.Preconditioner.MGSemi.MaxLevels      100
 
+pfset Solver.PrintSubsurfData True
+pfset Solver.PrintPressure True
+pfset Solver.PrintSaturation True
+pfset Solver.PrintConcentration False
+
+#-----------------------------------------------------------------------------
+# Geometry cache
+#-----------------------------------------------------------------------------
+pfset UseGeometryCache                                   True
+pfset GeometryCache.Directory                            geometry_cache
+
 #-----------------------------------------------------------------------------
-# Run and Unload the ParFlow output files
+# Run and do tests
 #-----------------------------------------------------------------------------
+
+file copy -force ../input/small_domain_indicator_field.pfb small_domain_indicator_field.pfb
+pfdist small_domain_indicator_field.pfb
+
+file delete -force geometry_cache
+file mkdir geometry_cache
+
+# The first run computes the solids and writes the cache
 pfrun $name
 pfundist $name
 
+file delete -force computed
+file mkdir computed
+foreach file [glob $name.out.*.pfb] {
+    file rename $file computed/$file
+}
+
+# The second run reads the solids from the cache
+pfrun $name
+pfundist $name
+pfundist small_domain_indicator_field.pfb
+
+source pftest.tcl
+set passed 1
+
+if {[llength [glob -nocomplain geometry_cache/geometry.*.cache]] != 1} {
+    puts "Geometry cache file was not written"
+    set passed 0
+}
+
+set file [open $name.out.txt r]
+set output [read $file]
+close $file
+if {[string first "Geometries read from cache" $output] < 0} {
+    puts "Geometries were not read from the cache"
+    set passed 0
+}
+
+foreach field "mask perm_x perm_y perm_z porosity" {
+    if ![pftestFile $name.out.$field.pfb "Max difference in $field" $sig_digits computed] {
+	set passed 0
+    }
+}
+
+foreach i "00000 00001" {
+    if ![pftestFile $name.out.press.$i.pfb "Max difference in Pressure for timestep $i" $sig_digits computed] {
+	set passed 0
+    }
+    if ![pftestFile $name.out.satur.$i.pfb "Max difference in Saturation for timestep $i" $sig_digits computed] {
+	set passed 0
+    }
+}
+
+file delete -force geometry_cache
+
+if $passed {
+    puts "$name : PASSED"
+} {
+    puts "$name : FAILED"
+}
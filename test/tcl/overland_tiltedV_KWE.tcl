@@ -507,3 +507,35 @@ if $runcheck==1 {
     puts "$runname : FAILED"
   }
 }
+
+#-----------------------------------------------------------------------------
+# KWE with the face coefficients cached and cube root depth powers, which
+# agree with the default evaluation to round-off
+#-----------------------------------------------------------------------------
+pfset Patch.z-upper.BCPressure.Type		      OverlandKinematic
+pfset Solver.Nonlinear.UseJacobian                       True
+pfset Solver.Linear.Preconditioner.PCMatrixType FullJacobian
+pfset Solver.OverlandKinematic.CacheCoefficients         True
+
+set runname TiltedV_OverlandKin
+puts "##########"
+puts "Running $runname Jacobian True Nonsymmetric Preconditioner CacheCoefficients"
+pfrun $runname
+pfundist $runname
+if $runcheck==1 {
+  set passed 1
+  foreach i "00000 00001 00002 00003 00004 00005 00006 00007 00008 00009 00010" {
+    if ![pftestFile $runname.out.press.$i.pfb "Max difference in Pressure for timestep $i" $sig_digits] {
+      set passed 0
+    }
+    if ![pftestFile  $runname.out.satur.$i.pfb "Max difference in Saturation for timestep $i" $sig_digits] {
+      set passed 0
+    }
+  }
+  if $passed {
+    puts "$runname : PASSED"
+  } {
+    puts "$runname : FAILED"
+  }
+}
+pfset Solver.OverlandKinematic.CacheCoefficients         False
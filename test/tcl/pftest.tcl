@@ -61,6 +61,30 @@ proc pftestFile {file message sig_digits {correct_output_dir "../correct_output"
     }
 }
 
+proc pftestFilesIdentical {file reference_file message} {
+    if ![file exists $file] {
+	puts "FAILED : output file <$file> not created"
+	return 0
+    }
+    if ![file exists $reference_file] {
+	puts "FAILED : reference file <$reference_file> does not exist"
+	return 0
+    }
+
+    set fa [open $file r]
+    set fb [open $reference_file r]
+    fconfigure $fa -translation binary
+    fconfigure $fb -translation binary
+    set identical [string equal [read $fa] [read $fb]]
+    close $fa
+    close $fb
+
+    if !$identical {
+	puts "FAILED : $message"
+    }
+    return $identical
+}
+
 proc pftestFileWithAbs {file message sig_digits abs_value {correct_output_dir "../correct_output"}} {
     if [file exists $file] {
 	set correct [pfload $correct_output_dir/$file]